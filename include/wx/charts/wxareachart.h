@@ -40,6 +40,8 @@
 #include "wxareachartoptions.h"
 #include "wxchartgrid.h"
 #include "wxchartpoint.h"
+#include "wxchartactivepoints.h"
+#include "wxchartpointseries.h"
 
 /// \ingroup dataclasses
 class wxAreaChartDataset
@@ -106,15 +108,17 @@ public:
 
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
-    void Save(const wxString &filename, const wxBitmapType &type,
-        const wxSize &size);
-
 private:
     void Initialize(const wxAreaChartData &data);
-    static wxDouble GetMinXValue(const wxVector<wxAreaChartDataset::ptr>& datasets);
-    static wxDouble GetMaxXValue(const wxVector<wxAreaChartDataset::ptr>& datasets);
-    static wxDouble GetMinYValue(const wxVector<wxAreaChartDataset::ptr>& datasets);
-    static wxDouble GetMaxYValue(const wxVector<wxAreaChartDataset::ptr>& datasets);
+    struct Extents
+    {
+        wxDouble m_minX;
+        wxDouble m_maxX;
+        wxDouble m_minY;
+        wxDouble m_maxY;
+    };
+
+    static Extents GetExtents(const wxVector<wxAreaChartDataset::ptr>& datasets);
 
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
@@ -149,26 +153,32 @@ private:
         typedef wxSharedPtr<Dataset> ptr;
 
         Dataset(bool showDots, bool showLine,
-            const wxColor &lineColor);
+            const wxColor &lineColor, const wxColor &dotColor);
 
         bool ShowDots() const;
         bool ShowLine() const;
         const wxColor& GetLineColor() const;
+        const wxColor& GetDotColor() const;
 
-        const wxVector<Point::ptr>& GetPoints() const;
-        void AppendPoint(Point::ptr point);
+        const wxChartPointSeries& GetPoints() const;
+        wxChartPointSeries& GetPoints();
 
     private:
         bool m_showDots;
         bool m_showLine;
         wxColor m_lineColor;
-        wxVector<Point::ptr> m_points;
+        wxColor m_dotColor;
+        wxChartPointSeries m_points;
     };
 
+    Point::ptr CreatePoint(const Dataset &dataset, size_t index) const;
+
 private:
     wxAreaChartOptions m_options;
+    Extents m_extents;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
+    wxChartActivePoints<Point::ptr> m_activePoints;
 };
 
 #endif
@@ -46,7 +46,7 @@
 /// A bar chart.
 
 /// \ingroup chartclasses
-class wxBarChart : public wxChart
+class wxBarChart : public wxChart, public wxChartsCategoricalDataObserver
 {
 public:
     wxBarChart(wxChartsCategoricalData::ptr &data, const wxSize &size);
@@ -55,10 +55,23 @@ public:
 
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
+    virtual void OnValueChanged(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index, wxDouble oldValue);
+    virtual void OnCategoryAppended(const wxChartsCategoricalData &data);
+    virtual void OnDatasetAdded(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+    virtual void OnDatasetRemoved(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+
 private:
     void Initialize(wxChartsCategoricalData::ptr &data);
-    static wxDouble GetMinValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
-    static wxDouble GetMaxValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
+    struct Extents
+    {
+        wxDouble m_minValue;
+        wxDouble m_maxValue;
+    };
+
+    static Extents GetExtents(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
 
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
@@ -76,8 +89,7 @@ private:
         Bar(wxDouble value,
             const wxChartTooltipProvider::ptr tooltipProvider,
             wxDouble x, wxDouble y,
-            const wxColor &fillColor, const wxColor &strokeColor,
-            int directions);
+            const wxChartRectangleOptions &options);
 
         wxDouble GetValue() const;
 
@@ -90,17 +102,32 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset();
+        Dataset(const wxChartRectangleOptions &options);
+
+        const wxChartRectangleOptions& GetRectangleOptions() const;
 
         const wxVector<Bar::ptr>& GetBars() const;
         void AppendBar(Bar::ptr bar);
+        void SetBar(size_t index, Bar::ptr bar);
 
     private:
+        wxChartRectangleOptions m_rectangleOptions;
         wxVector<Bar::ptr> m_bars;
     };
 
+    Bar::ptr CreateBar(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index,
+        const wxChartRectangleOptions &options) const;
+    Dataset::ptr CreateDataset(const wxChartsCategoricalData &data,
+        size_t datasetIndex) const;
+    void FitBar(size_t datasetIndex, size_t index, wxDouble barHeight);
+    bool UpdateValueAxis(const wxChartsCategoricalData &data, bool recompute);
+
 private:
     wxSharedPtr<wxBarChartOptions> m_options;
+    // The range of the values, it is kept up to date
+    // as the data changes
+    Extents m_extents;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
 };
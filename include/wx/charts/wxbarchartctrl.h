@@ -42,7 +42,7 @@
 /// A control that displays a bar chart.
 
 /// \ingroup chartclasses
-class wxBarChartCtrl : public wxChartCtrl
+class wxBarChartCtrl : public wxChartCtrl, public wxChartsCategoricalDataObserver
 {
 public:
     /// Constructs a wxBarChartCtrl control.
@@ -65,10 +65,21 @@ public:
         wxSharedPtr<wxBarChartOptions> options, const wxPoint &pos = wxDefaultPosition,
         const wxSize &size = wxDefaultSize, long style = 0);
 
+    virtual ~wxBarChartCtrl();
+
+    virtual void OnValueChanged(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index, wxDouble oldValue);
+    virtual void OnCategoryAppended(const wxChartsCategoricalData &data);
+    virtual void OnDatasetAdded(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+    virtual void OnDatasetRemoved(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+
 private:
     virtual wxBarChart& GetChart();
 
 private:
+    wxChartsCategoricalData::ptr m_data;
     wxBarChart m_barChart;
 };
 
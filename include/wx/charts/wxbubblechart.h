@@ -100,12 +100,17 @@ public:
 
 private:
     void Initialize(const wxBubbleChartData &data);
-    static wxDouble GetMinXValue(const wxVector<wxBubbleChartDataset::ptr>& datasets);
-    static wxDouble GetMaxXValue(const wxVector<wxBubbleChartDataset::ptr>& datasets);
-    static wxDouble GetMinYValue(const wxVector<wxBubbleChartDataset::ptr>& datasets);
-    static wxDouble GetMaxYValue(const wxVector<wxBubbleChartDataset::ptr>& datasets);
-    static wxDouble GetMinZValue(const wxVector<wxBubbleChartDataset::ptr>& datasets);
-    static wxDouble GetMaxZValue(const wxVector<wxBubbleChartDataset::ptr>& datasets);
+    struct Extents
+    {
+        wxDouble m_minX;
+        wxDouble m_maxX;
+        wxDouble m_minY;
+        wxDouble m_maxY;
+        wxDouble m_minZ;
+        wxDouble m_maxZ;
+    };
+
+    static Extents GetExtents(const wxVector<wxBubbleChartDataset::ptr>& datasets);
 
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
@@ -149,10 +154,9 @@ private:
 
 private:
     wxBubbleChartOptions m_options;
+    Extents m_extents;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
-    wxDouble m_minZValue;
-    wxDouble m_maxZValue;
 };
 
 #endif
@@ -29,6 +29,8 @@
 #include "wxchartohlcdata.h"
 #include "wxcandlestickchartoptions.h"
 #include "wxchartgrid.h"
+#include "wxchartactivepoints.h"
+#include <functional>
 
 /// Data for the wxCandlestickChartCtrl control.
 
@@ -36,6 +38,10 @@
 class wxCandlestickChartData
 {
 public:
+    /// Function used to format the text of the tooltips.
+    /// It receives the values of the candlestick.
+    typedef std::function<wxString(const wxChartOHLCData &data)> TooltipFormatter;
+
     wxCandlestickChartData(const wxVector<wxString> &labels, const wxVector<wxChartOHLCData> &data);
 
     /// Gets the labels of the X axis.
@@ -48,6 +54,16 @@ public:
     const wxColor& GetDownFillColor() const;
     unsigned int GetRectangleWidth() const;
     const wxVector<wxChartOHLCData>& GetData() const;
+    /// Gets the function used to format the text of
+    /// the tooltips.
+    /// @return The formatter. If it is empty the open,
+    /// high, low and close values are displayed.
+    const TooltipFormatter& GetTooltipFormatter() const;
+    /// Sets the function used to format the text of
+    /// the tooltips. The function is only called when
+    /// a tooltip is displayed.
+    /// @param formatter The new formatter.
+    void SetTooltipFormatter(const TooltipFormatter &formatter);
 
 private:
     wxVector<wxString> m_labels;
@@ -57,6 +73,7 @@ private:
     wxColor m_downFillColor;
     unsigned int m_rectangleWidth;
     wxVector<wxChartOHLCData> m_data;
+    TooltipFormatter m_tooltipFormatter;
 };
 
 /// A candlestick chart.
@@ -70,8 +87,15 @@ public:
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
 private:
-    static wxDouble GetMinValue(const wxCandlestickChartData &data);
-    static wxDouble GetMaxValue(const wxCandlestickChartData &data);
+    struct Extents
+    {
+        wxDouble m_minValue;
+        wxDouble m_maxValue;
+    };
+
+    // Returns the lowest low value and the highest
+    // high value of the candlesticks
+    static Extents GetExtents(const wxCandlestickChartData &data);
 
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
@@ -79,20 +103,24 @@ private:
     virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point);
 
 private:
-    class Candlestick : public wxChartElement
+    // The values and the position on the screen of a
+    // candlestick
+    class Candlestick
     {
     public:
-        typedef wxSharedPtr<Candlestick> ptr;
-
-        Candlestick(const wxChartOHLCData &data, const wxColor &lineColor, unsigned int lineWidth,
-            const wxColor &upFillColor, const wxColor &downFillColor, unsigned int rectangleWidth,
-            const wxChartTooltipProvider::ptr tooltipProvider);
+        Candlestick(const wxChartOHLCData &data);
 
-        virtual void Draw(wxGraphicsContext &gc) const;
-        virtual bool HitTest(const wxPoint &point) const;
-        virtual wxPoint2DDouble GetTooltipPosition() const;
+        const wxChartOHLCData& GetData() const;
+        bool HitTest(const wxPoint &point, wxDouble rectangleWidth) const;
+        wxPoint2DDouble GetTooltipPosition() const;
 
         void Update(const wxChartGridMapping& mapping, size_t index);
+        // Returns true if the close value is not below the
+        // open value
+        bool IsUp() const;
+        // Adds the wicks and the body of the candlestick
+        // to the path
+        void AddToPath(wxGraphicsPath &path, wxDouble rectangleWidth) const;
 
     private:
         wxChartOHLCData m_data;
@@ -100,17 +128,44 @@ private:
         wxPoint2DDouble m_highPoint;
         wxPoint2DDouble m_openPoint;
         wxPoint2DDouble m_closePoint;
-        wxColor m_lineColor;
-        unsigned int m_lineWidth;
-        wxColor m_upFillColor;
-        wxColor m_downFillColor;
-        unsigned int m_rectangleWidth;
     };
 
+    // The element created for a candlestick when it
+    // becomes active
+    class ActiveCandlestick : public wxChartElement
+    {
+    public:
+        typedef wxSharedPtr<ActiveCandlestick> ptr;
+
+        ActiveCandlestick(const Candlestick &candlestick, const wxCandlestickChart &chart,
+            const wxChartTooltipProvider::ptr tooltipProvider);
+
+        virtual void Draw(wxGraphicsContext &gc) const;
+        virtual bool HitTest(const wxPoint &point) const;
+        virtual wxPoint2DDouble GetTooltipPosition() const;
+
+    private:
+        Candlestick m_candlestick;
+        const wxCandlestickChart &m_chart;
+    };
+
+    ActiveCandlestick::ptr CreateActiveCandlestick(size_t index) const;
+
 private:
     wxCandlestickChartOptions m_options;
+    // The range of the values, computed once
+    // before the grid is created
+    Extents m_extents;
     wxChartGrid m_grid;
-    wxVector<Candlestick::ptr> m_data;
+    wxVector<Candlestick> m_data;
+    wxVector<wxString> m_labels;
+    wxCandlestickChartData::TooltipFormatter m_tooltipFormatter;
+    wxDouble m_rectangleWidth;
+    // The pen and brushes are shared by all the candlesticks
+    wxPen m_linePen;
+    wxBrush m_upBrush;
+    wxBrush m_downBrush;
+    wxChartActivePoints<ActiveCandlestick::ptr> m_activeCandlesticks;
 };
 
 #endif
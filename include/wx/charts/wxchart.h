@@ -27,7 +27,11 @@
 
 #include "wxchartcommonoptions.h"
 #include "wxchartelement.h"
+#include "wxcharttooltip.h"
+#include "wxchartmultitooltip.h"
+#include "wxchartinstrumentation.h"
 #include <wx/sharedptr.h>
+#include <wx/image.h>
 
 /// \defgroup chartclasses
 
@@ -45,10 +49,82 @@ public:
 
     void SetSize(const wxSize &size);
     void Draw(wxGraphicsContext &gc);
-    void ActivateElementsAt(const wxPoint &point);
+    /// Draws the chart without the tooltips. Together with
+    /// DrawTooltipLayer() this allows the chart to be
+    /// cached so that only the tooltips need to be redrawn
+    /// when the mouse moves.
+    /// @param gc The graphics context to draw on.
+    void DrawChartLayer(wxGraphicsContext &gc);
+    /// Draws the tooltips of the active elements. This
+    /// must be called after DrawChartLayer() has been
+    /// called at least once since the chart changed.
+    /// @param gc The graphics context to draw on.
+    void DrawTooltipLayer(wxGraphicsContext &gc);
+    /// Gets the area covered by the tooltips of the
+    /// active elements. The tooltips are laid out if
+    /// needed and the layout is reused by the next call
+    /// to DrawTooltipLayer().
+    /// @param gc The graphics context used to measure
+    /// the tooltips.
+    /// @return The area covered by the tooltips. The
+    /// rectangle is empty if there are no tooltips.
+    wxRect GetTooltipLayerBounds(wxGraphicsContext &gc);
+    /// Finds the elements at the given point and makes
+    /// them the active elements, whose tooltips are
+    /// displayed.
+    /// @param point The position of the mouse.
+    /// @retval true The set of active elements changed.
+    /// @retval false The same elements are still active and
+    /// the tooltips don't need to be redrawn.
+    bool ActivateElementsAt(const wxPoint &point);
 
-protected:
+    /// Draws the chart, without the tooltips, to an
+    /// image. This doesn't require a window and can be
+    /// used to generate images in batch jobs, but the GTK
+    /// port still needs a display to initialize wxWidgets.
+    /// @param image The image the chart is drawn to. It is
+    /// recreated with the given size and a white background.
+    /// @param size The size of the image. The chart isn't
+    /// laid out again for it: the chart is drawn at its
+    /// current size from the top left corner of the image,
+    /// so it is cropped if the image is smaller. Call
+    /// SetSize() with the same size first to fill the image.
+    /// @retval true The chart was drawn.
+    /// @retval false The chart couldn't be drawn.
+    bool RenderTo(wxImage &image, const wxSize &size);
+    /// Saves an image of the chart to a file.
+    /// @param filename The name of the file.
+    /// @param type The format of the file. The image
+    /// handler for this format must have been added.
+    /// @param size The size of the image.
+    void Save(const wxString &filename, const wxBitmapType &type,
+        const wxSize &size);
+
+    /// Gets the counters that measure the time spent
+    /// in each stage of the rendering of the chart.
+    /// @return The instrumentation of the chart.
+    wxChartInstrumentation& GetInstrumentation();
+    /// Gets the counters that measure the time spent
+    /// in each stage of the rendering of the chart.
+    /// @return The instrumentation of the chart.
+    const wxChartInstrumentation& GetInstrumentation() const;
+
+    /// Lays out the elements of the chart if its data or
+    /// its size changed since it was last laid out. Draw()
+    /// does this so this only needs to be called to lay the
+    /// chart out ahead of drawing it or to measure the
+    /// layout on its own.
     void Fit();
+
+protected:
+    /// Forces the next call to Fit() to recompute the
+    /// layout of the chart, for instance because the
+    /// grid mapping or the data changed.
+    void InvalidateFit();
+    /// Deactivates all the elements and hides their
+    /// tooltips. This must be called before destroying
+    /// elements that may be active.
+    void DeactivateElements();
     void DrawTooltips(wxGraphicsContext &gc);
 
 private:
@@ -57,9 +133,17 @@ private:
     virtual void DoDraw(wxGraphicsContext &gc, bool suppressTooltips) = 0;
     virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) = 0;
 
+    void CreateTooltips();
+
 private:
     bool m_needsFit;
     wxSharedPtr<wxVector<const wxChartElement*> > m_activeElements;
+    // The tooltips of the active elements are kept so that
+    // their text is only retrieved and measured once
+    bool m_tooltipsValid;
+    wxSharedPtr<wxChartTooltip> m_tooltip;
+    wxSharedPtr<wxChartMultiTooltip> m_multiTooltip;
+    wxChartInstrumentation m_instrumentation;
 };
 
 #endif
@@ -0,0 +1,138 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTACTIVEPOINTS_H_
+#define _WX_CHARTS_WXCHARTACTIVEPOINTS_H_
+
+#include <wx/vector.h>
+#include <unordered_map>
+#include <utility>
+
+/// Keeps the points that are active in a chart.
+
+/// Charts that store their data in a wxChartPointSeries only
+/// create point elements when they become active. This class
+/// keeps the points created by the previous hit test so that
+/// they can be reused if the same points are still active. The
+/// set of active elements is then unchanged and the control
+/// doesn't need to repaint the tooltips.
+/// @tparam PointPtr The type of the shared pointer to the
+/// points.
+template<typename PointPtr>
+class wxChartActivePoints
+{
+public:
+    /// Constructs an empty wxChartActivePoints instance.
+    wxChartActivePoints()
+        : m_reusable(true), m_reuse(true)
+    {
+    }
+
+    /// Starts a new hit test. The points that were active
+    /// are kept alive until the next hit test since the
+    /// chart may still refer to them.
+    void Begin()
+    {
+        m_previous = m_current;
+        m_current.clear();
+        m_reuse = m_reusable;
+        m_reusable = true;
+
+        // Dense charts can have thousands of points under
+        // the mouse so the points to reuse are looked up
+        // rather than searched for
+        m_previousIndices.clear();
+        for (size_t i = 0; m_reuse && (i < m_previous.size()); ++i)
+        {
+            m_previousIndices[Key(m_previous[i].dataset, m_previous[i].index)] = i;
+        }
+    }
+
+    /// Adds a point to the active points. The point created
+    /// by the previous hit test for the same dataset and index
+    /// is reused if there is one.
+    /// @param dataset The index of the dataset.
+    /// @param index The index of the point in the dataset.
+    /// @param create A function that creates the point if it
+    /// can't be reused.
+    /// @return The active point.
+    template<typename Factory>
+    const PointPtr& Add(size_t dataset, size_t index, Factory create)
+    {
+        if (m_reuse)
+        {
+            typename IndexMap::const_iterator it = m_previousIndices.find(Key(dataset, index));
+            if (it != m_previousIndices.end())
+            {
+                m_current.push_back(m_previous[it->second]);
+                return m_current.back().point;
+            }
+        }
+        m_current.push_back(Entry(dataset, index, create()));
+        return m_current.back().point;
+    }
+
+    /// Prevents the current points from being reused by the
+    /// next hit test. This must be called when the values or
+    /// the positions of the points change.
+    void Invalidate()
+    {
+        m_reusable = false;
+    }
+
+private:
+    struct Entry
+    {
+        Entry(size_t d, size_t i, const PointPtr &p)
+            : dataset(d), index(i), point(p)
+        {
+        }
+
+        size_t dataset;
+        size_t index;
+        PointPtr point;
+    };
+
+    // The dataset and the index of a point
+    typedef std::pair<size_t, size_t> Key;
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const
+        {
+            return std::hash<size_t>()(key.second ^ (key.first * 2654435761u));
+        }
+    };
+
+    // The positions of the entries of m_previous
+    typedef std::unordered_map<Key, size_t, KeyHash> IndexMap;
+
+    wxVector<Entry> m_current;
+    wxVector<Entry> m_previous;
+    IndexMap m_previousIndices;
+    bool m_reusable;
+    bool m_reuse;
+};
+
+#endif
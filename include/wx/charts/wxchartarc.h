@@ -70,6 +70,9 @@ public:
 
     virtual wxPoint2DDouble GetTooltipPosition() const;
 
+    /// Gets the center of the arc.
+    /// @return The coordinates of the center.
+    wxPoint2DDouble GetCenter() const;
     /// Sets the center of the arc.
     /// @param x The X coordinate of the center.
     /// @param y The Y coordinate of the center.
@@ -40,6 +40,7 @@
 #include "wxchartaxisoptions.h"
 #include "wxchartlabelgroup.h"
 #include <wx/graphics.h>
+#include <functional>
 
 /// This class represents an axis.
 
@@ -49,6 +50,10 @@ class wxChartAxis : public wxChartElement
 public:
     /// Smart pointer typedef.
     typedef wxSharedPtr<wxChartAxis> ptr;
+    /// Function that creates the label of a tick mark when
+    /// the labels are lazy. It receives the index of the
+    /// tick mark.
+    typedef std::function<wxString(size_t index)> LabelGenerator;
 
     virtual void Draw(wxGraphicsContext &gc) const;
 
@@ -58,7 +63,9 @@ public:
 
     /// Updates the size of each label using the 
     /// font details specified in the axis options
-    /// and the provided graphics context.
+    /// and the provided graphics context. If the labels
+    /// are lazy they are created first, for as many tick
+    /// marks as fit along the axis at its current length.
     /// @param gc The graphics context.
     void UpdateLabelSizes(wxGraphicsContext &gc);
     void Fit(wxPoint2DDouble startPoint, wxPoint2DDouble endPoint);
@@ -69,6 +76,28 @@ public:
     const wxChartLabelGroup& GetLabels() const;
     void SetLabels(const wxVector<wxChartLabel> &labels);
 
+    /// Whether the labels are created by a generator.
+    /// @retval true The labels are lazy.
+    /// @retval false There is a label for each tick mark.
+    bool HasLazyLabels() const;
+    /// Appends tick marks to an axis with lazy labels. The
+    /// labels are created the next time the axis is fitted.
+    /// @param count The number of tick marks to append.
+    void AppendTickMarks(size_t count);
+    /// Removes tick marks from the start of an axis with lazy
+    /// labels. The indices passed to the generator are shifted
+    /// accordingly.
+    /// @param count The number of tick marks to remove.
+    void RemoveFirstTickMarks(size_t count);
+    /// Gets the first tick mark, starting at a given one, that
+    /// is drawn along with its grid line. All the tick marks are
+    /// drawn unless the labels are lazy, in which case only the
+    /// tick marks with a label are.
+    /// @param index The index of the tick mark to start from.
+    /// @return The index of the tick mark. It may not be less
+    /// than the number of tick marks.
+    size_t GetNextShownTickMark(size_t index) const;
+
     wxPoint2DDouble CalculateLabelPosition(size_t index);
     size_t GetNumberOfTickMarks() const;
     wxDouble GetDistanceBetweenTickMarks() const;
@@ -87,9 +116,17 @@ protected:
     /// @param options The settings to be used for the axis.
     wxChartAxis(const std::string &id, const wxVector<wxString> &labels,
         const wxChartAxisOptions &options);
+    /// Constructs a wxChartAxis element whose labels are lazy.
+    /// @param count The number of tick marks.
+    /// @param generator The function that creates the labels.
+    /// @param options The settings to be used for the axis.
+    wxChartAxis(const std::string &id, size_t count,
+        const LabelGenerator &generator, const wxChartAxisOptions &options);
 
 private:
     void DrawTickMarks(wxGraphicsContext &gc) const;
+    void CreateLazyLabels(wxGraphicsContext &gc);
+    wxChartLabel CreateLabel(const wxString &text) const;
 
 private:
     wxChartAxisOptions m_options;
@@ -97,6 +134,15 @@ private:
     wxPoint2DDouble m_startPoint;
     wxPoint2DDouble m_endPoint;
     wxChartLabelGroup m_labels;
+    // When the labels are lazy the axis has m_tickMarkCount
+    // tick marks but only one every m_labelStride has a label.
+    // The tick marks with a label are chosen from the number of
+    // tick marks that were removed so that they don't change
+    // as the axis scrolls.
+    LabelGenerator m_labelGenerator;
+    size_t m_tickMarkCount;
+    size_t m_removedTickMarks;
+    size_t m_labelStride;
 };
 
 #endif
@@ -49,8 +49,21 @@ public:
     /// axis.
     wxChartCategoricalAxis(const std::string &id, const wxVector<wxString> &labels,
         const wxChartAxisOptions &options);
+    /// Constructs a wxChartCategoricalAxis axis whose labels
+    /// are only created for the tick marks that are labelled
+    /// when the axis is drawn, see wxChartAxis::UpdateLabelSizes().
+    /// This is meant for axes with many more categories than
+    /// can be labelled.
+    /// @param count The number of tick marks.
+    /// @param generator The function that creates the labels.
+    /// @param options The settings to be used for the
+    /// axis.
+    wxChartCategoricalAxis(const std::string &id, size_t count,
+        const LabelGenerator &generator, const wxChartAxisOptions &options);
     static ptr make_shared(const std::string &id, const wxVector<wxString> &labels,
         const wxChartAxisOptions &options);
+    static ptr make_shared(const std::string &id, size_t count,
+        const LabelGenerator &generator, const wxChartAxisOptions &options);
 };
 
 #endif
@@ -27,12 +27,31 @@
 
 #include "wxchart.h"
 #include <wx/control.h>
+#include <wx/bitmap.h>
+#include <wx/timer.h>
+#include <wx/stopwatch.h>
 
 /// Base class for the chart controls.
 
 /// The fact that all charts derive from wxChartCtrl is probably
 /// of little use for users of these classes. The base class
 /// is there to make implementation of chart controls easier.
+///
+/// The chart is drawn to a bitmap that is kept until the
+/// control is resized or refreshed. When the mouse moves
+/// only the tooltips are drawn on top of the cached bitmap
+/// so hovering over a chart doesn't depend on the
+/// number of points it displays. Nothing is repainted if
+/// the same elements are still active, otherwise only the
+/// area covered by the old and the new tooltips is.
+/// Derived classes must call Refresh() when the chart changes.
+/// The refreshes are coalesced: the chart is redrawn at most
+/// once per frame interval, see SetFrameInterval(), and not at
+/// all between BeginUpdate() and EndUpdate().
+///
+/// Controls that accept data from other threads through
+/// wxChartIngestionQueue instances drain the queues when the
+/// application is idle and on a timer, see DrainIngestionQueues().
 /// \ingroup chartclasses
 class wxChartCtrl : public wxControl
 {
@@ -54,14 +73,124 @@ public:
         const wxSize &size = wxDefaultSize,
         long style = 0);
 
+    /// Redraws the chart. The cached image of the chart
+    /// is discarded and the chart is redrawn entirely when
+    /// the next frame is due, or when EndUpdate() is called
+    /// if an update is in progress. Until then the paints
+    /// show the cached image.
+    /// @param eraseBackground See wxWindow::Refresh.
+    /// @param rect Ignored, the whole chart is redrawn.
+    virtual void Refresh(bool eraseBackground = true,
+        const wxRect *rect = NULL);
+
+    /// Gets the minimum time between two redraws of the chart.
+    /// @return The frame interval in milliseconds.
+    int GetFrameInterval() const;
+    /// Sets the minimum time between two redraws of the chart.
+    /// Refreshes requested before the next frame is due are
+    /// merged into a single redraw. The default is 16 ms,
+    /// about 60 frames per second.
+    /// @param milliseconds The frame interval. If it is 0
+    /// the chart is redrawn on each refresh.
+    void SetFrameInterval(int milliseconds);
+    /// Starts a batch of changes. The chart isn't redrawn
+    /// until EndUpdate() has been called as many times as
+    /// BeginUpdate(). See also wxChartCtrlUpdateLocker.
+    void BeginUpdate();
+    /// Ends a batch of changes. The chart is redrawn if it
+    /// was refreshed during the batch.
+    void EndUpdate();
+    /// Whether a batch of changes is in progress.
+    /// @retval true BeginUpdate() was called more often than
+    /// EndUpdate().
+    /// @retval false No batch is in progress.
+    bool IsUpdating() const;
+
+    /// Whether the counters of the last frame are drawn
+    /// on top of the chart.
+    /// @retval true The counters are drawn.
+    /// @retval false The counters are not drawn.
+    bool ShowsDebugOverlay() const;
+    /// Sets whether the counters of the last frame are drawn
+    /// on top of the chart. Showing the overlay enables the
+    /// instrumentation of the chart, see wxChart::GetInstrumentation().
+    /// @param show Whether to draw the counters.
+    void SetDebugOverlay(bool show);
+
+    /// Adds the values waiting in the ingestion queues of the
+    /// control to the chart. This is called automatically when
+    /// the application is idle and at the interval set with
+    /// SetIngestionInterval().
+    /// @retval true Values were added.
+    /// @retval false The queues were empty.
+    virtual bool DrainIngestionQueues();
+    /// Sets how often the ingestion queues are drained when
+    /// the application isn't idle. The default is 20 ms.
+    /// @param milliseconds The interval between two drains.
+    void SetIngestionInterval(int milliseconds);
+
+protected:
+    /// Schedules a redraw of the chart, like Refresh().
+    /// @param layoutParent Whether to lay out the parent
+    /// window before the chart is redrawn.
+    void ScheduleRefresh(bool layoutParent);
+    /// Starts draining the ingestion queues. Derived classes
+    /// call this when their first queue is created.
+    void StartIngestion();
+
 private:
     virtual wxChart& GetChart() = 0;
 
     void OnPaint(wxPaintEvent &evt);
     void OnSize(wxSizeEvent &evt);
+#if wxCHECK_VERSION(3, 1, 3)
+    void OnDPIChanged(wxDPIChangedEvent &evt);
+#endif
     void OnMouseOver(wxMouseEvent &evt);
+    void DrawDebugOverlay(wxGraphicsContext &gc);
+    void OnRefreshTimer(wxTimerEvent &evt);
+    void FlushRefresh();
+    void OnIngestionIdle(wxIdleEvent &evt);
+    void OnIngestionTimer(wxTimerEvent &evt);
+
+private:
+    // The chart without its tooltips
+    wxBitmap m_chartLayer;
+    bool m_chartLayerValid;
+    // The area covered by the tooltips the last time
+    // they were painted
+    wxRect m_tooltipBounds;
+    // The time since the chart was last refreshed or drawn
+    wxStopWatch m_frameWatch;
+    // Whether m_frameWatch was started, the first
+    // refresh is never delayed
+    bool m_frameStarted;
+    int m_frameInterval;
+    wxTimer m_refreshTimer;
+    bool m_refreshPending;
+    bool m_layoutPending;
+    int m_updateDepth;
+    bool m_debugOverlay;
+    wxTimer m_ingestionTimer;
+    int m_ingestionInterval;
+    bool m_ingestionStarted;
 
     DECLARE_EVENT_TABLE();
 };
 
+/// Calls wxChartCtrl::BeginUpdate() in its constructor
+/// and wxChartCtrl::EndUpdate() in its destructor.
+class wxChartCtrlUpdateLocker
+{
+public:
+    /// Starts a batch of changes.
+    /// @param ctrl The control.
+    wxChartCtrlUpdateLocker(wxChartCtrl &ctrl);
+    /// Ends the batch of changes.
+    ~wxChartCtrlUpdateLocker();
+
+private:
+    wxChartCtrl &m_ctrl;
+};
+
 #endif
@@ -0,0 +1,98 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTDECIMATION_H_
+#define _WX_CHARTS_WXCHARTDECIMATION_H_
+
+#include <wx/geometry.h>
+#include <wx/vector.h>
+
+/// The algorithm used to reduce the number of points
+/// of a line before it is drawn.
+enum wxChartDecimationMode
+{
+    /// All the points are drawn.
+    wxCHARTDECIMATION_NONE,
+    /// The first, minimum, maximum and last points
+    /// of each pixel column are kept. The result is
+    /// visually identical to the full line.
+    wxCHARTDECIMATION_MINMAX,
+    /// Largest-Triangle-Three-Buckets downsampling
+    /// to about two points per pixel column.
+    wxCHARTDECIMATION_LTTB
+};
+
+/// This class contains the algorithms used to decimate lines.
+
+/// The functions operate on window coordinates so that the amount
+/// of points that is kept depends on the width of the chart
+/// and not on the number of values in the dataset.
+class wxChartDecimation
+{
+public:
+    /// Decimates a line using the given algorithm.
+    /// @param mode The algorithm to use.
+    /// @param points The points of the line in window
+    /// coordinates. They are expected to be sorted by
+    /// X coordinate.
+    /// @param result When the function returns this
+    /// contains the points that should be drawn.
+    static void Decimate(wxChartDecimationMode mode,
+        const wxVector<wxPoint2DDouble> &points,
+        wxVector<wxPoint2DDouble> &result);
+    /// Keeps the first, minimum, maximum and last points
+    /// of each pixel column, in their original order.
+    /// @param points The points of the line in window
+    /// coordinates.
+    /// @param result When the function returns this
+    /// contains the decimated line.
+    static void MinMax(const wxVector<wxPoint2DDouble> &points,
+        wxVector<wxPoint2DDouble> &result);
+    /// Appends the first, minimum, maximum and last points of
+    /// a run of consecutive points to a line, in their original
+    /// order and without duplicates. This is the kernel of
+    /// MinMax(), it is also used on runs of points that cover a
+    /// range of X values rather than a pixel column.
+    /// @param x Pointer to the X value of the point at index 0.
+    /// @param y Pointer to the Y value of the point at index 0.
+    /// @param stride The distance between the values of two
+    /// consecutive points, in number of wxDouble.
+    /// @param first The index of the first point of the run.
+    /// @param last The index of the last point of the run.
+    /// @param result The line the points are appended to.
+    static void AppendMinMax(const wxDouble *x, const wxDouble *y,
+        size_t stride, size_t first, size_t last,
+        wxVector<wxPoint2DDouble> &result);
+    /// Downsamples a line using the Largest-Triangle-Three-Buckets
+    /// algorithm. The first and last points are always kept.
+    /// @param points The points of the line in window
+    /// coordinates.
+    /// @param threshold The number of points to keep.
+    /// @param result When the function returns this
+    /// contains the decimated line.
+    static void LTTB(const wxVector<wxPoint2DDouble> &points,
+        size_t threshold, wxVector<wxPoint2DDouble> &result);
+};
+
+#endif
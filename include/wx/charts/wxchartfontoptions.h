@@ -64,6 +64,13 @@ public:
     /// @return The font color.
     const wxColor& GetColor() const;
 
+    /// Compares two sets of font settings, including the
+    /// color of the text.
+    /// @param other The settings to compare with.
+    /// @return true if all the settings are equal.
+    bool operator==(const wxChartFontOptions &other) const;
+    bool operator!=(const wxChartFontOptions &other) const;
+
 private:
     wxFontFamily m_family;
     int m_size;
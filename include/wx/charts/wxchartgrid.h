@@ -109,7 +109,18 @@ public:
 
     virtual wxPoint2DDouble GetTooltipPosition() const;
 
-    void Fit(wxGraphicsContext &gc);
+    /// Computes the layout of the axes if the size
+    /// or the ranges of the grid changed since the
+    /// last call.
+    /// @param gc The graphics context used to measure
+    /// the labels.
+    /// @retval true The layout was recomputed.
+    /// @retval false The layout was already up to date.
+    bool Fit(wxGraphicsContext &gc);
+    /// Forces the layout to be recomputed by the next
+    /// call to Fit(), for instance after the labels of
+    /// one of the axes were changed directly.
+    void InvalidateFit();
 
     /// Resizes the grid.
     /// @param size The new size of the area where the grid
@@ -128,13 +139,35 @@ public:
     void Shift(double dx,double dy);
     void ChangeCorners(wxDouble minX,wxDouble maxX,
         wxDouble minY,wxDouble maxY);
-    void UpdateAxisLimit(const std::string& axisId, wxDouble min, wxDouble max);
+    /// Changes the range of values shown on a numerical
+    /// axis. An existing numerical axis is updated in place.
+    /// @param axisId The id of the axis, "x" or "y".
+    /// @param min The minimum value.
+    /// @param max The maximum value.
+    /// @retval true The tick marks of the axis changed.
+    /// @retval false The axis was already showing this range
+    /// with the same tick marks.
+    bool UpdateAxisLimit(const std::string& axisId, wxDouble min, wxDouble max);
     void ChangeLabels(const std::string& axisId, const wxVector<wxString> &labels, wxChartAxisOptions options);
+    /// Appends tick marks to an axis whose labels are lazy,
+    /// see wxChartAxis::AppendTickMarks(). The axis is updated
+    /// in place rather than rebuilt.
+    /// @param axisId The id of the axis, "x" or "y".
+    /// @param count The number of tick marks to append.
+    void AppendTickMarks(const std::string& axisId, size_t count);
+    /// Removes tick marks from the start of an axis whose labels
+    /// are lazy, see wxChartAxis::RemoveFirstTickMarks().
+    /// @param axisId The id of the axis, "x" or "y".
+    /// @param count The number of tick marks to remove.
+    void RemoveFirstTickMarks(const std::string& axisId, size_t count);
 
 private:
     void Update();
+    void UpdateRanges();
     void CalculatePadding(const wxChartAxis &xAxis,
         const wxChartAxis &yAxis, wxDouble &left, wxDouble &right);
+    void FitAxes(wxDouble startPoint, wxDouble endPoint,
+        wxDouble leftPadding, wxDouble rightPadding);
     static void DrawHorizontalGridLines(const wxChartAxis &horizontalAxis, const wxChartAxis &verticalAxis,
         const wxChartGridLineOptions &options, wxGraphicsContext &gc);
     static void DrawVerticalGridLines(const wxChartAxis &horizontalAxis, const wxChartAxis &verticalAxis,
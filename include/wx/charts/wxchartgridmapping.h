@@ -53,6 +53,7 @@ public:
     wxPoint2DDouble GetWindowPositionAtTickMark(size_t index, wxDouble value) const;
     
     const wxChartAxis& GetXAxis() const;
+    const wxChartAxis& GetYAxis() const;
     
 private:
     wxSize m_size;
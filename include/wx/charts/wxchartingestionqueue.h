@@ -0,0 +1,158 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTINGESTIONQUEUE_H_
+#define _WX_CHARTS_WXCHARTINGESTIONQUEUE_H_
+
+#include <wx/vector.h>
+#include <wx/sharedptr.h>
+#include <atomic>
+
+/// A lock-free queue used to hand values to a chart control.
+
+/// The queue is a ring buffer with a single producer and a
+/// single consumer: one thread, typically an acquisition
+/// thread, pushes values and the GUI thread pops them in bulk.
+/// Neither side ever blocks or allocates memory, and no event is
+/// posted for each batch of values. When the queue is full
+/// the values that don't fit are rejected and the producer
+/// decides whether to retry or drop them.
+/// @tparam T The type of the values.
+template<typename T>
+class wxChartIngestionQueue
+{
+public:
+    /// Smart pointer typedef. The queue is shared by the
+    /// producer and the control.
+    typedef wxSharedPtr<wxChartIngestionQueue> ptr;
+
+    /// Constructs an empty wxChartIngestionQueue instance.
+    /// @param capacity The maximum number of values in the
+    /// queue. It is rounded up to a power of 2.
+    wxChartIngestionQueue(size_t capacity)
+        : m_head(0), m_tail(0)
+    {
+        size_t roundedCapacity = 2;
+        while (roundedCapacity < capacity)
+        {
+            roundedCapacity *= 2;
+        }
+        m_values.resize(roundedCapacity);
+        m_mask = roundedCapacity - 1;
+    }
+
+    /// Gets the maximum number of values in the queue.
+    /// @return The capacity of the queue.
+    size_t GetCapacity() const
+    {
+        return (m_mask + 1);
+    }
+
+    /// Gets the number of values in the queue. This is exact
+    /// when called by the consumer, the producer may have
+    /// pushed more values by the time it returns.
+    /// @return The number of values in the queue.
+    size_t GetSize() const
+    {
+        return (m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire));
+    }
+
+    /// Adds a value to the queue. This must only be called
+    /// by the producer.
+    /// @param value The value.
+    /// @retval true The value was added.
+    /// @retval false The queue is full.
+    bool Push(const T &value)
+    {
+        return (Push(&value, 1) == 1);
+    }
+
+    /// Adds values to the queue. This must only be called
+    /// by the producer.
+    /// @param values The values.
+    /// @param count The number of values.
+    /// @return The number of values that were added, which is
+    /// less than count if the queue is full.
+    size_t Push(const T *values, size_t count)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_acquire);
+        size_t available = GetCapacity() - (tail - head);
+        if (count > available)
+        {
+            count = available;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_values[(tail + i) & m_mask] = values[i];
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Adds values to the queue. This must only be called
+    /// by the producer.
+    /// @param values The values.
+    /// @return The number of values that were added.
+    size_t Push(const wxVector<T> &values)
+    {
+        return (values.empty() ? 0 : Push(&values[0], values.size()));
+    }
+
+    /// Removes values from the queue. This must only be called
+    /// by the consumer.
+    /// @param values The values are appended to this vector.
+    /// @param maxCount The maximum number of values to remove.
+    /// @return The number of values that were removed.
+    size_t Pop(wxVector<T> &values, size_t maxCount = static_cast<size_t>(-1))
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        size_t count = tail - head;
+        if (count > maxCount)
+        {
+            count = maxCount;
+        }
+        values.reserve(values.size() + count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values.push_back(m_values[(head + i) & m_mask]);
+        }
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    wxVector<T> m_values;
+    size_t m_mask;
+    // The indices only ever grow, they are kept on separate
+    // cache lines since each is written by a different thread
+    char m_padding1[64];
+    std::atomic<size_t> m_head;
+    char m_padding2[64];
+    std::atomic<size_t> m_tail;
+    char m_padding3[64];
+};
+
+#endif
@@ -0,0 +1,263 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTINSTRUMENTATION_H_
+#define _WX_CHARTS_WXCHARTINSTRUMENTATION_H_
+
+#include <wx/string.h>
+#include <wx/vector.h>
+#include <ostream>
+#include <chrono>
+
+/// The stages of the rendering pipeline of a chart.
+enum wxChartStage
+{
+    /// Positioning the elements of the chart.
+    wxCHARTSTAGE_FIT = 0,
+    /// Fitting and drawing the grid and the axes.
+    wxCHARTSTAGE_GRID = 1,
+    /// Drawing the datasets.
+    wxCHARTSTAGE_DATASETS = 2,
+    /// Laying out and drawing the tooltips.
+    wxCHARTSTAGE_TOOLTIPS = 3,
+    /// Finding the elements under the mouse.
+    wxCHARTSTAGE_HITTEST = 4,
+    /// Adding the values of the ingestion queues.
+    wxCHARTSTAGE_INGEST = 5,
+    /// The number of stages.
+    wxCHARTSTAGE_COUNT = 6
+};
+
+/// The counters of one stage of the rendering pipeline.
+class wxChartStageCounters
+{
+public:
+    /// Constructs a wxChartStageCounters instance
+    /// with all the counters set to 0.
+    wxChartStageCounters();
+
+    /// Sets all the counters to 0.
+    void Reset();
+    /// Adds the counters of another instance to
+    /// this one.
+    /// @param other The counters to add.
+    void Add(const wxChartStageCounters &other);
+
+    /// Gets the wall time spent in the stage.
+    /// @return The time in milliseconds.
+    wxDouble GetTime() const;
+    /// Gets the number of times the stage was run.
+    /// @return The number of runs.
+    size_t GetCalls() const;
+    /// Gets the number of primitives, for instance
+    /// paths or markers, that were emitted.
+    /// @return The number of primitives.
+    size_t GetPrimitives() const;
+    /// Gets the number of data points that were
+    /// considered.
+    /// @return The number of points.
+    size_t GetPointsConsidered() const;
+    /// Gets the number of data points that were drawn
+    /// or processed after decimation.
+    /// @return The number of points.
+    size_t GetPointsDrawn() const;
+    /// Gets the number of memory allocations reported
+    /// while the stage was running. See
+    /// wxChartInstrumentation::RecordAllocation().
+    /// @return The number of allocations.
+    size_t GetAllocations() const;
+
+    // Used by wxChartInstrumentation to update the counters
+    void AddTime(wxDouble milliseconds);
+    void AddCall();
+    void AddPrimitives(size_t count);
+    void AddPoints(size_t considered, size_t drawn);
+    void AddAllocations(size_t count);
+
+private:
+    wxDouble m_time;
+    size_t m_calls;
+    size_t m_primitives;
+    size_t m_pointsConsidered;
+    size_t m_pointsDrawn;
+    size_t m_allocations;
+};
+
+/// Measures the time and the work spent in each stage of the
+/// rendering pipeline of a chart.
+
+/// Each wxChart has an instance of this class, see
+/// wxChart::GetInstrumentation(). It is disabled by default
+/// and then costs a test per stage. When it is enabled the
+/// counters of the stages are accumulated until the end of
+/// the frame, which is when the control has finished redrawing
+/// the chart, and can then be read with GetLastFrame(). The
+/// stages that run between two redraws, like hit tests and the
+/// repaints of the tooltips alone, are counted in the next frame.
+///
+/// The library can't intercept memory allocations by itself.
+/// An application that wants the allocation counters replaces
+/// the global operator new and calls RecordAllocation() from
+/// it. The allocations made by other threads while a stage is
+/// running are included.
+///
+/// The stages can also be recorded as trace events and saved
+/// in the JSON format understood by the Chrome trace viewer
+/// (chrome://tracing) and Perfetto.
+class wxChartInstrumentation
+{
+public:
+    /// Measures a stage from its construction to
+    /// its destruction.
+    class Scope
+    {
+    public:
+        /// Starts measuring a stage.
+        /// @param instrumentation The instrumentation
+        /// of the chart.
+        /// @param stage The stage.
+        Scope(wxChartInstrumentation &instrumentation, wxChartStage stage);
+        /// Adds the measurements to the counters of the stage.
+        ~Scope();
+
+        /// Discards the measurements. Use this when the stage
+        /// turns out to have had nothing to do so that it isn't
+        /// counted as a call.
+        void Discard();
+
+    private:
+        wxChartInstrumentation &m_instrumentation;
+        wxChartStage m_stage;
+        bool m_enabled;
+        std::chrono::steady_clock::time_point m_start;
+        size_t m_allocations;
+    };
+
+    /// Constructs a disabled wxChartInstrumentation instance.
+    wxChartInstrumentation();
+
+    /// Whether the stages are measured.
+    /// @retval true The stages are measured.
+    /// @retval false The stages are not measured.
+    bool IsEnabled() const;
+    /// Sets whether the stages are measured.
+    /// @param enable Whether to measure the stages.
+    void Enable(bool enable = true);
+    /// Sets all the counters to 0 and discards the
+    /// trace events.
+    void Reset();
+
+    /// Adds primitives to the counters of a stage of
+    /// the current frame.
+    /// @param stage The stage.
+    /// @param count The number of primitives.
+    void AddPrimitives(wxChartStage stage, size_t count);
+    /// Adds data points to the counters of a stage of
+    /// the current frame.
+    /// @param stage The stage.
+    /// @param considered The number of points that were considered.
+    /// @param drawn The number of points that were drawn.
+    void AddPoints(wxChartStage stage, size_t considered, size_t drawn);
+    /// Ends the current frame. Its counters become the
+    /// counters returned by GetLastFrame().
+    void EndFrame();
+
+    /// Gets the number of frames since the
+    /// instrumentation was enabled or reset.
+    /// @return The number of frames.
+    size_t GetFrameCount() const;
+    /// Gets the counters of a stage for the last
+    /// completed frame.
+    /// @param stage The stage.
+    /// @return The counters.
+    const wxChartStageCounters& GetLastFrame(wxChartStage stage) const;
+    /// Gets the counters of a stage accumulated
+    /// over all the completed frames.
+    /// @param stage The stage.
+    /// @return The counters.
+    const wxChartStageCounters& GetTotal(wxChartStage stage) const;
+    /// Formats the counters of the last frame, one
+    /// line per stage.
+    /// @return The text.
+    wxString FormatLastFrame() const;
+
+    /// Starts recording the stages as trace events.
+    /// The previous events are discarded.
+    /// @param maxEvents The maximum number of events that are
+    /// kept, the following events are ignored.
+    void StartTrace(size_t maxEvents = 100000);
+    /// Stops recording the trace events. The events that
+    /// were recorded are kept.
+    void StopTrace();
+    /// Whether the stages are recorded as trace events.
+    /// @retval true The events are recorded.
+    /// @retval false The events are not recorded.
+    bool IsTracing() const;
+    /// Writes the trace events in the Chrome trace event format.
+    /// @param stream The stream to write to.
+    void WriteTrace(std::ostream &stream) const;
+    /// Saves the trace events in the Chrome trace event format.
+    /// @param filename The name of the file.
+    /// @retval true The file was saved.
+    /// @retval false The file couldn't be written.
+    bool SaveTrace(const wxString &filename) const;
+
+    /// Gets the name of a stage.
+    /// @param stage The stage.
+    /// @return The name.
+    static const char* GetStageName(wxChartStage stage);
+    /// Reports a memory allocation. This can be called
+    /// from any thread.
+    static void RecordAllocation();
+    /// Gets the number of allocations reported with
+    /// RecordAllocation().
+    /// @return The number of allocations.
+    static size_t GetAllocationCount();
+
+private:
+    void EndStage(wxChartStage stage,
+        const std::chrono::steady_clock::time_point &start,
+        size_t allocations);
+
+private:
+    struct TraceEvent
+    {
+        wxChartStage stage;
+        // In microseconds since the start of the trace
+        wxDouble start;
+        wxDouble duration;
+    };
+
+    bool m_enabled;
+    size_t m_frameCount;
+    wxChartStageCounters m_currentFrame[wxCHARTSTAGE_COUNT];
+    wxChartStageCounters m_lastFrame[wxCHARTSTAGE_COUNT];
+    wxChartStageCounters m_total[wxCHARTSTAGE_COUNT];
+    bool m_tracing;
+    size_t m_maxEvents;
+    std::chrono::steady_clock::time_point m_traceStart;
+    wxVector<TraceEvent> m_events;
+};
+
+#endif
@@ -56,11 +56,23 @@ public:
         wxDouble height, const wxChartLabelOptions &options);
 
     virtual void Draw(wxGraphicsContext &gc) const;
+    /// Draws the background of the label, if it has one.
+    /// @param gc The graphics context to draw on.
+    void DrawBackground(wxGraphicsContext &gc) const;
+    /// Draws the text of the label using the font that is
+    /// currently set on the graphics context. This allows
+    /// several labels to be drawn without setting the font
+    /// for each of them.
+    /// @param gc The graphics context to draw on.
+    void DrawText(wxGraphicsContext &gc) const;
 
     virtual bool HitTest(const wxPoint &point) const;
 
     virtual wxPoint2DDouble GetTooltipPosition() const;
 
+    /// Gets the settings of the label.
+    /// @return The settings of the label.
+    const wxChartLabelOptions& GetOptions() const;
     /// Gets the text of the label.
     /// @return The text of the label.
     const wxString& GetText() const;
@@ -89,6 +101,10 @@ public:
     /// @param width The new width.
     /// @param height The new height.
     void SetSize(wxDouble width, wxDouble height);
+    /// Sets the size of the label to the size of its
+    /// text. The size is taken from wxChartsTextSizeCache
+    /// if the text was already measured with the same font.
+    /// @param gc The graphics context used to measure the text.
     void UpdateSize(wxGraphicsContext &gc);
     const wxChartPadding& GetPadding() const;
     void SetPadding(const wxChartPadding &padding);
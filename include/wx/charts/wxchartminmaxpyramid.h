@@ -0,0 +1,137 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTMINMAXPYRAMID_H_
+#define _WX_CHARTS_WXCHARTMINMAXPYRAMID_H_
+
+#include <wx/vector.h>
+#include <functional>
+
+/// A multi-resolution summary of the values of a series.
+
+/// The values are split in blocks of a fixed number of values
+/// and the index of the minimum and maximum value of each block
+/// is stored. Each level groups the blocks of the level below
+/// it in the same way. This allows the minimum and maximum of
+/// any range of values to be found by reading a few blocks on
+/// each level instead of all the values, so a line can be
+/// decimated to a few points per pixel column in a time that
+/// depends on the number of columns and not on the number of
+/// values.
+///
+/// The pyramid doesn't store the values. They are read through
+/// an accessor that takes an index. Indices only ever grow: when
+/// values are removed from the start of the series the indices of
+/// the remaining values don't change, which allows the pyramid to
+/// be maintained incrementally for series with a retention window.
+/// Only the blocks that are complete are stored so appending
+/// values never modifies existing blocks.
+class wxChartMinMaxPyramid
+{
+public:
+    /// Function used to read the values. It receives
+    /// the index of the value.
+    typedef std::function<wxDouble(size_t index)> Accessor;
+
+    /// Constructs an empty wxChartMinMaxPyramid instance.
+    /// @param blockSize The number of values in a block
+    /// of the first level, and the number of blocks of a
+    /// level that are grouped in a block of the next level.
+    wxChartMinMaxPyramid(size_t blockSize = 16);
+
+    /// Removes all the blocks.
+    void Clear();
+    /// Updates the pyramid after values were appended to the
+    /// series or removed from its start. Only the new blocks
+    /// are computed. If the range moved backward the series
+    /// was replaced and the pyramid is rebuilt.
+    /// @param start The index of the first value of the series.
+    /// @param end The index following the last value of the series.
+    /// @param value The accessor used to read the values.
+    void Update(size_t start, size_t end, const Accessor &value);
+
+    /// Gets the index of the first value of the series.
+    /// @return The index of the first value.
+    size_t GetStart() const;
+    /// Gets the index following the last value of the series.
+    /// @return The index following the last value.
+    size_t GetEnd() const;
+    /// Gets the number of levels.
+    /// @return The number of levels.
+    size_t GetNumberOfLevels() const;
+
+    /// Finds the minimum and maximum of a range of values.
+    /// @param first The index of the first value of the range.
+    /// @param last The index following the last value of the range.
+    /// It must be greater than first.
+    /// @param value The accessor used to read the values.
+    /// @param minIndex When the function returns this contains the
+    /// index of the minimum value.
+    /// @param maxIndex When the function returns this contains the
+    /// index of the maximum value.
+    void FindMinMax(size_t first, size_t last, const Accessor &value,
+        size_t &minIndex, size_t &maxIndex) const;
+    /// Selects the values needed to draw a line. The range of
+    /// values is split in columns and the first, minimum, maximum
+    /// and last values of each column are kept, in their original
+    /// order. A column can contain a single value, which is how the
+    /// values just outside of the visible range are usually kept.
+    /// @param boundaries The index of the first value of each
+    /// column followed by the index following the last value of
+    /// the last column. The indices must be in increasing order.
+    /// @param value The accessor used to read the values.
+    /// @param indices When the function returns this contains the
+    /// indices of the values to draw.
+    void Decimate(const wxVector<size_t> &boundaries, const Accessor &value,
+        wxVector<size_t> &indices) const;
+
+private:
+    struct Block
+    {
+        wxDouble minValue;
+        wxDouble maxValue;
+        size_t minIndex;
+        size_t maxIndex;
+    };
+
+    struct Level
+    {
+        Level() : firstBlock(0) {}
+        // The index of the first block in the vector. Blocks
+        // that are before the start of the series are only
+        // erased once they make up half of the vector.
+        size_t firstBlock;
+        wxVector<Block> blocks;
+    };
+
+    size_t GetBlockSize(size_t level) const;
+
+private:
+    size_t m_blockSize;
+    size_t m_start;
+    size_t m_end;
+    wxVector<Level> m_levels;
+};
+
+#endif
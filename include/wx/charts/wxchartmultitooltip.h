@@ -53,6 +53,18 @@ public:
     /// @param gc The graphics context.
     void Draw(wxGraphicsContext &gc);
 
+    /// Computes the size and the position of the
+    /// tooltip and of each of its lines. The layout
+    /// is kept until a new tooltip is added.
+    /// @param gc The graphics context used to measure
+    /// the text.
+    void Fit(wxGraphicsContext &gc);
+    /// Gets the area covered by the tooltip. Fit() must
+    /// have been called first.
+    /// @return The smallest rectangle that contains the
+    /// tooltip.
+    wxRect GetBounds() const;
+
     void AddTooltip(const wxChartTooltip &tooltip);
 
 private:
@@ -61,6 +73,13 @@ private:
     wxVector<wxPoint2DDouble> m_tooltipPositions;
     wxVector<wxChartTooltipProvider::ptr> m_tooltipProviders;
     wxVector<wxChartLegendLine> m_lines;
+    bool m_needsFit;
+    wxDouble m_outerX;
+    wxDouble m_outerY;
+    wxDouble m_outerWidth;
+    wxDouble m_outerHeight;
+    wxDouble m_innerX;
+    wxDouble m_innerY;
 };
 
 #endif
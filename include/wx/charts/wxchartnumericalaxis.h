@@ -68,6 +68,19 @@ public:
     wxDouble GetMaxValue() const;
     void SetMaxValue(wxDouble maxValue);
 
+    /// Recomputes the tick marks for a new range of
+    /// values. The axis is updated in place so that
+    /// the grid mappings that refer to it stay valid.
+    /// @param minValue The minimum of the values that
+    /// will be shown on the axis.
+    /// @param maxValue The maximum of the values that
+    /// will be shown on the axis.
+    /// @retval true The tick marks changed and the axis
+    /// needs to be fitted again.
+    /// @retval false The existing tick marks and labels
+    /// were kept.
+    bool UpdateRange(wxDouble minValue, wxDouble maxValue);
+
 private:
     wxDouble m_minValue;
     wxDouble m_maxValue;
@@ -26,37 +26,111 @@
 #define _WX_CHARTS_WXCHARTOBSERVERS_H_
 
 #include <wx/vector.h>
+#include <algorithm>
 
-template<typename T>
+/// The delta type used by values that don't describe
+/// their changes. Observers are simply given the new value.
+class wxChartNoDelta
+{
+public:
+    void Clear() {}
+    void SetFullUpdate() {}
+};
+
+template<typename T, typename D = wxChartNoDelta>
 class wxChartValueObserver
 {
 public:
     virtual void OnUpdate(const T &value) = 0;
+    /// Called when the value changed. The delta describes
+    /// what changed since the previous notification so that
+    /// observers can avoid processing the whole value. By
+    /// default this calls OnUpdate(value).
+    /// @param value The new value.
+    /// @param delta The changes since the previous notification.
+    virtual void OnDeltaUpdate(const T &value, const D &delta)
+    {
+        OnUpdate(value);
+    }
 };
 
-template<typename T>
+/// A value that notifies its observers when it changes.
+
+/// Several changes can be grouped with BeginUpdate() and
+/// EndUpdate(), or with a wxChartUpdateLocker, in which case
+/// the observers are only notified once at the end. Derived
+/// classes record the changes they make in m_delta so that
+/// the observers receive all the changes of the batch in one
+/// notification.
+/// @tparam T The type of the value.
+/// @tparam D The type of the delta. It must have a Clear()
+/// function, called after each notification, and a
+/// SetFullUpdate() function, called when the whole value is
+/// replaced.
+template<typename T, typename D = wxChartNoDelta>
 class wxChartObservableValue
 {
 public:
-    wxChartObservableValue() {};
+    wxChartObservableValue() : m_updateDepth(0), m_pendingNotification(false) {};
     virtual ~wxChartObservableValue() {};
 
-    void AddObserver(wxChartValueObserver<T> *observer)
+    void AddObserver(wxChartValueObserver<T, D> *observer)
     {
         m_observers.push_back(observer);
     }
 
-    void RemoveObserver(wxChartValueObserver<T> *observer)
+    void RemoveObserver(wxChartValueObserver<T, D> *observer)
     {
         m_observers.erase(
             std::remove(m_observers.begin(), m_observers.end(), observer),
             m_observers.end());
     }
 
+    /// Notifies the observers of the changes recorded since
+    /// the last notification. If an update is in progress
+    /// the notification is deferred to EndUpdate().
     void Notify()
     {
+        if (m_updateDepth > 0)
+        {
+            m_pendingNotification = true;
+            return;
+        }
+
+        m_pendingNotification = false;
         for(auto &observer : m_observers)
-            observer->OnUpdate(m_value);
+            observer->OnDeltaUpdate(m_value, m_delta);
+        m_delta.Clear();
+    }
+
+    /// Starts a batch of changes. Calls can be nested, the
+    /// observers are notified when the outermost batch ends.
+    void BeginUpdate()
+    {
+        ++m_updateDepth;
+    }
+
+    /// Ends a batch of changes started with BeginUpdate(). The
+    /// observers are notified once if any change was made.
+    void EndUpdate()
+    {
+        if (m_updateDepth == 0)
+        {
+            return;
+        }
+        --m_updateDepth;
+        if ((m_updateDepth == 0) && m_pendingNotification)
+        {
+            Notify();
+        }
+    }
+
+    /// Whether a batch of changes is in progress.
+    /// @return true if BeginUpdate() was called more times
+    /// than EndUpdate().
+    bool IsUpdating() const
+    {
+        return (m_updateDepth > 0);
     }
 
     T GetValue() const
@@ -67,14 +141,50 @@ public:
     void SetValue(const T &newValue)
     {
         m_value = newValue;
+        m_delta.SetFullUpdate();
         Notify();
     }
 
 protected:
     T m_value;
+    D m_delta;
+
+private:
+    wxVector<wxChartValueObserver<T, D>*> m_observers;
+    unsigned int m_updateDepth;
+    bool m_pendingNotification;
+};
+
+/// Groups the changes made to a wxChartObservableValue
+/// during its lifetime in a single notification.
+
+/// BeginUpdate() is called by the constructor and
+/// EndUpdate() by the destructor.
+/// @tparam Observable The type of the observable value.
+template<typename Observable>
+class wxChartUpdateLocker
+{
+public:
+    /// Starts a batch of changes on a value.
+    /// @param observable The value that is changed.
+    explicit wxChartUpdateLocker(Observable &observable)
+        : m_observable(observable)
+    {
+        m_observable.BeginUpdate();
+    }
+
+    /// Ends the batch of changes and notifies the
+    /// observers if needed.
+    ~wxChartUpdateLocker()
+    {
+        m_observable.EndUpdate();
+    }
 
 private:
-    wxVector<wxChartValueObserver<T>*> m_observers;
+    wxChartUpdateLocker(const wxChartUpdateLocker&);
+    wxChartUpdateLocker& operator=(const wxChartUpdateLocker&);
+
+    Observable &m_observable;
 };
 
 #endif
@@ -53,6 +53,19 @@ public:
 
     virtual void Draw(wxGraphicsContext &gc) const;
 
+    /// Draws a set of points that share the same radius and
+    /// options. All the circles are added to a single path so
+    /// the pen and brush are set once and the path is filled
+    /// and stroked once, whatever the number of points.
+    /// @param gc The graphics context to draw on.
+    /// @param positions The positions of the centers of the
+    /// points.
+    /// @param radius The radius of the circles.
+    /// @param options The settings used for all the points.
+    static void DrawAll(wxGraphicsContext &gc, 
+        const wxVector<wxPoint2DDouble> &positions,
+        wxDouble radius, const wxChartPointOptions &options);
+
     virtual bool HitTest(const wxPoint &point) const;
 
     virtual wxPoint2DDouble GetTooltipPosition() const;
@@ -26,6 +26,8 @@
 #define _WX_CHARTS_WXCHARTPOINTOPTIONS_H_
 
 #include <wx/colour.h>
+#include <wx/pen.h>
+#include <wx/brush.h>
 
 /// The options for the wxChartPoint element.
 
@@ -45,11 +47,21 @@ public:
     unsigned int GetStrokeWidth() const;
     const wxColor& GetStrokeColor() const;
     const wxColor& GetFillColor() const;
+    /// Gets the pen used to draw the outline of the circle. The
+    /// pen is created once when the options are constructed so that
+    /// it can be reused for every point and every draw.
+    /// @return The pen used to draw the outline of the circle.
+    const wxPen& GetPen() const;
+    /// Gets the brush used to fill the circle.
+    /// @return The brush used to fill the circle.
+    const wxBrush& GetBrush() const;
 
 private:
     unsigned int m_strokeWidth;
     wxColor m_strokeColor;
     wxColor m_fillColor;
+    wxPen m_pen;
+    wxBrush m_brush;
 };
 
 #endif
@@ -0,0 +1,306 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTPOINTSERIES_H_
+#define _WX_CHARTS_WXCHARTPOINTSERIES_H_
+
+#include "wxchartspatialindex.h"
+#include "wxchartminmaxpyramid.h"
+#include <wx/geometry.h>
+#include <wx/vector.h>
+#include <deque>
+#include <functional>
+
+/// Stores the points of a dataset in contiguous arrays.
+
+/// The values and their position in the window are kept in
+/// separate arrays so that charts with a large number of
+/// points don't need to allocate an element for each of them.
+/// wxChartPoint instances are only created when they are needed,
+/// for instance to display a tooltip.
+///
+/// The values are stored in a circular buffer. A retention
+/// window can be set with SetMaxCount() or SetMaxXSpan(), in
+/// which case the oldest points are discarded as new points
+/// are appended. This keeps the memory used by live charts
+/// constant however long they run. The extents of the
+/// points are maintained as they are appended and removed,
+/// which takes amortized constant time per point.
+/// \ingroup elementclasses
+class wxChartPointSeries
+{
+public:
+    /// Constructs an empty wxChartPointSeries instance.
+    wxChartPointSeries();
+
+    /// Gets the number of points.
+    /// @return The number of points.
+    size_t GetCount() const;
+    /// Reserves memory for the given number of points.
+    /// @param count The number of points.
+    void Reserve(size_t count);
+    /// Removes all the points.
+    void Clear();
+    /// Appends a point. Points that fall outside the
+    /// retention window are removed.
+    /// @param x The X value of the point.
+    /// @param y The Y value of the point.
+    /// @return The number of points that were removed
+    /// from the start of the series.
+    size_t Append(wxDouble x, wxDouble y);
+    /// Appends a list of points. Points that fall outside
+    /// the retention window are removed.
+    /// @param values The values of the points.
+    /// @return The number of points that were removed
+    /// from the start of the series.
+    size_t Append(const wxVector<wxPoint2DDouble> &values);
+    /// Removes the points at the start of the series whose
+    /// X value is less than a given value. This assumes the
+    /// points are sorted by X value.
+    /// @param x The X value of the first point to keep.
+    /// @return The number of points that were removed.
+    size_t RemoveBeforeX(wxDouble x);
+
+    /// Gets the maximum number of points that are kept.
+    /// @return The maximum number of points, 0 if there is
+    /// no limit.
+    size_t GetMaxCount() const;
+    /// Sets the maximum number of points that are kept. Once
+    /// this number is reached appending a point discards the
+    /// oldest one. The memory for all the points is allocated
+    /// up front.
+    /// @param maxCount The maximum number of points, 0 if
+    /// there is no limit.
+    void SetMaxCount(size_t maxCount);
+    /// Gets the maximum difference between the X values of
+    /// the newest and oldest points.
+    /// @return The maximum span, 0 if there is no limit.
+    wxDouble GetMaxXSpan() const;
+    /// Sets the maximum difference between the X values of
+    /// the newest and oldest points. When a point is appended
+    /// the points whose X value is too far behind its X value
+    /// are discarded. This assumes the points are appended in
+    /// increasing order of X value, as is the case for
+    /// time series.
+    /// @param maxXSpan The maximum span, 0 if there is no limit.
+    void SetMaxXSpan(wxDouble maxXSpan);
+    /// Whether a wxChartMinMaxPyramid of the Y values is
+    /// maintained as points are appended.
+    /// @retval true The pyramid is maintained.
+    /// @retval false The pyramid is not maintained.
+    bool UsesMinMaxPyramid() const;
+    /// Sets whether a wxChartMinMaxPyramid of the Y values is
+    /// maintained as points are appended. The pyramid makes
+    /// Decimate() independent of the number of points but
+    /// uses about 2 bytes of memory per point.
+    /// @param use Whether to maintain the pyramid.
+    void SetUseMinMaxPyramid(bool use);
+
+    /// Gets the X value of a point.
+    /// @param index The index of the point.
+    /// @return The X value.
+    wxDouble GetX(size_t index) const;
+    /// Gets the Y value of a point.
+    /// @param index The index of the point.
+    /// @return The Y value.
+    wxDouble GetY(size_t index) const;
+    /// Gets the value of a point.
+    /// @param index The index of the point.
+    /// @return The value of the point.
+    wxPoint2DDouble GetValue(size_t index) const;
+    /// Sets the functions applied to the values of the points
+    /// before their extents are computed, see GetExtents(). The
+    /// extents are computed again.
+    /// @param transformX The function applied to the X values.
+    /// If it is empty the values are used as they are.
+    /// @param transformY The function applied to the Y values.
+    /// If it is empty the values are used as they are.
+    void SetExtentsTransforms(const std::function<wxDouble(wxDouble)> &transformX,
+        const std::function<wxDouble(wxDouble)> &transformY);
+    /// Gets the extents of the transformed values of the points.
+    /// The extents are maintained as points are appended and
+    /// removed so this takes constant time.
+    /// @param minX The minimum X value.
+    /// @param maxX The maximum X value.
+    /// @param minY The minimum Y value.
+    /// @param maxY The maximum Y value.
+    /// @retval true The extents were set.
+    /// @retval false The series is empty, the extents are
+    /// unchanged.
+    bool GetExtents(wxDouble &minX, wxDouble &maxX,
+        wxDouble &minY, wxDouble &maxY) const;
+
+    /// Gets the position of a point in the window.
+    /// @param index The index of the point.
+    /// @return The position of the point.
+    const wxPoint2DDouble& GetPosition(size_t index) const;
+    /// Gets the positions of all the points. The positions
+    /// are not updated when points are removed, they must be
+    /// set again after points have been appended.
+    /// @return The positions of the points.
+    const wxVector<wxPoint2DDouble>& GetPositions() const;
+    /// Sets the position of a point in the window.
+    /// @param index The index of the point.
+    /// @param position The new position of the point.
+    void SetPosition(size_t index, const wxPoint2DDouble &position);
+
+    /// Rebuilds the index used by FindInXRange() and
+    /// FindInRadius(). This needs to be called after the
+    /// positions of the points have changed.
+    /// @param cellSize The size of the cells of the grid
+    /// used by FindInRadius(). If this is 0 FindInRadius()
+    /// only uses the X coordinates to narrow the search.
+    void BuildIndex(wxDouble cellSize = 0);
+    /// Finds the points whose position has an X coordinate
+    /// between minX and maxX inclusive.
+    /// @param minX The lower bound of the range.
+    /// @param maxX The upper bound of the range.
+    /// @param indices The indices of the points that were
+    /// found are appended to this vector.
+    void FindInXRange(wxDouble minX, wxDouble maxX,
+        wxVector<size_t> &indices) const;
+    /// Finds, among a subset of the points, the points whose
+    /// position has an X coordinate between minX and maxX
+    /// inclusive using a binary search. This doesn't use the
+    /// index, only the points of the subset need a position.
+    /// @param subset The indices of the points to search. The
+    /// X coordinates of their positions must be in ascending
+    /// order.
+    /// @param minX The lower bound of the range.
+    /// @param maxX The upper bound of the range.
+    /// @param indices The indices of the points that were
+    /// found are appended to this vector.
+    void FindInXRange(const wxVector<size_t> &subset, wxDouble minX,
+        wxDouble maxX, wxVector<size_t> &indices) const;
+    /// Finds the points whose position is within a given
+    /// distance of a point.
+    /// @param center The center of the search area.
+    /// @param radius The radius of the search area.
+    /// @param indices The indices of the points that were
+    /// found are appended to this vector.
+    void FindInRadius(const wxPoint2DDouble &center, wxDouble radius,
+        wxVector<size_t> &indices) const;
+
+    /// Finds the first point whose transformed X value is not
+    /// less than a given value using a binary search. The points
+    /// must be sorted by X value and the transform must be
+    /// increasing.
+    /// @param x The value to search for.
+    /// @param transformX The function applied to the X values.
+    /// @return The index of the point, or the number of points if
+    /// all the X values are less than x.
+    size_t FindFirstX(wxDouble x,
+        const std::function<wxDouble(wxDouble)> &transformX) const;
+    /// Finds the points with the minimum and maximum Y values
+    /// in a range of points. The pyramid is used if it is
+    /// maintained.
+    /// @param first The index of the first point of the range.
+    /// @param last The index following the last point of the
+    /// range. It must be greater than first.
+    /// @param minIndex When the function returns this contains
+    /// the index of the point with the minimum Y value.
+    /// @param maxIndex When the function returns this contains
+    /// the index of the point with the maximum Y value.
+    void FindMinMaxY(size_t first, size_t last,
+        size_t &minIndex, size_t &maxIndex) const;
+    /// Selects the points needed to draw the line. See
+    /// wxChartMinMaxPyramid::Decimate(). If the pyramid is not
+    /// maintained the points of each column are read.
+    /// @param boundaries The index of the first point of each
+    /// column followed by the index following the last point
+    /// of the last column.
+    /// @param indices When the function returns this contains the
+    /// indices of the points to draw.
+    void Decimate(const wxVector<size_t> &boundaries,
+        wxVector<size_t> &indices) const;
+
+private:
+    // Keeps the minimum or the maximum of the values in
+    // a window that only moves forward. The candidates are
+    // sorted by sequence number and each one is more extreme
+    // than the ones before it, so the extremum is the first
+    // candidate and a value is added and removed in amortized
+    // constant time.
+    class WindowExtremum
+    {
+    public:
+        WindowExtremum(bool minimum);
+
+        void Clear();
+        // If keepCandidates is false the values are never
+        // removed so only the extremum is kept
+        void Push(size_t sequence, wxDouble value, bool keepCandidates);
+        // Removes the values whose sequence number is less
+        // than the given one
+        void PopBefore(size_t sequence);
+        wxDouble GetValue() const;
+
+    private:
+        // Whether a is more extreme than b or equal to it
+        bool Precedes(wxDouble a, wxDouble b) const;
+
+    private:
+        bool m_minimum;
+        std::deque<std::pair<size_t, wxDouble> > m_candidates;
+    };
+
+private:
+    size_t GetStorageIndex(size_t index) const;
+    void SetCapacity(size_t capacity);
+    void RemoveFirst();
+    void UpdatePyramid();
+    void PushExtents(size_t sequence, wxDouble x, wxDouble y);
+    void ResetExtents();
+
+private:
+    // The values are stored in a circular buffer, the first
+    // point is at index m_start. The size of the vectors is
+    // the capacity of the buffer.
+    wxVector<wxDouble> m_x;
+    wxVector<wxDouble> m_y;
+    size_t m_start;
+    size_t m_count;
+    size_t m_maxCount;
+    wxDouble m_maxXSpan;
+    // The positions are always stored in the order of the
+    // points
+    wxVector<wxPoint2DDouble> m_positions;
+    wxChartSpatialIndex m_index;
+    // The pyramid uses indices that don't change when points
+    // are removed so the number of removed points is kept to
+    // convert them
+    bool m_usePyramid;
+    size_t m_removed;
+    wxChartMinMaxPyramid m_pyramid;
+    // The sequence number of a point is m_removed plus its
+    // index
+    std::function<wxDouble(wxDouble)> m_transformX;
+    std::function<wxDouble(wxDouble)> m_transformY;
+    WindowExtremum m_minX;
+    WindowExtremum m_maxX;
+    WindowExtremum m_minY;
+    WindowExtremum m_maxY;
+};
+
+#endif
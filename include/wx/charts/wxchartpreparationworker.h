@@ -0,0 +1,114 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTPREPARATIONWORKER_H_
+#define _WX_CHARTS_WXCHARTPREPARATIONWORKER_H_
+
+#include "wxchartrendersnapshot.h"
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/// Prepares the geometry of a chart on a background thread.
+
+/// The GUI thread submits jobs that compute a wxChartRenderSnapshot
+/// from a copy of the data of the chart and only draws the latest
+/// snapshot that was completed, so neither mapping the points nor
+/// decimating the lines delays the handling of user input.
+///
+/// At most one job runs at a time and at most one job waits. A job
+/// that is submitted while another one is waiting replaces it, so
+/// a slow preparation doesn't cause a backlog of outdated jobs: the
+/// worker always moves on to the most recent request. A job that is
+/// already running is cancelled, it should check the flag it is
+/// given and return early, and its snapshot is never published so
+/// the snapshot on screen is only replaced by an up to date one.
+///
+/// The thread is only started when the first job is submitted.
+class wxChartPreparationWorker
+{
+public:
+    /// A job. It is run on the worker thread and must only
+    /// use the data it owns, never the chart itself.
+    /// It receives the snapshot to fill and a flag that is
+    /// set when a more recent job is submitted.
+    typedef std::function<void(wxChartRenderSnapshot &snapshot,
+        const std::atomic<bool> &cancelled)> Job;
+    /// Function called on the worker thread each time a
+    /// snapshot has been published. It is typically used to
+    /// post an event to the GUI thread.
+    typedef std::function<void()> Callback;
+
+    /// Constructs a wxChartPreparationWorker instance.
+    wxChartPreparationWorker();
+    /// Waits for the running job to complete and
+    /// stops the thread. The waiting job is discarded.
+    ~wxChartPreparationWorker();
+
+    /// Sets the function called when a snapshot has been
+    /// published.
+    /// @param callback The function to call.
+    void SetCallback(const Callback &callback);
+
+    /// Submits a job. If a job is already waiting it is
+    /// discarded and if a job is running it is cancelled.
+    /// @param job The job.
+    /// @return The generation of the job. It is also the
+    /// generation of the snapshot the job will produce.
+    unsigned long Submit(const Job &job);
+    /// Gets the generation of the last job that was
+    /// submitted.
+    /// @return The generation of the last job.
+    unsigned long GetGeneration() const;
+    /// Gets the most recent snapshot.
+    /// @return The snapshot, or a null pointer if no job
+    /// has completed yet.
+    wxChartRenderSnapshot::ptr GetSnapshot() const;
+    /// Blocks until all the submitted jobs have either
+    /// completed or been discarded.
+    void Wait();
+
+private:
+    void Run();
+
+private:
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    // Signaled when a job is submitted and when
+    // the worker becomes idle
+    std::condition_variable m_condition;
+    bool m_stop;
+    bool m_busy;
+    Job m_pendingJob;
+    unsigned long m_pendingGeneration;
+    unsigned long m_generation;
+    // Set when the running job is superseded
+    std::atomic<bool> m_cancelled;
+    wxChartRenderSnapshot::ptr m_snapshot;
+    Callback m_callback;
+};
+
+#endif
@@ -49,6 +49,32 @@ public:
 
     virtual void Draw(wxGraphicsContext &gc) const;
 
+    /// Draws a set of rectangles that share the same fill
+    /// and stroke colors, like the columns of a dataset.
+    /// All the rectangles are added to the same pair of paths
+    /// so the pen and brush are set once whatever the number
+    /// of rectangles. The colors of the first rectangle are
+    /// used for all of them.
+    /// @param gc The graphics context to draw on.
+    /// @param rectangles Pointers to the rectangles to draw.
+    template<typename RectanglePtr>
+    static void DrawAll(wxGraphicsContext &gc, 
+        const wxVector<RectanglePtr> &rectangles)
+    {
+        if (rectangles.empty())
+        {
+            return;
+        }
+
+        wxGraphicsPath fillPath = gc.CreatePath();
+        wxGraphicsPath strokePath = gc.CreatePath();
+        for (size_t i = 0; i < rectangles.size(); ++i)
+        {
+            rectangles[i]->AddToPaths(fillPath, strokePath);
+        }
+        DrawPaths(gc, fillPath, strokePath, rectangles[0]->GetOptions());
+    }
+
     virtual bool HitTest(const wxPoint &point) const;
 
     virtual wxPoint2DDouble GetTooltipPosition() const;
@@ -71,6 +97,23 @@ public:
     wxDouble GetWidth() const;
     wxDouble GetHeight() const;
     void SetSize(wxDouble width, wxDouble height);
+    /// Gets the settings used to draw the rectangle.
+    /// @return The settings of the rectangle.
+    const wxChartRectangleOptions& GetOptions() const;
+
+    /// Adds the rectangle to the paths used to draw it.
+    /// @param fillPath The path that will be filled, the
+    /// whole rectangle is added to it.
+    /// @param strokePath The path that will be stroked, only
+    /// the borders selected in the options are added to it.
+    void AddToPaths(wxGraphicsPath &fillPath, wxGraphicsPath &strokePath) const;
+    /// Fills and strokes paths built with AddToPaths().
+    /// @param gc The graphics context to draw on.
+    /// @param fillPath The path to fill.
+    /// @param strokePath The path to stroke.
+    /// @param options The settings providing the pen and brush.
+    static void DrawPaths(wxGraphicsContext &gc, const wxGraphicsPath &fillPath,
+        const wxGraphicsPath &strokePath, const wxChartRectangleOptions &options);
 
 private:
     wxChartRectangleOptions m_options;
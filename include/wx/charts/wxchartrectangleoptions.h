@@ -26,6 +26,8 @@
 #define _WX_CHARTS_WXCHARTRECTANGLEOPTIONS_H_
 
 #include <wx/colour.h>
+#include <wx/pen.h>
+#include <wx/brush.h>
 
 /// The options for the wxChartRectangle element.
 
@@ -52,11 +54,25 @@ public:
     /// outline of the rectangle.
     const wxColor& GetStrokeColor() const;
     int GetDirections() const;
+    /// Gets the pen used to draw the outline of the
+    /// rectangle. The pen is created once when the options
+    /// are constructed so that it can be reused on every draw.
+    /// Copies of the options share the same pen so charts
+    /// with many rectangles should create the options once
+    /// per dataset and pass them to each rectangle.
+    /// @return The pen used to draw the outline of the
+    /// rectangle.
+    const wxPen& GetPen() const;
+    /// Gets the brush used to fill the rectangle.
+    /// @return The brush used to fill the rectangle.
+    const wxBrush& GetBrush() const;
 
 private:
     wxColor m_fillColor;
     wxColor m_strokeColor;
     int m_directions;
+    wxPen m_pen;
+    wxBrush m_brush;
 };
 
 #endif
@@ -0,0 +1,131 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTRENDERSNAPSHOT_H_
+#define _WX_CHARTS_WXCHARTRENDERSNAPSHOT_H_
+
+#include "wxchartspatialindex.h"
+#include <wx/geometry.h>
+#include <wx/sharedptr.h>
+#include <wx/vector.h>
+
+/// The geometry of a chart in window coordinates.
+
+/// A snapshot is computed by a wxChartPreparationWorker from
+/// a copy of the data of a chart and is never modified once it
+/// has been published, so it can be drawn on the GUI thread
+/// while the worker prepares the next one. It only contains
+/// positions: the colors and the other options are read from
+/// the chart when the snapshot is drawn.
+class wxChartRenderSnapshot
+{
+public:
+    /// Smart pointer typedef. A published snapshot is
+    /// always accessed through a pointer to const.
+    typedef wxSharedPtr<const wxChartRenderSnapshot> ptr;
+
+    /// The geometry of one dataset.
+    class Series
+    {
+    public:
+        /// Gets the decimated line.
+        /// @return The points of the line.
+        const wxVector<wxPoint2DDouble>& GetLine() const;
+        /// Gets the decimated line.
+        /// @return The points of the line.
+        wxVector<wxPoint2DDouble>& GetLine();
+        /// Gets the positions of the markers.
+        /// @return The positions of the markers.
+        const wxVector<wxPoint2DDouble>& GetMarkers() const;
+        /// Gets the positions of the markers.
+        /// @return The positions of the markers.
+        wxVector<wxPoint2DDouble>& GetMarkers();
+        /// Gets the indices, in the data of the chart, of the
+        /// points represented by the markers.
+        /// @return One index per marker.
+        const wxVector<size_t>& GetMarkerIndices() const;
+        /// Gets the indices, in the data of the chart, of the
+        /// points represented by the markers.
+        /// @return One index per marker.
+        wxVector<size_t>& GetMarkerIndices();
+        /// Gets the values of the points represented by the
+        /// markers. They are copied so that the tooltips don't
+        /// depend on the data of the chart, which may have
+        /// changed since the snapshot was prepared.
+        /// @return One value per marker.
+        const wxVector<wxPoint2DDouble>& GetMarkerValues() const;
+        /// Gets the values of the points represented by the
+        /// markers.
+        /// @return One value per marker.
+        wxVector<wxPoint2DDouble>& GetMarkerValues();
+
+        /// Builds the index used by FindInXRange(). This
+        /// must be called once the markers have been set.
+        void BuildIndex();
+        /// Finds the markers whose X coordinate is between
+        /// minX and maxX inclusive.
+        /// @param minX The lower bound of the range.
+        /// @param maxX The upper bound of the range.
+        /// @param markers The positions of the markers that were
+        /// found in the vector returned by GetMarkers() are
+        /// appended to this vector.
+        void FindInXRange(wxDouble minX, wxDouble maxX,
+            wxVector<size_t> &markers) const;
+
+    private:
+        wxVector<wxPoint2DDouble> m_line;
+        wxVector<wxPoint2DDouble> m_markers;
+        wxVector<size_t> m_markerIndices;
+        wxVector<wxPoint2DDouble> m_markerValues;
+        wxChartSpatialIndex m_index;
+    };
+
+    /// Constructs an empty wxChartRenderSnapshot instance.
+    /// @param generation The number of the request the
+    /// snapshot was prepared for.
+    wxChartRenderSnapshot(unsigned long generation);
+
+    /// Gets the number of the request the snapshot was
+    /// prepared for. See wxChartPreparationWorker::Submit().
+    /// @return The generation of the snapshot.
+    unsigned long GetGeneration() const;
+
+    /// Gets the number of series.
+    /// @return The number of series.
+    size_t GetSeriesCount() const;
+    /// Gets a series.
+    /// @param index The index of the series.
+    /// @return The series.
+    const Series& GetSeries(size_t index) const;
+    /// Adds an empty series. The reference is only valid
+    /// until the next series is added.
+    /// @return The new series.
+    Series& AddSeries();
+
+private:
+    unsigned long m_generation;
+    wxVector<Series> m_series;
+};
+
+#endif
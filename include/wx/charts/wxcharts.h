@@ -27,6 +27,7 @@
 
 #include "wxchartcategoricalaxis.h"
 #include "wxchartnumericalaxis.h"
+#include "wxchartscolumnarfile.h"
 
 #include "wxbarchartctrl.h"
 #include "wxstackedbarchartctrl.h"
@@ -49,13 +49,37 @@ public:
     /// Adds a dataset.
     /// @param dataset The dataset to add.
     void AddDataset(wxChartsDoubleDataset::ptr dataset);
+    /// Removes a dataset.
+    /// @param index The index of the dataset to remove. It
+    /// must be valid.
+    void RemoveDataset(size_t index);
+    /// Appends a category.
+    /// @param category The new category.
+    /// @param values The values of the new category, one
+    /// for each dataset in the same order as the datasets.
+    void AppendCategory(const wxString &category, const wxVector<wxDouble> &values);
+    /// Changes one of the values. The observers are not
+    /// notified if the value doesn't change.
+    /// @param datasetIndex The index of the dataset. It must
+    /// be valid.
+    /// @param index The index of the value in the dataset. It
+    /// must be valid.
+    /// @param value The new value.
+    void SetValue(size_t datasetIndex, size_t index, wxDouble value);
 
     /// Gets the categories.
     /// @return A vector containing the categories.
     const wxVector<wxString>& GetCategories() const;
     const wxVector<wxChartsDoubleDataset::ptr>& GetDatasets() const;
 
-    void AddObserver();
+    /// Registers an observer. The observer is notified of
+    /// each change made through this class until it is
+    /// removed.
+    /// @param observer The observer.
+    void AddObserver(wxChartsCategoricalDataObserver *observer);
+    /// Unregisters an observer.
+    /// @param observer The observer.
+    void RemoveObserver(wxChartsCategoricalDataObserver *observer);
 
 private:
     wxVector<wxString> m_categories;
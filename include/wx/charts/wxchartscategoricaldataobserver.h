@@ -25,8 +25,46 @@
 #ifndef _WX_CHARTS_WXCHARTSCATEGORICALDATAOBSERVER_H_
 #define _WX_CHARTS_WXCHARTSCATEGORICALDATAOBSERVER_H_
 
+#include <wx/defs.h>
+#include <stddef.h>
+
+class wxChartsCategoricalData;
+
+/// Interface for the classes that want to be notified of the changes made to a wxChartsCategoricalData instance.
+
+/// Each notification describes a single change so that the observers
+/// can update only the elements affected by it instead of being rebuilt
+/// from the whole data. The notifications are sent after the change has
+/// been applied to the data. The default implementations do nothing.
+/// \ingroup dataclasses
 class wxChartsCategoricalDataObserver
 {
+public:
+    virtual ~wxChartsCategoricalDataObserver();
+
+    /// Called when a single value has been changed.
+    /// @param data The data that changed.
+    /// @param datasetIndex The index of the dataset containing the value.
+    /// @param index The index of the value, this is also the index of
+    /// its category.
+    /// @param oldValue The value before the change.
+    virtual void OnValueChanged(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index, wxDouble oldValue);
+    /// Called when a category has been appended. The new category is
+    /// the last one and each dataset has a new value for it.
+    /// @param data The data that changed.
+    virtual void OnCategoryAppended(const wxChartsCategoricalData &data);
+    /// Called when a dataset has been added.
+    /// @param data The data that changed.
+    /// @param datasetIndex The index of the new dataset.
+    virtual void OnDatasetAdded(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+    /// Called when a dataset has been removed.
+    /// @param data The data that changed.
+    /// @param datasetIndex The index the dataset had before it was
+    /// removed.
+    virtual void OnDatasetRemoved(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
 };
 
 #endif
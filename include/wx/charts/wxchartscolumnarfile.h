@@ -0,0 +1,223 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTSCOLUMNARFILE_H_
+#define _WX_CHARTS_WXCHARTSCOLUMNARFILE_H_
+
+#include <wx/geometry.h>
+#include <wx/sharedptr.h>
+#include <wx/string.h>
+#include <wx/vector.h>
+
+/// The flags of a column of a wxChartsColumnarFile.
+enum wxChartsColumnFlags
+{
+    /// The values of the column are in ascending order.
+    wxCHARTSCOLUMN_SORTED = 0x1
+};
+
+/// A read-only, memory-mapped file of columns of values.
+
+/// The file is mapped in memory rather than read so that opening
+/// it doesn't depend on its size and the values are read directly
+/// from the page cache of the operating system: only the parts of
+/// the file that are accessed are loaded, and they can be discarded
+/// again by the operating system when memory is needed.
+///
+/// The file format is:
+/// - A 32 byte header:
+///   - the 8 bytes "WXCCOL01",
+///   - the version of the format as a 32-bit unsigned integer, 1,
+///   - the number of columns as a 32-bit unsigned integer,
+///   - the number of rows as a 64-bit unsigned integer,
+///   - 8 bytes that must be 0.
+/// - A table with one 64 byte entry for each column:
+///   - the name of the column, in UTF-8, padded with 0 to 48 bytes,
+///   - the flags of the column as a 32-bit unsigned integer. The only
+///     flag is wxCHARTSCOLUMN_SORTED, which is set if the values of
+///     the column are in ascending order,
+///   - 4 bytes that must be 0,
+///   - the position of the values of the column, from the start of
+///     the file, as a 64-bit unsigned integer. It must be a multiple
+///     of 8.
+/// - The values of each column, as consecutive 64-bit IEEE 754
+///   floating point numbers.
+///
+/// All the numbers are little-endian. Files can be created with
+/// Write().
+/// \ingroup dataclasses
+class wxChartsColumnarFile
+{
+public:
+    /// Smart pointer typedef.
+    typedef wxSharedPtr<wxChartsColumnarFile> ptr;
+
+    /// Constructs a wxChartsColumnarFile instance. No file
+    /// is open.
+    wxChartsColumnarFile();
+    /// Closes the file.
+    ~wxChartsColumnarFile();
+
+    /// Opens and maps a file. The header and the column table
+    /// are checked but the values are not read.
+    /// @param filename The name of the file.
+    /// @retval true The file was opened.
+    /// @retval false The file couldn't be opened or isn't in the
+    /// expected format.
+    bool Open(const wxString &filename);
+    /// Unmaps and closes the file. The pointers returned by
+    /// GetColumn() are no longer valid.
+    void Close();
+    /// Whether a file is open.
+    /// @retval true A file is open.
+    /// @retval false No file is open.
+    bool IsOpen() const;
+
+    /// Gets the number of values in each column.
+    /// @return The number of rows.
+    size_t GetRowCount() const;
+    /// Gets the number of columns.
+    /// @return The number of columns.
+    size_t GetColumnCount() const;
+    /// Gets the name of a column.
+    /// @param index The index of the column.
+    /// @return The name of the column.
+    const wxString& GetColumnName(size_t index) const;
+    /// Gets the flags of a column.
+    /// @param index The index of the column.
+    /// @return A combination of wxChartsColumnFlags values.
+    unsigned int GetColumnFlags(size_t index) const;
+    /// Finds a column by name.
+    /// @param name The name of the column.
+    /// @return The index of the column or wxNOT_FOUND.
+    int FindColumn(const wxString &name) const;
+    /// Gets the values of a column. They are not copied, the
+    /// pointer refers to the mapped file.
+    /// @param index The index of the column.
+    /// @return A pointer to the GetRowCount() values of the column.
+    const wxDouble* GetColumn(size_t index) const;
+
+    /// Writes a file in the format read by this class.
+    /// @param filename The name of the file.
+    /// @param names The names of the columns. Names longer than
+    /// 47 bytes are truncated.
+    /// @param columns The values of the columns. All the columns
+    /// must have the same number of values.
+    /// @retval true The file was written.
+    /// @retval false The file couldn't be written.
+    static bool Write(const wxString &filename, const wxVector<wxString> &names,
+        const wxVector<wxVector<wxDouble> > &columns);
+
+private:
+    wxChartsColumnarFile(const wxChartsColumnarFile&);
+    wxChartsColumnarFile& operator=(const wxChartsColumnarFile&);
+
+    bool Map(const wxString &filename);
+    void Unmap();
+    bool ReadHeader();
+
+private:
+    const char *m_data;
+    size_t m_size;
+    size_t m_rowCount;
+    wxVector<wxString> m_columnNames;
+    wxVector<unsigned int> m_columnFlags;
+    wxVector<const wxDouble*> m_columns;
+};
+
+/// An XY series whose values are read from two columns of a wxChartsColumnarFile.
+
+/// The series doesn't copy the values. It is meant to be used with
+/// captures too large to be loaded into a chart: Decimate() extracts
+/// the points to display for a range of X values and the result is
+/// given to the chart, for instance with wxMath2DPlot::UpdateData().
+/// Only the part of the file that covers the range is accessed if
+/// the X column is sorted.
+/// \ingroup dataclasses
+class wxChartsColumnarSeries
+{
+public:
+    /// Constructs a wxChartsColumnarSeries instance.
+    /// @param file The file containing the values. It must
+    /// stay open as long as the series is used.
+    /// @param xColumn The index of the column of the X values.
+    /// @param yColumn The index of the column of the Y values.
+    wxChartsColumnarSeries(wxChartsColumnarFile::ptr file,
+        size_t xColumn, size_t yColumn);
+
+    /// Gets the number of points.
+    /// @return The number of points.
+    size_t GetCount() const;
+    /// Gets the value of a point.
+    /// @param index The index of the point.
+    /// @return The value of the point.
+    wxPoint2DDouble GetValue(size_t index) const;
+    /// Whether the X values are in ascending order.
+    /// @retval true The X values are sorted.
+    /// @retval false The X values may not be sorted.
+    bool IsXSorted() const;
+
+    /// Finds the points whose X value is between minX and
+    /// maxX inclusive. This is a binary search if the X values
+    /// are sorted, otherwise all the points are returned.
+    /// @param minX The lower bound of the range.
+    /// @param maxX The upper bound of the range.
+    /// @param begin The index of the first point in the range.
+    /// @param end The index after the last point in the range.
+    void FindXRange(wxDouble minX, wxDouble maxX,
+        size_t &begin, size_t &end) const;
+    /// Computes the range of the values.
+    /// @param minX The minimum X value.
+    /// @param maxX The maximum X value.
+    /// @param minY The minimum Y value.
+    /// @param maxY The maximum Y value.
+    /// @retval true The ranges were computed.
+    /// @retval false The series is empty.
+    bool GetExtents(wxDouble &minX, wxDouble &maxX,
+        wxDouble &minY, wxDouble &maxY) const;
+    /// Extracts the points to display for a range of X values.
+    /// The range is split into buckets that cover the same
+    /// range of X values and the first, minimum, maximum and last
+    /// points of each bucket are kept, in their original order,
+    /// like wxChartDecimation::MinMax() does for pixel columns.
+    /// With one bucket per pixel column the line drawn from the
+    /// result looks the same as the full line.
+    /// @param minX The lower bound of the range.
+    /// @param maxX The upper bound of the range.
+    /// @param bucketCount The number of buckets, typically the
+    /// width of the chart in pixels.
+    /// @param result When the function returns this contains
+    /// at most 4 * bucketCount points.
+    void Decimate(wxDouble minX, wxDouble maxX, size_t bucketCount,
+        wxVector<wxPoint2DDouble> &result) const;
+
+private:
+    wxChartsColumnarFile::ptr m_file;
+    const wxDouble *m_x;
+    const wxDouble *m_y;
+    size_t m_count;
+    bool m_xSorted;
+};
+
+#endif
@@ -60,6 +60,17 @@ public:
     /// outline of the bar.
     const wxColor& GetStrokeColor() const;
     const wxVector<wxDouble>& GetData() const;
+    /// Sets one of the values. The charts are not notified
+    /// of the change, use wxChartsCategoricalData::SetValue()
+    /// to change the data of a dataset that is displayed.
+    /// @param index The index of the value.
+    /// @param value The new value.
+    void SetValue(size_t index, wxDouble value);
+    /// Appends a value. The charts are not notified of the
+    /// change, use wxChartsCategoricalData::AppendCategory()
+    /// to extend the data of a dataset that is displayed.
+    /// @param value The value to append.
+    void AppendValue(wxDouble value);
 
 private:
     wxColor m_fillColor;
@@ -0,0 +1,96 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#ifndef _WX_CHARTS_WXCHARTSHAREDPOINTS_H_
+#define _WX_CHARTS_WXCHARTSHAREDPOINTS_H_
+
+#include <wx/geometry.h>
+#include <wx/sharedptr.h>
+#include <wx/vector.h>
+#include <functional>
+
+/// A copy of the values of a series that can be read on
+/// another thread while the series is modified.
+
+/// The values are stored in blocks that are never modified
+/// once they have been created, so copying a wxChartSharedPoints
+/// instance only copies pointers to the blocks and the copy
+/// stays valid whatever happens to the original. This is how
+/// the data of a chart is handed to a wxChartPreparationWorker
+/// without copying all the points each time a job is submitted.
+///
+/// Appending values creates a new block. The last blocks are
+/// merged as long as a block isn't larger than the one before
+/// it so there are never more blocks than the logarithm of the
+/// number of values and each value is copied a logarithmic number
+/// of times. Removing values from the start only releases the
+/// blocks that no longer contain any value.
+/// \ingroup elementclasses
+class wxChartSharedPoints
+{
+public:
+    /// Constructs an empty wxChartSharedPoints instance.
+    wxChartSharedPoints();
+
+    /// Gets the number of values.
+    /// @return The number of values.
+    size_t GetCount() const;
+    /// Gets a value.
+    /// @param index The index of the value.
+    /// @return The value.
+    const wxPoint2DDouble& GetValue(size_t index) const;
+
+    /// Removes all the values.
+    void Clear();
+    /// Appends values.
+    /// @param values The values to append.
+    void Append(const wxVector<wxPoint2DDouble> &values);
+    /// Removes values from the start.
+    /// @param count The number of values to remove. It must
+    /// not be greater than the number of values.
+    void RemoveFirst(size_t count);
+
+    /// Finds the first value whose transformed X value is not
+    /// less than a given value using a binary search. The values
+    /// must be sorted by X value and the transform must be
+    /// increasing.
+    /// @param x The value to search for.
+    /// @param transformX The function applied to the X values.
+    /// @return The index of the value, or the number of values if
+    /// all the X values are less than x.
+    size_t FindFirstX(wxDouble x,
+        const std::function<wxDouble(wxDouble)> &transformX) const;
+
+private:
+    typedef wxSharedPtr<const wxVector<wxPoint2DDouble> > Block;
+
+private:
+    wxVector<Block> m_blocks;
+    // The sequence number of the first value of each block,
+    // the sequence number of a value is its index plus the
+    // number of values that were removed
+    wxVector<size_t> m_starts;
+    size_t m_removed;
+    size_t m_count;
+};
+
+#endif
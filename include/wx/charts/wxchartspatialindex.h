@@ -0,0 +1,102 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTSPATIALINDEX_H_
+#define _WX_CHARTS_WXCHARTSPATIALINDEX_H_
+
+#include <wx/geometry.h>
+#include <wx/vector.h>
+
+/// An index used to quickly find the points located near a position.
+
+/// The index doesn't keep a copy of the positions, the same
+/// positions that were passed to Build() must be passed to
+/// the Find functions. The index needs to be rebuilt each time
+/// the positions change.
+///
+/// Points are sorted by X coordinate so that the points in
+/// a vertical band can be found using a binary search. If a
+/// cell size is given when building the index, the points are
+/// also stored in a uniform grid used to find the points
+/// within a given distance of a position.
+/// \ingroup elementclasses
+class wxChartSpatialIndex
+{
+public:
+    /// Constructs an empty wxChartSpatialIndex instance.
+    wxChartSpatialIndex();
+
+    /// Builds the index.
+    /// @param positions The positions of the points.
+    /// @param cellSize The size of the cells of the grid.
+    /// If this is 0 no grid is built.
+    void Build(const wxVector<wxPoint2DDouble> &positions,
+        wxDouble cellSize = 0);
+    /// Empties the index.
+    void Clear();
+
+    /// Finds the points whose X coordinate is between
+    /// minX and maxX inclusive.
+    /// @param positions The positions passed to Build().
+    /// @param minX The lower bound of the range.
+    /// @param maxX The upper bound of the range.
+    /// @param indices The indices of the points that
+    /// were found are appended to this vector, in
+    /// increasing order of X coordinate.
+    void FindInXRange(const wxVector<wxPoint2DDouble> &positions,
+        wxDouble minX, wxDouble maxX, wxVector<size_t> &indices) const;
+    /// Finds the points whose distance to the center is
+    /// less than or equal to the radius.
+    /// @param positions The positions passed to Build().
+    /// @param center The center of the search area.
+    /// @param radius The radius of the search area.
+    /// @param indices The indices of the points that
+    /// were found are appended to this vector.
+    void FindInRadius(const wxVector<wxPoint2DDouble> &positions,
+        const wxPoint2DDouble &center, wxDouble radius,
+        wxVector<size_t> &indices) const;
+
+private:
+    size_t GetCellIndex(size_t column, size_t row) const;
+    size_t GetColumn(wxDouble x) const;
+    size_t GetRow(wxDouble y) const;
+
+private:
+    size_t m_count;
+    // True if the positions are already sorted by X
+    // coordinate in which case m_order is empty
+    bool m_sorted;
+    wxVector<size_t> m_order;
+    wxDouble m_cellSize;
+    wxDouble m_minX;
+    wxDouble m_minY;
+    size_t m_columns;
+    size_t m_rows;
+    // The points of cell i are m_cellPoints[m_cellStart[i]]
+    // to m_cellPoints[m_cellStart[i + 1] - 1]
+    wxVector<size_t> m_cellStart;
+    wxVector<size_t> m_cellPoints;
+};
+
+#endif
@@ -0,0 +1,139 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTTEXTSIZECACHE_H_
+#define _WX_CHARTS_WXCHARTTEXTSIZECACHE_H_
+
+#include "wxchartfontoptions.h"
+#include <wx/graphics.h>
+#include <wx/string.h>
+#include <mutex>
+#include <unordered_map>
+
+/// Caches the size of strings drawn with a given font.
+
+/// Measuring text requires a call to the graphics backend
+/// and is one of the most expensive parts of fitting a chart.
+/// The labels of the axes are measured again each time the
+/// chart is resized or the axes are rebuilt even though their
+/// text rarely changes, so their sizes are kept in this cache.
+///
+/// The cache is keyed by the font family, size, style and
+/// weight, by the text, and by the renderer and content scale
+/// factor of the graphics context the text was measured with,
+/// since different backends and resolutions measure the same
+/// text differently. The color of the font doesn't affect the
+/// size of the text and is ignored. When the cache is full it
+/// is emptied. The cache can be used from several threads.
+class wxChartTextSizeCache
+{
+public:
+    /// Constructs an empty wxChartTextSizeCache instance.
+    /// @param maxCount The maximum number of sizes kept in
+    /// the cache.
+    wxChartTextSizeCache(size_t maxCount = 16384);
+
+    /// Looks up the size of a string.
+    /// @param font The font used to draw the text.
+    /// @param text The text.
+    /// @param renderer The renderer of the graphics context
+    /// used to measure the text.
+    /// @param scaleFactor The content scale factor of the
+    /// graphics context used to measure the text.
+    /// @param width When the function returns true this
+    /// contains the width of the text.
+    /// @param height When the function returns true this
+    /// contains the height of the text.
+    /// @return true if the size was found in the cache.
+    bool Find(const wxChartFontOptions &font, const wxString &text,
+        const wxGraphicsRenderer *renderer, wxDouble scaleFactor,
+        wxDouble &width, wxDouble &height) const;
+    /// Adds the size of a string to the cache.
+    /// @param font The font used to draw the text.
+    /// @param text The text.
+    /// @param renderer The renderer of the graphics context
+    /// used to measure the text.
+    /// @param scaleFactor The content scale factor of the
+    /// graphics context used to measure the text.
+    /// @param width The width of the text.
+    /// @param height The height of the text.
+    void Insert(const wxChartFontOptions &font, const wxString &text,
+        const wxGraphicsRenderer *renderer, wxDouble scaleFactor,
+        wxDouble width, wxDouble height);
+    /// Removes all the sizes from the cache. This should be
+    /// called if the way text is rendered changes without the
+    /// renderer or the scale factor changing, for instance
+    /// after a DPI change on a platform that scales fonts
+    /// rather than the graphics context.
+    void Clear();
+
+    /// Gets the number of sizes in the cache.
+    /// @return The number of sizes in the cache.
+    size_t GetCount() const;
+    /// Gets the maximum number of sizes kept in the cache.
+    /// @return The maximum number of sizes.
+    size_t GetMaxCount() const;
+    /// Sets the maximum number of sizes kept in the cache.
+    /// @param maxCount The maximum number of sizes.
+    void SetMaxCount(size_t maxCount);
+
+private:
+    struct Key
+    {
+        Key(const wxChartFontOptions &font, const wxString &text,
+            const wxGraphicsRenderer *renderer, wxDouble scaleFactor);
+
+        bool operator==(const Key &other) const;
+
+        wxFontFamily m_family;
+        int m_size;
+        wxFontStyle m_style;
+        wxFontWeight m_weight;
+        wxString m_text;
+        const wxGraphicsRenderer *m_renderer;
+        wxDouble m_scaleFactor;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct Size
+    {
+        wxDouble m_width;
+        wxDouble m_height;
+    };
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<Key, Size, KeyHash> m_sizes;
+    size_t m_maxCount;
+};
+
+/// The cache used by wxChartUtilities::GetTextSize(). It is
+/// shared by all the charts.
+extern wxChartTextSizeCache wxChartsTextSizeCache;
+
+#endif
@@ -20,6 +20,7 @@
     IN THE SOFTWARE.
 */
 
+
 /// @file
 
 #ifndef _WX_CHARTS_WXCHARTTIMEAXIS_H_
@@ -27,10 +28,106 @@
 
 #include "wxchartaxis.h"
 
+/// The calendar units used to space the tick marks
+/// of a wxChartTimeAxis.
+enum wxChartTimeUnit
+{
+    wxCHARTTIMEUNIT_MILLISECOND,
+    wxCHARTTIMEUNIT_SECOND,
+    wxCHARTTIMEUNIT_MINUTE,
+    wxCHARTTIMEUNIT_HOUR,
+    wxCHARTTIMEUNIT_DAY,
+    wxCHARTTIMEUNIT_MONTH,
+    wxCHARTTIMEUNIT_YEAR
+};
+
+/// This class represents an axis that displays timestamps.
+
+/// The timestamps are numbers of milliseconds since
+/// 1970-01-01 00:00:00 UTC. The tick marks are placed on
+/// calendar boundaries, for instance every 15 minutes
+/// or on the first day of each month, and the range of
+/// the axis is extended to the tick marks that surround
+/// it. Between two tick marks time is linear so months
+/// of different lengths are drawn with the same width.
+/// \ingroup elementclasses
 class wxChartTimeAxis : public wxChartAxis
 {
 public:
+    /// Constructs a wxChartTimeAxis element.
+    /// @param id The id of the axis.
+    /// @param options The settings to be used for the axis.
     wxChartTimeAxis(const std::string &id, const wxChartAxisOptions &options);
+
+    /// Changes the range of timestamps shown on the axis. The
+    /// tick marks and their labels are only rebuilt if they
+    /// are different from the current ones so calling this
+    /// repeatedly with similar ranges is cheap.
+    /// @param start The first timestamp to show.
+    /// @param end The last timestamp to show.
+    /// @param maxTickMarks The maximum number of tick marks,
+    /// usually derived from the length of the axis in pixels.
+    /// @retval true The tick marks changed.
+    /// @retval false The tick marks are the same.
+    bool UpdateRange(wxInt64 start, wxInt64 end, size_t maxTickMarks);
+
+    /// Gets the first timestamp of the axis. This is the
+    /// first tick mark.
+    /// @return The first timestamp.
+    wxInt64 GetStart() const;
+    /// Gets the last timestamp of the axis. This is the
+    /// last tick mark.
+    /// @return The last timestamp.
+    wxInt64 GetEnd() const;
+    /// Gets the unit of the interval between tick marks.
+    /// @return The unit.
+    wxChartTimeUnit GetUnit() const;
+    /// Gets the interval between tick marks as a number
+    /// of units.
+    /// @return The number of units.
+    unsigned int GetStep() const;
+    /// Gets the timestamps of the tick marks.
+    /// @return The timestamps of the tick marks.
+    const wxVector<wxInt64>& GetTickMarks() const;
+    /// Gets the position of a timestamp relative to the
+    /// axis, 0 for the first tick mark and 1 for the last.
+    /// The result can be passed to GetPosition().
+    /// @param timestamp The timestamp.
+    /// @return The relative position.
+    wxDouble GetRelativePosition(wxInt64 timestamp) const;
+
+    /// Rounds a timestamp down to a calendar boundary.
+    /// @param timestamp The timestamp.
+    /// @param unit The unit of the boundaries.
+    /// @param step The number of units between two boundaries.
+    /// @return The last boundary that is not after the timestamp.
+    static wxInt64 Floor(wxInt64 timestamp, wxChartTimeUnit unit,
+        unsigned int step);
+    /// Moves a timestamp forward by a number of units.
+    /// @param timestamp The timestamp.
+    /// @param unit The unit.
+    /// @param step The number of units.
+    /// @return The new timestamp.
+    static wxInt64 Advance(wxInt64 timestamp, wxChartTimeUnit unit,
+        unsigned int step);
+    /// Formats a timestamp with the precision needed
+    /// to tell apart tick marks of the given unit.
+    /// @param timestamp The timestamp.
+    /// @param unit The unit.
+    /// @return The text of the label.
+    static wxString FormatLabel(wxInt64 timestamp, wxChartTimeUnit unit);
+
+private:
+    void SelectStep(wxInt64 start, wxInt64 end, size_t maxTickMarks,
+        wxChartTimeUnit &unit, unsigned int &step) const;
+
+private:
+    wxInt64 m_requestedStart;
+    wxInt64 m_requestedEnd;
+    size_t m_maxTickMarks;
+    wxChartTimeUnit m_unit;
+    unsigned int m_step;
+    wxVector<wxInt64> m_tickMarks;
 };
 
 #endif
@@ -51,6 +51,18 @@ public:
     /// @param gc The graphics context.
     void Draw(wxGraphicsContext &gc);
 
+    /// Computes the size of the tooltip. The text is only
+    /// retrieved and measured the first time this function
+    /// is called.
+    /// @param gc The graphics context used to measure the
+    /// text.
+    void Fit(wxGraphicsContext &gc);
+    /// Gets the area covered by the tooltip. Fit() must
+    /// have been called first.
+    /// @return The smallest rectangle that contains the
+    /// tooltip.
+    wxRect GetBounds() const;
+
     /// Gets the position of the tooltip.
     /// @return The position of the tooltip.
     const wxPoint2DDouble& GetPosition() const;
@@ -62,6 +74,11 @@ private:
     wxChartTooltipOptions m_options;
     wxPoint2DDouble m_position;
     wxChartTooltipProvider::ptr m_provider;
+    bool m_needsFit;
+    wxString m_text;
+    wxFont m_font;
+    wxDouble m_width;
+    wxDouble m_height;
 };
 
 #endif
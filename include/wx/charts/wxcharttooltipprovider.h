@@ -28,6 +28,7 @@
 #include <wx/colour.h>
 #include <wx/string.h>
 #include <wx/sharedptr.h>
+#include <functional>
 
 /// Interface for the classes that are able to generate content for tooltips
 class wxChartTooltipProvider
@@ -80,4 +81,40 @@ private:
     wxColor m_color;
 };
 
+/// Implementation of the wxChartTooltipProvider interface that generates its content on demand.
+
+/// An implementation of the wxChartTooltipProvider
+/// interface where the title and the text are generated
+/// by functions the first time they are requested. This
+/// avoids formatting the tooltips of elements that are
+/// never shown.
+class wxChartTooltipProviderLazy : public wxChartTooltipProvider
+{
+public:
+    /// Function returning the title or the text of a tooltip.
+    typedef std::function<wxString()> Generator;
+
+    /// Constructs a wxChartTooltipProviderLazy instance.
+    /// @param title The function used to generate the title
+    /// of the tooltip.
+    /// @param text The function used to generate the text
+    /// of the tooltip.
+    /// @param color The color associated with the tooltip.
+    wxChartTooltipProviderLazy(const Generator &title, const Generator &text,
+        const wxColor &color);
+
+    virtual wxString GetTooltipTitle() const;
+    virtual wxString GetTooltipText() const;
+    virtual wxColor GetAssociatedColor() const;
+
+private:
+    Generator m_titleGenerator;
+    Generator m_textGenerator;
+    wxColor m_color;
+    mutable bool m_titleGenerated;
+    mutable wxString m_title;
+    mutable bool m_textGenerated;
+    mutable wxString m_text;
+};
+
 #endif
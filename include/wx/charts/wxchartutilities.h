@@ -37,7 +37,9 @@
 #define _WX_CHARTS_WXCHARTUTILITIES_H_
 
 #include "wxchartlabel.h"
+#include "wxchartfontoptions.h"
 #include <wx/graphics.h>
+#include <functional>
 
 /// This class contains a set of static utility functions.
 class wxChartUtilities
@@ -63,6 +65,244 @@ public:
     static void GetTextSize(wxGraphicsContext &gc,
         const wxFont &font, const wxString &string,
         wxDouble &width, wxDouble &height);
+    /// Gets the size of the text for the given font. The size
+    /// is looked up in wxChartsTextSizeCache first and the text
+    /// is only measured if it isn't there. The font of the
+    /// graphics context is only changed if the text is measured.
+    /// @param gc The graphics context.
+    /// @param font The font settings.
+    /// @param string The text that we need to measure.
+    /// @param width When the function returns this will contain
+    /// the width of the string.
+    /// @param height When the function returns this will contain
+    /// the height of the string.
+    static void GetTextSize(wxGraphicsContext &gc,
+        const wxChartFontOptions &font, const wxString &string,
+        wxDouble &width, wxDouble &height);
+
+    /// Extends a range so that it includes a set of values.
+    /// The minimum and maximum are computed in a single pass
+    /// and large arrays are split between several threads.
+    /// @param values Pointer to the first value.
+    /// @param count The number of values.
+    /// @param stride The distance between two consecutive values,
+    /// in number of wxDouble, for instance the number of columns
+    /// of a table of values stored row by row. Use the overload
+    /// that takes accessors for the members of an array of
+    /// structures.
+    /// @param found Whether minValue and maxValue already contain
+    /// a range. This is set to true if count is not 0.
+    /// @param minValue The minimum value.
+    /// @param maxValue The maximum value.
+    static void UpdateExtents(const wxDouble *values, size_t count,
+        size_t stride, bool &found, wxDouble &minValue, wxDouble &maxValue);
+    /// Extends a range so that it includes a set of values after
+    /// they have been transformed. The transform is called once
+    /// for each value, in order and from the calling thread, so
+    /// it doesn't need to be thread-safe.
+    /// @param values Pointer to the first value.
+    /// @param count The number of values.
+    /// @param transform The function applied to each value.
+    /// @param found Whether minValue and maxValue already contain
+    /// a range. This is set to true if count is not 0.
+    /// @param minValue The minimum transformed value.
+    /// @param maxValue The maximum transformed value.
+    static void UpdateExtents(const wxDouble *values, size_t count,
+        const std::function<wxDouble(wxDouble)> &transform,
+        bool &found, wxDouble &minValue, wxDouble &maxValue);
+    /// Extends a range so that it includes a set of values.
+    /// @param values The values.
+    /// @param found Whether minValue and maxValue already contain
+    /// a range. This is set to true if values is not empty.
+    /// @param minValue The minimum value.
+    /// @param maxValue The maximum value.
+    static void UpdateExtents(const wxVector<wxDouble> &values,
+        bool &found, wxDouble &minValue, wxDouble &maxValue);
+    /// Extends a rectangle so that it includes a set of points.
+    /// The X and Y ranges are computed in a single pass.
+    /// @param points The points.
+    /// @param found Whether the ranges already contain values.
+    /// This is set to true if points is not empty.
+    /// @param minX The minimum X value.
+    /// @param maxX The maximum X value.
+    /// @param minY The minimum Y value.
+    /// @param maxY The maximum Y value.
+    static void UpdateExtents(const wxVector<wxPoint2DDouble> &points,
+        bool &found, wxDouble &minX, wxDouble &maxX,
+        wxDouble &minY, wxDouble &maxY);
+    /// Extends a range so that it includes the values of an
+    /// array of structures. The minimum is taken from one member
+    /// and the maximum from another, for instance the low and the
+    /// high values of candlesticks, in a single pass. Large arrays
+    /// are split between several threads so the accessors are
+    /// used from several threads at the same time.
+    /// @param items Pointer to the first structure.
+    /// @param count The number of structures.
+    /// @param low The data member or the const getter that gives
+    /// the value the minimum is computed from.
+    /// @param high The data member or the const getter that gives
+    /// the value the maximum is computed from.
+    /// @param found Whether minValue and maxValue already contain
+    /// a range. This is set to true if count is not 0.
+    /// @param minValue The minimum value.
+    /// @param maxValue The maximum value.
+    template<typename T, typename Accessor>
+    static void UpdateExtents(const T *items, size_t count,
+        Accessor low, Accessor high, bool &found,
+        wxDouble &minValue, wxDouble &maxValue)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        size_t chunkCount = GetParallelChunkCount(count);
+        wxVector<wxDouble> lows(chunkCount);
+        wxVector<wxDouble> highs(chunkCount);
+        ParallelFor(count,
+            [items, low, high, &lows, &highs](size_t chunk, size_t begin, size_t end)
+            {
+                wxDouble lo = Read(items[begin], low);
+                wxDouble hi = Read(items[begin], high);
+                for (size_t i = begin + 1; i < end; ++i)
+                {
+                    wxDouble l = Read(items[i], low);
+                    wxDouble h = Read(items[i], high);
+                    lo = (l < lo) ? l : lo;
+                    hi = (h > hi) ? h : hi;
+                }
+                lows[chunk] = lo;
+                highs[chunk] = hi;
+            });
+        for (size_t i = 0; i < chunkCount; ++i)
+        {
+            MergeExtents(lows[i], highs[i], found, minValue, maxValue);
+        }
+    }
+    /// Extends a box so that it includes a set of 3D points.
+    /// The three ranges are computed in a single pass, large
+    /// arrays are split between several threads.
+    /// @param items Pointer to the first point.
+    /// @param count The number of points.
+    /// @param x The data member that holds the X value.
+    /// @param y The data member that holds the Y value.
+    /// @param z The data member that holds the Z value.
+    /// @param found Whether the ranges already contain values.
+    /// This is set to true if count is not 0.
+    /// @param minX The minimum X value.
+    /// @param maxX The maximum X value.
+    /// @param minY The minimum Y value.
+    /// @param maxY The maximum Y value.
+    /// @param minZ The minimum Z value.
+    /// @param maxZ The maximum Z value.
+    template<typename T>
+    static void UpdateExtents(const T *items, size_t count,
+        wxDouble T::*x, wxDouble T::*y, wxDouble T::*z, bool &found,
+        wxDouble &minX, wxDouble &maxX, wxDouble &minY, wxDouble &maxY,
+        wxDouble &minZ, wxDouble &maxZ)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        // The bounds of each chunk: X, Y and Z minimums
+        // followed by X, Y and Z maximums
+        size_t chunkCount = GetParallelChunkCount(count);
+        wxVector<wxDouble> bounds(chunkCount * 6);
+        ParallelFor(count,
+            [items, x, y, z, &bounds](size_t chunk, size_t begin, size_t end)
+            {
+                wxDouble loX = items[begin].*x;
+                wxDouble hiX = loX;
+                wxDouble loY = items[begin].*y;
+                wxDouble hiY = loY;
+                wxDouble loZ = items[begin].*z;
+                wxDouble hiZ = loZ;
+                for (size_t i = begin + 1; i < end; ++i)
+                {
+                    const T &item = items[i];
+                    loX = (item.*x < loX) ? item.*x : loX;
+                    hiX = (item.*x > hiX) ? item.*x : hiX;
+                    loY = (item.*y < loY) ? item.*y : loY;
+                    hiY = (item.*y > hiY) ? item.*y : hiY;
+                    loZ = (item.*z < loZ) ? item.*z : loZ;
+                    hiZ = (item.*z > hiZ) ? item.*z : hiZ;
+                }
+                wxDouble *chunkBounds = &bounds[chunk * 6];
+                chunkBounds[0] = loX;
+                chunkBounds[1] = loY;
+                chunkBounds[2] = loZ;
+                chunkBounds[3] = hiX;
+                chunkBounds[4] = hiY;
+                chunkBounds[5] = hiZ;
+            });
+
+        // The three ranges are always found together
+        bool foundY = found;
+        bool foundZ = found;
+        for (size_t i = 0; i < chunkCount; ++i)
+        {
+            const wxDouble *chunkBounds = &bounds[i * 6];
+            MergeExtents(chunkBounds[0], chunkBounds[3], found, minX, maxX);
+            MergeExtents(chunkBounds[1], chunkBounds[4], foundY, minY, maxY);
+            MergeExtents(chunkBounds[2], chunkBounds[5], foundZ, minZ, maxZ);
+        }
+    }
+    /// Extends a range so that it includes another range.
+    /// @param lo The minimum of the other range.
+    /// @param hi The maximum of the other range.
+    /// @param found Whether minValue and maxValue already contain
+    /// a range. This is set to true.
+    /// @param minValue The minimum value.
+    /// @param maxValue The maximum value.
+    static void MergeExtents(wxDouble lo, wxDouble hi, bool &found,
+        wxDouble &minValue, wxDouble &maxValue);
+    /// Updates a range after one of the values it was computed
+    /// from changed. The range is extended if the new value is
+    /// outside of it. If the old value was one of the bounds the
+    /// range may have to shrink, this can't be known without
+    /// looking at all the values again.
+    /// @param oldValue The value before the change.
+    /// @param newValue The value after the change.
+    /// @param minValue The minimum value.
+    /// @param maxValue The maximum value.
+    /// @retval true The range is up to date.
+    /// @retval false The range must be recomputed from all the
+    /// values.
+    static bool ReplaceInExtents(wxDouble oldValue, wxDouble newValue,
+        wxDouble &minValue, wxDouble &maxValue);
+
+    /// Gets the number of chunks ParallelFor() splits a
+    /// range of values into. This is 1 unless there are
+    /// enough values to make using several threads worth
+    /// it.
+    /// @param count The number of values.
+    /// @return The number of chunks.
+    static size_t GetParallelChunkCount(size_t count);
+    /// Splits the range [0, count) in GetParallelChunkCount()
+    /// consecutive chunks and calls a function for each of them.
+    /// The chunks are processed in parallel and the function
+    /// returns once all of them have been processed.
+    /// @param count The number of values.
+    /// @param func The function called for each chunk with
+    /// the index of the chunk and the range of values it
+    /// covers.
+    static void ParallelFor(size_t count,
+        const std::function<void(size_t chunk, size_t begin, size_t end)> &func);
+
+private:
+    template<typename T>
+    static wxDouble Read(const T &item, wxDouble T::*member)
+    {
+        return item.*member;
+    }
+
+    template<typename T>
+    static wxDouble Read(const T &item, wxDouble (T::*getter)() const)
+    {
+        return (item.*getter)();
+    }
 };
 
 #endif
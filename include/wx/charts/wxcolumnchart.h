@@ -46,16 +46,29 @@
 /// A column chart.
 
 /// \ingroup chartclasses
-class wxColumnChart : public wxChart
+class wxColumnChart : public wxChart, public wxChartsCategoricalDataObserver
 {
 public:
     wxColumnChart(wxChartsCategoricalData::ptr &data, const wxSize &size);
 
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
+    virtual void OnValueChanged(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index, wxDouble oldValue);
+    virtual void OnCategoryAppended(const wxChartsCategoricalData &data);
+    virtual void OnDatasetAdded(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+    virtual void OnDatasetRemoved(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+
 private:
-    static wxDouble GetMinValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
-    static wxDouble GetMaxValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
+    struct Extents
+    {
+        wxDouble m_minValue;
+        wxDouble m_maxValue;
+    };
+
+    static Extents GetExtents(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
 
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
@@ -73,8 +86,7 @@ private:
         Column(wxDouble value,
             const wxChartTooltipProvider::ptr tooltipProvider,
             wxDouble x, wxDouble y,
-            const wxColor &fillColor, const wxColor &strokeColor,
-            int directions);
+            const wxChartRectangleOptions &options);
 
         wxDouble GetValue() const;
 
@@ -87,17 +99,32 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset();
+        Dataset(const wxChartRectangleOptions &options);
+
+        const wxChartRectangleOptions& GetRectangleOptions() const;
 
         const wxVector<Column::ptr>& GetColumns() const;
         void AppendColumn(Column::ptr column);
+        void SetColumn(size_t index, Column::ptr column);
 
     private:
+        wxChartRectangleOptions m_rectangleOptions;
         wxVector<Column::ptr> m_columns;
     };
 
+    Column::ptr CreateColumn(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index,
+        const wxChartRectangleOptions &options) const;
+    Dataset::ptr CreateDataset(const wxChartsCategoricalData &data,
+        size_t datasetIndex) const;
+    void FitColumn(size_t datasetIndex, size_t index, wxDouble columnWidth);
+    bool UpdateValueAxis(const wxChartsCategoricalData &data, bool recompute);
+
 private:
     wxSharedPtr<wxColumnChartOptions> m_options;
+    // The range of the values, it is kept up to date
+    // as the data changes
+    Extents m_extents;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
 };
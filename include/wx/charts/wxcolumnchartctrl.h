@@ -42,7 +42,7 @@
 /// A control that displays a column chart.
 
 /// \ingroup chartclasses
-class wxColumnChartCtrl : public wxChartCtrl
+class wxColumnChartCtrl : public wxChartCtrl, public wxChartsCategoricalDataObserver
 {
 public:
     /// Constructs a wxColumnChartCtrl control.
@@ -62,10 +62,21 @@ public:
         const wxPoint &pos = wxDefaultPosition, const wxSize &size = wxDefaultSize,
         long style = 0);
 
+    virtual ~wxColumnChartCtrl();
+
+    virtual void OnValueChanged(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index, wxDouble oldValue);
+    virtual void OnCategoryAppended(const wxChartsCategoricalData &data);
+    virtual void OnDatasetAdded(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+    virtual void OnDatasetRemoved(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+
 private:
     virtual wxColumnChart& GetChart();
 
 private:
+    wxChartsCategoricalData::ptr m_data;
     wxColumnChart m_columnChart;
 };
 
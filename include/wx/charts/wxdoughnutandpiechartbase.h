@@ -44,9 +44,40 @@
 #include <wx/control.h>
 #include <wx/sharedptr.h>
 #include <map>
+#include <set>
+
+/// The changes made to a wxPieChartData instance
+/// since its observers were last notified.
+class wxPieChartDataDelta
+{
+public:
+    /// Constructs an empty wxPieChartDataDelta instance.
+    wxPieChartDataDelta();
+
+    /// Whether all the slices may have changed, for
+    /// instance because the slices were replaced. In that
+    /// case GetChangedSlices() is meaningless.
+    /// @return true if the slices need to be rebuilt.
+    bool IsFullUpdate() const;
+    /// Gets the labels of the slices that were added or
+    /// whose value changed.
+    /// @return The labels of the changed slices.
+    const std::set<wxString>& GetChangedSlices() const;
+
+    void AddChangedSlice(const wxString &label);
+    void SetFullUpdate();
+    void Clear();
+
+private:
+    bool m_fullUpdate;
+    std::set<wxString> m_changedSlices;
+};
 
 /// Data for the wxPieChartCtrl control.
-class wxPieChartData : public wxChartObservableValue<std::map<wxString, wxChartSliceData>>
+
+/// Use BeginUpdate() and EndUpdate(), or a wxChartUpdateLocker,
+/// to make several changes with a single notification.
+class wxPieChartData : public wxChartObservableValue<std::map<wxString, wxChartSliceData>, wxPieChartDataDelta>
 {
 public:
     /// Smart pointer typedef.
@@ -77,7 +108,16 @@ public:
     /// instance.
     wxDoughnutAndPieChartBase(wxPieChartData::ptr data);
     wxDoughnutAndPieChartBase(wxPieChartData::ptr data, const wxSize &size);
+    /// Rebuilds all the slices.
+    /// @param data The slices.
     void SetData(const std::map<wxString, wxChartSliceData> &data);
+    /// Updates the slices that changed. The other slices
+    /// are kept, only their angles are recomputed.
+    /// @param data The slices.
+    /// @param delta The slices that changed since the last
+    /// call to SetData() or UpdateData().
+    void UpdateData(const std::map<wxString, wxChartSliceData> &data,
+        const wxPieChartDataDelta &delta);
 
 private:
     virtual void DoSetSize(const wxSize &size);
@@ -103,15 +143,29 @@ private:
         void Resize(const wxSize &size, const wxDoughnutAndPieChartOptionsBase& options);
 
         wxDouble GetValue() const;
+        const wxString& GetLabel() const;
 
     private:
         wxDouble m_value;
+        wxString m_label;
     };
 
+    SliceArc::ptr CreateSliceArc(const wxChartSliceData &slice) const;
+
 private:
     wxPieChartData::ptr m_data;
+    // The slices are created from m_data on the first
+    // fit since the options aren't available before
+    bool m_needsSlices;
     wxSize m_size;
+    // The slices are sorted by label like the map
+    // they are created from
     wxVector<SliceArc::ptr> m_slices;
+    // The end angle of each slice, the slices are laid
+    // out in order so this is sorted and is used to find
+    // the slice under the mouse without testing all the
+    // slices
+    wxVector<wxDouble> m_endAngles;
     wxDouble m_total;
 };
 
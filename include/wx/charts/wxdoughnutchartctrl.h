@@ -31,7 +31,7 @@
 /// A control that displays a doughnut chart.
 
 /// \ingroup chartclasses
-class wxDoughnutChartCtrl : public wxChartCtrl, public wxChartValueObserver<std::map<wxString, wxChartSliceData>>
+class wxDoughnutChartCtrl : public wxChartCtrl, public wxChartValueObserver<std::map<wxString, wxChartSliceData>, wxPieChartDataDelta>
 {
 public:
     wxDoughnutChartCtrl(wxWindow *parent, wxWindowID id, wxPieChartData::ptr data,
@@ -44,6 +44,8 @@ public:
 private:
     virtual wxDoughnutChart& GetChart();
     void OnUpdate(const std::map<wxString,wxChartSliceData> &data) override;
+    void OnDeltaUpdate(const std::map<wxString, wxChartSliceData> &data,
+        const wxPieChartDataDelta &delta) override;
 
 private:
     wxDoughnutChart m_doughnutChart;
@@ -38,8 +38,11 @@
 
 #include "wxchart.h"
 #include "wxhistchartoptions.h"
+#include "wxhistchartsketch.h"
 #include "wxchartgrid.h"
 #include "wxchartpoint.h"
+#include "wxchartrectangle.h"
+#include "wxchartactivepoints.h"
 
 #include <wx/scopedptr.h>
 
@@ -54,7 +57,19 @@ public:
     wxHistogramChartDataset(
         const wxColor &lineColor,
         const wxColor &fillColor,
-        wxVector<wxDouble> &data);
+        const wxVector<wxDouble> &data);
+    /// Constructs a dataset from a sketch of the values
+    /// rather than the values themselves. The chart then
+    /// keeps its own copy of the sketch, values added to it
+    /// later use constant memory and the number of bins can
+    /// be changed at any time.
+    /// @param lineColor The color of the outline.
+    /// @param fillColor The color of the bins.
+    /// @param sketch The sketch of the values.
+    wxHistogramChartDataset(
+        const wxColor &lineColor,
+        const wxColor &fillColor,
+        const wxHistogramChartSketch &sketch);
 
     const wxColor& GetLineColor() const;
     /// Whether to fill the part of the chart
@@ -69,12 +84,21 @@ public:
     /// @return The fill color.
     const wxColor& GetFillColor() const;
     const wxVector<wxDouble>& GetData() const;
+    /// Whether the dataset was constructed from a
+    /// sketch of the values.
+    /// @return true if the dataset has a sketch.
+    bool HasSketch() const;
+    /// Gets the sketch of the values. This must only be
+    /// called if HasSketch() returns true.
+    /// @return The sketch.
+    const wxHistogramChartSketch& GetSketch() const;
 
 private:
     bool m_fill;
     wxColor m_fillColor;
     wxColor m_lineColor;
     wxVector<wxDouble> m_data;
+    wxSharedPtr<wxHistogramChartSketch> m_sketch;
 };
 
 /// Data for the wxHistogramChartCtrl control.
@@ -106,11 +130,43 @@ public:
 
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
-    void Save(const wxString &filename, const wxBitmapType &type,
-        const wxSize &size);
+    /// Adds values to the histogram. Only the counts of the
+    /// buckets are updated, the values themselves are not
+    /// stored. The buckets keep the range of the values the
+    /// chart was created with, values outside of that range
+    /// are counted in the first or the last bucket. If the
+    /// chart was created without values the range of the
+    /// values passed to the first call is used.
+    ///
+    /// If the chart was created from a sketch the values
+    /// are added to the sketch instead and the bins are
+    /// recomputed to cover the new range of the values.
+    /// @param values The values to add.
+    void AddValues(const wxVector<wxDouble> &values);
+    /// Merges a sketch into the sketch of the chart, for
+    /// instance to combine the values collected by several
+    /// producers.
+    /// @param sketch The sketch to merge.
+    /// @retval true The sketch was merged.
+    /// @retval false The chart wasn't created from a sketch
+    /// or the sketches have different accuracies.
+    bool MergeSketch(const wxHistogramChartSketch &sketch);
+    /// Changes the number of bins. This requires the chart
+    /// to have been created from a sketch since the values
+    /// aren't kept otherwise.
+    /// @param n The number of bins.
+    /// @retval true The values were re-binned.
+    /// @retval false The chart wasn't created from a sketch.
+    bool SetNBins(std::size_t n);
 
 private:
+    // The unit tests check the buckets and the axes directly
+    friend class wxHistogramChartTest;
+
     void Initialize(const wxHistogramChartData &data);
+    void CreateDataset(const wxVector<wxDouble> &values);
+    void UpdateFromSketch();
+    void UpdateYAxis();
 
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
@@ -125,6 +181,8 @@ private:
         std::size_t m_count;
     };
 
+    typedef wxSharedPtr<wxChartRectangle> BucketRectangle;
+
     class Dataset
     {
     public:
@@ -135,19 +193,39 @@ private:
         const wxColor& GetFillColor() const;
         const wxColor& GetLineColor() const;
         const wxVector<Bucket>& GetBuckets() const;
+        std::size_t GetMaxCount() const;
+        std::size_t GetBucketIndex(wxDouble value) const;
         void AppendValue(wxDouble value);
+        void AppendValues(const wxDouble *values, std::size_t count);
+        void SetCounts(const wxVector<std::size_t> &counts);
 
     private:
         bool m_fill;
         wxColor m_fillColor;
         wxColor m_lineColor;
         wxVector<Bucket> m_buckets;
+        // The buckets all have the same width so the bucket
+        // of a value can be computed directly
+        wxDouble m_min;
+        wxDouble m_step;
+        std::size_t m_maxCount;
     };
 
+    BucketRectangle CreateBucketRectangle(std::size_t index) const;
+
 private:
     wxHistogramChartOptions m_options;
     wxChartGrid m_grid;
+    std::size_t m_nbins;
+    wxColor m_lineColor;
+    wxColor m_fillColor;
     wxScopedPtr<Dataset> m_dataset;
+    // Only set if the chart was created from a sketch
+    wxScopedPtr<wxHistogramChartSketch> m_sketch;
+    wxDouble m_axisMinX;
+    wxDouble m_axisMaxX;
+    std::size_t m_axisMaxY;
+    wxChartActivePoints<BucketRectangle> m_activeBuckets;
 };
 
 #endif
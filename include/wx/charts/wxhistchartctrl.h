@@ -66,6 +66,21 @@ public:
         const wxHistogramChartOptions &options, const wxPoint &pos = wxDefaultPosition,
         const wxSize &size = wxDefaultSize, long style = 0);
 
+    /// Adds values to the histogram and redraws it.
+    /// See wxHistogramChart::AddValues() for details.
+    /// @param values The values to add.
+    void AddValues(const wxVector<wxDouble> &values);
+    /// Merges a sketch into the chart and redraws it.
+    /// See wxHistogramChart::MergeSketch() for details.
+    /// @param sketch The sketch to merge.
+    /// @return Whether the sketch could be merged.
+    bool MergeSketch(const wxHistogramChartSketch &sketch);
+    /// Changes the number of bins and redraws the chart.
+    /// See wxHistogramChart::SetNBins() for details.
+    /// @param n The number of bins.
+    /// @return Whether the values could be re-binned.
+    bool SetNBins(std::size_t n);
+
 private:
     virtual wxHistogramChart& GetChart();
 
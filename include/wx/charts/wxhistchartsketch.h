@@ -0,0 +1,155 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXHISTCHARTSKETCH_H_
+#define _WX_CHARTS_WXHISTCHARTSKETCH_H_
+
+#include <wx/vector.h>
+
+/// A summary of a stream of values with bounded memory.
+
+/// The values are counted in buckets whose width grows
+/// logarithmically with the magnitude of the values so that
+/// any value can be recovered with a fixed relative error. The
+/// values themselves are not stored: the memory used depends
+/// on the range of the values and is capped by the maximum
+/// number of buckets, whatever the number of values. When the
+/// cap is reached the buckets of the values closest to zero
+/// are merged.
+///
+/// Sketches with the same relative accuracy can be merged,
+/// for instance to combine the samples collected by several
+/// threads. A sketch can be re-binned into any number of
+/// uniform bins for display, see wxHistogramChartDataset.
+/// \ingroup dataclasses
+class wxHistogramChartSketch
+{
+public:
+    /// Constructs an empty wxHistogramChartSketch instance.
+    /// @param relativeAccuracy The maximum relative error
+    /// on the values recovered from the sketch, between 1e-6
+    /// and 1. The default value is 1%.
+    /// @param maxBucketCount The maximum number of buckets
+    /// used for the positive values, and separately for the
+    /// negative values. With the default settings this covers
+    /// values from 1 nanosecond to about 19 years.
+    wxHistogramChartSketch(wxDouble relativeAccuracy = 0.01,
+        size_t maxBucketCount = 2048);
+
+    /// Gets the relative accuracy of the sketch.
+    /// @return The relative accuracy.
+    wxDouble GetRelativeAccuracy() const;
+    /// Gets the maximum number of buckets.
+    /// @return The maximum number of buckets.
+    size_t GetMaxBucketCount() const;
+
+    /// Adds a value to the sketch. NaN and infinite
+    /// values are ignored.
+    /// @param value The value.
+    void Add(wxDouble value);
+    /// Adds values to the sketch.
+    /// @param values The values.
+    void Add(const wxVector<wxDouble> &values);
+    /// Adds the values of another sketch to this one.
+    /// @param other The sketch to merge.
+    /// @retval true The sketch was merged.
+    /// @retval false The sketches don't have the same
+    /// relative accuracy and couldn't be merged.
+    bool Merge(const wxHistogramChartSketch &other);
+    /// Removes all the values from the sketch.
+    void Clear();
+
+    /// Whether the sketch contains any value.
+    /// @return true if no values were added.
+    bool IsEmpty() const;
+    /// Gets the number of values added to the sketch.
+    /// @return The number of values.
+    size_t GetCount() const;
+    /// Gets the smallest value added to the sketch. The
+    /// value is exact.
+    /// @return The smallest value, 0 if the sketch is empty.
+    wxDouble GetMin() const;
+    /// Gets the largest value added to the sketch. The
+    /// value is exact.
+    /// @return The largest value, 0 if the sketch is empty.
+    wxDouble GetMax() const;
+    /// Gets an approximation of a quantile of the values.
+    /// @param quantile The quantile, between 0 and 1. For
+    /// instance 0.99 gives the 99th percentile.
+    /// @return The value of the quantile, 0 if the sketch is
+    /// empty.
+    wxDouble GetQuantile(wxDouble quantile) const;
+
+    /// Counts the values in uniform bins. The values of each
+    /// bucket of the sketch are assumed to be spread uniformly
+    /// over the range of the bucket and its count is shared
+    /// between the bins that range overlaps, in proportion to
+    /// the overlap. The counts are rounded so that they still
+    /// add up to the number of values.
+    /// @param minValue The start of the first bin.
+    /// @param maxValue The end of the last bin.
+    /// @param binCount The number of bins.
+    /// @param counts The number of values in each bin.
+    void Rebin(wxDouble minValue, wxDouble maxValue,
+        size_t binCount, wxVector<size_t> &counts) const;
+
+private:
+    // The counts of a range of consecutive bucket keys
+    class Store
+    {
+    public:
+        Store();
+
+        bool IsEmpty() const;
+        int GetMinKey() const;
+        int GetMaxKey() const;
+        size_t GetCount(int key) const;
+        void Add(int key, size_t count, size_t maxBucketCount);
+        void Clear();
+
+    private:
+        int m_offset;
+        wxVector<size_t> m_counts;
+    };
+
+    int GetKey(wxDouble magnitude) const;
+    wxDouble GetValue(int key) const;
+    wxDouble Clamp(wxDouble value) const;
+
+private:
+    wxDouble m_relativeAccuracy;
+    size_t m_maxBucketCount;
+    wxDouble m_gamma;
+    wxDouble m_logGamma;
+    Store m_positiveValues;
+    // The keys of the negative values are computed
+    // from their absolute value
+    Store m_negativeValues;
+    size_t m_zeroCount;
+    size_t m_count;
+    wxDouble m_min;
+    wxDouble m_max;
+};
+
+#endif
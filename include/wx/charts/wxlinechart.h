@@ -40,6 +40,10 @@
 #include "wxlinechartoptions.h"
 #include "wxchartgrid.h"
 #include "wxchartpoint.h"
+#include "wxchartactivepoints.h"
+#include "wxchartpointseries.h"
+#include <functional>
+#include <deque>
 
 enum wxLineType
 {
@@ -55,6 +59,9 @@ class wxLineChartDataset
 public:
     /// Smart pointer typedef.
     typedef wxSharedPtr<wxLineChartDataset> ptr;
+    /// Function used to format the text of the tooltips.
+    /// It receives the value of the point.
+    typedef std::function<wxString(wxDouble value)> TooltipFormatter;
 
     /// Constructs a wxLineChartDataset instance.
     /// @param label The name of the dataset. This
@@ -98,6 +105,28 @@ public:
     const wxColor& GetFillColor() const;
     const wxVector<wxDouble>& GetData() const;
     const wxLineType& GetType() const;
+    /// Gets the function used to format the text of
+    /// the tooltips.
+    /// @return The formatter. If it is empty the value
+    /// is displayed as is.
+    const TooltipFormatter& GetTooltipFormatter() const;
+    /// Sets the function used to format the text of
+    /// the tooltips. The function is only called when
+    /// a tooltip is displayed.
+    /// @param formatter The new formatter.
+    void SetTooltipFormatter(const TooltipFormatter &formatter);
+    /// Whether the chart maintains a wxChartMinMaxPyramid
+    /// for this dataset.
+    /// @retval true The pyramid is maintained.
+    /// @retval false The pyramid is not maintained.
+    bool UsesMinMaxPyramid() const;
+    /// Sets whether the chart maintains a wxChartMinMaxPyramid
+    /// for this dataset. With the pyramid only the points that
+    /// are drawn are positioned and the range of the Y axis is
+    /// found without scanning all the values. Tooltips are only
+    /// shown for the points that are drawn.
+    /// @param use Whether to maintain the pyramid.
+    void SetUseMinMaxPyramid(bool use);
 
 private:
     wxString m_label;
@@ -110,6 +139,8 @@ private:
     wxColor m_fillColor;
     wxVector<wxDouble> m_data;
     wxLineType m_type;
+    TooltipFormatter m_tooltipFormatter;
+    bool m_useMinMaxPyramid;
 };
 
 /// Data for the wxLineChartCtrl control.
@@ -143,19 +174,71 @@ private:
 class wxLineChart : public wxChart
 {
 public:
+    /// Function used to create the labels of the values that
+    /// are added without a label. It receives the number of
+    /// values that were added without a label before this one.
+    typedef std::function<wxString(size_t index)> LabelGenerator;
+
     wxLineChart(const wxLineChartData &data, const wxSize &size);
     wxLineChart(const wxLineChartData &data, const wxLineChartOptions &options,
         const wxSize &size);
 
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
-    void Save(const wxString &filename, const wxBitmapType &type,
-        const wxSize &size);
+    /// Appends a value to each dataset. The values are
+    /// placed at the tick mark of the new label, even for
+    /// datasets that have fewer values than there are
+    /// labels. If a maximum number of values was set with
+    /// wxLineChartOptions::SetMaxCount the oldest labels
+    /// are discarded along with the values at their tick
+    /// marks.
+    /// @param label The label of the new values.
+    /// @param values The new values, one per dataset.
+    /// @retval true The values were added.
+    /// @retval false The number of values doesn't match
+    /// the number of datasets.
+    bool AddData(const wxString &label, const wxVector<wxDouble> &values);
+    /// Appends several values to each dataset. The axes are
+    /// only updated once.
+    /// @param labels The labels of the new values.
+    /// @param values The new values of each dataset. Each
+    /// vector must contain as many values as there are labels.
+    /// @retval true The values were added.
+    /// @retval false The number of values doesn't match
+    /// the number of datasets or of labels.
+    bool AddData(const wxVector<wxString> &labels,
+        const wxVector<wxVector<wxDouble> > &values);
+    /// Appends several values to each dataset without labels.
+    /// Their labels are only created, by the function set
+    /// with SetLabelGenerator(), when they are displayed.
+    /// @param values The new values of each dataset. Each
+    /// vector must contain the same number of values.
+    /// @retval true The values were added.
+    /// @retval false The number of values doesn't match
+    /// the number of datasets.
+    bool AddData(const wxVector<wxVector<wxDouble> > &values);
+    /// Sets the function used to create the labels of the
+    /// values added without a label. By default the labels
+    /// are empty.
+    /// @param generator The function.
+    void SetLabelGenerator(const LabelGenerator &generator);
+    /// Gets the number of datasets.
+    /// @return The number of datasets.
+    size_t GetDatasetCount() const;
 
 private:
+    // The unit tests check the positions of the points directly
+    friend class wxLineChartTest;
+
     void Initialize(const wxLineChartData &data);
-    static wxDouble GetMinValue(const wxVector<wxLineChartDataset::ptr>& datasets);
-    static wxDouble GetMaxValue(const wxVector<wxLineChartDataset::ptr>& datasets);
+    void UpdateAxes();
+    wxString GetLabel(size_t index) const;
+    void AppendLabels(const wxVector<wxString> &labels);
+    void AppendGeneratedLabels(size_t count);
+    void RemoveExtraLabels();
+    wxPoint2DDouble GetPointPosition(const wxChartPointSeries &points, size_t index) const;
+    static wxChartAxis::ptr CreateValueAxis(const wxVector<wxLineChartDataset::ptr>& datasets,
+        const wxChartAxisOptions &options);
 
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
@@ -188,34 +271,71 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset(bool showDots, bool showLine, const wxColor &lineColor,
-                bool fill, const wxColor &fillColor,
-                const wxLineType &lineType=wxLINETYPE_STRAIGHTLINE);
+        Dataset(bool showDots, const wxColor &dotColor,
+                const wxColor &dotStrokeColor, bool showLine,
+                const wxColor &lineColor, bool fill,
+                const wxColor &fillColor, const wxLineType &lineType,
+                const wxLineChartDataset::TooltipFormatter &tooltipFormatter);
 
         bool ShowDots() const;
+        const wxColor& GetDotColor() const;
+        const wxColor& GetDotStrokeColor() const;
         bool ShowLine() const;
         const wxColor& GetLineColor() const;
         bool Fill() const;
         const wxColor& GetFillColor() const;
         const wxLineType& GetType() const;
+        const wxLineChartDataset::TooltipFormatter& GetTooltipFormatter() const;
 
-        const wxVector<Point::ptr>& GetPoints() const;
-        void AppendPoint(Point::ptr point);
+        const wxChartPointSeries& GetPoints() const;
+        wxChartPointSeries& GetPoints();
+        const wxVector<size_t>& GetLineIndices() const;
+        wxVector<size_t>& GetLineIndices();
 
     private:
         bool m_showDots;
+        wxColor m_dotColor;
+        wxColor m_dotStrokeColor;
         bool m_showLine;
         wxColor m_lineColor;
         bool m_fill;
         wxColor m_fillColor;
         wxLineType m_type;
-        wxVector<Point::ptr> m_points;
+        wxLineChartDataset::TooltipFormatter m_tooltipFormatter;
+        wxChartPointSeries m_points;
+        wxVector<size_t> m_lineIndices;
     };
 
+    void UpdateLinePositions(Dataset &dataset);
+    Point::ptr CreatePoint(const Dataset &dataset, size_t index) const;
+
 private:
     wxLineChartOptions m_options;
     wxChartGrid m_grid;
+    // The labels of the X axis are stored as runs of
+    // consecutive values whose labels are either given, in
+    // which case they are stored in m_labels, or created by
+    // m_labelGenerator when they are displayed
+    struct LabelRun
+    {
+        size_t count;
+        bool generated;
+        // The index passed to the generator for the first
+        // label of a generated run
+        size_t generatorIndex;
+    };
+    std::deque<LabelRun> m_labelRuns;
+    std::deque<wxString> m_labels;
+    size_t m_labelCount;
+    // The X value of a point is the number of labels that
+    // were added before its own, so the tick mark of the
+    // point is its X value minus the number of labels that
+    // were removed
+    size_t m_removedLabelCount;
+    LabelGenerator m_labelGenerator;
+    size_t m_generatedCount;
     wxVector<Dataset::ptr> m_datasets;
+    wxChartActivePoints<Point::ptr> m_activePoints;
 };
 
 #endif
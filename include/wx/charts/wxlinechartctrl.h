@@ -38,6 +38,7 @@
 
 #include "wxchartctrl.h"
 #include "wxlinechart.h"
+#include "wxchartingestionqueue.h"
 #include <wx/menu.h>
 
 /// A control that displays a line chart.
@@ -46,6 +47,15 @@
 class wxLineChartCtrl : public wxChartCtrl
 {
 public:
+    /// The queue used to add values from another thread.
+    typedef wxChartIngestionQueue<wxDouble> IngestionQueue;
+    /// Function used to create the labels of the values
+    /// added through the ingestion queues. It receives the
+    /// number of values that were added through the queues
+    /// before this one. It is only called for the values
+    /// whose label is displayed.
+    typedef wxLineChart::LabelGenerator LabelGenerator;
+
     /// Constructs a wxLineChartCtrl control.
     /// @param parent Pointer to a parent window.
     /// @param id Control identifier. If wxID_ANY, will automatically
@@ -79,6 +89,35 @@ public:
     wxLineChartCtrl(wxWindow *parent, wxWindowID id, const wxLineChartData &data,
         const wxLineChartOptions &options, const wxPoint &pos = wxDefaultPosition,
         const wxSize &size = wxDefaultSize, long style = 0);
+
+    /// Appends a value to each dataset and refreshes
+    /// the control.
+    /// @param label The label of the new values.
+    /// @param values The new values, one per dataset.
+    /// @retval true The values were added.
+    /// @retval false The number of values doesn't match
+    /// the number of datasets.
+    bool AddData(const wxString &label, const wxVector<wxDouble> &values);
+
+    /// Creates a queue through which a producer thread can add
+    /// values to a dataset without going through the event loop.
+    /// A value is only added once all the datasets have a queue
+    /// and a value is available in each of them, see
+    /// wxChartCtrl::DrainIngestionQueues(). Only one thread may
+    /// push values to a given queue.
+    /// @param index The index of the dataset.
+    /// @param capacity The maximum number of values waiting
+    /// in the queue.
+    /// @return The queue, or a null pointer if the index
+    /// is invalid.
+    IngestionQueue::ptr CreateIngestionQueue(size_t index,
+        size_t capacity = 65536);
+    /// Sets the function used to create the labels of the
+    /// values added through the ingestion queues. By default
+    /// the labels are empty.
+    /// @param generator The function.
+    void SetIngestionLabelGenerator(const LabelGenerator &generator);
+    virtual bool DrainIngestionQueues();
     
 private:
     virtual wxLineChart& GetChart();
@@ -88,6 +127,9 @@ private:
 private:
     wxLineChart m_lineChart;
     wxMenu m_contextMenu;
+    // One queue per dataset, null until it is created
+    wxVector<IngestionQueue::ptr> m_ingestionQueues;
+    wxVector<wxVector<wxDouble> > m_ingestionBuffers;
 };
 
 #endif
@@ -27,6 +27,7 @@
 
 #include "wxchartoptions.h"
 #include "wxchartgridoptions.h"
+#include "wxchartdecimation.h"
 
 /// The options for the wxLineChartCtrl control.
 
@@ -67,6 +68,27 @@ public:
     /// coordinate is ignored in this calculation.
     /// @return The hit detection range.
     wxDouble GetHitDetectionRange() const;
+    /// Gets the algorithm used to reduce the number
+    /// of points of the lines before they are drawn.
+    /// @return The decimation mode.
+    wxChartDecimationMode GetDecimationMode() const;
+    /// Sets the algorithm used to reduce the number
+    /// of points of the lines before they are drawn.
+    /// @param mode The decimation mode.
+    void SetDecimationMode(wxChartDecimationMode mode);
+    /// Gets the maximum number of values kept
+    /// for each dataset.
+    /// @return The maximum number of values, 0 if
+    /// there is no limit.
+    size_t GetMaxCount() const;
+    /// Sets the maximum number of values kept for
+    /// each dataset. When values are added with
+    /// wxLineChart::AddData the oldest values and
+    /// their labels are discarded once this number
+    /// is reached.
+    /// @param maxCount The maximum number of values,
+    /// 0 if there is no limit.
+    void SetMaxCount(size_t maxCount);
 
 private:
     wxChartGridOptions m_gridOptions;
@@ -74,6 +96,8 @@ private:
     unsigned int m_dotStrokeWidth;
     unsigned int m_lineWidth;
     wxDouble m_hitDetectionRange;
+    wxChartDecimationMode m_decimationMode;
+    size_t m_maxCount;
 };
 
 #endif
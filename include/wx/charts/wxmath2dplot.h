@@ -40,6 +40,10 @@
 #include "wxmath2dplotoptions.h"
 #include "wxchartgrid.h"
 #include "wxchartpoint.h"
+#include "wxchartactivepoints.h"
+#include "wxchartpointseries.h"
+#include "wxchartsharedpoints.h"
+#include "wxchartpreparationworker.h"
 
 enum wxChartType
 {
@@ -53,6 +57,10 @@ class wxMath2DPlotDataset
 public:
     /// Smart pointer typedef.
     typedef wxSharedPtr<wxMath2DPlotDataset> ptr;
+    /// Function used to format the text of the tooltips.
+    /// It receives the X and Y values of the point after
+    /// they have been transformed by the axis functions.
+    typedef std::function<wxString(wxDouble x, wxDouble y)> TooltipFormatter;
 
     /// Constructs a Math2DPlot instance.
     /// @param lineColor The color of the line.
@@ -82,6 +90,53 @@ public:
     const wxColor& GetLineColor() const;
     const wxVector<wxPoint2DDouble>& GetData() const;
     const wxChartType& GetType() const;
+    /// Gets the function used to format the text of
+    /// the tooltips.
+    /// @return The formatter. If it is empty the values
+    /// are displayed as (x,y).
+    const TooltipFormatter& GetTooltipFormatter() const;
+    /// Sets the function used to format the text of
+    /// the tooltips. The function is only called when
+    /// a tooltip is displayed.
+    /// @param formatter The new formatter.
+    void SetTooltipFormatter(const TooltipFormatter &formatter);
+    /// Gets the maximum number of points kept by
+    /// the chart for this dataset.
+    /// @return The maximum number of points, 0 if
+    /// there is no limit.
+    size_t GetMaxCount() const;
+    /// Sets the maximum number of points kept by the
+    /// chart for this dataset. When points are added
+    /// with wxMath2DPlot::AddData the oldest points are
+    /// discarded once this number is reached.
+    /// @param maxCount The maximum number of points, 0
+    /// if there is no limit.
+    void SetMaxCount(size_t maxCount);
+    /// Gets the maximum span of X values kept by
+    /// the chart for this dataset.
+    /// @return The maximum span, 0 if there is no limit.
+    wxDouble GetMaxXSpan() const;
+    /// Sets the maximum span of X values kept by the
+    /// chart for this dataset. When points are added
+    /// with wxMath2DPlot::AddData the points whose X value
+    /// is more than maxXSpan behind the X value of the
+    /// newest point are discarded.
+    /// @param maxXSpan The maximum span, 0 if there is
+    /// no limit.
+    void SetMaxXSpan(wxDouble maxXSpan);
+    /// Whether the chart maintains a wxChartMinMaxPyramid
+    /// for this dataset.
+    /// @retval true The pyramid is maintained.
+    /// @retval false The pyramid is not maintained.
+    bool UsesMinMaxPyramid() const;
+    /// Sets whether the chart maintains a wxChartMinMaxPyramid
+    /// for this dataset. With the pyramid only the points that
+    /// are drawn are positioned, so the time needed to draw the
+    /// chart depends on its width and not on the number of
+    /// points. The points must be sorted by X value. Tooltips
+    /// are only shown for the points that are drawn.
+    /// @param use Whether to maintain the pyramid.
+    void SetUseMinMaxPyramid(bool use);
 
 private:
     bool m_showDots;
@@ -91,6 +146,10 @@ private:
     wxColor m_lineColor;
     wxVector<wxPoint2DDouble> m_data;
     wxChartType m_type;
+    TooltipFormatter m_tooltipFormatter;
+    size_t m_maxCount;
+    wxDouble m_maxXSpan;
+    bool m_useMinMaxPyramid;
 };
 
 /// Data for the wxMath2DPlotCtrl control.
@@ -122,15 +181,15 @@ public:
 
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
-    void Save(const wxString &filename, const wxBitmapType &type,
-        const wxSize &size);
-
     bool Scale(int coeff);
     void Shift(double dx,double dy);
     bool UpdateData(std::size_t index,const wxVector<wxPoint2DDouble> &points);
     bool AddData(std::size_t index,const wxVector<wxPoint2DDouble> &points);
     bool RemoveDataset(std::size_t index);
     void AddDataset(const wxMath2DPlotDataset::ptr &newset,bool is_new = true);
+    /// Gets the number of datasets.
+    /// @return The number of datasets.
+    std::size_t GetDatasetCount() const;
 
     const wxChartGridOptions& GetGridOptions() const;
     void  SetGridOptions(const wxChartGridOptions& opt);
@@ -138,13 +197,34 @@ public:
     void  SetChartOptions(const wxMath2DPlotOptions& opt);
     bool  SetChartType(std::size_t index,const wxChartType &type);
 
+    /// Whether the positions of the points are computed
+    /// on a background thread.
+    /// @retval true The positions are computed on a background thread.
+    /// @retval false The positions are computed when the chart is drawn.
+    bool UsesBackgroundPreparation() const;
+    /// Sets whether the positions of the points and the lines
+    /// are computed on a background thread. When the data or
+    /// the layout changes a copy of the values is handed to a
+    /// wxChartPreparationWorker and the chart is drawn from the
+    /// latest wxChartRenderSnapshot it completed, which may
+    /// be out of date for a short time. Tooltips are only shown
+    /// once the snapshot matches the current data. The
+    /// wxChartMinMaxPyramid of the datasets isn't used in this
+    /// mode. The functions set with wxMath2DPlotOptions::SetAxisFuncX()
+    /// and wxMath2DPlotOptions::SetAxisFuncY() are called on the
+    /// background thread so they must be thread-safe.
+    /// @param enable Whether to use a background thread.
+    /// @param callback Function called on the worker thread
+    /// each time a new snapshot is available. It should
+    /// arrange for the chart to be redrawn.
+    void SetBackgroundPreparation(bool enable,
+        const wxChartPreparationWorker::Callback &callback = wxChartPreparationWorker::Callback());
+
 private:
     void Initialize(const wxMath2DPlotData &data);
-    void Update();
-    static wxDouble GetMinXValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets,const AxisFunc &F);
-    static wxDouble GetMaxXValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets,const AxisFunc &F);
-    static wxDouble GetMinYValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets,const AxisFunc &F);
-    static wxDouble GetMaxYValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets,const AxisFunc &F);
+    void Update(bool forceAxesUpdate = false);
+    bool GetExtents(wxDouble &minX, wxDouble &maxX,
+        wxDouble &minY, wxDouble &maxY) const;
 
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
@@ -181,8 +261,10 @@ private:
         Dataset(
             bool showDots, bool showLine,
             const wxColor &lineColor,
+            const wxColor &dotColor,
             const wxColor &dotStrokeColor,
-            const wxChartType &chartType=wxCHARTTYPE_LINE);
+            const wxChartType &chartType,
+            const wxMath2DPlotDataset::TooltipFormatter &tooltipFormatter);
 
         bool ShowDots() const;
         bool ShowLine() const;
@@ -191,9 +273,18 @@ private:
         const wxColor& GetDotStrokeColor() const;
         const wxChartType& GetType() const;
         void SetType(const wxChartType &chartType);
-
-        const wxVector<Point::ptr>& GetPoints() const;
-        void AppendPoint(Point::ptr point);
+        const wxMath2DPlotDataset::TooltipFormatter& GetTooltipFormatter() const;
+
+        const wxChartPointSeries& GetPoints() const;
+        wxChartPointSeries& GetPoints();
+        // When the pyramid is used only the points
+        // listed here have an up to date position
+        const wxVector<size_t>& GetLineIndices() const;
+        wxVector<size_t>& GetLineIndices();
+        // Only kept up to date when the positions are
+        // computed on a background thread
+        const wxChartSharedPoints& GetSharedValues() const;
+        wxChartSharedPoints& GetSharedValues();
 
     private:
         bool m_showDots;
@@ -202,13 +293,40 @@ private:
         wxColor m_dotColor;
         wxColor m_dotStrokeColor;
         wxChartType m_type;
-        wxVector<Point::ptr> m_points;
+        wxMath2DPlotDataset::TooltipFormatter m_tooltipFormatter;
+        wxChartPointSeries m_points;
+        wxVector<size_t> m_lineIndices;
+        wxChartSharedPoints m_sharedValues;
     };
 
+    void UpdatePositions();
+    void UpdateLinePositions(Dataset &dataset);
+    void SubmitPreparation();
+    // Selects the first, minimum, maximum and last points of
+    // each run of consecutive points in the same pixel column
+    static void SelectMarkers(const wxVector<wxPoint2DDouble> &positions,
+        wxVector<size_t> &selected);
+    Point::ptr CreatePoint(const Dataset &dataset, const wxPoint2DDouble &value,
+        const wxPoint2DDouble &position) const;
+
 private:
     wxMath2DPlotOptions m_options;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
+    wxChartActivePoints<Point::ptr> m_activePoints;
+    // The limits that were last passed to the grid, the
+    // axes are only rebuilt if these change
+    wxDouble m_axisMinX;
+    wxDouble m_axisMaxX;
+    wxDouble m_axisMinY;
+    wxDouble m_axisMaxY;
+    // Only set when the positions are computed on
+    // a background thread
+    wxSharedPtr<wxChartPreparationWorker> m_worker;
+    // The generation of the snapshot that matches the
+    // data, 0 if the data changed since the last job was
+    // submitted
+    unsigned long m_preparedGeneration;
 };
 
 #endif
@@ -38,6 +38,7 @@
 
 #include "wxchartctrl.h"
 #include "wxmath2dplot.h"
+#include "wxchartingestionqueue.h"
 #include <wx/menu.h>
 
 /// A control that displays a math2d plot.
@@ -46,6 +47,9 @@
 class wxMath2DPlotCtrl : public wxChartCtrl
 {
 public:
+    /// The queue used to add points from another thread.
+    typedef wxChartIngestionQueue<wxPoint2DDouble> IngestionQueue;
+
     /// Constructs a wxMath2DPlotCtrl control.
     /// @param parent Pointer to a parent window.
     /// @param id Control identifier. If wxID_ANY, will automatically
@@ -65,6 +69,9 @@ public:
     wxMath2DPlotCtrl(wxWindow *parent, wxWindowID id, const wxMath2DPlotData &data,
         const wxMath2DPlotOptions &options, const wxPoint &pos = wxDefaultPosition,
         const wxSize &size = wxDefaultSize, long style = 0);
+    /// Stops the background thread, if any, before
+    /// the control is destroyed.
+    ~wxMath2DPlotCtrl();
 
     bool UpdateData(std::size_t index,const wxVector<wxPoint2DDouble> &points);
     bool AddData(std::size_t index,const wxVector<wxPoint2DDouble> &points);
@@ -76,12 +83,33 @@ public:
     const wxMath2DPlotOptions& GetChartOptions() const;
     void  SetChartOptions(const wxMath2DPlotOptions& opt);
     void  SetChartType(std::size_t index,const wxChartType &type);
+    /// Sets whether the positions of the points are computed
+    /// on a background thread. The control is refreshed each
+    /// time new positions are available. See
+    /// wxMath2DPlot::SetBackgroundPreparation().
+    /// @param enable Whether to use a background thread.
+    void SetBackgroundPreparation(bool enable);
+
+    /// Creates a queue through which a producer thread can add
+    /// points to a dataset without going through the event
+    /// loop. The points are added to the dataset in bulk when
+    /// the queue is drained, see wxChartCtrl::DrainIngestionQueues().
+    /// Only one thread may push points to a given queue.
+    /// @param index The index of the dataset.
+    /// @param capacity The maximum number of points waiting
+    /// in the queue.
+    /// @return The queue, or a null pointer if the index is
+    /// invalid. The queue is released when the dataset is removed.
+    IngestionQueue::ptr CreateIngestionQueue(std::size_t index,
+        std::size_t capacity = 65536);
+    virtual bool DrainIngestionQueues();
 
 private:
     virtual wxMath2DPlot& GetChart();
 
     void CreateContextMenu();
     void Update();
+    void OnSnapshotReady();
 
 private:
     wxMath2DPlot m_math2dPlot;
@@ -89,6 +117,9 @@ private:
     wxMenu *m_subMenu;
     int m_posX;
     int m_posY;
+    // The queues and the index of their dataset
+    wxVector<std::pair<std::size_t, IngestionQueue::ptr> > m_ingestionQueues;
+    wxVector<wxPoint2DDouble> m_ingestionBuffer;
 };
 
 #endif
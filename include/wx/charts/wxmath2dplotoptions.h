@@ -27,6 +27,7 @@
 
 #include "wxchartoptions.h"
 #include "wxchartgridoptions.h"
+#include "wxchartdecimation.h"
 
 #include <functional>
 
@@ -71,10 +72,26 @@ public:
     /// coordinate is ignored in this calculation.
     /// @return The hit detection range.
     wxDouble GetHitDetectionRange() const;
+    /// Gets the algorithm used to reduce the number
+    /// of points of the lines before they are drawn.
+    /// @return The decimation mode.
+    wxChartDecimationMode GetDecimationMode() const;
+    /// Sets the algorithm used to reduce the number
+    /// of points of the lines before they are drawn.
+    /// @param mode The decimation mode.
+    void SetDecimationMode(wxChartDecimationMode mode);
 
     const AxisFunc& GetAxisFuncX() const;
     const AxisFunc& GetAxisFuncY() const;
+    /// Sets the function applied to the X values before
+    /// they are plotted. With wxMath2DPlot::SetBackgroundPreparation()
+    /// it is also called on the background thread so it
+    /// must be thread-safe.
+    /// @param newfunc The function.
     void SetAxisFuncX(const AxisFunc &newfunc);
+    /// Sets the function applied to the Y values before
+    /// they are plotted. See SetAxisFuncX().
+    /// @param newfunc The function.
     void SetAxisFuncY(const AxisFunc &newfunc);
 
 private:
@@ -83,6 +100,7 @@ private:
     unsigned int m_dotStrokeWidth;
     unsigned int m_lineWidth;
     wxDouble m_hitDetectionRange;
+    wxChartDecimationMode m_decimationMode;
     AxisFunc m_axisFuncX;
     AxisFunc m_axisFuncY;
 };
@@ -31,7 +31,7 @@
 /// A control that displays a pie chart.
 
 /// \ingroup chartclasses
-class wxPieChartCtrl : public wxChartCtrl, public wxChartValueObserver<std::map<wxString, wxChartSliceData>>
+class wxPieChartCtrl : public wxChartCtrl, public wxChartValueObserver<std::map<wxString, wxChartSliceData>, wxPieChartDataDelta>
 {
 public:
     /// Constructs a wxPieChartCtrl control.
@@ -72,6 +72,8 @@ public:
 private:
     virtual wxPieChart& GetChart();
     void OnUpdate(const std::map<wxString,wxChartSliceData> &data) override;
+    void OnDeltaUpdate(const std::map<wxString, wxChartSliceData> &data,
+        const wxPieChartDataDelta &delta) override;
 
 private:
     wxPieChart m_pieChart;
@@ -29,6 +29,8 @@
 #include "wxscatterplotoptions.h"
 #include "wxchartgrid.h"
 #include "wxchartpoint.h"
+#include "wxchartactivepoints.h"
+#include "wxchartpointseries.h"
 
 class wxScatterPlotDataset
 {
@@ -86,10 +88,15 @@ public:
 
 private:
     void Initialize(const wxScatterPlotData &data);
-    static wxDouble GetMinXValue(const wxVector<wxScatterPlotDataset::ptr>& datasets);
-    static wxDouble GetMaxXValue(const wxVector<wxScatterPlotDataset::ptr>& datasets);
-    static wxDouble GetMinYValue(const wxVector<wxScatterPlotDataset::ptr>& datasets);
-    static wxDouble GetMaxYValue(const wxVector<wxScatterPlotDataset::ptr>& datasets);
+    struct Extents
+    {
+        wxDouble m_minX;
+        wxDouble m_maxX;
+        wxDouble m_minY;
+        wxDouble m_maxY;
+    };
+
+    static Extents GetExtents(const wxVector<wxScatterPlotDataset::ptr>& datasets);
 
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
@@ -120,19 +127,26 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset();
+        Dataset(const wxColor &fillColor, const wxColor &strokeColor);
 
-        const wxVector<Point::ptr>& GetPoints() const;
-        void AppendPoint(Point::ptr point);
+        const wxChartPointOptions& GetPointOptions() const;
+
+        const wxChartPointSeries& GetPoints() const;
+        wxChartPointSeries& GetPoints();
 
     private:
-        wxVector<Point::ptr> m_points;
+        wxChartPointOptions m_pointOptions;
+        wxChartPointSeries m_points;
     };
 
+    Point::ptr CreatePoint(const Dataset &dataset, size_t index) const;
+
 private:
     wxScatterPlotOptions m_options;
+    Extents m_extents;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
+    wxChartActivePoints<Point::ptr> m_activePoints;
 };
 
 #endif
@@ -34,7 +34,7 @@
 /// A stacked bar chart.
 
 /// \ingroup chartclasses
-class wxStackedBarChart : public wxChart
+class wxStackedBarChart : public wxChart, public wxChartsCategoricalDataObserver
 {
 public:
     wxStackedBarChart(wxChartsCategoricalData::ptr &data, const wxSize &size);
@@ -43,7 +43,21 @@ public:
 
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
+    virtual void OnValueChanged(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index, wxDouble oldValue);
+    virtual void OnCategoryAppended(const wxChartsCategoricalData &data);
+    virtual void OnDatasetAdded(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+    virtual void OnDatasetRemoved(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+
 private:
+    void Initialize(wxChartsCategoricalData::ptr &data);
+    static wxDouble GetCumulativeValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets,
+        size_t index);
+    // The sum with the value of one dataset replaced, see OnValueChanged()
+    static wxDouble GetCumulativeValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets,
+        size_t index, size_t replacedDataset, wxDouble replacement);
     static wxDouble GetCumulativeMinValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
     static wxDouble GetCumulativeMaxValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
 
@@ -61,8 +75,7 @@ private:
         Bar(wxDouble value,
             const wxChartTooltipProvider::ptr tooltipProvider,
             wxDouble x, wxDouble y,
-            const wxColor &fillColor, const wxColor &strokeColor,
-            int directions);
+            const wxChartRectangleOptions &options);
 
         virtual bool HitTest(const wxPoint &point) const;
 
@@ -77,17 +90,33 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset();
+        Dataset(const wxChartRectangleOptions &options);
+
+        const wxChartRectangleOptions& GetRectangleOptions() const;
 
         const wxVector<Bar::ptr>& GetBars() const;
         void AppendBar(Bar::ptr bar);
+        void SetBar(size_t index, Bar::ptr bar);
 
     private:
+        wxChartRectangleOptions m_rectangleOptions;
         wxVector<Bar::ptr> m_bars;
     };
 
+    Bar::ptr CreateBar(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index,
+        const wxChartRectangleOptions &options) const;
+    Dataset::ptr CreateDataset(const wxChartsCategoricalData &data,
+        size_t datasetIndex) const;
+    void FitBars(size_t index);
+    bool UpdateValueAxis(const wxChartsCategoricalData &data, bool recompute);
+
 private:
     wxStackedBarChartOptions m_options;
+    // The range of the cumulative values, it is kept
+    // up to date as the data changes
+    wxDouble m_minValue;
+    wxDouble m_maxValue;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
 };
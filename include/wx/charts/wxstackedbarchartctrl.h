@@ -31,7 +31,7 @@
 /// A control that displays a stacked bar chart.
 
 /// \ingroup chartclasses
-class wxStackedBarChartCtrl : public wxChartCtrl
+class wxStackedBarChartCtrl : public wxChartCtrl, public wxChartsCategoricalDataObserver
 {
 public:
     /// Constructs a wxStackedBarChartCtrl control.
@@ -54,10 +54,21 @@ public:
         const wxStackedBarChartOptions &options, const wxPoint &pos = wxDefaultPosition,
         const wxSize &size = wxDefaultSize, long style = 0);
 
+    virtual ~wxStackedBarChartCtrl();
+
+    virtual void OnValueChanged(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index, wxDouble oldValue);
+    virtual void OnCategoryAppended(const wxChartsCategoricalData &data);
+    virtual void OnDatasetAdded(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+    virtual void OnDatasetRemoved(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+
 private:
     virtual wxStackedBarChart& GetChart();
 
 private:
+    wxChartsCategoricalData::ptr m_data;
     wxStackedBarChart m_stackedBarChart;
 };
 
@@ -45,14 +45,27 @@
 /// A stacked column chart.
 
 /// \ingroup chartclasses
-class wxStackedColumnChart : public wxChart
+class wxStackedColumnChart : public wxChart, public wxChartsCategoricalDataObserver
 {
 public:
     wxStackedColumnChart(wxChartsCategoricalData::ptr &data, const wxSize &size);
 
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
+    virtual void OnValueChanged(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index, wxDouble oldValue);
+    virtual void OnCategoryAppended(const wxChartsCategoricalData &data);
+    virtual void OnDatasetAdded(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+    virtual void OnDatasetRemoved(const wxChartsCategoricalData &data,
+        size_t datasetIndex);
+
 private:
+    static wxDouble GetCumulativeValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets,
+        size_t index);
+    // The sum with the value of one dataset replaced, see OnValueChanged()
+    static wxDouble GetCumulativeValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets,
+        size_t index, size_t replacedDataset, wxDouble replacement);
     static wxDouble GetCumulativeMinValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
     static wxDouble GetCumulativeMaxValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets);
 
@@ -70,8 +83,7 @@ private:
         Column(wxDouble value,
             const wxChartTooltipProvider::ptr tooltipProvider,
             wxDouble x, wxDouble y,
-            const wxColor &fillColor, const wxColor &strokeColor,
-            int directions);
+            const wxChartRectangleOptions &options);
 
         virtual bool HitTest(const wxPoint &point) const;
 
@@ -86,17 +98,33 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset();
+        Dataset(const wxChartRectangleOptions &options);
+
+        const wxChartRectangleOptions& GetRectangleOptions() const;
 
         const wxVector<Column::ptr>& GetColumns() const;
         void AppendColumn(Column::ptr column);
+        void SetColumn(size_t index, Column::ptr column);
 
     private:
+        wxChartRectangleOptions m_rectangleOptions;
         wxVector<Column::ptr> m_columns;
     };
 
+    Column::ptr CreateColumn(const wxChartsCategoricalData &data,
+        size_t datasetIndex, size_t index,
+        const wxChartRectangleOptions &options) const;
+    Dataset::ptr CreateDataset(const wxChartsCategoricalData &data,
+        size_t datasetIndex) const;
+    void FitColumns(size_t index);
+    bool UpdateValueAxis(const wxChartsCategoricalData &data, bool recompute);
+
 private:
     wxStackedColumnChartOptions m_options;
+    // The range of the cumulative values, it is kept
+    // up to date as the data changes
+    wxDouble m_minValue;
+    wxDouble m_maxValue;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
 };
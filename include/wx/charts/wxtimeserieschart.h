@@ -20,32 +20,263 @@
     IN THE SOFTWARE.
 */
 
+
 /// @file
 
-#ifndef _WX_CHARTS_WXTIMESERIESCHARTOPTIONS_H_
-#define _WX_CHARTS_WXTIMESERIESCHARTOPTIONS_H_
+#ifndef _WX_CHARTS_WXTIMESERIESCHART_H_
+#define _WX_CHARTS_WXTIMESERIESCHART_H_
 
 #include "wxchart.h"
 #include "wxtimeserieschartoptions.h"
+#include "wxchartgrid.h"
+#include "wxcharttimeaxis.h"
+#include "wxchartnumericalaxis.h"
+#include "wxchartminmaxpyramid.h"
+
+/// Stores the information about a dataset to be shown on a wxTimeSeriesChart.
+
+/// The timestamps and the values are kept in two separate
+/// contiguous arrays. The timestamps are numbers of
+/// milliseconds since 1970-01-01 00:00:00 UTC and must be
+/// in increasing order so that the samples that fall in
+/// a given time range can be found by binary search.
+///
+/// A retention window can be set with SetMaxCount() or
+/// SetMaxTimeSpan(), in which case the oldest samples are
+/// discarded as new samples are appended. The discarded
+/// samples are only removed from the arrays once they
+/// outnumber the samples that are kept, so discarding a
+/// sample takes amortized constant time and the memory
+/// used is at most twice the size of the window.
+/// \ingroup dataclasses
+class wxTimeSeriesDataset
+{
+public:
+    /// Smart pointer typedef.
+    typedef wxSharedPtr<wxTimeSeriesDataset> ptr;
+
+    /// Constructs an empty wxTimeSeriesDataset instance.
+    /// @param label The name of the dataset. This
+    /// is the name that will be used in the legend.
+    /// @param lineColor The color of the line.
+    wxTimeSeriesDataset(const wxString &label, const wxColor &lineColor);
+    /// Constructs a wxTimeSeriesDataset instance.
+    /// @param label The name of the dataset. This
+    /// is the name that will be used in the legend.
+    /// @param lineColor The color of the line.
+    /// @param timestamps The timestamps of the samples,
+    /// in increasing order.
+    /// @param values The values of the samples.
+    wxTimeSeriesDataset(const wxString &label, const wxColor &lineColor,
+        const wxVector<wxInt64> &timestamps, const wxVector<wxDouble> &values);
+
+    /// Gets the name of the dataset.
+    /// @return The name of the dataset.
+    const wxString& GetLabel() const;
+    const wxColor& GetLineColor() const;
+
+    /// Gets the number of samples.
+    /// @return The number of samples.
+    size_t GetCount() const;
+    /// Reserves memory for the given number of samples.
+    /// @param count The number of samples.
+    void Reserve(size_t count);
+    /// Appends a sample.
+    /// @param timestamp The timestamp of the sample.
+    /// @param value The value of the sample.
+    /// @retval true The sample was added.
+    /// @retval false The timestamp is before the timestamp
+    /// of the last sample.
+    bool Append(wxInt64 timestamp, wxDouble value);
+    /// Gets the timestamps of the samples. The pointer is
+    /// only valid until the next sample is appended.
+    /// @return The timestamps, GetCount() of them.
+    const wxInt64* GetTimestamps() const;
+    /// Gets the values of the samples. The pointer is
+    /// only valid until the next sample is appended.
+    /// @return The values, GetCount() of them.
+    const wxDouble* GetValues() const;
+
+    /// Gets the maximum number of samples that are kept.
+    /// @return The maximum number of samples, 0 if there
+    /// is no limit.
+    size_t GetMaxCount() const;
+    /// Sets the maximum number of samples that are kept.
+    /// Once this number is reached appending a sample
+    /// discards the oldest one.
+    /// @param maxCount The maximum number of samples, 0 if
+    /// there is no limit.
+    void SetMaxCount(size_t maxCount);
+    /// Gets the maximum difference between the timestamps
+    /// of the newest and oldest samples.
+    /// @return The maximum span in milliseconds, 0 if there
+    /// is no limit.
+    wxInt64 GetMaxTimeSpan() const;
+    /// Sets the maximum difference between the timestamps
+    /// of the newest and oldest samples. When a sample is
+    /// appended the samples that are older than its timestamp
+    /// minus the span are discarded.
+    /// @param maxTimeSpan The maximum span in milliseconds,
+    /// 0 if there is no limit.
+    void SetMaxTimeSpan(wxInt64 maxTimeSpan);
+
+    /// Whether a wxChartMinMaxPyramid of the values is
+    /// maintained as samples are appended.
+    /// @retval true The pyramid is maintained.
+    /// @retval false The pyramid is not maintained.
+    bool UsesMinMaxPyramid() const;
+    /// Sets whether a wxChartMinMaxPyramid of the values is
+    /// maintained as samples are appended. With the pyramid
+    /// the time needed to draw the chart only depends on its
+    /// width, whatever the number of visible samples.
+    /// @param use Whether to maintain the pyramid.
+    void SetUseMinMaxPyramid(bool use);
+    /// Extends a range so that it includes the values of
+    /// some of the samples. The pyramid is used if it is
+    /// maintained.
+    /// @param first The index of the first sample.
+    /// @param last The index following the last sample.
+    /// @param found Whether minValue and maxValue already contain
+    /// a range. This is set to true if last is greater than first.
+    /// @param minValue The minimum value.
+    /// @param maxValue The maximum value.
+    void UpdateExtents(size_t first, size_t last, bool &found,
+        wxDouble &minValue, wxDouble &maxValue) const;
+    /// Selects the samples needed to draw the line. See
+    /// wxChartMinMaxPyramid::Decimate().
+    /// @param boundaries The index of the first sample of each
+    /// column followed by the index following the last sample
+    /// of the last column.
+    /// @param indices When the function returns this contains
+    /// the indices of the samples to draw.
+    void Decimate(const wxVector<size_t> &boundaries,
+        wxVector<size_t> &indices) const;
+
+    /// Finds the samples whose timestamp is in the given range
+    /// using a binary search.
+    /// @param start The start of the range.
+    /// @param end The end of the range, included.
+    /// @param first When the function returns this contains
+    /// the index of the first sample in the range.
+    /// @param last When the function returns this contains
+    /// the index following the last sample in the range.
+    void FindRange(wxInt64 start, wxInt64 end,
+        size_t &first, size_t &last) const;
+
+private:
+    void RemoveOldSamples();
+    void UpdatePyramid();
+
+private:
+    wxString m_label;
+    wxColor m_lineColor;
+    // The first m_first samples of the arrays have been
+    // discarded but not removed yet
+    wxVector<wxInt64> m_timestamps;
+    wxVector<wxDouble> m_values;
+    size_t m_first;
+    size_t m_maxCount;
+    wxInt64 m_maxTimeSpan;
+    // The pyramid uses indices that don't change when samples
+    // are discarded so the number of discarded samples is kept
+    // to convert them
+    bool m_usePyramid;
+    size_t m_removed;
+    wxChartMinMaxPyramid m_pyramid;
+};
 
+/// Data for the wxTimeSeriesChartCtrl control.
+
+/// \ingroup dataclasses
+class wxTimeSeriesData
+{
+public:
+    /// Constructs an empty wxTimeSeriesData instance.
+    wxTimeSeriesData();
+
+    /// Adds a dataset. The dataset is shared with the chart,
+    /// the samples are not copied.
+    /// @param dataset The dataset to add.
+    void AddDataset(wxTimeSeriesDataset::ptr dataset);
+
+    const wxVector<wxTimeSeriesDataset::ptr>& GetDatasets() const;
+
+private:
+    wxVector<wxTimeSeriesDataset::ptr> m_datasets;
+};
+
+/// A time series chart.
+
+/// Only the samples that fall inside the visible range are
+/// looked at when the chart is laid out, and when there are
+/// more of them than pixels only the first, minimum, maximum
+/// and last samples of each pixel column are drawn.
 /// \ingroup chartclasses
 class wxTimeSeriesChart : public wxChart
 {
 public:
-    wxTimeSeriesChart(const wxSize &size);
-    wxTimeSeriesChart(const wxTimeSeriesChartOptions &options,
-        const wxSize &size);
+    wxTimeSeriesChart(const wxTimeSeriesData &data, const wxSize &size);
+    wxTimeSeriesChart(const wxTimeSeriesData &data,
+        const wxTimeSeriesChartOptions &options, const wxSize &size);
 
     virtual const wxChartCommonOptions& GetCommonOptions() const;
 
+    /// Appends a sample to a dataset. If the dataset has
+    /// a retention window the samples that fall out of it
+    /// are discarded.
+    /// @param datasetIndex The index of the dataset.
+    /// @param timestamp The timestamp of the sample.
+    /// @param value The value of the sample.
+    /// @retval true The sample was added.
+    /// @retval false The index is not valid or the timestamp
+    /// is before the timestamp of the last sample of the
+    /// dataset.
+    bool Append(size_t datasetIndex, wxInt64 timestamp, wxDouble value);
+
+    /// Restricts the chart to a range of timestamps.
+    /// @param start The first timestamp to show.
+    /// @param end The last timestamp to show.
+    void SetVisibleRange(wxInt64 start, wxInt64 end);
+    /// Shows all the samples. This is the default. The
+    /// range is extended as samples are appended.
+    void ResetVisibleRange();
+
 private:
+    void Initialize(const wxTimeSeriesData &data);
+    void UpdateVisibleRange();
+    void UpdateAxes();
+    size_t GetMaxTickMarks() const;
+    wxPoint2DDouble GetWindowPosition(wxInt64 timestamp, wxDouble value) const;
+    void BuildLine(const wxTimeSeriesDataset &dataset, size_t first,
+        size_t last, wxVector<wxPoint2DDouble> &line) const;
+
     virtual void DoSetSize(const wxSize &size);
     virtual void DoFit();
     virtual void DoDraw(wxGraphicsContext &gc, bool suppressTooltips);
     virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point);
 
+private:
+    struct VisibleRange
+    {
+        VisibleRange() : first(0), last(0) {}
+        size_t first;
+        size_t last;
+    };
+
 private:
     wxTimeSeriesChartOptions m_options;
+    // The axes are owned by the grid
+    wxChartTimeAxis* m_timeAxis;
+    wxChartNumericalAxis* m_valueAxis;
+    wxChartGrid m_grid;
+    wxVector<wxTimeSeriesDataset::ptr> m_datasets;
+    bool m_autoRange;
+    wxInt64 m_start;
+    wxInt64 m_end;
+    wxDouble m_minValue;
+    wxDouble m_maxValue;
+    wxVector<VisibleRange> m_visibleRanges;
+    wxVector<wxVector<wxPoint2DDouble> > m_lines;
 };
 
 #endif
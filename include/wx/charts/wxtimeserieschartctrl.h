@@ -20,6 +20,7 @@
     IN THE SOFTWARE.
 */
 
+
 /// @file
 
 #ifndef _WX_CHARTS_WXTIMESERIESCHARTCTRL_H_
@@ -34,12 +35,58 @@
 class wxTimeSeriesChartCtrl : public wxChartCtrl
 {
 public:
+    /// Constructs a wxTimeSeriesChartCtrl control.
+    /// @param parent Pointer to a parent window.
+    /// @param id Control identifier. If wxID_ANY, will automatically
+    /// create an identifier.
+    /// @param data The data that will be used to initialize the chart.
+    /// @param pos Control position. wxDefaultPosition indicates that
+    /// wxWidgets should generate a default position for the control.
+    /// @param size Control size. wxDefaultSize indicates that wxWidgets
+    /// should generate a default size for the window. If no suitable
+    /// size can  be found, the window will be sized to 20x20 pixels
+    /// so that the window is visible but obviously not correctly sized.
+    /// @param style Control style. For generic window styles, please
+    /// see wxWindow.
+    wxTimeSeriesChartCtrl(wxWindow *parent, wxWindowID id,
+        const wxTimeSeriesData &data, const wxPoint &pos = wxDefaultPosition,
+        const wxSize &size = wxDefaultSize, long style = 0);
+    /// Constructs a wxTimeSeriesChartCtrl control.
+    /// @param parent Pointer to a parent window.
+    /// @param id Control identifier. If wxID_ANY, will automatically
+    /// create an identifier.
+    /// @param data The data that will be used to initialize the chart.
+    /// @param options The settings to be used for this chart.
+    /// @param pos Control position. wxDefaultPosition indicates that
+    /// wxWidgets should generate a default position for the control.
+    /// @param size Control size. wxDefaultSize indicates that wxWidgets
+    /// should generate a default size for the window. If no suitable
+    /// size can  be found, the window will be sized to 20x20 pixels
+    /// so that the window is visible but obviously not correctly sized.
+    /// @param style Control style. For generic window styles, please
+    /// see wxWindow.
     wxTimeSeriesChartCtrl(wxWindow *parent, wxWindowID id,
+        const wxTimeSeriesData &data, const wxTimeSeriesChartOptions &options,
         const wxPoint &pos = wxDefaultPosition, const wxSize &size = wxDefaultSize,
         long style = 0);
-    wxTimeSeriesChartCtrl(wxWindow *parent, wxWindowID id,
-        const wxTimeSeriesChartOptions &options, const wxPoint &pos = wxDefaultPosition,
-        const wxSize &size = wxDefaultSize, long style = 0);
+
+    /// Appends a sample to a dataset and refreshes
+    /// the control.
+    /// @param datasetIndex The index of the dataset.
+    /// @param timestamp The timestamp of the sample.
+    /// @param value The value of the sample.
+    /// @retval true The sample was added.
+    /// @retval false The index is not valid or the timestamp
+    /// is before the timestamp of the last sample of the
+    /// dataset.
+    bool Append(size_t datasetIndex, wxInt64 timestamp, wxDouble value);
+    /// Restricts the chart to a range of timestamps and
+    /// refreshes the control.
+    /// @param start The first timestamp to show.
+    /// @param end The last timestamp to show.
+    void SetVisibleRange(wxInt64 start, wxInt64 end);
+    /// Shows all the samples and refreshes the control.
+    void ResetVisibleRange();
 
 private:
     virtual wxTimeSeriesChart& GetChart();
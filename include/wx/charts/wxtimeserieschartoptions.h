@@ -20,20 +20,52 @@
     IN THE SOFTWARE.
 */
 
+
 /// @file
 
-#ifndef _WX_CHARTS_WXTIMESERIESCHART_H_
-#define _WX_CHARTS_WXTIMESERIESCHART_H_
+#ifndef _WX_CHARTS_WXTIMESERIESCHARTOPTIONS_H_
+#define _WX_CHARTS_WXTIMESERIESCHARTOPTIONS_H_
 
 #include "wxchartoptions.h"
 #include "wxchartgridoptions.h"
 
+/// The options for the wxTimeSeriesChartCtrl control.
+
 /// \ingroup chartclasses
 class wxTimeSeriesChartOptions : public wxChartOptions
 {
 public:
     /// Constructs a wxTimeSeriesChartOptions instance.
     wxTimeSeriesChartOptions();
+
+    /// Gets the options for the grid.
+    /// @return The options for the grid.
+    const wxChartGridOptions& GetGridOptions() const;
+    /// Gets the options for the grid.
+    /// @return The options for the grid.
+    wxChartGridOptions& GetGridOptions();
+    /// Gets the width of the pen used to draw
+    /// the lines.
+    /// @return The width of the pen.
+    unsigned int GetLineWidth() const;
+    /// Sets the width of the pen used to draw
+    /// the lines.
+    /// @param width The width of the pen.
+    void SetLineWidth(unsigned int width);
+    /// Gets the minimum distance in pixels between
+    /// two tick marks of the time axis. This controls
+    /// how many tick marks fit on the axis.
+    /// @return The distance in pixels.
+    unsigned int GetTickMarkSpacing() const;
+    /// Sets the minimum distance in pixels between
+    /// two tick marks of the time axis.
+    /// @param spacing The distance in pixels.
+    void SetTickMarkSpacing(unsigned int spacing);
+
+private:
+    wxChartGridOptions m_gridOptions;
+    unsigned int m_lineWidth;
+    unsigned int m_tickMarkSpacing;
 };
 
 #endif
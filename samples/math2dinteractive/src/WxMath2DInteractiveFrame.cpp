@@ -45,6 +45,8 @@ WxMath2DInteractiveFrame::WxMath2DInteractiveFrame(const wxString& title)
             wxColor(0, 0, 0, 0xB8),
             data1)
         );
+    // Only keep the most recent points
+    dataset1->SetMaxXSpan(100);
     chartData.AddDataset(dataset1);
 
     wxVector<wxPoint2DDouble> data2;
@@ -55,6 +57,8 @@ WxMath2DInteractiveFrame::WxMath2DInteractiveFrame(const wxString& title)
             wxColor(50, 210, 105, 0xB8),
             data2)
         );
+    // Only keep the most recent points
+    dataset2->SetMaxXSpan(100);
     chartData.AddDataset(dataset2);
 
     math2dPlotCtrl = new wxMath2DPlotCtrl(panel, wxID_ANY, chartData,options);
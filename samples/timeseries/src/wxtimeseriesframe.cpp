@@ -24,6 +24,7 @@
 #include <wx/panel.h>
 #include <wx/sizer.h>
 #include <wx/charts/wxcharts.h>
+#include <cmath>
 
 WxTimeSeriesFrame::WxTimeSeriesFrame(const wxString& title)
 	: wxFrame(NULL, wxID_ANY, title)
@@ -31,9 +32,29 @@ WxTimeSeriesFrame::WxTimeSeriesFrame(const wxString& title)
 	// Create a top-level panel to hold all the contents of the frame
 	wxPanel* panel = new wxPanel(this, wxID_ANY);
 
+	// Create the data for the time series chart widget: one
+	// sample per minute over a month, starting on 2018-01-01
+	const wxInt64 start = 1514764800000LL;
+	const size_t count = 31 * 24 * 60;
+
+	wxTimeSeriesDataset::ptr dataset1(new wxTimeSeriesDataset("Dataset 1", wxColor(220, 30, 30)));
+	wxTimeSeriesDataset::ptr dataset2(new wxTimeSeriesDataset("Dataset 2", wxColor(30, 30, 220)));
+	dataset1->Reserve(count);
+	dataset2->Reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		wxInt64 timestamp = start + (i * 60000LL);
+		dataset1->Append(timestamp, 20 + (10 * std::sin(i / 720.0)) + (i % 37) / 10.0);
+		dataset2->Append(timestamp, 15 + (5 * std::cos(i / 1440.0)));
+	}
+
+	wxTimeSeriesData chartData;
+	chartData.AddDataset(dataset1);
+	chartData.AddDataset(dataset2);
+
 	// Create the time series chart widget from the constructed data
 	wxTimeSeriesChartCtrl* timeSeriesChartCtrl = new wxTimeSeriesChartCtrl(panel, wxID_ANY,
-		wxDefaultPosition, wxDefaultSize, wxBORDER_NONE);
+		chartData, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE);
 
 	// Set up the sizer for the panel
 	wxBoxSizer* panelSizer = new wxBoxSizer(wxHORIZONTAL);
@@ -32,7 +32,7 @@
 */
 
 #include "wxareachart.h"
-#include <wx/dcmemory.h>
+#include "wxchartutilities.h"
 #include <sstream>
 
 wxAreaChartDataset::wxAreaChartDataset(
@@ -120,9 +120,10 @@ wxPoint2DDouble wxAreaChart::Point::GetValue() const
 
 wxAreaChart::Dataset::Dataset(bool showDots,
     bool showLine,
-    const wxColor &lineColor)
+    const wxColor &lineColor,
+    const wxColor &dotColor)
     : m_showDots(showDots), m_showLine(showLine),
-    m_lineColor(lineColor)
+    m_lineColor(lineColor), m_dotColor(dotColor)
 {
 }
 
@@ -141,23 +142,29 @@ const wxColor& wxAreaChart::Dataset::GetLineColor() const
     return m_lineColor;
 }
 
-const wxVector<wxAreaChart::Point::ptr>& wxAreaChart::Dataset::GetPoints() const
+const wxColor& wxAreaChart::Dataset::GetDotColor() const
+{
+    return m_dotColor;
+}
+
+const wxChartPointSeries& wxAreaChart::Dataset::GetPoints() const
 {
     return m_points;
 }
 
-void wxAreaChart::Dataset::AppendPoint(Point::ptr point)
+wxChartPointSeries& wxAreaChart::Dataset::GetPoints()
 {
-    m_points.push_back(point);
+    return m_points;
 }
 
 wxAreaChart::wxAreaChart(const wxAreaChartData &data,
                            const wxSize &size)
-    : m_grid(
+    : m_extents(GetExtents(data.GetDatasets())),
+    m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
-        GetMinXValue(data.GetDatasets()), GetMaxXValue(data.GetDatasets()),
-        GetMinYValue(data.GetDatasets()), GetMaxYValue(data.GetDatasets()),
+        m_extents.m_minX, m_extents.m_maxX,
+        m_extents.m_minY, m_extents.m_maxY,
         m_options.GetGridOptions())
 {
     Initialize(data);
@@ -167,11 +174,12 @@ wxAreaChart::wxAreaChart(const wxAreaChartData &data,
                              const wxAreaChartOptions &options,
                              const wxSize &size)
     : m_options(options),
+    m_extents(GetExtents(data.GetDatasets())),
     m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
-        GetMinXValue(data.GetDatasets()), GetMaxXValue(data.GetDatasets()),
-        GetMinYValue(data.GetDatasets()), GetMaxYValue(data.GetDatasets()),
+        m_extents.m_minX, m_extents.m_maxX,
+        m_extents.m_minY, m_extents.m_maxY,
         m_options.GetGridOptions())
 {
     Initialize(data);
@@ -182,149 +190,52 @@ const wxChartCommonOptions& wxAreaChart::GetCommonOptions() const
     return m_options.GetCommonOptions();
 }
 
-void wxAreaChart::Save(const wxString &filename,
-                       const wxBitmapType &type,
-                       const wxSize &size)
-{
-    wxBitmap bmp(size.GetWidth(), size.GetHeight());
-    wxMemoryDC mdc(bmp);
-    mdc.Clear();
-    wxGraphicsContext* gc = wxGraphicsContext::Create(mdc);
-    if (gc)
-    {
-        DoDraw(*gc, true);
-        bmp.SaveFile(filename, type);
-        delete gc;
-    }
-}
-
 void wxAreaChart::Initialize(const wxAreaChartData &data)
 {
     const wxVector<wxAreaChartDataset::ptr>& datasets = data.GetDatasets();
     for (size_t i = 0; i < datasets.size(); ++i)
     {
         Dataset::ptr newDataset(new Dataset(datasets[i]->ShowDots(),datasets[i]->ShowLine(),
-            datasets[i]->GetLineColor()));
-
-        const wxVector<wxPoint2DDouble>& datasetData = datasets[i]->GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << "(" << datasetData[j].m_x << "," << datasetData[j].m_y << ")";
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic("", tooltip.str(), datasets[i]->GetLineColor())
-                );
-
-            Point::ptr point(
-                new Point(datasetData[j], tooltipProvider, 20 + j * 10, 0,
-                    m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
-                    datasets[i]->GetDotColor(),m_options.GetHitDetectionRange()));
-
-            newDataset->AppendPoint(point);
-        }
-
+            datasets[i]->GetLineColor(), datasets[i]->GetDotColor()));
+        newDataset->GetPoints().Append(datasets[i]->GetData());
         m_datasets.push_back(newDataset);
     }
 }
 
-wxDouble wxAreaChart::GetMinXValue(const wxVector<wxAreaChartDataset::ptr>& datasets)
+wxAreaChart::Point::ptr wxAreaChart::CreatePoint(const Dataset &dataset,
+                                                 size_t index) const
 {
-    wxDouble result = 0;
-    bool foundValue = false;
+    const wxChartPointSeries& points = dataset.GetPoints();
+    wxPoint2DDouble value = points.GetValue(index);
 
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_x;
-                foundValue = true;
-            }
-            else if (result > values[j].m_x)
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderLazy(
+            wxChartTooltipProviderLazy::Generator(),
+            [value]() -> wxString
             {
-                result = values[j].m_x;
-            }
-        }
-    }
-
-    return result;
-}
-
-wxDouble wxAreaChart::GetMaxXValue(const wxVector<wxAreaChartDataset::ptr>& datasets)
-{
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_x;
-                foundValue = true;
-            }
-            else if (result < values[j].m_x)
-            {
-                result = values[j].m_x;
-            }
-        }
-    }
-
-    return result;
-}
-
-wxDouble wxAreaChart::GetMinYValue(const wxVector<wxAreaChartDataset::ptr>& datasets)
-{
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_y;
-                foundValue = true;
-            }
-            else if (result > values[j].m_y)
-            {
-                result = values[j].m_y;
-            }
-        }
-    }
+                std::stringstream tooltip;
+                tooltip << "(" << value.m_x << "," << value.m_y << ")";
+                return tooltip.str();
+            },
+            dataset.GetLineColor())
+        );
 
-    return result;
+    const wxPoint2DDouble& position = points.GetPosition(index);
+    return Point::ptr(new Point(value, tooltipProvider, position.m_x, position.m_y,
+        m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
+        dataset.GetDotColor(), m_options.GetHitDetectionRange()));
 }
 
-wxDouble wxAreaChart::GetMaxYValue(const wxVector<wxAreaChartDataset::ptr>& datasets)
+wxAreaChart::Extents wxAreaChart::GetExtents(const wxVector<wxAreaChartDataset::ptr>& datasets)
 {
-    wxDouble result = 0;
+    Extents extents = { 0, 0, 0, 0 };
     bool foundValue = false;
-
     for (size_t i = 0; i < datasets.size(); ++i)
     {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_y;
-                foundValue = true;
-            }
-            else if (result < values[j].m_y)
-            {
-                result = values[j].m_y;
-            }
-        }
+        wxChartUtilities::UpdateExtents(datasets[i]->GetData(), foundValue,
+            extents.m_minX, extents.m_maxX, extents.m_minY, extents.m_maxY);
     }
-
-    return result;
+    return extents;
 }
 
 void wxAreaChart::DoSetSize(const wxSize &size)
@@ -340,42 +251,40 @@ void wxAreaChart::DoFit()
 {
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        for (size_t j = 0; j < points.GetCount(); ++j)
         {
-            const Point::ptr& point = points[j];
-            point->SetPosition(m_grid.GetMapping().GetWindowPosition(point->GetValue().m_x, point->GetValue().m_y));
+            points.SetPosition(j, m_grid.GetMapping().GetWindowPosition(points.GetX(j), points.GetY(j)));
         }
+        points.BuildIndex();
     }
 }
 
 void wxAreaChart::DoDraw(wxGraphicsContext &gc,
                          bool suppressTooltips)
 {
+    // The chart is only redrawn when the data or the layout
+    // changed, in which case the active points are stale
+    m_activePoints.Invalidate();
+
     m_grid.Fit(gc);
     m_grid.Draw(gc);
     Fit();
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
+        const wxVector<wxPoint2DDouble>& positions = m_datasets[i]->GetPoints().GetPositions();
 
         wxGraphicsPath path = gc.CreatePath();
 
-        if (points.size() > 0)
+        if (positions.size() > 0)
         {
-            auto value = points[0]->GetValue();
-            wxPoint2DDouble firstPosition = m_grid.GetMapping().GetWindowPosition(value.m_x,value.m_y );
-            path.MoveToPoint(firstPosition);
-
-            wxPoint2DDouble lastPosition;
-            for (size_t j = 1; j < points.size(); ++j)
+            path.MoveToPoint(positions[0]);
+            for (size_t j = 1; j < positions.size(); ++j)
             {
-                value = points[j]->GetValue();
-                lastPosition =  m_grid.GetMapping().GetWindowPosition(value.m_x,value.m_y );
-                path.AddLineToPoint(lastPosition);
+                path.AddLineToPoint(positions[j]);
             }
-            path.AddLineToPoint(firstPosition);
+            path.AddLineToPoint(positions[0]);
 
             wxBrush brush(m_datasets[i]->GetLineColor());
             gc.SetBrush(brush);
@@ -385,10 +294,11 @@ void wxAreaChart::DoDraw(wxGraphicsContext &gc,
 
         if (m_datasets[i]->ShowDots())
         {
-            for (size_t j = 0; j < points.size(); ++j)
-            {
-                points[j]->Draw(gc);
-            }
+            // All the points of the dataset are drawn as
+            // a single path
+            wxChartPoint::DrawAll(gc, positions, m_options.GetDotRadius(),
+                wxChartPointOptions(m_options.GetDotStrokeWidth(),
+                    m_datasets[i]->GetDotColor(), m_datasets[i]->GetDotColor()));
         }
     }
 
@@ -400,15 +310,27 @@ void wxAreaChart::DoDraw(wxGraphicsContext &gc,
 
 wxSharedPtr<wxVector<const wxChartElement*> > wxAreaChart::GetActiveElements(const wxPoint &point)
 {
+    m_activePoints.Begin();
     wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
+    wxDouble range = m_options.GetHitDetectionRange();
+    wxVector<size_t> candidates;
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        const wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        candidates.clear();
+        points.FindInXRange(point.x - range, point.x + range, candidates);
+        for (size_t j = 0; j < candidates.size(); ++j)
         {
-            if (points[j]->HitTest(point))
+            wxDouble distance = (point.x - points.GetPosition(candidates[j]).m_x);
+            if (distance < 0)
+            {
+                distance = -distance;
+            }
+            if (distance < range)
             {
-                activeElements->push_back(points[j].get());
+                const Point::ptr &activePoint = m_activePoints.Add(i, candidates[j],
+                    [&]() { return CreatePoint(*m_datasets[i], candidates[j]); });
+                activeElements->push_back(activePoint.get());
             }
         }
     }
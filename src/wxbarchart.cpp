@@ -35,16 +35,15 @@
 #include "wxchartstheme.h"
 #include "wxchartcategoricalaxis.h"
 #include "wxchartnumericalaxis.h"
+#include "wxchartutilities.h"
 #include <sstream>
 
 wxBarChart::Bar::Bar(wxDouble value,
                      const wxChartTooltipProvider::ptr tooltipProvider,
                      wxDouble x,
                      wxDouble y,
-                     const wxColor &fillColor,
-                     const wxColor &strokeColor,
-                     int directions)
-    : wxChartRectangle(x, y, tooltipProvider, wxChartRectangleOptions(fillColor, strokeColor, directions)),
+                     const wxChartRectangleOptions &options)
+    : wxChartRectangle(x, y, tooltipProvider, options),
     m_value(value)
 {
 }
@@ -54,10 +53,16 @@ wxDouble wxBarChart::Bar::GetValue() const
     return m_value;
 }
 
-wxBarChart::Dataset::Dataset()
+wxBarChart::Dataset::Dataset(const wxChartRectangleOptions &options)
+    : m_rectangleOptions(options)
 {
 }
 
+const wxChartRectangleOptions& wxBarChart::Dataset::GetRectangleOptions() const
+{
+    return m_rectangleOptions;
+}
+
 const wxVector<wxBarChart::Bar::ptr>& wxBarChart::Dataset::GetBars() const
 {
     return m_bars;
@@ -68,14 +73,20 @@ void wxBarChart::Dataset::AppendBar(Bar::ptr bar)
     m_bars.push_back(bar);
 }
 
+void wxBarChart::Dataset::SetBar(size_t index, Bar::ptr bar)
+{
+    m_bars[index] = bar;
+}
+
 wxBarChart::wxBarChart(wxChartsCategoricalData::ptr &data,
                        const wxSize &size)
     : m_options(wxChartsDefaultTheme->GetBarChartOptions()),
+    m_extents(GetExtents(data->GetDatasets())),
     m_grid(
         wxPoint2DDouble(m_options->GetPadding().GetLeft(), m_options->GetPadding().GetRight()),
         size,
         wxChartCategoricalAxis::make_shared("x", data->GetCategories(), m_options->GetGridOptions().GetXAxisOptions()),
-        wxChartNumericalAxis::make_shared("y", GetMinValue(data->GetDatasets()), GetMaxValue(data->GetDatasets()), m_options->GetGridOptions().GetYAxisOptions()),
+        wxChartNumericalAxis::make_shared("y", m_extents.m_minValue, m_extents.m_maxValue, m_options->GetGridOptions().GetYAxisOptions()),
         m_options->GetGridOptions()
     )
 {
@@ -86,11 +97,12 @@ wxBarChart::wxBarChart(wxChartsCategoricalData::ptr &data,
                        wxSharedPtr<wxBarChartOptions> options,
                        const wxSize &size)
     : m_options(options),
+    m_extents(GetExtents(data->GetDatasets())),
     m_grid(
         wxPoint2DDouble(m_options->GetPadding().GetLeft(), m_options->GetPadding().GetRight()),
         size,
         wxChartCategoricalAxis::make_shared("x", data->GetCategories(), m_options->GetGridOptions().GetXAxisOptions()),
-        wxChartNumericalAxis::make_shared("y", GetMinValue(data->GetDatasets()), GetMaxValue(data->GetDatasets()), m_options->GetGridOptions().GetYAxisOptions()),
+        wxChartNumericalAxis::make_shared("y", m_extents.m_minValue, m_extents.m_maxValue, m_options->GetGridOptions().GetYAxisOptions()),
         m_options->GetGridOptions()
         )
 {
@@ -104,79 +116,80 @@ const wxChartCommonOptions& wxBarChart::GetCommonOptions() const
 
 void wxBarChart::Initialize(wxChartsCategoricalData::ptr &data)
 {
-    const wxVector<wxChartsDoubleDataset::ptr>& datasets = data->GetDatasets();
-    for (size_t i = 0; i < datasets.size(); ++i)
+    for (size_t i = 0; i < data->GetDatasets().size(); ++i)
     {
-        const wxChartsDoubleDataset& dataset = *datasets[i];
-        Dataset::ptr newDataset(new Dataset());
-
-        const wxVector<wxDouble>& datasetData = dataset.GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << datasetData[j];
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic(data->GetCategories()[j], tooltip.str(), dataset.GetFillColor())
-                );
-
-            newDataset->AppendBar(Bar::ptr(new Bar(
-                datasetData[j], tooltipProvider, 25, 50, dataset.GetFillColor(),
-                dataset.GetStrokeColor(), wxTOP | wxRIGHT | wxBOTTOM
-                )));
-        }
-
-        m_datasets.push_back(newDataset);
+        m_datasets.push_back(CreateDataset(*data, i));
     }
 }
 
-wxDouble wxBarChart::GetMinValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets)
+void wxBarChart::OnValueChanged(const wxChartsCategoricalData &data,
+                                size_t datasetIndex,
+                                size_t index,
+                                wxDouble oldValue)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
+    // Only the bar of the value is replaced and, unless
+    // the axis changes, laid out again
+    DeactivateElements();
+    m_datasets[datasetIndex]->SetBar(index, CreateBar(data, datasetIndex, index,
+        m_datasets[datasetIndex]->GetRectangleOptions()));
+
+    wxDouble value = data.GetDatasets()[datasetIndex]->GetData()[index];
+    bool upToDate = wxChartUtilities::ReplaceInExtents(oldValue, value, m_extents.m_minValue, m_extents.m_maxValue);
+    if (!UpdateValueAxis(data, !upToDate))
+    {
+        FitBar(datasetIndex, index, GetBarHeight());
+    }
+}
 
-    for (size_t i = 0; i < datasets.size(); ++i)
+void wxBarChart::OnCategoryAppended(const wxChartsCategoricalData &data)
+{
+    size_t index = data.GetCategories().size() - 1;
+    bool found = (index > 0);
+    for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<wxDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j];
-                foundValue = true;
-            }
-            else if (result > values[j])
-            {
-                result = values[j];
-            }
-        }
+        m_datasets[i]->AppendBar(CreateBar(data, i, index,
+            m_datasets[i]->GetRectangleOptions()));
+        wxChartUtilities::UpdateExtents(&data.GetDatasets()[i]->GetData()[index], 1, 1,
+            found, m_extents.m_minValue, m_extents.m_maxValue);
     }
 
-    return result;
+    m_grid.ChangeLabels("x", data.GetCategories(), m_options->GetGridOptions().GetXAxisOptions());
+    UpdateValueAxis(data, false);
+    InvalidateFit();
 }
 
-wxDouble wxBarChart::GetMaxValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets)
+void wxBarChart::OnDatasetAdded(const wxChartsCategoricalData &data,
+                                size_t datasetIndex)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
+    m_datasets.insert(m_datasets.begin() + datasetIndex, CreateDataset(data, datasetIndex));
+
+    bool found = ((m_datasets.size() > 1) && !data.GetCategories().empty());
+    wxChartUtilities::UpdateExtents(data.GetDatasets()[datasetIndex]->GetData(),
+        found, m_extents.m_minValue, m_extents.m_maxValue);
+    UpdateValueAxis(data, false);
+    // The height of all the bars changes
+    InvalidateFit();
+}
+
+void wxBarChart::OnDatasetRemoved(const wxChartsCategoricalData &data,
+                                  size_t datasetIndex)
+{
+    DeactivateElements();
+    m_datasets.erase(m_datasets.begin() + datasetIndex);
+    UpdateValueAxis(data, true);
+    InvalidateFit();
+}
 
+wxBarChart::Extents wxBarChart::GetExtents(const wxVector<wxChartsDoubleDataset::ptr>& datasets)
+{
+    Extents extents = { 0, 0 };
+    bool foundValue = false;
     for (size_t i = 0; i < datasets.size(); ++i)
     {
-        const wxVector<wxDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j];
-                foundValue = true;
-            }
-            else if (result < values[j])
-            {
-                result = values[j];
-            }
-        }
+        wxChartUtilities::UpdateExtents(datasets[i]->GetData(), foundValue,
+            extents.m_minValue, extents.m_maxValue);
     }
-
-    return result;
+    return extents;
 }
 
 void wxBarChart::DoSetSize(const wxSize &size)
@@ -194,22 +207,9 @@ void wxBarChart::DoFit()
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetBars().size(); ++j)
+        for (size_t j = 0; j < m_datasets[i]->GetBars().size(); ++j)
         {
-            Bar& bar = *(currentDataset.GetBars()[j]);
-
-            wxPoint2DDouble upperLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j + 1);
-            upperLeftCornerPosition.m_y += m_options->GetBarSpacing() + (i * (barHeight + m_options->GetDatasetSpacing()));
-
-            wxPoint2DDouble bottomLeftCornerPosition = upperLeftCornerPosition;
-            bottomLeftCornerPosition.m_y += barHeight;
-
-            wxPoint2DDouble upperRightCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j + 1, bar.GetValue());
-
-            bar.SetPosition(upperLeftCornerPosition);
-            bar.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
-                bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y);
+            FitBar(i, j, barHeight);
         }
     }
 }
@@ -217,18 +217,19 @@ void wxBarChart::DoFit()
 void wxBarChart::DoDraw(wxGraphicsContext &gc,
                         bool suppressTooltips)
 {
-    m_grid.Fit(gc);
+    if (m_grid.Fit(gc))
+    {
+        InvalidateFit();
+    }
     m_grid.Draw(gc);
 
     Fit();
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetBars().size(); ++j)
-        {
-            currentDataset.GetBars()[j]->Draw(gc);
-        }
+        // All the elements of a dataset share the same colors
+        // and are drawn with a single fill and stroke
+        wxChartRectangle::DrawAll(gc, m_datasets[i]->GetBars());
     }
 
     if (!suppressTooltips)
@@ -261,7 +262,80 @@ wxSharedPtr<wxVector<const wxChartElement*> > wxBarChart::GetActiveElements(cons
 
 wxDouble wxBarChart::GetBarHeight() const
 {
+    if (m_datasets.empty())
+    {
+        return 0;
+    }
+
     wxDouble availableHeight = m_grid.GetMapping().GetXAxis().GetDistanceBetweenTickMarks() -
         (2 * m_options->GetBarSpacing()) - ((m_datasets.size() - 1) * m_options->GetDatasetSpacing());
     return (availableHeight / m_datasets.size());
 }
+
+wxBarChart::Bar::ptr wxBarChart::CreateBar(const wxChartsCategoricalData &data,
+                                           size_t datasetIndex,
+                                           size_t index,
+                                           const wxChartRectangleOptions &options) const
+{
+    const wxChartsDoubleDataset& dataset = *data.GetDatasets()[datasetIndex];
+    wxDouble value = dataset.GetData()[index];
+
+    std::stringstream tooltip;
+    tooltip << value;
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderStatic(data.GetCategories()[index], tooltip.str(), dataset.GetFillColor())
+        );
+
+    return Bar::ptr(new Bar(value, tooltipProvider, 25, 50, options));
+}
+
+wxBarChart::Dataset::ptr wxBarChart::CreateDataset(const wxChartsCategoricalData &data,
+                                                   size_t datasetIndex) const
+{
+    // The pen and brush are shared by all the bars of the dataset
+    const wxChartsDoubleDataset& dataset = *data.GetDatasets()[datasetIndex];
+    Dataset::ptr newDataset(new Dataset(wxChartRectangleOptions(dataset.GetFillColor(),
+        dataset.GetStrokeColor(), wxTOP | wxRIGHT | wxBOTTOM)));
+    const wxVector<wxDouble>& datasetData = dataset.GetData();
+    for (size_t j = 0; j < datasetData.size(); ++j)
+    {
+        newDataset->AppendBar(CreateBar(data, datasetIndex, j,
+            newDataset->GetRectangleOptions()));
+    }
+    return newDataset;
+}
+
+void wxBarChart::FitBar(size_t datasetIndex,
+                        size_t index,
+                        wxDouble barHeight)
+{
+    Bar& bar = *(m_datasets[datasetIndex]->GetBars()[index]);
+
+    wxPoint2DDouble upperLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(index + 1);
+    upperLeftCornerPosition.m_y += m_options->GetBarSpacing() + (datasetIndex * (barHeight + m_options->GetDatasetSpacing()));
+
+    wxPoint2DDouble bottomLeftCornerPosition = upperLeftCornerPosition;
+    bottomLeftCornerPosition.m_y += barHeight;
+
+    wxPoint2DDouble upperRightCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(index + 1, bar.GetValue());
+
+    bar.SetPosition(upperLeftCornerPosition);
+    bar.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
+        bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y);
+}
+
+bool wxBarChart::UpdateValueAxis(const wxChartsCategoricalData &data,
+                                 bool recompute)
+{
+    if (recompute)
+    {
+        m_extents = GetExtents(data.GetDatasets());
+    }
+
+    if (m_grid.UpdateAxisLimit("y", m_extents.m_minValue, m_extents.m_maxValue))
+    {
+        InvalidateFit();
+        return true;
+    }
+    return false;
+}
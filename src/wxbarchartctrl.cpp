@@ -40,8 +40,10 @@ wxBarChartCtrl::wxBarChartCtrl(wxWindow *parent,
                                const wxSize &size,
                                long style)
     : wxChartCtrl(parent, id, pos, size, style), 
+    m_data(data),
     m_barChart(data, size)
 {
+    m_data->AddObserver(this);
 }
 
 wxBarChartCtrl::wxBarChartCtrl(wxWindow *parent, 
@@ -52,11 +54,47 @@ wxBarChartCtrl::wxBarChartCtrl(wxWindow *parent,
                                const wxSize &size, 
                                long style)
     : wxChartCtrl(parent, id, pos, size, style), 
+    m_data(data),
     m_barChart(data, options, size)
 {
+    m_data->AddObserver(this);
+}
+
+wxBarChartCtrl::~wxBarChartCtrl()
+{
+    m_data->RemoveObserver(this);
 }
 
 wxBarChart& wxBarChartCtrl::GetChart()
 {
     return m_barChart;
 }
+
+void wxBarChartCtrl::OnValueChanged(const wxChartsCategoricalData &data,
+                                    size_t datasetIndex,
+                                    size_t index,
+                                    wxDouble oldValue)
+{
+    m_barChart.OnValueChanged(data, datasetIndex, index, oldValue);
+    Refresh();
+}
+
+void wxBarChartCtrl::OnCategoryAppended(const wxChartsCategoricalData &data)
+{
+    m_barChart.OnCategoryAppended(data);
+    Refresh();
+}
+
+void wxBarChartCtrl::OnDatasetAdded(const wxChartsCategoricalData &data,
+                                    size_t datasetIndex)
+{
+    m_barChart.OnDatasetAdded(data, datasetIndex);
+    Refresh();
+}
+
+void wxBarChartCtrl::OnDatasetRemoved(const wxChartsCategoricalData &data,
+                                      size_t datasetIndex)
+{
+    m_barChart.OnDatasetRemoved(data, datasetIndex);
+    Refresh();
+}
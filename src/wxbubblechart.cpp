@@ -23,6 +23,7 @@
 /// @file
 
 #include "wxbubblechart.h"
+#include "wxchartutilities.h"
 #include <sstream>
 #include <cmath>
 
@@ -127,14 +128,14 @@ unsigned int wxBubbleChart::Dataset::GetMaxRadius() const
 
 wxBubbleChart::wxBubbleChart(const wxBubbleChartData &data, 
                              const wxSize &size)
-    : m_grid(
+    : m_extents(GetExtents(data.GetDatasets())),
+    m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
-        GetMinXValue(data.GetDatasets()), GetMaxXValue(data.GetDatasets()),
-        GetMinYValue(data.GetDatasets()), GetMaxYValue(data.GetDatasets()),
+        m_extents.m_minX, m_extents.m_maxX,
+        m_extents.m_minY, m_extents.m_maxY,
         m_options.GetGridOptions()
-        ),
-    m_minZValue(GetMinZValue(data.GetDatasets())), m_maxZValue(GetMaxZValue(data.GetDatasets()))
+        )
 {
     Initialize(data);
 }
@@ -173,159 +174,27 @@ void wxBubbleChart::Initialize(const wxBubbleChartData &data)
     }
 }
 
-wxDouble wxBubbleChart::GetMinXValue(const wxVector<wxBubbleChartDataset::ptr>& datasets)
+wxBubbleChart::Extents wxBubbleChart::GetExtents(const wxVector<wxBubbleChartDataset::ptr>& datasets)
 {
-    wxDouble result = 0;
+    Extents extents = { 0, 0, 0, 0, 0, 0 };
     bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxDoubleTriplet>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_x;
-                foundValue = true;
-            }
-            else if (result > values[j].m_x)
-            {
-                result = values[j].m_x;
-            }
-        }
-    }
-
-    return result;
-}
-
-wxDouble wxBubbleChart::GetMaxXValue(const wxVector<wxBubbleChartDataset::ptr>& datasets)
-{
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxDoubleTriplet>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_x;
-                foundValue = true;
-            }
-            else if (result < values[j].m_x)
-            {
-                result = values[j].m_x;
-            }
-        }
-    }
-
-    return result;
-}
-
-wxDouble wxBubbleChart::GetMinYValue(const wxVector<wxBubbleChartDataset::ptr>& datasets)
-{
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxDoubleTriplet>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_y;
-                foundValue = true;
-            }
-            else if (result > values[j].m_y)
-            {
-                result = values[j].m_y;
-            }
-        }
-    }
-
-    return result;
-}
-
-wxDouble wxBubbleChart::GetMaxYValue(const wxVector<wxBubbleChartDataset::ptr>& datasets)
-{
-    wxDouble result = 0;
-    bool foundValue = false;
-
     for (size_t i = 0; i < datasets.size(); ++i)
     {
         const wxVector<wxDoubleTriplet>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
+        if (!values.empty())
         {
-            if (!foundValue)
-            {
-                result = values[j].m_y;
-                foundValue = true;
-            }
-            else if (result < values[j].m_y)
-            {
-                result = values[j].m_y;
-            }
+            wxChartUtilities::UpdateExtents(&values[0], values.size(),
+                &wxDoubleTriplet::m_x, &wxDoubleTriplet::m_y, &wxDoubleTriplet::m_z, foundValue,
+                extents.m_minX, extents.m_maxX, extents.m_minY, extents.m_maxY,
+                extents.m_minZ, extents.m_maxZ);
         }
     }
-
-    return result;
-}
-
-wxDouble wxBubbleChart::GetMinZValue(const wxVector<wxBubbleChartDataset::ptr>& datasets)
-{
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxDoubleTriplet>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_z;
-                foundValue = true;
-            }
-            else if (result > values[j].m_z)
-            {
-                result = values[j].m_z;
-            }
-        }
-    }
-
-    return result;
-}
-
-wxDouble wxBubbleChart::GetMaxZValue(const wxVector<wxBubbleChartDataset::ptr>& datasets)
-{
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxDoubleTriplet>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_z;
-                foundValue = true;
-            }
-            else if (result < values[j].m_z)
-            {
-                result = values[j].m_z;
-            }
-        }
-    }
-
-    return result;
+    return extents;
 }
 
 void wxBubbleChart::DoFit()
 {
-    wxDouble zFactor = 1 / (m_maxZValue - m_minZValue);
+    wxDouble zFactor = 1 / (m_extents.m_maxZ - m_extents.m_minZ);
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
@@ -25,6 +25,7 @@
 #include "wxcandlestickchart.h"
 #include "wxchartcategoricalaxis.h"
 #include "wxchartnumericalaxis.h"
+#include "wxchartutilities.h"
 #include <wx/brush.h>
 #include <wx/pen.h>
 #include <sstream>
@@ -72,82 +73,33 @@ const wxVector<wxChartOHLCData>& wxCandlestickChartData::GetData() const
     return m_data;
 }
 
-wxCandlestickChart::Candlestick::Candlestick(const wxChartOHLCData &data,
-    const wxColor &lineColor,
-    unsigned int lineWidth,
-    const wxColor &upFillColor,
-    const wxColor &downFillColor,
-    unsigned int rectangleWidth,
-    const wxChartTooltipProvider::ptr tooltipProvider)
-    : wxChartElement(tooltipProvider), m_data(data), m_lowPoint(0, 0), m_highPoint(0, 0),
-    m_openPoint(0, 0), m_closePoint(0, 0), m_lineColor(lineColor), m_lineWidth(lineWidth),
-    m_upFillColor(upFillColor), m_downFillColor(downFillColor), m_rectangleWidth(rectangleWidth)
+const wxCandlestickChartData::TooltipFormatter& wxCandlestickChartData::GetTooltipFormatter() const
 {
+    return m_tooltipFormatter;
 }
 
-void wxCandlestickChart::Candlestick::Draw(wxGraphicsContext &gc) const
+void wxCandlestickChartData::SetTooltipFormatter(const TooltipFormatter &formatter)
 {
-    if (m_data.GetCloseValue() >= m_data.GetOpenValue())
-    {
-        wxGraphicsPath path = gc.CreatePath();
-        path.MoveToPoint(m_highPoint);
-        path.AddLineToPoint(m_closePoint);
-
-        wxDouble halfWidth = m_rectangleWidth / 2;
-        wxDouble rectangleHeight = m_openPoint.m_y - m_closePoint.m_y;
-        if (rectangleHeight < 2)
-        {
-            rectangleHeight = 2;
-        }
-        path.AddRectangle(m_closePoint.m_x - halfWidth, m_closePoint.m_y,
-            m_rectangleWidth, rectangleHeight);
-
-        path.MoveToPoint(m_openPoint);
-        path.AddLineToPoint(m_lowPoint);
-
-        wxBrush brush(m_upFillColor);
-        gc.SetBrush(brush);
-        gc.FillPath(path);
-
-        wxPen pen(m_lineColor, m_lineWidth);
-        gc.SetPen(pen);
-
-        gc.StrokePath(path);
-    }
-    else
-    {
-        wxGraphicsPath path = gc.CreatePath();
-        path.MoveToPoint(m_highPoint);
-        path.AddLineToPoint(m_openPoint);
-
-        wxDouble halfWidth = m_rectangleWidth / 2;
-        wxDouble rectangleHeight = m_closePoint.m_y - m_openPoint.m_y;
-        if (rectangleHeight < 2)
-        {
-            rectangleHeight = 2;
-        }
-        path.AddRectangle(m_openPoint.m_x - halfWidth, m_openPoint.m_y,
-            m_rectangleWidth, rectangleHeight);
-
-        path.MoveToPoint(m_closePoint);
-        path.AddLineToPoint(m_lowPoint);
-
-        wxBrush brush(m_downFillColor);
-        gc.SetBrush(brush);
-        gc.FillPath(path);
+    m_tooltipFormatter = formatter;
+}
 
-        wxPen pen(m_lineColor, m_lineWidth);
-        gc.SetPen(pen);
+wxCandlestickChart::Candlestick::Candlestick(const wxChartOHLCData &data)
+    : m_data(data), m_lowPoint(0, 0), m_highPoint(0, 0),
+    m_openPoint(0, 0), m_closePoint(0, 0)
+{
+}
 
-        gc.StrokePath(path);
-    }
+const wxChartOHLCData& wxCandlestickChart::Candlestick::GetData() const
+{
+    return m_data;
 }
 
-bool wxCandlestickChart::Candlestick::HitTest(const wxPoint &point) const
+bool wxCandlestickChart::Candlestick::HitTest(const wxPoint &point,
+                                              wxDouble rectangleWidth) const
 {
     return ((point.y <= m_lowPoint.m_y) && (point.y >= m_highPoint.m_y) &&
-        (point.x >= (m_lowPoint.m_x - (m_rectangleWidth / 2))) &&
-        (point.x <= (m_lowPoint.m_x + (m_rectangleWidth / 2))));
+        (point.x >= (m_lowPoint.m_x - (rectangleWidth / 2))) &&
+        (point.x <= (m_lowPoint.m_x + (rectangleWidth / 2))));
 }
 
 wxPoint2DDouble wxCandlestickChart::Candlestick::GetTooltipPosition() const
@@ -164,37 +116,86 @@ void wxCandlestickChart::Candlestick::Update(const wxChartGridMapping& mapping,
     m_closePoint = mapping.GetWindowPositionAtTickMark(index, m_data.GetCloseValue());
 }
 
+bool wxCandlestickChart::Candlestick::IsUp() const
+{
+    return (m_data.GetCloseValue() >= m_data.GetOpenValue());
+}
+
+void wxCandlestickChart::Candlestick::AddToPath(wxGraphicsPath &path,
+                                                wxDouble rectangleWidth) const
+{
+    // The body goes from the open value to the close value,
+    // whichever is higher on the screen
+    const wxPoint2DDouble& top = IsUp() ? m_closePoint : m_openPoint;
+    const wxPoint2DDouble& bottom = IsUp() ? m_openPoint : m_closePoint;
+
+    path.MoveToPoint(m_highPoint);
+    path.AddLineToPoint(top);
+
+    wxDouble halfWidth = rectangleWidth / 2;
+    wxDouble rectangleHeight = bottom.m_y - top.m_y;
+    if (rectangleHeight < 2)
+    {
+        rectangleHeight = 2;
+    }
+    path.AddRectangle(top.m_x - halfWidth, top.m_y,
+        rectangleWidth, rectangleHeight);
+
+    path.MoveToPoint(bottom);
+    path.AddLineToPoint(m_lowPoint);
+}
+
+wxCandlestickChart::ActiveCandlestick::ActiveCandlestick(const Candlestick &candlestick,
+                                                         const wxCandlestickChart &chart,
+                                                         const wxChartTooltipProvider::ptr tooltipProvider)
+    : wxChartElement(tooltipProvider), m_candlestick(candlestick), m_chart(chart)
+{
+}
+
+void wxCandlestickChart::ActiveCandlestick::Draw(wxGraphicsContext &gc) const
+{
+    wxGraphicsPath path = gc.CreatePath();
+    m_candlestick.AddToPath(path, m_chart.m_rectangleWidth);
+
+    gc.SetBrush(m_candlestick.IsUp() ? m_chart.m_upBrush : m_chart.m_downBrush);
+    gc.FillPath(path);
+
+    gc.SetPen(m_chart.m_linePen);
+    gc.StrokePath(path);
+}
+
+bool wxCandlestickChart::ActiveCandlestick::HitTest(const wxPoint &point) const
+{
+    return m_candlestick.HitTest(point, m_chart.m_rectangleWidth);
+}
+
+wxPoint2DDouble wxCandlestickChart::ActiveCandlestick::GetTooltipPosition() const
+{
+    return m_candlestick.GetTooltipPosition();
+}
+
 wxCandlestickChart::wxCandlestickChart(const wxCandlestickChartData &data,
                                        const wxSize &size)
-    : m_grid(
+    : m_extents(GetExtents(data)),
+    m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetTop()),
         size,
         wxChartCategoricalAxis::make_shared("x", data.GetLabels(), m_options.GetGridOptions().GetXAxisOptions()),
-        wxChartNumericalAxis::make_shared("y", GetMinValue(data), GetMaxValue(data), m_options.GetGridOptions().GetYAxisOptions()),
+        wxChartNumericalAxis::make_shared("y", m_extents.m_minValue, m_extents.m_maxValue, m_options.GetGridOptions().GetYAxisOptions()),
         m_options.GetGridOptions()
-        )
+        ),
+    m_labels(data.GetLabels()), m_tooltipFormatter(data.GetTooltipFormatter()),
+    m_rectangleWidth(data.GetRectangleWidth()),
+    m_linePen(data.GetLineColor(), data.GetLineWidth()),
+    m_upBrush(data.GetUpFillColor()), m_downBrush(data.GetDownFillColor())
 {
+    // Only the values and the positions are kept for each
+    // candlestick, the elements with their tooltips are
+    // created when the candlesticks become active
+    m_data.reserve(data.GetData().size());
     for (size_t i = 0; i < data.GetData().size(); ++i)
     {
-        std::stringstream tooltip;
-        tooltip << "O: " << data.GetData()[i].GetOpenValue()
-            << "\r\nH: " << data.GetData()[i].GetHighValue()
-            << "\r\nL: " << data.GetData()[i].GetLowValue()
-            << "\r\nC: " << data.GetData()[i].GetCloseValue();
-        wxChartTooltipProvider::ptr tooltipProvider(
-            new wxChartTooltipProviderStatic(data.GetLabels()[i], tooltip.str(), *wxWHITE)
-            );
-
-        Candlestick::ptr newCandlestick(new Candlestick(
-            data.GetData()[i],
-            data.GetLineColor(),
-            data.GetLineWidth(),
-            data.GetUpFillColor(),
-            data.GetDownFillColor(),
-            data.GetRectangleWidth(),
-            tooltipProvider
-            ));
-        m_data.push_back(newCandlestick);
+        m_data.push_back(Candlestick(data.GetData()[i]));
     }
 }
 
@@ -203,46 +204,17 @@ const wxChartCommonOptions& wxCandlestickChart::GetCommonOptions() const
     return m_options.GetCommonOptions();
 }
 
-wxDouble wxCandlestickChart::GetMinValue(const wxCandlestickChartData &data)
+wxCandlestickChart::Extents wxCandlestickChart::GetExtents(const wxCandlestickChartData &data)
 {
-    wxDouble result = 0;
+    Extents extents = { 0, 0 };
     bool foundValue = false;
-
-    for (size_t i = 0; i < data.GetData().size(); ++i)
+    if (!data.GetData().empty())
     {
-        if (!foundValue)
-        {
-            result = data.GetData()[i].GetLowValue();
-            foundValue = true;
-        }
-        else if (result > data.GetData()[i].GetLowValue())
-        {
-            result = data.GetData()[i].GetLowValue();
-        }
+        wxChartUtilities::UpdateExtents(&data.GetData()[0], data.GetData().size(),
+            &wxChartOHLCData::GetLowValue, &wxChartOHLCData::GetHighValue,
+            foundValue, extents.m_minValue, extents.m_maxValue);
     }
-
-    return result;
-}
-
-wxDouble wxCandlestickChart::GetMaxValue(const wxCandlestickChartData &data)
-{
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < data.GetData().size(); ++i)
-    {
-        if (!foundValue)
-        {
-            result = data.GetData()[i].GetHighValue();
-            foundValue = true;
-        }
-        else if (result < data.GetData()[i].GetHighValue())
-        {
-            result = data.GetData()[i].GetHighValue();
-        }
-    }
-
-    return result;
+    return extents;
 }
 
 void wxCandlestickChart::DoSetSize(const wxSize &size)
@@ -258,23 +230,40 @@ void wxCandlestickChart::DoFit()
 {
     for (size_t i = 0; i < m_data.size(); ++i)
     {
-        m_data[i]->Update(m_grid.GetMapping(), i);
+        m_data[i].Update(m_grid.GetMapping(), i);
     }
 }
 
 void wxCandlestickChart::DoDraw(wxGraphicsContext &gc,
                                 bool suppressTooltips)
 {
+    // The chart is only redrawn when the data or the layout
+    // changed, in which case the active candlesticks are stale
+    m_activeCandlesticks.Invalidate();
+
     m_grid.Fit(gc);
     m_grid.Draw(gc);
 
     Fit();
 
+    // The candlesticks are split in two paths based on
+    // their fill color
+    wxGraphicsPath upPath = gc.CreatePath();
+    wxGraphicsPath downPath = gc.CreatePath();
     for (size_t i = 0; i < m_data.size(); ++i)
     {
-        m_data[i]->Draw(gc);
+        m_data[i].AddToPath(m_data[i].IsUp() ? upPath : downPath, m_rectangleWidth);
     }
 
+    gc.SetBrush(m_upBrush);
+    gc.FillPath(upPath);
+    gc.SetBrush(m_downBrush);
+    gc.FillPath(downPath);
+
+    gc.SetPen(m_linePen);
+    gc.StrokePath(upPath);
+    gc.StrokePath(downPath);
+
     if (!suppressTooltips)
     {
         DrawTooltips(gc);
@@ -283,13 +272,46 @@ void wxCandlestickChart::DoDraw(wxGraphicsContext &gc,
 
 wxSharedPtr<wxVector<const wxChartElement*> > wxCandlestickChart::GetActiveElements(const wxPoint &point)
 {
+    m_activeCandlesticks.Begin();
     wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
     for (size_t i = 0; i < m_data.size(); ++i)
     {
-        if (m_data[i]->HitTest(point))
+        if (m_data[i].HitTest(point, m_rectangleWidth))
         {
-            activeElements->push_back(m_data[i].get());
+            const ActiveCandlestick::ptr &candlestick = m_activeCandlesticks.Add(0, i,
+                [&]() { return CreateActiveCandlestick(i); });
+            activeElements->push_back(candlestick.get());
         }
     }
     return activeElements;
 }
+
+wxCandlestickChart::ActiveCandlestick::ptr wxCandlestickChart::CreateActiveCandlestick(size_t index) const
+{
+    wxString title = (index < m_labels.size()) ? m_labels[index] : wxString();
+    const wxChartOHLCData& ohlc = m_data[index].GetData();
+    wxCandlestickChartData::TooltipFormatter formatter = m_tooltipFormatter;
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderLazy(
+            [title]() -> wxString
+            {
+                return title;
+            },
+            [formatter, ohlc]() -> wxString
+            {
+                if (formatter)
+                {
+                    return formatter(ohlc);
+                }
+                std::stringstream tooltip;
+                tooltip << "O: " << ohlc.GetOpenValue()
+                    << "\r\nH: " << ohlc.GetHighValue()
+                    << "\r\nL: " << ohlc.GetLowValue()
+                    << "\r\nC: " << ohlc.GetCloseValue();
+                return tooltip.str();
+            },
+            *wxWHITE)
+        );
+
+    return ActiveCandlestick::ptr(new ActiveCandlestick(m_data[index], *this, tooltipProvider));
+}
@@ -21,12 +21,11 @@
 */
 
 #include "wxchart.h"
-#include "wxcharttooltip.h"
-#include "wxchartmultitooltip.h"
 
 wxChart::wxChart()
     : m_needsFit(true),
-    m_activeElements(new wxVector<const wxChartElement*>())
+    m_activeElements(new wxVector<const wxChartElement*>()),
+    m_tooltipsValid(false)
 {
 }
 
@@ -38,12 +37,102 @@ void wxChart::SetSize(const wxSize &size)
 
 void wxChart::Draw(wxGraphicsContext &gc)
 {
+    // The chart is only redrawn if something changed, which
+    // may also affect the position or the text of the tooltips
+    m_tooltipsValid = false;
     DoDraw(gc, false);
 }
 
-void wxChart::ActivateElementsAt(const wxPoint &point)
+void wxChart::DrawChartLayer(wxGraphicsContext &gc)
 {
-    m_activeElements = GetActiveElements(point);
+    m_tooltipsValid = false;
+    DoDraw(gc, true);
+}
+
+void wxChart::DrawTooltipLayer(wxGraphicsContext &gc)
+{
+    DrawTooltips(gc);
+}
+
+wxRect wxChart::GetTooltipLayerBounds(wxGraphicsContext &gc)
+{
+    wxChartInstrumentation::Scope scope(m_instrumentation, wxCHARTSTAGE_TOOLTIPS);
+    CreateTooltips();
+    if (m_tooltip)
+    {
+        m_tooltip->Fit(gc);
+        return m_tooltip->GetBounds();
+    }
+    else if (m_multiTooltip)
+    {
+        m_multiTooltip->Fit(gc);
+        return m_multiTooltip->GetBounds();
+    }
+    return wxRect();
+}
+
+bool wxChart::ActivateElementsAt(const wxPoint &point)
+{
+    wxChartInstrumentation::Scope scope(m_instrumentation, wxCHARTSTAGE_HITTEST);
+    wxSharedPtr<wxVector<const wxChartElement*> > activeElements = GetActiveElements(point);
+
+    bool changed = (activeElements->size() != m_activeElements->size());
+    for (size_t i = 0; !changed && (i < activeElements->size()); ++i)
+    {
+        changed = ((*activeElements)[i] != (*m_activeElements)[i]);
+    }
+
+    m_activeElements = activeElements;
+    if (changed)
+    {
+        m_tooltipsValid = false;
+    }
+    return changed;
+}
+
+bool wxChart::RenderTo(wxImage &image, const wxSize &size)
+{
+    if ((size.GetWidth() <= 0) || (size.GetHeight() <= 0))
+    {
+        return false;
+    }
+
+    image.Create(size.GetWidth(), size.GetHeight());
+    image.SetRGB(wxRect(0, 0, size.GetWidth(), size.GetHeight()), 255, 255, 255);
+
+    // The drawing is only copied to the image when
+    // the graphics context is destroyed
+    wxGraphicsContext* gc = wxGraphicsContext::Create(image);
+    if (!gc)
+    {
+        return false;
+    }
+    DoDraw(*gc, true);
+    delete gc;
+    m_instrumentation.EndFrame();
+
+    return true;
+}
+
+void wxChart::Save(const wxString &filename,
+                   const wxBitmapType &type,
+                   const wxSize &size)
+{
+    wxImage image;
+    if (RenderTo(image, size))
+    {
+        image.SaveFile(filename, type);
+    }
+}
+
+wxChartInstrumentation& wxChart::GetInstrumentation()
+{
+    return m_instrumentation;
+}
+
+const wxChartInstrumentation& wxChart::GetInstrumentation() const
+{
+    return m_instrumentation;
 }
 
 void wxChart::Fit()
@@ -53,31 +142,64 @@ void wxChart::Fit()
         return;
     }
 
+    wxChartInstrumentation::Scope scope(m_instrumentation, wxCHARTSTAGE_FIT);
     DoFit();
 
     m_needsFit = false;
 }
 
+void wxChart::InvalidateFit()
+{
+    m_needsFit = true;
+}
+
+void wxChart::DeactivateElements()
+{
+    m_activeElements.reset(new wxVector<const wxChartElement*>());
+    m_tooltipsValid = false;
+}
+
 void wxChart::DrawTooltips(wxGraphicsContext &gc)
 {
+    wxChartInstrumentation::Scope scope(m_instrumentation, wxCHARTSTAGE_TOOLTIPS);
+    CreateTooltips();
+    if (m_tooltip)
+    {
+        m_tooltip->Draw(gc);
+    }
+    else if (m_multiTooltip)
+    {
+        m_multiTooltip->Draw(gc);
+    }
+}
+
+void wxChart::CreateTooltips()
+{
+    if (m_tooltipsValid)
+    {
+        return;
+    }
+
+    m_tooltip.reset();
+    m_multiTooltip.reset();
     if (m_activeElements->size() == 1)
     {
         // If only one element is active draw a normal tooltip
-        wxChartTooltip tooltip((*m_activeElements)[0]->GetTooltipPosition(),
-            (*m_activeElements)[0]->GetTooltipProvider()->GetTooltipText());
-        tooltip.Draw(gc);
+        m_tooltip.reset(new wxChartTooltip((*m_activeElements)[0]->GetTooltipPosition(),
+            (*m_activeElements)[0]->GetTooltipProvider()->GetTooltipText()));
     }
     else if (m_activeElements->size() > 1)
     {
         // If more than one element is active draw a multi-tooltip
-        wxChartMultiTooltip multiTooltip((*m_activeElements)[0]->GetTooltipProvider()->GetTooltipTitle(),
-            GetCommonOptions().GetMultiTooltipOptions());
+        m_multiTooltip.reset(new wxChartMultiTooltip((*m_activeElements)[0]->GetTooltipProvider()->GetTooltipTitle(),
+            GetCommonOptions().GetMultiTooltipOptions()));
         for (size_t j = 0; j < m_activeElements->size(); ++j)
         {
             wxChartTooltip tooltip((*m_activeElements)[j]->GetTooltipPosition(),
                 (*m_activeElements)[j]->GetTooltipProvider());
-            multiTooltip.AddTooltip(tooltip);
+            m_multiTooltip->AddTooltip(tooltip);
         }
-        multiTooltip.Draw(gc);
     }
+
+    m_tooltipsValid = true;
 }
@@ -127,6 +127,11 @@ wxPoint2DDouble wxChartArc::GetTooltipPosition() const
     return wxPoint2DDouble(x, y);
 }
 
+wxPoint2DDouble wxChartArc::GetCenter() const
+{
+    return wxPoint2DDouble(m_x, m_y);
+}
+
 void wxChartArc::SetCenter(wxDouble x, wxDouble y)
 {
     m_x = x;
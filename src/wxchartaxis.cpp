@@ -33,6 +33,8 @@
 
 #include "wxchartaxis.h"
 #include <wx/pen.h>
+#include <algorithm>
+#include <cmath>
 
 void wxChartAxis::Draw(wxGraphicsContext &gc) const
 {
@@ -76,7 +78,14 @@ void wxChartAxis::Fit(wxPoint2DDouble startPoint,
 
 void wxChartAxis::UpdateLabelSizes(wxGraphicsContext &gc)
 {
-    m_labels.UpdateSizes(gc);
+    if (m_labelGenerator)
+    {
+        CreateLazyLabels(gc);
+    }
+    else
+    {
+        m_labels.UpdateSizes(gc);
+    }
 }
 
 void wxChartAxis::UpdateLabelPositions()
@@ -97,8 +106,43 @@ void wxChartAxis::SetLabels(const wxVector<wxChartLabel> &labels)
     m_labels.assign(labels.begin(), labels.end());
 }
 
+bool wxChartAxis::HasLazyLabels() const
+{
+    return (bool)m_labelGenerator;
+}
+
+void wxChartAxis::AppendTickMarks(size_t count)
+{
+    m_tickMarkCount += count;
+}
+
+void wxChartAxis::RemoveFirstTickMarks(size_t count)
+{
+    count = std::min(count, m_tickMarkCount);
+    m_tickMarkCount -= count;
+    m_removedTickMarks += count;
+}
+
+size_t wxChartAxis::GetNextShownTickMark(size_t index) const
+{
+    if (!m_labelGenerator)
+    {
+        return index;
+    }
+    size_t remainder = (m_removedTickMarks + index) % m_labelStride;
+    return ((remainder == 0) ? index : (index + m_labelStride - remainder));
+}
+
 wxPoint2DDouble wxChartAxis::CalculateLabelPosition(size_t index)
 {
+    // With lazy labels the labels are one every
+    // m_labelStride tick marks
+    size_t tickMark = index;
+    if (m_labelGenerator)
+    {
+        tickMark = GetNextShownTickMark(0) + (index * m_labelStride);
+    }
+
     wxDouble marginCorrection = 0;
     if (m_options.GetStartMarginType() == wxCHARTAXISMARGINTYPE_TICKMARKOFFSET)
     {
@@ -109,7 +153,7 @@ wxPoint2DDouble wxChartAxis::CalculateLabelPosition(size_t index)
         wxDouble distance = GetDistanceBetweenTickMarks();
         wxPoint2DDouble position(
             m_startPoint.m_x - 10 - m_labels[index].GetSize().GetWidth(),
-            m_startPoint.m_y - (distance * index) - (m_labels[index].GetSize().GetHeight() / 2) - marginCorrection
+            m_startPoint.m_y - (distance * tickMark) - (m_labels[index].GetSize().GetHeight() / 2) - marginCorrection
             );
 
         if (m_options.GetLabelType() == wxCHARTAXISLABELTYPE_RANGE)
@@ -123,7 +167,7 @@ wxPoint2DDouble wxChartAxis::CalculateLabelPosition(size_t index)
     {
         wxDouble distance = GetDistanceBetweenTickMarks();
         wxPoint2DDouble position(
-            m_startPoint.m_x + (distance * index) - (m_labels[index].GetSize().GetWidth() / 2) + marginCorrection,
+            m_startPoint.m_x + (distance * tickMark) - (m_labels[index].GetSize().GetWidth() / 2) + marginCorrection,
             m_startPoint.m_y + 8
             );
 
@@ -151,13 +195,14 @@ wxPoint2DDouble wxChartAxis::CalculateLabelPosition(size_t index)
 
 size_t wxChartAxis::GetNumberOfTickMarks() const
 {
+    size_t count = (m_labelGenerator ? m_tickMarkCount : m_labels.size());
     if (m_options.GetLabelType() == wxCHARTAXISLABELTYPE_POINT)
     {
-        return m_labels.size();
+        return count;
     }
     else
     {
-        return (m_labels.size() + 1);
+        return (count + 1);
     }
 }
 
@@ -241,7 +286,8 @@ const wxChartAxisOptions& wxChartAxis::GetOptions() const
 wxChartAxis::wxChartAxis(const std::string &id, 
                          const wxChartAxisOptions &options)
     : m_options(options), m_id(id), 
-    m_startPoint(0, 0), m_endPoint(0, 0)
+    m_startPoint(0, 0), m_endPoint(0, 0), m_tickMarkCount(0),
+    m_removedTickMarks(0), m_labelStride(1)
 {
 }
 
@@ -249,25 +295,31 @@ wxChartAxis::wxChartAxis(const std::string &id,
                          const wxVector<wxString> &labels,
                          const wxChartAxisOptions &options)
     : m_options(options), m_id(id),
-    m_startPoint(0, 0), m_endPoint(0, 0)
+    m_startPoint(0, 0), m_endPoint(0, 0), m_tickMarkCount(0),
+    m_removedTickMarks(0), m_labelStride(1)
 {
     for (size_t i = 0; i < labels.size(); ++i)
     {
-        m_labels.push_back(
-            wxChartLabel(
-                labels[i], 
-                wxChartLabelOptions(m_options.GetFontOptions(), false, wxChartBackgroundOptions(*wxWHITE, 0))
-                )
-            );
+        m_labels.push_back(CreateLabel(labels[i]));
     }
 }
 
+wxChartAxis::wxChartAxis(const std::string &id,
+                         size_t count,
+                         const LabelGenerator &generator,
+                         const wxChartAxisOptions &options)
+    : m_options(options), m_id(id),
+    m_startPoint(0, 0), m_endPoint(0, 0), m_labelGenerator(generator),
+    m_tickMarkCount(count), m_removedTickMarks(0), m_labelStride(1)
+{
+}
+
 void wxChartAxis::DrawTickMarks(wxGraphicsContext &gc) const
 {
     if (m_options.GetPosition() == wxCHARTAXISPOSITION_LEFT)
     {
         size_t n = GetNumberOfTickMarks();
-        for (size_t i = 0; i < n; ++i)
+        for (size_t i = GetNextShownTickMark(0); i < n; i = GetNextShownTickMark(i + 1))
         {
             wxDouble linePositionY = GetTickMarkPosition(i).m_y;
 
@@ -280,7 +332,7 @@ void wxChartAxis::DrawTickMarks(wxGraphicsContext &gc) const
     else if (m_options.GetPosition() == wxCHARTAXISPOSITION_BOTTOM)
     {
         size_t n = GetNumberOfTickMarks();
-        for (size_t i = 0; i < n; ++i)
+        for (size_t i = GetNextShownTickMark(0); i < n; i = GetNextShownTickMark(i + 1))
         {
             wxDouble linePosition = GetTickMarkPosition(i).m_x;
 
@@ -291,3 +343,59 @@ void wxChartAxis::DrawTickMarks(wxGraphicsContext &gc) const
         }
     }
 }
+
+void wxChartAxis::CreateLazyLabels(wxGraphicsContext &gc)
+{
+    m_labels.clear();
+    m_labelStride = 1;
+    if (m_tickMarkCount == 0)
+    {
+        return;
+    }
+
+    bool vertical = (m_options.GetPosition() == wxCHARTAXISPOSITION_LEFT);
+    wxDouble length = vertical ? (m_startPoint.m_y - m_endPoint.m_y) : (m_endPoint.m_x - m_startPoint.m_x);
+    wxDouble spacing = std::abs(length) / std::max<size_t>(m_tickMarkCount - 1, 1);
+
+    // The stride is a power of two so that the tick marks with
+    // a label stay the same as long as the density doesn't
+    // change much. It is increased until the labels don't overlap,
+    // starting from labels as wide as the font is high.
+    wxDouble minExtent = m_options.GetFontOptions().GetSize() + 10;
+    while (true)
+    {
+        while ((m_labelStride < m_tickMarkCount) && ((m_labelStride * spacing) < minExtent))
+        {
+            m_labelStride *= 2;
+        }
+
+        m_labels.clear();
+        for (size_t i = GetNextShownTickMark(0); i < m_tickMarkCount; i += m_labelStride)
+        {
+            m_labels.push_back(CreateLabel(m_labelGenerator(i)));
+        }
+        m_labels.UpdateSizes(gc);
+
+        wxDouble extent = m_labels.GetMaxWidth();
+        if (vertical)
+        {
+            extent = 0;
+            for (size_t i = 0; i < m_labels.size(); ++i)
+            {
+                extent = std::max<wxDouble>(extent, m_labels[i].GetSize().GetHeight());
+            }
+        }
+        extent += 10;
+        if ((m_labelStride >= m_tickMarkCount) || ((m_labelStride * spacing) >= extent))
+        {
+            break;
+        }
+        minExtent = extent;
+    }
+}
+
+wxChartLabel wxChartAxis::CreateLabel(const wxString &text) const
+{
+    return wxChartLabel(text,
+        wxChartLabelOptions(m_options.GetFontOptions(), false, wxChartBackgroundOptions(*wxWHITE, 0)));
+}
@@ -40,9 +40,25 @@ wxChartCategoricalAxis::wxChartCategoricalAxis(const std::string &id,
 {
 }
 
+wxChartCategoricalAxis::wxChartCategoricalAxis(const std::string &id,
+                                               size_t count,
+                                               const LabelGenerator &generator,
+                                               const wxChartAxisOptions &options)
+    : wxChartAxis(id, count, generator, options)
+{
+}
+
 wxChartCategoricalAxis::ptr wxChartCategoricalAxis::make_shared(const std::string &id, 
                                                                 const wxVector<wxString> &labels,
                                                                 const wxChartAxisOptions &options)
 {
     return ptr(new wxChartCategoricalAxis(id, labels, options));
 }
+
+wxChartCategoricalAxis::ptr wxChartCategoricalAxis::make_shared(const std::string &id,
+                                                                size_t count,
+                                                                const LabelGenerator &generator,
+                                                                const wxChartAxisOptions &options)
+{
+    return ptr(new wxChartCategoricalAxis(id, count, generator, options));
+}
@@ -21,32 +21,271 @@
 */
 
 #include "wxchartctrl.h"
+#include "wxcharttextsizecache.h"
 #include <wx/dcbuffer.h>
+#include <wx/dcmemory.h>
+#include <sstream>
 
 wxChartCtrl::wxChartCtrl(wxWindow *parent,
                          wxWindowID id,
                          const wxPoint &pos,
                          const wxSize &size,
                          long style)
-    : wxControl(parent, id, pos, size, style)
+    : wxControl(parent, id, pos, size, style),
+    m_chartLayerValid(false), m_frameStarted(false),
+    m_frameInterval(16), m_refreshTimer(this), m_refreshPending(false),
+    m_layoutPending(false), m_updateDepth(0), m_debugOverlay(false),
+    m_ingestionTimer(this),
+    m_ingestionInterval(20), m_ingestionStarted(false)
 {
     SetBackgroundStyle(wxBG_STYLE_PAINT);
     SetBackgroundColour(*wxWHITE);
+    Bind(wxEVT_TIMER, &wxChartCtrl::OnRefreshTimer, this, m_refreshTimer.GetId());
+#if wxCHECK_VERSION(3, 1, 3)
+    // The event doesn't exist in older versions of wxWidgets
+    Bind(wxEVT_DPI_CHANGED, &wxChartCtrl::OnDPIChanged, this);
+#endif
+}
+
+void wxChartCtrl::Refresh(bool eraseBackground, const wxRect *rect)
+{
+    ScheduleRefresh(false);
+}
+
+int wxChartCtrl::GetFrameInterval() const
+{
+    return m_frameInterval;
+}
+
+void wxChartCtrl::SetFrameInterval(int milliseconds)
+{
+    m_frameInterval = milliseconds;
+}
+
+void wxChartCtrl::BeginUpdate()
+{
+    ++m_updateDepth;
+}
+
+void wxChartCtrl::EndUpdate()
+{
+    if (m_updateDepth == 0)
+    {
+        return;
+    }
+    --m_updateDepth;
+    if ((m_updateDepth == 0) && m_refreshPending)
+    {
+        ScheduleRefresh(m_layoutPending);
+    }
+}
+
+bool wxChartCtrl::IsUpdating() const
+{
+    return (m_updateDepth > 0);
+}
+
+bool wxChartCtrl::ShowsDebugOverlay() const
+{
+    return m_debugOverlay;
+}
+
+void wxChartCtrl::SetDebugOverlay(bool show)
+{
+    m_debugOverlay = show;
+    if (show)
+    {
+        GetChart().GetInstrumentation().Enable();
+    }
+    Refresh();
+}
+
+void wxChartCtrl::ScheduleRefresh(bool layoutParent)
+{
+    // The cached image of the chart stays valid until the
+    // frame is due so that the paints that come before it,
+    // like those of the tooltips, don't redraw the chart
+    m_refreshPending = true;
+    m_layoutPending = (m_layoutPending || layoutParent);
+    if (m_updateDepth > 0)
+    {
+        return;
+    }
+
+    long elapsed = m_frameWatch.Time();
+    if ((m_frameInterval <= 0) || !m_frameStarted || (elapsed >= m_frameInterval))
+    {
+        FlushRefresh();
+    }
+    else if (!m_refreshTimer.IsRunning())
+    {
+        m_refreshTimer.Start(m_frameInterval - elapsed, wxTIMER_ONE_SHOT);
+    }
+}
+
+void wxChartCtrl::OnRefreshTimer(wxTimerEvent &evt)
+{
+    if (m_updateDepth == 0)
+    {
+        FlushRefresh();
+    }
+}
+
+void wxChartCtrl::FlushRefresh()
+{
+    if (!m_refreshPending)
+    {
+        return;
+    }
+
+    m_refreshTimer.Stop();
+    m_refreshPending = false;
+    m_chartLayerValid = false;
+    // The frame starts when the refresh is issued, not when
+    // it is painted, or the refreshes that follow before the
+    // paint event would all be issued too
+    m_frameWatch.Start();
+    m_frameStarted = true;
+    if (m_layoutPending)
+    {
+        m_layoutPending = false;
+        wxWindow* parent = GetParent();
+        if (parent)
+        {
+            parent->Layout();
+        }
+    }
+    wxControl::Refresh();
+}
+
+bool wxChartCtrl::DrainIngestionQueues()
+{
+    return false;
+}
+
+void wxChartCtrl::SetIngestionInterval(int milliseconds)
+{
+    m_ingestionInterval = milliseconds;
+    if (m_ingestionStarted)
+    {
+        m_ingestionTimer.Start(m_ingestionInterval);
+    }
+}
+
+void wxChartCtrl::StartIngestion()
+{
+    if (m_ingestionStarted)
+    {
+        return;
+    }
+
+    // The idle events drain the queues as soon as the GUI
+    // thread has nothing else to do, the timer makes sure
+    // they are also drained while it is busy and when no
+    // other event wakes it up
+    Bind(wxEVT_IDLE, &wxChartCtrl::OnIngestionIdle, this);
+    Bind(wxEVT_TIMER, &wxChartCtrl::OnIngestionTimer, this, m_ingestionTimer.GetId());
+    m_ingestionTimer.Start(m_ingestionInterval);
+    m_ingestionStarted = true;
 }
 
 void wxChartCtrl::OnPaint(wxPaintEvent &evt)
 {
     wxAutoBufferedPaintDC dc(this);
-    dc.Clear();
+
+    wxSize size = GetClientSize();
+    if ((size.GetWidth() <= 0) || (size.GetHeight() <= 0))
+    {
+        return;
+    }
+
+    // The layer has as many pixels as the screen area it
+    // covers so that it stays sharp on high DPI displays
+    double scaleFactor = GetContentScaleFactor();
+    bool sizeChanged = (!m_chartLayer.IsOk() ||
+        (m_chartLayer.GetScaledWidth() != size.GetWidth()) ||
+        (m_chartLayer.GetScaledHeight() != size.GetHeight()) ||
+        (m_chartLayer.GetScaleFactor() != scaleFactor));
+    bool redrawChart = (sizeChanged || !m_chartLayerValid);
+    if (redrawChart)
+    {
+        if (sizeChanged)
+        {
+            m_chartLayer.CreateScaled(size.GetWidth(), size.GetHeight(),
+                wxBITMAP_SCREEN_DEPTH, scaleFactor);
+        }
+
+        wxMemoryDC layerDC(m_chartLayer);
+        layerDC.SetBackground(wxBrush(GetBackgroundColour()));
+        layerDC.Clear();
+        wxGraphicsContext* gc = wxGraphicsContext::Create(layerDC);
+        if (gc)
+        {
+            GetChart().DrawChartLayer(*gc);
+            delete gc;
+        }
+        layerDC.SelectObject(wxNullBitmap);
+
+        m_chartLayerValid = true;
+        m_frameWatch.Start();
+        m_frameStarted = true;
+    }
+
+    // The bitmap is drawn at its logical size
+    dc.DrawBitmap(m_chartLayer, 0, 0);
 
     wxGraphicsContext* gc = wxGraphicsContext::Create(dc);
     if (gc)
     {
-        GetChart().Draw(*gc);
+        GetChart().DrawTooltipLayer(*gc);
+        m_tooltipBounds = GetChart().GetTooltipLayerBounds(*gc);
+        // The repaints of the tooltips alone are clipped to the
+        // tooltips and leave the overlay as it was, they don't
+        // end a frame so that it still shows the last one
+        if (redrawChart)
+        {
+            GetChart().GetInstrumentation().EndFrame();
+        }
+        if (m_debugOverlay)
+        {
+            DrawDebugOverlay(*gc);
+        }
         delete gc;
     }
 }
 
+void wxChartCtrl::DrawDebugOverlay(wxGraphicsContext &gc)
+{
+    wxChartFontOptions fontOptions(wxFONTFAMILY_TELETYPE, 10,
+        wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, *wxBLACK);
+    gc.SetFont(fontOptions.GetFont(), fontOptions.GetColor());
+
+    wxVector<wxString> lines;
+    std::stringstream text(GetChart().GetInstrumentation().FormatLastFrame().ToStdString());
+    std::string line;
+    wxDouble width = 0;
+    wxDouble lineHeight = 0;
+    while (std::getline(text, line))
+    {
+        lines.push_back(line);
+        wxDouble lineWidth = 0;
+        gc.GetTextExtent(lines.back(), &lineWidth, &lineHeight);
+        if (lineWidth > width)
+        {
+            width = lineWidth;
+        }
+    }
+
+    const wxDouble padding = 4;
+    gc.SetPen(*wxTRANSPARENT_PEN);
+    gc.SetBrush(wxBrush(wxColour(255, 255, 255, 200)));
+    gc.DrawRectangle(0, 0, width + (2 * padding), (lines.size() * lineHeight) + (2 * padding));
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        gc.DrawText(lines[i], padding, padding + (i * lineHeight));
+    }
+}
+
 void wxChartCtrl::OnSize(wxSizeEvent &evt)
 {
     if (GetChart().GetCommonOptions().IsResponsive())
@@ -56,15 +295,98 @@ void wxChartCtrl::OnSize(wxSizeEvent &evt)
     }
 }
 
+#if wxCHECK_VERSION(3, 1, 3)
+void wxChartCtrl::OnDPIChanged(wxDPIChangedEvent &evt)
+{
+    // The fonts are scaled so the cached text sizes, which
+    // were measured at the old DPI, are all wrong and the
+    // chart must be laid out again
+    wxChartsTextSizeCache.Clear();
+    if (GetChart().GetCommonOptions().IsResponsive())
+    {
+        GetChart().SetSize(GetClientSize());
+    }
+    Refresh();
+    evt.Skip();
+}
+#endif
+
 void wxChartCtrl::OnMouseOver(wxMouseEvent &evt)
 {
     if (GetChart().GetCommonOptions().ShowTooltips())
     {
-        GetChart().ActivateElementsAt(evt.GetPosition());
-        Refresh();
+        if (!GetChart().ActivateElementsAt(evt.GetPosition()))
+        {
+            return;
+        }
+
+        // Only the tooltips have changed so the cached
+        // image of the chart can be reused and only the
+        // area covered by the old and the new tooltips
+        // needs to be repainted. wxControl::Refresh() is
+        // called directly because our override, which
+        // RefreshRect() would end up calling, discards the
+        // cached image.
+        wxGraphicsContext* gc = wxGraphicsContext::Create();
+        if (!gc)
+        {
+            wxControl::Refresh();
+            return;
+        }
+        wxRect newBounds = GetChart().GetTooltipLayerBounds(*gc);
+        delete gc;
+
+        wxRect dirtyRect = m_tooltipBounds;
+        if (dirtyRect.IsEmpty())
+        {
+            dirtyRect = newBounds;
+        }
+        else if (!newBounds.IsEmpty())
+        {
+            dirtyRect.Union(newBounds);
+        }
+        if (!dirtyRect.IsEmpty())
+        {
+            // Allow for antialiasing at the edges
+            dirtyRect.Inflate(2);
+            wxControl::Refresh(false, &dirtyRect);
+        }
     }
 }
 
+void wxChartCtrl::OnIngestionIdle(wxIdleEvent &evt)
+{
+    // The idle events are frequent and the queues are
+    // usually empty, only the drains that added values
+    // are counted
+    wxChartInstrumentation::Scope scope(GetChart().GetInstrumentation(), wxCHARTSTAGE_INGEST);
+    if (!DrainIngestionQueues())
+    {
+        scope.Discard();
+    }
+    evt.Skip();
+}
+
+void wxChartCtrl::OnIngestionTimer(wxTimerEvent &evt)
+{
+    wxChartInstrumentation::Scope scope(GetChart().GetInstrumentation(), wxCHARTSTAGE_INGEST);
+    if (!DrainIngestionQueues())
+    {
+        scope.Discard();
+    }
+}
+
+wxChartCtrlUpdateLocker::wxChartCtrlUpdateLocker(wxChartCtrl &ctrl)
+    : m_ctrl(ctrl)
+{
+    m_ctrl.BeginUpdate();
+}
+
+wxChartCtrlUpdateLocker::~wxChartCtrlUpdateLocker()
+{
+    m_ctrl.EndUpdate();
+}
+
 BEGIN_EVENT_TABLE(wxChartCtrl, wxControl)
     EVT_PAINT(wxChartCtrl::OnPaint)
     EVT_SIZE(wxChartCtrl::OnSize)
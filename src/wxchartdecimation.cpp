@@ -0,0 +1,194 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartdecimation.h"
+#include <cmath>
+
+static_assert(sizeof(wxPoint2DDouble) == (2 * sizeof(wxDouble)),
+    "wxPoint2DDouble must not contain padding");
+
+void wxChartDecimation::Decimate(wxChartDecimationMode mode,
+                                 const wxVector<wxPoint2DDouble> &points,
+                                 wxVector<wxPoint2DDouble> &result)
+{
+    switch (mode)
+    {
+    case wxCHARTDECIMATION_MINMAX:
+        MinMax(points, result);
+        break;
+
+    case wxCHARTDECIMATION_LTTB:
+        if (points.size() > 0)
+        {
+            // Keep about two points for each pixel column covered
+            // by the line
+            wxDouble width = std::abs(points.back().m_x - points.front().m_x);
+            LTTB(points, 2 * static_cast<size_t>(std::ceil(width)) + 2, result);
+        }
+        else
+        {
+            result.clear();
+        }
+        break;
+
+    default:
+        result = points;
+        break;
+    }
+}
+
+void wxChartDecimation::MinMax(const wxVector<wxPoint2DDouble> &points,
+                               wxVector<wxPoint2DDouble> &result)
+{
+    result.clear();
+    if (points.empty())
+    {
+        return;
+    }
+
+    // The coordinates of the points are next to each other
+    // so they can be scanned with a stride of 2
+    const wxDouble *x = &points[0].m_x;
+    const wxDouble *y = &points[0].m_y;
+    size_t i = 0;
+    while (i < points.size())
+    {
+        wxDouble column = std::floor(points[i].m_x);
+        size_t first = i;
+        for (++i; (i < points.size()) && (std::floor(points[i].m_x) == column); ++i)
+        {
+        }
+        AppendMinMax(x, y, 2, first, i - 1, result);
+    }
+}
+
+void wxChartDecimation::AppendMinMax(const wxDouble *x,
+                                     const wxDouble *y,
+                                     size_t stride,
+                                     size_t first,
+                                     size_t last,
+                                     wxVector<wxPoint2DDouble> &result)
+{
+    size_t minIndex = first;
+    size_t maxIndex = first;
+    for (size_t i = first + 1; i <= last; ++i)
+    {
+        if (y[i * stride] < y[minIndex * stride])
+        {
+            minIndex = i;
+        }
+        if (y[i * stride] > y[maxIndex * stride])
+        {
+            maxIndex = i;
+        }
+    }
+
+    // Emit the extrema in the order in which they appear
+    // so that the shape of the line is preserved
+    size_t lowIndex = (minIndex < maxIndex) ? minIndex : maxIndex;
+    size_t highIndex = (minIndex < maxIndex) ? maxIndex : minIndex;
+
+    result.push_back(wxPoint2DDouble(x[first * stride], y[first * stride]));
+    if ((lowIndex != first) && (lowIndex != last))
+    {
+        result.push_back(wxPoint2DDouble(x[lowIndex * stride], y[lowIndex * stride]));
+    }
+    if ((highIndex != lowIndex) && (highIndex != first) && (highIndex != last))
+    {
+        result.push_back(wxPoint2DDouble(x[highIndex * stride], y[highIndex * stride]));
+    }
+    if (last != first)
+    {
+        result.push_back(wxPoint2DDouble(x[last * stride], y[last * stride]));
+    }
+}
+
+void wxChartDecimation::LTTB(const wxVector<wxPoint2DDouble> &points,
+                             size_t threshold,
+                             wxVector<wxPoint2DDouble> &result)
+{
+    size_t count = points.size();
+    if ((threshold >= count) || (threshold < 3))
+    {
+        result = points;
+        return;
+    }
+
+    result.clear();
+    result.reserve(threshold);
+
+    // The first and last points are always kept, the other
+    // points are split in (threshold - 2) buckets
+    wxDouble bucketSize = static_cast<wxDouble>(count - 2) / (threshold - 2);
+
+    size_t selected = 0;
+    result.push_back(points[0]);
+
+    for (size_t i = 0; i < (threshold - 2); ++i)
+    {
+        // Average of the next bucket, used as the third
+        // vertex of the triangle
+        size_t averageStart = static_cast<size_t>(std::floor((i + 1) * bucketSize)) + 1;
+        size_t averageEnd = static_cast<size_t>(std::floor((i + 2) * bucketSize)) + 1;
+        if (averageEnd > count)
+        {
+            averageEnd = count;
+        }
+
+        wxDouble averageX = 0;
+        wxDouble averageY = 0;
+        for (size_t j = averageStart; j < averageEnd; ++j)
+        {
+            averageX += points[j].m_x;
+            averageY += points[j].m_y;
+        }
+        averageX /= (averageEnd - averageStart);
+        averageY /= (averageEnd - averageStart);
+
+        // Select the point of the current bucket that forms
+        // the largest triangle with the previously selected
+        // point and the average of the next bucket
+        size_t rangeStart = static_cast<size_t>(std::floor(i * bucketSize)) + 1;
+        size_t rangeEnd = static_cast<size_t>(std::floor((i + 1) * bucketSize)) + 1;
+
+        const wxPoint2DDouble &a = points[selected];
+        wxDouble maxArea = -1;
+        size_t next = rangeStart;
+        for (size_t j = rangeStart; j < rangeEnd; ++j)
+        {
+            wxDouble area = std::abs(
+                (a.m_x - averageX) * (points[j].m_y - a.m_y) -
+                (a.m_x - points[j].m_x) * (averageY - a.m_y)
+                );
+            if (area > maxArea)
+            {
+                maxArea = area;
+                next = j;
+            }
+        }
+
+        result.push_back(points[next]);
+        selected = next;
+    }
+
+    result.push_back(points[count - 1]);
+}
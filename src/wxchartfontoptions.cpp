@@ -63,3 +63,15 @@ const wxColor& wxChartFontOptions::GetColor() const
 {
     return m_color;
 }
+
+bool wxChartFontOptions::operator==(const wxChartFontOptions &other) const
+{
+    return ((m_family == other.m_family) && (m_size == other.m_size) &&
+        (m_style == other.m_style) && (m_weight == other.m_weight) &&
+        (m_color == other.m_color));
+}
+
+bool wxChartFontOptions::operator!=(const wxChartFontOptions &other) const
+{
+    return !(*this == other);
+}
@@ -115,11 +115,11 @@ wxPoint2DDouble wxChartGrid::GetTooltipPosition() const
     return wxPoint2DDouble(0, 0);
 }
 
-void wxChartGrid::Fit(wxGraphicsContext &gc)
+bool wxChartGrid::Fit(wxGraphicsContext &gc)
 {
     if (!m_needsFit)
     {
-        return;
+        return false;
     }
 
     wxDouble startPoint = m_mapping.GetSize().GetHeight() - (m_YAxis->GetOptions().GetFontOptions().GetSize() + 15) - 5; // -5 to pad labels
@@ -129,13 +129,33 @@ void wxChartGrid::Fit(wxGraphicsContext &gc)
     //this.startPoint += this.padding;
     //this.endPoint -= this.padding;
 
+    // Axes with lazy labels choose how many labels to create
+    // from their length so they are first fitted without padding
+    if (m_XAxis->HasLazyLabels() || m_YAxis->HasLazyLabels())
+    {
+        FitAxes(startPoint, endPoint, 0, 0);
+    }
+
     m_YAxis->UpdateLabelSizes(gc);
     m_XAxis->UpdateLabelSizes(gc);
 
     wxDouble leftPadding = 0;
     wxDouble rightPadding = 0;
     CalculatePadding(*m_XAxis, *m_YAxis, leftPadding, rightPadding);
+    FitAxes(startPoint, endPoint, leftPadding, rightPadding);
+
+    m_XAxis->UpdateLabelPositions();
+    m_YAxis->UpdateLabelPositions();
 
+    m_needsFit = false;
+    return true;
+}
+
+void wxChartGrid::FitAxes(wxDouble startPoint,
+                          wxDouble endPoint,
+                          wxDouble leftPadding,
+                          wxDouble rightPadding)
+{
     if (m_XAxis->GetOptions().GetPosition() == wxCHARTAXISPOSITION_BOTTOM)
     {
         m_XAxis->Fit(wxPoint2DDouble(leftPadding, startPoint), wxPoint2DDouble(m_mapping.GetSize().GetWidth() - rightPadding, startPoint));
@@ -146,11 +166,11 @@ void wxChartGrid::Fit(wxGraphicsContext &gc)
         m_XAxis->Fit(wxPoint2DDouble(leftPadding, startPoint), wxPoint2DDouble(leftPadding, endPoint));
         m_YAxis->Fit(wxPoint2DDouble(leftPadding, startPoint), wxPoint2DDouble(m_mapping.GetSize().GetWidth() - rightPadding, startPoint));
     }
+}
 
-    m_XAxis->UpdateLabelPositions();
-    m_YAxis->UpdateLabelPositions();
-
-    m_needsFit = false;
+void wxChartGrid::InvalidateFit()
+{
+    m_needsFit = true;
 }
 
 void wxChartGrid::Resize(const wxSize &size)
@@ -196,7 +216,7 @@ bool wxChartGrid::Scale(int c)
     }
     else
         m_curAxisLimits = m_origAxisLimits;
-    Update();
+    UpdateRanges();
     return true;
 }
 
@@ -210,11 +230,13 @@ void wxChartGrid::Shift(double dx,double dy)
     m_curAxisLimits.MinY+=deltaY;
     m_curAxisLimits.MaxY+=deltaY;
 
-    Update();
+    UpdateRanges();
 }
 
-void wxChartGrid::UpdateAxisLimit(const std::string& axisId, wxDouble min, wxDouble max)
+bool wxChartGrid::UpdateAxisLimit(const std::string& axisId, wxDouble min, wxDouble max)
 {
+    wxChartAxis::ptr *axis = 0;
+    const wxChartAxisOptions *axisOptions = 0;
     if(axisId == "x")
     {
         m_origAxisLimits.MinX = min;
@@ -223,8 +245,8 @@ void wxChartGrid::UpdateAxisLimit(const std::string& axisId, wxDouble min, wxDou
         m_curAxisLimits.MinX = min;
         m_curAxisLimits.MaxX = max;
 
-        m_XAxis = new wxChartNumericalAxis(axisId,m_curAxisLimits.MinX,
-                                           m_curAxisLimits.MaxX,m_options.GetXAxisOptions());
+        axis = &m_XAxis;
+        axisOptions = &m_options.GetXAxisOptions();
     }
     else if(axisId == "y")
     {
@@ -233,11 +255,32 @@ void wxChartGrid::UpdateAxisLimit(const std::string& axisId, wxDouble min, wxDou
 
         m_curAxisLimits.MinY = min;
         m_curAxisLimits.MaxY = max;
-        m_YAxis = new wxChartNumericalAxis(axisId,m_curAxisLimits.MinY,
-                                           m_curAxisLimits.MaxY, m_options.GetYAxisOptions());
+
+        axis = &m_YAxis;
+        axisOptions = &m_options.GetYAxisOptions();
+    }
+    else
+    {
+        return false;
+    }
+
+    // A numerical axis is updated in place, the mapping
+    // shares it and doesn't need to be rebuilt
+    wxChartNumericalAxis* numericalAxis = dynamic_cast<wxChartNumericalAxis*>(axis->get());
+    if (numericalAxis)
+    {
+        if (!numericalAxis->UpdateRange(min, max))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        *axis = new wxChartNumericalAxis(axisId, min, max, *axisOptions);
+        m_mapping = wxChartGridMapping(m_mapping.GetSize(), m_XAxis, m_YAxis);
     }
-    m_mapping = wxChartGridMapping(m_mapping.GetSize(), m_XAxis, m_YAxis);
     m_needsFit = true;
+    return true;
 }
 
 void wxChartGrid::ChangeLabels(const std::string& axisId, const wxVector<wxString> &labels, wxChartAxisOptions options)
@@ -251,6 +294,20 @@ void wxChartGrid::ChangeLabels(const std::string& axisId, const wxVector<wxStrin
     m_needsFit = true;
 }
 
+void wxChartGrid::AppendTickMarks(const std::string& axisId, size_t count)
+{
+    wxChartAxis::ptr &axis = (axisId == "x") ? m_XAxis : m_YAxis;
+    axis->AppendTickMarks(count);
+    m_needsFit = true;
+}
+
+void wxChartGrid::RemoveFirstTickMarks(const std::string& axisId, size_t count)
+{
+    wxChartAxis::ptr &axis = (axisId == "x") ? m_XAxis : m_YAxis;
+    axis->RemoveFirstTickMarks(count);
+    m_needsFit = true;
+}
+
 void wxChartGrid::Update()
 {
     m_XAxis = new wxChartNumericalAxis("x", m_curAxisLimits.MinX,
@@ -261,6 +318,26 @@ void wxChartGrid::Update()
     m_needsFit = true;
 }
 
+void wxChartGrid::UpdateRanges()
+{
+    wxChartNumericalAxis* xAxis = dynamic_cast<wxChartNumericalAxis*>(m_XAxis.get());
+    wxChartNumericalAxis* yAxis = dynamic_cast<wxChartNumericalAxis*>(m_YAxis.get());
+    if (!xAxis || !yAxis)
+    {
+        Update();
+        return;
+    }
+
+    // Only the ranges change so the axes, and the mapping that
+    // shares them, are updated in place rather than rebuilt.
+    bool xChanged = xAxis->UpdateRange(m_curAxisLimits.MinX, m_curAxisLimits.MaxX);
+    bool yChanged = yAxis->UpdateRange(m_curAxisLimits.MinY, m_curAxisLimits.MaxY);
+    if (xChanged || yChanged)
+    {
+        m_needsFit = true;
+    }
+}
+
 void wxChartGrid::CalculatePadding(const wxChartAxis &xAxis,
                                    const wxChartAxis &yAxis,
                                    wxDouble &left,
@@ -305,7 +382,8 @@ void wxChartGrid::DrawHorizontalGridLines(const wxChartAxis &horizontalAxis,
         const wxChartGridLineOptions &options,
         wxGraphicsContext &gc)
 {
-    for (size_t i = 1; i < verticalAxis.GetNumberOfTickMarks(); ++i)
+    for (size_t i = verticalAxis.GetNextShownTickMark(1); i < verticalAxis.GetNumberOfTickMarks();
+        i = verticalAxis.GetNextShownTickMark(i + 1))
     {
         wxPoint2DDouble lineStartPosition = verticalAxis.GetTickMarkPosition(i);
         wxPoint2DDouble lineEndPosition = horizontalAxis.GetTickMarkPosition(horizontalAxis.GetNumberOfTickMarks() - 1);
@@ -358,7 +436,7 @@ void wxChartGrid::DrawVerticalGridLines(const wxChartAxis &horizontalAxis,
     {
         ++end;
     }
-    for (; i < end; ++i)
+    for (i = horizontalAxis.GetNextShownTickMark(i); i < end; i = horizontalAxis.GetNextShownTickMark(i + 1))
     {
         wxPoint2DDouble lineStartPosition = horizontalAxis.GetTickMarkPosition(i);
         wxPoint2DDouble lineEndPosition = verticalAxis.GetTickMarkPosition(verticalAxis.GetNumberOfTickMarks() - 1);
@@ -108,3 +108,8 @@ const wxChartAxis& wxChartGridMapping::GetXAxis() const
 {
     return *m_XAxis;
 }
+
+const wxChartAxis& wxChartGridMapping::GetYAxis() const
+{
+    return *m_YAxis;
+}
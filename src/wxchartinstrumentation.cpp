@@ -0,0 +1,341 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartinstrumentation.h"
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace
+{
+    std::atomic<size_t> allocationCount(0);
+
+    wxDouble GetMicroseconds(const std::chrono::steady_clock::duration &duration)
+    {
+        return std::chrono::duration_cast<std::chrono::duration<wxDouble, std::micro> >(duration).count();
+    }
+}
+
+wxChartStageCounters::wxChartStageCounters()
+{
+    Reset();
+}
+
+void wxChartStageCounters::Reset()
+{
+    m_time = 0;
+    m_calls = 0;
+    m_primitives = 0;
+    m_pointsConsidered = 0;
+    m_pointsDrawn = 0;
+    m_allocations = 0;
+}
+
+void wxChartStageCounters::Add(const wxChartStageCounters &other)
+{
+    m_time += other.m_time;
+    m_calls += other.m_calls;
+    m_primitives += other.m_primitives;
+    m_pointsConsidered += other.m_pointsConsidered;
+    m_pointsDrawn += other.m_pointsDrawn;
+    m_allocations += other.m_allocations;
+}
+
+wxDouble wxChartStageCounters::GetTime() const
+{
+    return m_time;
+}
+
+size_t wxChartStageCounters::GetCalls() const
+{
+    return m_calls;
+}
+
+size_t wxChartStageCounters::GetPrimitives() const
+{
+    return m_primitives;
+}
+
+size_t wxChartStageCounters::GetPointsConsidered() const
+{
+    return m_pointsConsidered;
+}
+
+size_t wxChartStageCounters::GetPointsDrawn() const
+{
+    return m_pointsDrawn;
+}
+
+size_t wxChartStageCounters::GetAllocations() const
+{
+    return m_allocations;
+}
+
+void wxChartStageCounters::AddTime(wxDouble milliseconds)
+{
+    m_time += milliseconds;
+}
+
+void wxChartStageCounters::AddCall()
+{
+    ++m_calls;
+}
+
+void wxChartStageCounters::AddPrimitives(size_t count)
+{
+    m_primitives += count;
+}
+
+void wxChartStageCounters::AddPoints(size_t considered,
+                                     size_t drawn)
+{
+    m_pointsConsidered += considered;
+    m_pointsDrawn += drawn;
+}
+
+void wxChartStageCounters::AddAllocations(size_t count)
+{
+    m_allocations += count;
+}
+
+wxChartInstrumentation::Scope::Scope(wxChartInstrumentation &instrumentation,
+                                     wxChartStage stage)
+    : m_instrumentation(instrumentation), m_stage(stage),
+    m_enabled(instrumentation.IsEnabled()), m_allocations(0)
+{
+    if (m_enabled)
+    {
+        m_allocations = GetAllocationCount();
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+wxChartInstrumentation::Scope::~Scope()
+{
+    if (m_enabled)
+    {
+        m_instrumentation.EndStage(m_stage, m_start, m_allocations);
+    }
+}
+
+void wxChartInstrumentation::Scope::Discard()
+{
+    m_enabled = false;
+}
+
+wxChartInstrumentation::wxChartInstrumentation()
+    : m_enabled(false), m_frameCount(0), m_tracing(false),
+    m_maxEvents(0)
+{
+}
+
+bool wxChartInstrumentation::IsEnabled() const
+{
+    return m_enabled;
+}
+
+void wxChartInstrumentation::Enable(bool enable)
+{
+    m_enabled = enable;
+}
+
+void wxChartInstrumentation::Reset()
+{
+    m_frameCount = 0;
+    for (size_t i = 0; i < wxCHARTSTAGE_COUNT; ++i)
+    {
+        m_currentFrame[i].Reset();
+        m_lastFrame[i].Reset();
+        m_total[i].Reset();
+    }
+    m_events.clear();
+    m_traceStart = std::chrono::steady_clock::now();
+}
+
+void wxChartInstrumentation::AddPrimitives(wxChartStage stage,
+                                           size_t count)
+{
+    if (m_enabled)
+    {
+        m_currentFrame[stage].AddPrimitives(count);
+    }
+}
+
+void wxChartInstrumentation::AddPoints(wxChartStage stage,
+                                       size_t considered,
+                                       size_t drawn)
+{
+    if (m_enabled)
+    {
+        m_currentFrame[stage].AddPoints(considered, drawn);
+    }
+}
+
+void wxChartInstrumentation::EndFrame()
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < wxCHARTSTAGE_COUNT; ++i)
+    {
+        m_lastFrame[i] = m_currentFrame[i];
+        m_total[i].Add(m_currentFrame[i]);
+        m_currentFrame[i].Reset();
+    }
+    ++m_frameCount;
+}
+
+size_t wxChartInstrumentation::GetFrameCount() const
+{
+    return m_frameCount;
+}
+
+const wxChartStageCounters& wxChartInstrumentation::GetLastFrame(wxChartStage stage) const
+{
+    return m_lastFrame[stage];
+}
+
+const wxChartStageCounters& wxChartInstrumentation::GetTotal(wxChartStage stage) const
+{
+    return m_total[stage];
+}
+
+wxString wxChartInstrumentation::FormatLastFrame() const
+{
+    std::stringstream text;
+    text << "frame " << m_frameCount;
+    text << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < wxCHARTSTAGE_COUNT; ++i)
+    {
+        const wxChartStageCounters& counters = m_lastFrame[i];
+        text << "\n" << GetStageName(static_cast<wxChartStage>(i)) << ": "
+            << counters.GetTime() << " ms, "
+            << counters.GetPrimitives() << " primitives, "
+            << counters.GetPointsDrawn() << "/" << counters.GetPointsConsidered() << " points, "
+            << counters.GetAllocations() << " allocations";
+    }
+    return text.str();
+}
+
+void wxChartInstrumentation::StartTrace(size_t maxEvents)
+{
+    m_tracing = true;
+    m_maxEvents = maxEvents;
+    m_events.clear();
+    m_traceStart = std::chrono::steady_clock::now();
+}
+
+void wxChartInstrumentation::StopTrace()
+{
+    m_tracing = false;
+}
+
+bool wxChartInstrumentation::IsTracing() const
+{
+    return m_tracing;
+}
+
+void wxChartInstrumentation::WriteTrace(std::ostream &stream) const
+{
+    // Complete events ("ph":"X") with timestamps and
+    // durations in microseconds
+    stream << "{\"traceEvents\":[";
+    stream << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < m_events.size(); ++i)
+    {
+        if (i > 0)
+        {
+            stream << ",";
+        }
+        stream << "\n{\"name\":\"" << GetStageName(m_events[i].stage)
+            << "\",\"cat\":\"wxCharts\",\"ph\":\"X\",\"ts\":" << m_events[i].start
+            << ",\"dur\":" << m_events[i].duration << ",\"pid\":1,\"tid\":1}";
+    }
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool wxChartInstrumentation::SaveTrace(const wxString &filename) const
+{
+    std::ofstream stream(filename.fn_str(), std::ios::out | std::ios::trunc);
+    if (!stream)
+    {
+        return false;
+    }
+    WriteTrace(stream);
+    return stream.good();
+}
+
+const char* wxChartInstrumentation::GetStageName(wxChartStage stage)
+{
+    switch (stage)
+    {
+    case wxCHARTSTAGE_FIT:
+        return "fit";
+    case wxCHARTSTAGE_GRID:
+        return "grid";
+    case wxCHARTSTAGE_DATASETS:
+        return "datasets";
+    case wxCHARTSTAGE_TOOLTIPS:
+        return "tooltips";
+    case wxCHARTSTAGE_HITTEST:
+        return "hit test";
+    case wxCHARTSTAGE_INGEST:
+        return "ingest";
+    default:
+        return "unknown";
+    }
+}
+
+void wxChartInstrumentation::RecordAllocation()
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t wxChartInstrumentation::GetAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void wxChartInstrumentation::EndStage(wxChartStage stage,
+                                      const std::chrono::steady_clock::time_point &start,
+                                      size_t allocations)
+{
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    wxDouble duration = GetMicroseconds(end - start);
+
+    wxChartStageCounters& counters = m_currentFrame[stage];
+    counters.AddTime(duration / 1000);
+    counters.AddCall();
+    counters.AddAllocations(GetAllocationCount() - allocations);
+
+    if (m_tracing && (m_events.size() < m_maxEvents))
+    {
+        TraceEvent event;
+        event.stage = stage;
+        event.start = GetMicroseconds(start - m_traceStart);
+        event.duration = duration;
+        m_events.push_back(event);
+    }
+}
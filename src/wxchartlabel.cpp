@@ -41,6 +41,15 @@ wxChartLabel::wxChartLabel(const wxString &text,
 }
 
 void wxChartLabel::Draw(wxGraphicsContext &gc) const
+{
+    DrawBackground(gc);
+
+    wxFont font = m_options.GetFontOptions().GetFont();
+    gc.SetFont(font, m_options.GetFontOptions().GetColor());
+    DrawText(gc);
+}
+
+void wxChartLabel::DrawBackground(wxGraphicsContext &gc) const
 {
     if (m_options.HasBackground())
     {
@@ -51,9 +60,10 @@ void wxChartLabel::Draw(wxGraphicsContext &gc) const
         wxChartBackground background(m_options.GetBackgroundOptions());
         background.Draw(m_position, backgroundSize, gc);
     }
+}
 
-    wxFont font = m_options.GetFontOptions().GetFont();
-    gc.SetFont(font, m_options.GetFontOptions().GetColor());
+void wxChartLabel::DrawText(wxGraphicsContext &gc) const
+{
     gc.DrawText(m_text, m_position.m_x, m_position.m_y);
 }
 
@@ -67,6 +77,11 @@ wxPoint2DDouble wxChartLabel::GetTooltipPosition() const
     return wxPoint2DDouble(0, 0);
 }
 
+const wxChartLabelOptions& wxChartLabel::GetOptions() const
+{
+    return m_options;
+}
+
 const wxString& wxChartLabel::GetText() const
 {
     return m_text;
@@ -107,10 +122,9 @@ void wxChartLabel::SetSize(wxDouble width, wxDouble height)
 
 void wxChartLabel::UpdateSize(wxGraphicsContext &gc)
 {
-    wxFont font = m_options.GetFontOptions().GetFont();
     wxDouble width = 0;
     wxDouble height = 0;
-    wxChartUtilities::GetTextSize(gc, font, m_text, width, height);
+    wxChartUtilities::GetTextSize(gc, m_options.GetFontOptions(), m_text, width, height);
     m_size.x = width;
     m_size.y = height;
 }
@@ -29,9 +29,21 @@ wxChartLabelGroup::wxChartLabelGroup()
 
 void wxChartLabelGroup::Draw(wxGraphicsContext &gc) const
 {
+    // The labels of a group usually share the same font
+    // so it is only set when it changes
+    const wxChartFontOptions *currentFont = 0;
     for (size_t i = 0; i < size(); ++i)
     {
-        (*this)[i].Draw(gc);
+        const wxChartLabel &label = (*this)[i];
+        label.DrawBackground(gc);
+
+        const wxChartFontOptions &font = label.GetOptions().GetFontOptions();
+        if (!currentFont || (*currentFont != font))
+        {
+            gc.SetFont(font.GetFont(), font.GetColor());
+            currentFont = &font;
+        }
+        label.DrawText(gc);
     }
 }
 
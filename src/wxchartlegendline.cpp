@@ -86,7 +86,7 @@ void wxChartLegendLine::UpdateSize(wxGraphicsContext &gc)
 {
     wxDouble width;
     wxDouble height;
-    wxChartUtilities::GetTextSize(gc, m_options.GetFontOptions().GetFont(), m_text, width, height);
+    wxChartUtilities::GetTextSize(gc, m_options.GetFontOptions(), m_text, width, height);
     m_size.x = width + 20;
     m_size.y = height;
 }
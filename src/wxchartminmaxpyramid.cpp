@@ -0,0 +1,258 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartminmaxpyramid.h"
+
+wxChartMinMaxPyramid::wxChartMinMaxPyramid(size_t blockSize)
+    : m_blockSize((blockSize < 2) ? 2 : blockSize), m_start(0), m_end(0)
+{
+}
+
+void wxChartMinMaxPyramid::Clear()
+{
+    m_start = 0;
+    m_end = 0;
+    m_levels.clear();
+}
+
+void wxChartMinMaxPyramid::Update(size_t start,
+                                  size_t end,
+                                  const Accessor &value)
+{
+    if ((start < m_start) || (end < m_end))
+    {
+        Clear();
+    }
+    m_start = start;
+    m_end = end;
+
+    for (size_t l = 0; ; ++l)
+    {
+        size_t blockSize = GetBlockSize(l);
+
+        // The blocks that are entirely inside the series,
+        // first included and count excluded
+        size_t first = (start + blockSize - 1) / blockSize;
+        size_t count = end / blockSize;
+        if (count <= first)
+        {
+            break;
+        }
+
+        if (l == m_levels.size())
+        {
+            m_levels.push_back(Level());
+        }
+        Level &level = m_levels[l];
+
+        size_t next = level.firstBlock + level.blocks.size();
+        if (level.blocks.empty() || (next < first))
+        {
+            level.blocks.clear();
+            level.firstBlock = first;
+        }
+        else if (first > level.firstBlock)
+        {
+            size_t removed = first - level.firstBlock;
+            if ((2 * removed) >= level.blocks.size())
+            {
+                level.blocks.erase(level.blocks.begin(), level.blocks.begin() + removed);
+                level.firstBlock = first;
+            }
+        }
+
+        for (size_t b = level.firstBlock + level.blocks.size(); b < count; ++b)
+        {
+            Block block;
+            if (l == 0)
+            {
+                size_t i = b * blockSize;
+                block.minValue = block.maxValue = value(i);
+                block.minIndex = block.maxIndex = i;
+                for (++i; i < ((b + 1) * blockSize); ++i)
+                {
+                    wxDouble v = value(i);
+                    if (v < block.minValue)
+                    {
+                        block.minValue = v;
+                        block.minIndex = i;
+                    }
+                    if (v > block.maxValue)
+                    {
+                        block.maxValue = v;
+                        block.maxIndex = i;
+                    }
+                }
+            }
+            else
+            {
+                const Level &children = m_levels[l - 1];
+                size_t c = (b * m_blockSize) - children.firstBlock;
+                block = children.blocks[c];
+                for (size_t j = 1; j < m_blockSize; ++j)
+                {
+                    const Block &child = children.blocks[c + j];
+                    if (child.minValue < block.minValue)
+                    {
+                        block.minValue = child.minValue;
+                        block.minIndex = child.minIndex;
+                    }
+                    if (child.maxValue > block.maxValue)
+                    {
+                        block.maxValue = child.maxValue;
+                        block.maxIndex = child.maxIndex;
+                    }
+                }
+            }
+            level.blocks.push_back(block);
+        }
+    }
+}
+
+size_t wxChartMinMaxPyramid::GetStart() const
+{
+    return m_start;
+}
+
+size_t wxChartMinMaxPyramid::GetEnd() const
+{
+    return m_end;
+}
+
+size_t wxChartMinMaxPyramid::GetNumberOfLevels() const
+{
+    return m_levels.size();
+}
+
+void wxChartMinMaxPyramid::FindMinMax(size_t first,
+                                      size_t last,
+                                      const Accessor &value,
+                                      size_t &minIndex,
+                                      size_t &maxIndex) const
+{
+    wxDouble minValue = value(first);
+    wxDouble maxValue = minValue;
+    minIndex = maxIndex = first;
+
+    size_t i = first + 1;
+    while (i < last)
+    {
+        // Use the largest block that starts at this index
+        // and fits in the range, or the value itself if
+        // there isn't any
+        bool foundBlock = false;
+        for (size_t l = m_levels.size(); l-- > 0; )
+        {
+            size_t blockSize = GetBlockSize(l);
+            if (((i % blockSize) != 0) || ((i + blockSize) > last))
+            {
+                continue;
+            }
+            const Level &level = m_levels[l];
+            size_t b = i / blockSize;
+            if ((b < level.firstBlock) || (b >= (level.firstBlock + level.blocks.size())))
+            {
+                continue;
+            }
+
+            const Block &block = level.blocks[b - level.firstBlock];
+            if (block.minValue < minValue)
+            {
+                minValue = block.minValue;
+                minIndex = block.minIndex;
+            }
+            if (block.maxValue > maxValue)
+            {
+                maxValue = block.maxValue;
+                maxIndex = block.maxIndex;
+            }
+            i += blockSize;
+            foundBlock = true;
+            break;
+        }
+
+        if (!foundBlock)
+        {
+            wxDouble v = value(i);
+            if (v < minValue)
+            {
+                minValue = v;
+                minIndex = i;
+            }
+            if (v > maxValue)
+            {
+                maxValue = v;
+                maxIndex = i;
+            }
+            ++i;
+        }
+    }
+}
+
+void wxChartMinMaxPyramid::Decimate(const wxVector<size_t> &boundaries,
+                                    const Accessor &value,
+                                    wxVector<size_t> &indices) const
+{
+    indices.clear();
+    for (size_t c = 0; (c + 1) < boundaries.size(); ++c)
+    {
+        size_t first = boundaries[c];
+        size_t last = boundaries[c + 1];
+        if (first >= last)
+        {
+            continue;
+        }
+
+        if ((last - first) <= 4)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                indices.push_back(i);
+            }
+            continue;
+        }
+
+        size_t minIndex;
+        size_t maxIndex;
+        FindMinMax(first, last, value, minIndex, maxIndex);
+
+        size_t candidates[4] = { first, (minIndex < maxIndex) ? minIndex : maxIndex,
+            (minIndex < maxIndex) ? maxIndex : minIndex, last - 1 };
+        for (size_t j = 0; j < 4; ++j)
+        {
+            if ((j == 0) || (candidates[j] != candidates[j - 1]))
+            {
+                indices.push_back(candidates[j]);
+            }
+        }
+    }
+}
+
+size_t wxChartMinMaxPyramid::GetBlockSize(size_t level) const
+{
+    size_t blockSize = m_blockSize;
+    for (size_t l = 0; l < level; ++l)
+    {
+        blockSize *= m_blockSize;
+    }
+    return blockSize;
+}
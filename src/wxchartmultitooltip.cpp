@@ -34,20 +34,54 @@
 #include "wxchartmultitooltip.h"
 #include "wxchartutilities.h"
 #include <wx/brush.h>
+#include <cmath>
 
 wxChartMultiTooltip::wxChartMultiTooltip(const wxString &title)
-    : m_title(title)
+    : m_title(title), m_needsFit(true), m_outerX(0), m_outerY(0),
+    m_outerWidth(0), m_outerHeight(0), m_innerX(0), m_innerY(0)
 {
 }
 
 wxChartMultiTooltip::wxChartMultiTooltip(const wxString &title,
     const wxChartMultiTooltipOptions &options)
-    : m_title(title), m_options(options)
+    : m_title(title), m_options(options), m_needsFit(true), m_outerX(0),
+    m_outerY(0), m_outerWidth(0), m_outerHeight(0), m_innerX(0), m_innerY(0)
 {
 }
 
 void wxChartMultiTooltip::Draw(wxGraphicsContext &gc)
 {
+    Fit(gc);
+
+    // Draw the background
+    wxGraphicsPath path = gc.CreatePath();
+    path.AddRoundedRectangle(m_outerX, m_outerY, m_outerWidth, m_outerHeight,
+        m_options.GetCornerRadius());
+    wxBrush brush(m_options.GetBackgroundColor());
+    gc.SetBrush(brush);
+    gc.FillPath(path);
+
+    if (m_options.ShowTitle())
+    {
+        // Draw the title
+        gc.SetFont(m_options.GetTitleFontOptions().GetFont(), m_options.GetTitleFontOptions().GetColor());
+        gc.DrawText(m_title, m_innerX, m_innerY);
+    }
+
+    // Draw the lines
+    for (size_t i = 0; i < m_lines.size(); ++i)
+    {
+        m_lines[i].Draw(gc);
+    }
+}
+
+void wxChartMultiTooltip::Fit(wxGraphicsContext &gc)
+{
+    if (!m_needsFit)
+    {
+        return;
+    }
+
     // First we will compute the size of each of the lines
     // of the multi-tooltip and its total size.
     /////
@@ -164,31 +198,23 @@ void wxChartMultiTooltip::Draw(wxGraphicsContext &gc)
         y += (m_lines[i].GetSize().GetHeight() + m_options.GetLineSpacing());
     }
 
+    m_outerX = outerX;
+    m_outerY = outerY;
+    m_outerWidth = totalOuterWidth;
+    m_outerHeight = totalOuterHeight;
+    m_innerX = innerX;
+    m_innerY = innerY;
 
+    m_needsFit = false;
+}
 
-    // And finally draw everything
-    /////
-
-    // Draw the background
-    wxGraphicsPath path = gc.CreatePath();
-    path.AddRoundedRectangle(outerX, outerY, totalOuterWidth, totalOuterHeight,
-        m_options.GetCornerRadius());
-    wxBrush brush(m_options.GetBackgroundColor());
-    gc.SetBrush(brush);
-    gc.FillPath(path);
-
-    if (m_options.ShowTitle())
-    {
-        // Draw the title
-        gc.SetFont(titleFont, m_options.GetTitleFontOptions().GetColor());
-        gc.DrawText(m_title, innerX, innerY);
-    }
-
-    // Draw the lines
-    for (size_t i = 0; i < m_lines.size(); ++i)
-    {
-        m_lines[i].Draw(gc);
-    }
+wxRect wxChartMultiTooltip::GetBounds() const
+{
+    int left = floor(m_outerX);
+    int top = floor(m_outerY);
+    int right = ceil(m_outerX + m_outerWidth);
+    int bottom = ceil(m_outerY + m_outerHeight);
+    return wxRect(left, top, right - left, bottom - top);
 }
 
 void wxChartMultiTooltip::AddTooltip(const wxChartTooltip &tooltip)
@@ -200,4 +226,5 @@ void wxChartMultiTooltip::AddTooltip(const wxChartTooltip &tooltip)
         tooltip.GetProvider()->GetTooltipText(), 
         wxChartLegendLineOptions(m_options.GetTextFontOptions())
         ));
+    m_needsFit = true;
 }
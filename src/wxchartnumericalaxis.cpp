@@ -41,36 +41,7 @@ wxChartNumericalAxis::wxChartNumericalAxis(const std::string &id,
     : wxChartAxis(id, options),
     m_minValue(minValue), m_maxValue(maxValue)
 {
-    wxDouble effectiveMinXValue = minValue;
-    if (options.GetStartValueMode() == wxCHARTAXISVALUEMODE_EXPLICIT)
-    {
-        effectiveMinXValue = options.GetStartValue();
-    }
-    wxDouble effectiveMaxXValue = maxValue;
-    if (options.GetEndValueMode() == wxCHARTAXISVALUEMODE_EXPLICIT)
-    {
-        effectiveMaxXValue = options.GetEndValue();
-    }
-
-    wxDouble graphMinXValue;
-    wxDouble graphMaxXValue;
-    wxDouble xValueRange = 0;
-    size_t steps = 0;
-    wxDouble stepValue = 0;
-    wxChartUtilities::CalculateGridRange(effectiveMinXValue, effectiveMaxXValue,
-        graphMinXValue, graphMaxXValue, xValueRange, steps, stepValue);
-
-    SetMinValue(graphMinXValue);
-    SetMaxValue(graphMaxXValue);
-
-    wxVector<wxChartLabel> xLabels;
-    wxChartUtilities::BuildNumericalLabels(
-        GetMinValue(),
-        steps,
-        stepValue,
-        wxChartLabelOptions(options.GetFontOptions(), false, wxChartBackgroundOptions(*wxWHITE, 0)),
-        xLabels);
-    SetLabels(xLabels);
+    UpdateRange(minValue, maxValue);
 }
 
 wxChartNumericalAxis::ptr wxChartNumericalAxis::make_shared(const std::string &id, 
@@ -100,3 +71,51 @@ void wxChartNumericalAxis::SetMaxValue(wxDouble maxValue)
 {
     m_maxValue = maxValue;
 }
+
+bool wxChartNumericalAxis::UpdateRange(wxDouble minValue, wxDouble maxValue)
+{
+    const wxChartAxisOptions &options = GetOptions();
+
+    wxDouble effectiveMinValue = minValue;
+    if (options.GetStartValueMode() == wxCHARTAXISVALUEMODE_EXPLICIT)
+    {
+        effectiveMinValue = options.GetStartValue();
+    }
+    wxDouble effectiveMaxValue = maxValue;
+    if (options.GetEndValueMode() == wxCHARTAXISVALUEMODE_EXPLICIT)
+    {
+        effectiveMaxValue = options.GetEndValue();
+    }
+
+    wxDouble graphMinValue;
+    wxDouble graphMaxValue;
+    wxDouble valueRange = 0;
+    size_t steps = 0;
+    wxDouble stepValue = 0;
+    wxChartUtilities::CalculateGridRange(effectiveMinValue, effectiveMaxValue,
+        graphMinValue, graphMaxValue, valueRange, steps, stepValue);
+
+    // The grid range snaps to round values so small pans and zooms
+    // often end up with the same tick marks, in which case the labels
+    // and their measured sizes can be kept as they are.
+    if ((GetLabels().size() == (steps + 1)) &&
+        (graphMinValue == m_minValue) &&
+        (graphMaxValue == m_maxValue))
+    {
+        return false;
+    }
+
+    SetMinValue(graphMinValue);
+    SetMaxValue(graphMaxValue);
+
+    wxVector<wxChartLabel> labels;
+    wxChartUtilities::BuildNumericalLabels(
+        GetMinValue(),
+        steps,
+        stepValue,
+        wxChartLabelOptions(options.GetFontOptions(), false, wxChartBackgroundOptions(*wxWHITE, 0)),
+        labels);
+    SetLabels(labels);
+
+    return true;
+}
@@ -32,8 +32,6 @@
 */
 
 #include "wxchartpoint.h"
-#include <wx/pen.h>
-#include <wx/brush.h>
 
 wxChartPoint::wxChartPoint(wxDouble x,
                            wxDouble y, 
@@ -59,15 +57,37 @@ wxChartPoint::wxChartPoint(wxDouble x,
 void wxChartPoint::Draw(wxGraphicsContext &gc) const
 {
     wxGraphicsPath path = gc.CreatePath();
-    path.AddArc(m_position.m_x, m_position.m_y, m_radius, 0, 2 * M_PI, false);
-    path.CloseSubpath();
+    path.AddCircle(m_position.m_x, m_position.m_y, m_radius);
 
-    wxBrush brush(m_options.GetFillColor());
-    gc.SetBrush(brush);
+    gc.SetBrush(m_options.GetBrush());
     gc.FillPath(path);
 
-    wxPen pen(m_options.GetStrokeColor(), m_options.GetStrokeWidth());
-    gc.SetPen(pen);
+    gc.SetPen(m_options.GetPen());
+    gc.StrokePath(path);
+}
+
+void wxChartPoint::DrawAll(wxGraphicsContext &gc,
+                           const wxVector<wxPoint2DDouble> &positions,
+                           wxDouble radius,
+                           const wxChartPointOptions &options)
+{
+    if (positions.empty())
+    {
+        return;
+    }
+
+    // Each circle is a separate closed subpath
+    wxGraphicsPath path = gc.CreatePath();
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        path.AddCircle(positions[i].m_x, positions[i].m_y, radius);
+    }
+
+    // Overlapping circles must not cancel each other out
+    gc.SetBrush(options.GetBrush());
+    gc.FillPath(path, wxWINDING_RULE);
+
+    gc.SetPen(options.GetPen());
     gc.StrokePath(path);
 }
 
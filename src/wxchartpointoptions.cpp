@@ -26,7 +26,8 @@ wxChartPointOptions::wxChartPointOptions(unsigned int strokeWidth,
                                          const wxColor &strokeColor,
                                          const wxColor &fillColor)
     : m_strokeWidth(strokeWidth), m_strokeColor(strokeColor),
-    m_fillColor(fillColor)
+    m_fillColor(fillColor), m_pen(strokeColor, strokeWidth),
+    m_brush(fillColor)
 {
 }
 
@@ -44,3 +45,13 @@ const wxColor& wxChartPointOptions::GetFillColor() const
 {
     return m_fillColor;
 }
+
+const wxPen& wxChartPointOptions::GetPen() const
+{
+    return m_pen;
+}
+
+const wxBrush& wxChartPointOptions::GetBrush() const
+{
+    return m_brush;
+}
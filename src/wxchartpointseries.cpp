@@ -0,0 +1,479 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartpointseries.h"
+#include <algorithm>
+
+wxChartPointSeries::wxChartPointSeries()
+    : m_start(0), m_count(0), m_maxCount(0), m_maxXSpan(0),
+    m_usePyramid(false), m_removed(0), m_minX(true), m_maxX(false),
+    m_minY(true), m_maxY(false)
+{
+}
+
+size_t wxChartPointSeries::GetCount() const
+{
+    return m_count;
+}
+
+void wxChartPointSeries::Reserve(size_t count)
+{
+    if (m_maxCount > 0)
+    {
+        // The buffer is already allocated
+        return;
+    }
+    if (count > m_x.size())
+    {
+        SetCapacity(count);
+    }
+    m_positions.reserve(count);
+}
+
+void wxChartPointSeries::Clear()
+{
+    m_start = 0;
+    m_count = 0;
+    m_positions.clear();
+    m_index.Clear();
+    m_removed = 0;
+    m_pyramid.Clear();
+    m_minX.Clear();
+    m_maxX.Clear();
+    m_minY.Clear();
+    m_maxY.Clear();
+}
+
+size_t wxChartPointSeries::Append(wxDouble x, wxDouble y)
+{
+    size_t removed = 0;
+    if ((m_maxCount > 0) && (m_count == m_maxCount))
+    {
+        RemoveFirst();
+        ++removed;
+    }
+    else if (m_count == m_x.size())
+    {
+        SetCapacity((m_count < 8) ? 16 : (2 * m_count));
+    }
+
+    size_t index = GetStorageIndex(m_count);
+    m_x[index] = x;
+    m_y[index] = y;
+    ++m_count;
+    m_positions.push_back(wxPoint2DDouble(0, 0));
+    PushExtents(m_removed + m_count - 1, x, y);
+
+    if (m_maxXSpan > 0)
+    {
+        while ((m_count > 1) && ((x - m_x[m_start]) > m_maxXSpan))
+        {
+            RemoveFirst();
+            ++removed;
+        }
+    }
+
+    if (m_usePyramid)
+    {
+        UpdatePyramid();
+    }
+
+    return removed;
+}
+
+size_t wxChartPointSeries::Append(const wxVector<wxPoint2DDouble> &values)
+{
+    Reserve(m_count + values.size());
+    size_t removed = 0;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        removed += Append(values[i].m_x, values[i].m_y);
+    }
+    return removed;
+}
+
+size_t wxChartPointSeries::RemoveBeforeX(wxDouble x)
+{
+    size_t removed = 0;
+    while ((m_count > 0) && (m_x[m_start] < x))
+    {
+        RemoveFirst();
+        ++removed;
+    }
+
+    if (removed > 0)
+    {
+        // Without a retention window the extrema don't keep
+        // the candidates that replace the removed points
+        if ((m_maxCount == 0) && (m_maxXSpan == 0))
+        {
+            ResetExtents();
+        }
+        if (m_usePyramid)
+        {
+            UpdatePyramid();
+        }
+    }
+
+    return removed;
+}
+
+size_t wxChartPointSeries::GetMaxCount() const
+{
+    return m_maxCount;
+}
+
+void wxChartPointSeries::SetMaxCount(size_t maxCount)
+{
+    m_maxCount = maxCount;
+    if (m_maxCount > 0)
+    {
+        while (m_count > m_maxCount)
+        {
+            RemoveFirst();
+        }
+        SetCapacity(m_maxCount);
+    }
+    // The candidates that were not needed without a
+    // retention window may be needed now
+    ResetExtents();
+}
+
+wxDouble wxChartPointSeries::GetMaxXSpan() const
+{
+    return m_maxXSpan;
+}
+
+void wxChartPointSeries::SetMaxXSpan(wxDouble maxXSpan)
+{
+    m_maxXSpan = maxXSpan;
+    if ((m_maxXSpan > 0) && (m_count > 1))
+    {
+        wxDouble x = GetX(m_count - 1);
+        while ((m_count > 1) && ((x - m_x[m_start]) > m_maxXSpan))
+        {
+            RemoveFirst();
+        }
+    }
+    ResetExtents();
+}
+
+bool wxChartPointSeries::UsesMinMaxPyramid() const
+{
+    return m_usePyramid;
+}
+
+void wxChartPointSeries::SetUseMinMaxPyramid(bool use)
+{
+    m_usePyramid = use;
+    m_pyramid.Clear();
+    if (m_usePyramid)
+    {
+        UpdatePyramid();
+    }
+}
+
+wxDouble wxChartPointSeries::GetX(size_t index) const
+{
+    return m_x[GetStorageIndex(index)];
+}
+
+wxDouble wxChartPointSeries::GetY(size_t index) const
+{
+    return m_y[GetStorageIndex(index)];
+}
+
+wxPoint2DDouble wxChartPointSeries::GetValue(size_t index) const
+{
+    size_t storageIndex = GetStorageIndex(index);
+    return wxPoint2DDouble(m_x[storageIndex], m_y[storageIndex]);
+}
+
+void wxChartPointSeries::SetExtentsTransforms(const std::function<wxDouble(wxDouble)> &transformX,
+                                              const std::function<wxDouble(wxDouble)> &transformY)
+{
+    m_transformX = transformX;
+    m_transformY = transformY;
+    ResetExtents();
+}
+
+bool wxChartPointSeries::GetExtents(wxDouble &minX,
+                                    wxDouble &maxX,
+                                    wxDouble &minY,
+                                    wxDouble &maxY) const
+{
+    if (m_count == 0)
+    {
+        return false;
+    }
+
+    minX = m_minX.GetValue();
+    maxX = m_maxX.GetValue();
+    minY = m_minY.GetValue();
+    maxY = m_maxY.GetValue();
+    return true;
+}
+
+const wxPoint2DDouble& wxChartPointSeries::GetPosition(size_t index) const
+{
+    return m_positions[index];
+}
+
+const wxVector<wxPoint2DDouble>& wxChartPointSeries::GetPositions() const
+{
+    return m_positions;
+}
+
+void wxChartPointSeries::SetPosition(size_t index,
+                                     const wxPoint2DDouble &position)
+{
+    m_positions[index] = position;
+}
+
+void wxChartPointSeries::BuildIndex(wxDouble cellSize)
+{
+    m_index.Build(m_positions, cellSize);
+}
+
+void wxChartPointSeries::FindInXRange(wxDouble minX,
+                                      wxDouble maxX,
+                                      wxVector<size_t> &indices) const
+{
+    m_index.FindInXRange(m_positions, minX, maxX, indices);
+}
+
+void wxChartPointSeries::FindInXRange(const wxVector<size_t> &subset,
+                                      wxDouble minX,
+                                      wxDouble maxX,
+                                      wxVector<size_t> &indices) const
+{
+    wxVector<size_t>::const_iterator first = std::lower_bound(subset.begin(), subset.end(), minX,
+        [this](size_t index, wxDouble x) { return (m_positions[index].m_x < x); });
+    wxVector<size_t>::const_iterator last = std::upper_bound(first, subset.end(), maxX,
+        [this](wxDouble x, size_t index) { return (x < m_positions[index].m_x); });
+    for (; first != last; ++first)
+    {
+        indices.push_back(*first);
+    }
+}
+
+void wxChartPointSeries::FindInRadius(const wxPoint2DDouble &center,
+                                      wxDouble radius,
+                                      wxVector<size_t> &indices) const
+{
+    m_index.FindInRadius(m_positions, center, radius, indices);
+}
+
+size_t wxChartPointSeries::FindFirstX(wxDouble x,
+                                      const std::function<wxDouble(wxDouble)> &transformX) const
+{
+    size_t first = 0;
+    size_t count = m_count;
+    while (count > 0)
+    {
+        size_t step = count / 2;
+        if (transformX(GetX(first + step)) < x)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    return first;
+}
+
+void wxChartPointSeries::FindMinMaxY(size_t first,
+                                     size_t last,
+                                     size_t &minIndex,
+                                     size_t &maxIndex) const
+{
+    m_pyramid.FindMinMax(first + m_removed, last + m_removed,
+        [this](size_t index) { return GetY(index - m_removed); },
+        minIndex, maxIndex);
+    minIndex -= m_removed;
+    maxIndex -= m_removed;
+}
+
+void wxChartPointSeries::Decimate(const wxVector<size_t> &boundaries,
+                                  wxVector<size_t> &indices) const
+{
+    wxVector<size_t> pyramidBoundaries;
+    pyramidBoundaries.reserve(boundaries.size());
+    for (size_t i = 0; i < boundaries.size(); ++i)
+    {
+        pyramidBoundaries.push_back(boundaries[i] + m_removed);
+    }
+
+    m_pyramid.Decimate(pyramidBoundaries,
+        [this](size_t index) { return GetY(index - m_removed); },
+        indices);
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        indices[i] -= m_removed;
+    }
+}
+
+size_t wxChartPointSeries::GetStorageIndex(size_t index) const
+{
+    size_t storageIndex = m_start + index;
+    if (storageIndex >= m_x.size())
+    {
+        storageIndex -= m_x.size();
+    }
+    return storageIndex;
+}
+
+void wxChartPointSeries::SetCapacity(size_t capacity)
+{
+    // Copy the points to the new buffer so that the
+    // first point is at the start
+    wxVector<wxDouble> x(capacity);
+    wxVector<wxDouble> y(capacity);
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        size_t storageIndex = GetStorageIndex(i);
+        x[i] = m_x[storageIndex];
+        y[i] = m_y[storageIndex];
+    }
+    m_x = x;
+    m_y = y;
+    m_start = 0;
+}
+
+void wxChartPointSeries::RemoveFirst()
+{
+    ++m_start;
+    if (m_start == m_x.size())
+    {
+        m_start = 0;
+    }
+    --m_count;
+    // The positions are stale until they are updated
+    // by the chart so only the size needs to be kept
+    // in sync
+    m_positions.pop_back();
+    ++m_removed;
+
+    m_minX.PopBefore(m_removed);
+    m_maxX.PopBefore(m_removed);
+    m_minY.PopBefore(m_removed);
+    m_maxY.PopBefore(m_removed);
+}
+
+void wxChartPointSeries::UpdatePyramid()
+{
+    m_pyramid.Update(m_removed, m_removed + m_count,
+        [this](size_t index) { return GetY(index - m_removed); });
+}
+
+void wxChartPointSeries::PushExtents(size_t sequence,
+                                     wxDouble x,
+                                     wxDouble y)
+{
+    if (m_transformX)
+    {
+        x = m_transformX(x);
+    }
+    if (m_transformY)
+    {
+        y = m_transformY(y);
+    }
+
+    // Without a retention window the points are only removed
+    // by Clear() and RemoveBeforeX() which recompute the
+    // extents so the candidates are not needed
+    bool keepCandidates = ((m_maxCount > 0) || (m_maxXSpan > 0));
+    m_minX.Push(sequence, x, keepCandidates);
+    m_maxX.Push(sequence, x, keepCandidates);
+    m_minY.Push(sequence, y, keepCandidates);
+    m_maxY.Push(sequence, y, keepCandidates);
+}
+
+void wxChartPointSeries::ResetExtents()
+{
+    m_minX.Clear();
+    m_maxX.Clear();
+    m_minY.Clear();
+    m_maxY.Clear();
+
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        PushExtents(m_removed + i, GetX(i), GetY(i));
+    }
+}
+
+wxChartPointSeries::WindowExtremum::WindowExtremum(bool minimum)
+    : m_minimum(minimum)
+{
+}
+
+void wxChartPointSeries::WindowExtremum::Clear()
+{
+    m_candidates.clear();
+}
+
+void wxChartPointSeries::WindowExtremum::Push(size_t sequence,
+                                              wxDouble value,
+                                              bool keepCandidates)
+{
+    if (!keepCandidates)
+    {
+        if (m_candidates.empty() || !Precedes(m_candidates.front().second, value))
+        {
+            m_candidates.clear();
+            m_candidates.push_back(std::make_pair(sequence, value));
+        }
+        return;
+    }
+
+    // The candidates that are not more extreme than the new
+    // value will be removed before it so they can't be the
+    // extremum anymore
+    while (!m_candidates.empty() && Precedes(value, m_candidates.back().second))
+    {
+        m_candidates.pop_back();
+    }
+    m_candidates.push_back(std::make_pair(sequence, value));
+}
+
+void wxChartPointSeries::WindowExtremum::PopBefore(size_t sequence)
+{
+    while (!m_candidates.empty() && (m_candidates.front().first < sequence))
+    {
+        m_candidates.pop_front();
+    }
+}
+
+wxDouble wxChartPointSeries::WindowExtremum::GetValue() const
+{
+    return m_candidates.front().second;
+}
+
+bool wxChartPointSeries::WindowExtremum::Precedes(wxDouble a,
+                                                  wxDouble b) const
+{
+    return (m_minimum ? (a <= b) : (a >= b));
+}
@@ -0,0 +1,138 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartpreparationworker.h"
+
+wxChartPreparationWorker::wxChartPreparationWorker()
+    : m_stop(false), m_busy(false), m_pendingGeneration(0),
+    m_generation(0), m_cancelled(false)
+{
+}
+
+wxChartPreparationWorker::~wxChartPreparationWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_pendingJob = Job();
+        m_cancelled = true;
+    }
+    m_condition.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void wxChartPreparationWorker::SetCallback(const Callback &callback)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_callback = callback;
+}
+
+unsigned long wxChartPreparationWorker::Submit(const Job &job)
+{
+    unsigned long generation;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        generation = ++m_generation;
+        m_pendingJob = job;
+        m_pendingGeneration = generation;
+        if (m_busy)
+        {
+            m_cancelled = true;
+        }
+        if (!m_thread.joinable())
+        {
+            m_thread = std::thread(&wxChartPreparationWorker::Run, this);
+        }
+    }
+    m_condition.notify_all();
+    return generation;
+}
+
+unsigned long wxChartPreparationWorker::GetGeneration() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_generation;
+}
+
+wxChartRenderSnapshot::ptr wxChartPreparationWorker::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_snapshot;
+}
+
+void wxChartPreparationWorker::Wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return (!m_pendingJob && !m_busy); });
+}
+
+void wxChartPreparationWorker::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_condition.wait(lock, [this]() { return (m_stop || m_pendingJob); });
+        if (m_stop)
+        {
+            break;
+        }
+
+        Job job;
+        std::swap(job, m_pendingJob);
+        unsigned long generation = m_pendingGeneration;
+        m_busy = true;
+        m_cancelled = false;
+        lock.unlock();
+
+        wxChartRenderSnapshot* snapshot = new wxChartRenderSnapshot(generation);
+        job(*snapshot, m_cancelled);
+
+        // The flag is only set while holding the lock so
+        // it can't change between the test and the publication
+        lock.lock();
+        Callback callback;
+        if (!m_cancelled)
+        {
+            m_snapshot.reset(snapshot);
+            callback = m_callback;
+        }
+        else
+        {
+            delete snapshot;
+        }
+        lock.unlock();
+
+        // The owner is notified without holding the lock
+        // so that it can get the snapshot right away
+        if (callback)
+        {
+            callback();
+        }
+
+        lock.lock();
+        m_busy = false;
+        m_condition.notify_all();
+    }
+}
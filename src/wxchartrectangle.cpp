@@ -32,8 +32,6 @@
 */
 
 #include "wxchartrectangle.h"
-#include <wx/pen.h>
-#include <wx/brush.h>
 
 wxChartRectangle::wxChartRectangle(wxDouble x,
                                    wxDouble y,
@@ -46,46 +44,10 @@ wxChartRectangle::wxChartRectangle(wxDouble x,
 
 void wxChartRectangle::Draw(wxGraphicsContext &gc) const
 {
-    wxGraphicsPath path = gc.CreatePath();
-
-    path.AddRectangle(m_position.m_x, m_position.m_y, m_width, m_height);
-
-    wxBrush brush(m_options.GetFillColor());
-    gc.SetBrush(brush);
-    gc.FillPath(path);
-
-    if (m_options.GetDirections() == wxALL)
-    {
-        wxPen pen(m_options.GetStrokeColor(), 2);
-        gc.SetPen(pen);
-        gc.StrokePath(path);
-    }
-    else
-    {
-        wxPen pen(m_options.GetStrokeColor(), 2);
-        gc.SetPen(pen);
-
-        if (m_options.GetDirections() & wxTOP)
-        {
-            gc.StrokeLine(m_position.m_x, m_position.m_y, 
-                m_position.m_x + m_width, m_position.m_y);
-        }
-        if (m_options.GetDirections() & wxRIGHT)
-        {
-            gc.StrokeLine(m_position.m_x + m_width, m_position.m_y, 
-                m_position.m_x + m_width, m_position.m_y + m_height);
-        }
-        if (m_options.GetDirections() & wxBOTTOM)
-        {
-            gc.StrokeLine(m_position.m_x, m_position.m_y + m_height,
-                m_position.m_x + m_width, m_position.m_y + m_height);
-        }
-        if (m_options.GetDirections() & wxLEFT)
-        {
-            gc.StrokeLine(m_position.m_x, m_position.m_y,
-                m_position.m_x, m_position.m_y + m_height);
-        }
-    }
+    wxGraphicsPath fillPath = gc.CreatePath();
+    wxGraphicsPath strokePath = gc.CreatePath();
+    AddToPaths(fillPath, strokePath);
+    DrawPaths(gc, fillPath, strokePath, m_options);
 }
 
 bool wxChartRectangle::HitTest(const wxPoint &point) const
@@ -132,3 +94,54 @@ void wxChartRectangle::SetSize(wxDouble width, wxDouble height)
     m_width = width;
     m_height = height;
 }
+
+const wxChartRectangleOptions& wxChartRectangle::GetOptions() const
+{
+    return m_options;
+}
+
+void wxChartRectangle::AddToPaths(wxGraphicsPath &fillPath,
+                                  wxGraphicsPath &strokePath) const
+{
+    fillPath.AddRectangle(m_position.m_x, m_position.m_y, m_width, m_height);
+
+    int directions = m_options.GetDirections();
+    if (directions == wxALL)
+    {
+        strokePath.AddRectangle(m_position.m_x, m_position.m_y, m_width, m_height);
+        return;
+    }
+
+    if (directions & wxTOP)
+    {
+        strokePath.MoveToPoint(m_position.m_x, m_position.m_y);
+        strokePath.AddLineToPoint(m_position.m_x + m_width, m_position.m_y);
+    }
+    if (directions & wxRIGHT)
+    {
+        strokePath.MoveToPoint(m_position.m_x + m_width, m_position.m_y);
+        strokePath.AddLineToPoint(m_position.m_x + m_width, m_position.m_y + m_height);
+    }
+    if (directions & wxBOTTOM)
+    {
+        strokePath.MoveToPoint(m_position.m_x, m_position.m_y + m_height);
+        strokePath.AddLineToPoint(m_position.m_x + m_width, m_position.m_y + m_height);
+    }
+    if (directions & wxLEFT)
+    {
+        strokePath.MoveToPoint(m_position.m_x, m_position.m_y);
+        strokePath.AddLineToPoint(m_position.m_x, m_position.m_y + m_height);
+    }
+}
+
+void wxChartRectangle::DrawPaths(wxGraphicsContext &gc,
+                                 const wxGraphicsPath &fillPath,
+                                 const wxGraphicsPath &strokePath,
+                                 const wxChartRectangleOptions &options)
+{
+    gc.SetBrush(options.GetBrush());
+    gc.FillPath(fillPath);
+
+    gc.SetPen(options.GetPen());
+    gc.StrokePath(strokePath);
+}
@@ -25,7 +25,8 @@
 wxChartRectangleOptions::wxChartRectangleOptions(const wxColor &fillColor,
                                                  const wxColor &strokeColor, 
                                                  int directions)
-    : m_fillColor(fillColor), m_strokeColor(strokeColor), m_directions(directions)
+    : m_fillColor(fillColor), m_strokeColor(strokeColor), m_directions(directions),
+    m_pen(strokeColor, 2), m_brush(fillColor)
 {
 }
 
@@ -43,3 +44,13 @@ int wxChartRectangleOptions::GetDirections() const
 {
     return m_directions;
 }
+
+const wxPen& wxChartRectangleOptions::GetPen() const
+{
+    return m_pen;
+}
+
+const wxBrush& wxChartRectangleOptions::GetBrush() const
+{
+    return m_brush;
+}
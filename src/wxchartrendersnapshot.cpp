@@ -0,0 +1,101 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartrendersnapshot.h"
+
+const wxVector<wxPoint2DDouble>& wxChartRenderSnapshot::Series::GetLine() const
+{
+    return m_line;
+}
+
+wxVector<wxPoint2DDouble>& wxChartRenderSnapshot::Series::GetLine()
+{
+    return m_line;
+}
+
+const wxVector<wxPoint2DDouble>& wxChartRenderSnapshot::Series::GetMarkers() const
+{
+    return m_markers;
+}
+
+wxVector<wxPoint2DDouble>& wxChartRenderSnapshot::Series::GetMarkers()
+{
+    return m_markers;
+}
+
+const wxVector<size_t>& wxChartRenderSnapshot::Series::GetMarkerIndices() const
+{
+    return m_markerIndices;
+}
+
+wxVector<size_t>& wxChartRenderSnapshot::Series::GetMarkerIndices()
+{
+    return m_markerIndices;
+}
+
+const wxVector<wxPoint2DDouble>& wxChartRenderSnapshot::Series::GetMarkerValues() const
+{
+    return m_markerValues;
+}
+
+wxVector<wxPoint2DDouble>& wxChartRenderSnapshot::Series::GetMarkerValues()
+{
+    return m_markerValues;
+}
+
+void wxChartRenderSnapshot::Series::BuildIndex()
+{
+    m_index.Build(m_markers);
+}
+
+void wxChartRenderSnapshot::Series::FindInXRange(wxDouble minX,
+                                                 wxDouble maxX,
+                                                 wxVector<size_t> &markers) const
+{
+    m_index.FindInXRange(m_markers, minX, maxX, markers);
+}
+
+wxChartRenderSnapshot::wxChartRenderSnapshot(unsigned long generation)
+    : m_generation(generation)
+{
+}
+
+unsigned long wxChartRenderSnapshot::GetGeneration() const
+{
+    return m_generation;
+}
+
+size_t wxChartRenderSnapshot::GetSeriesCount() const
+{
+    return m_series.size();
+}
+
+const wxChartRenderSnapshot::Series& wxChartRenderSnapshot::GetSeries(size_t index) const
+{
+    return m_series[index];
+}
+
+wxChartRenderSnapshot::Series& wxChartRenderSnapshot::AddSeries()
+{
+    m_series.push_back(Series());
+    return m_series.back();
+}
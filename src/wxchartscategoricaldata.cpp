@@ -37,6 +37,55 @@ wxChartsCategoricalData::ptr wxChartsCategoricalData::make_shared(const wxVector
 void wxChartsCategoricalData::AddDataset(wxChartsDoubleDataset::ptr dataset)
 {
     m_datasets.push_back(dataset);
+    for (size_t i = 0; i < m_observers.size(); ++i)
+    {
+        m_observers[i]->OnDatasetAdded(*this, m_datasets.size() - 1);
+    }
+}
+
+void wxChartsCategoricalData::RemoveDataset(size_t index)
+{
+    wxCHECK_RET(index < m_datasets.size(), "Invalid dataset index");
+
+    m_datasets.erase(m_datasets.begin() + index);
+    for (size_t i = 0; i < m_observers.size(); ++i)
+    {
+        m_observers[i]->OnDatasetRemoved(*this, index);
+    }
+}
+
+void wxChartsCategoricalData::AppendCategory(const wxString &category,
+                                             const wxVector<wxDouble> &values)
+{
+    m_categories.push_back(category);
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        m_datasets[i]->AppendValue((i < values.size()) ? values[i] : 0);
+    }
+    for (size_t i = 0; i < m_observers.size(); ++i)
+    {
+        m_observers[i]->OnCategoryAppended(*this);
+    }
+}
+
+void wxChartsCategoricalData::SetValue(size_t datasetIndex,
+                                       size_t index,
+                                       wxDouble value)
+{
+    wxCHECK_RET(datasetIndex < m_datasets.size(), "Invalid dataset index");
+    wxChartsDoubleDataset &dataset = *m_datasets[datasetIndex];
+    wxCHECK_RET(index < dataset.GetData().size(), "Invalid value index");
+    wxDouble oldValue = dataset.GetData()[index];
+    if (value == oldValue)
+    {
+        return;
+    }
+
+    dataset.SetValue(index, value);
+    for (size_t i = 0; i < m_observers.size(); ++i)
+    {
+        m_observers[i]->OnValueChanged(*this, datasetIndex, index, oldValue);
+    }
 }
 
 const wxVector<wxString>& wxChartsCategoricalData::GetCategories() const
@@ -49,6 +98,19 @@ const wxVector<wxChartsDoubleDataset::ptr>& wxChartsCategoricalData::GetDatasets
     return m_datasets;
 }
 
-void wxChartsCategoricalData::AddObserver()
+void wxChartsCategoricalData::AddObserver(wxChartsCategoricalDataObserver *observer)
+{
+    m_observers.push_back(observer);
+}
+
+void wxChartsCategoricalData::RemoveObserver(wxChartsCategoricalDataObserver *observer)
 {
+    for (size_t i = 0; i < m_observers.size(); ++i)
+    {
+        if (m_observers[i] == observer)
+        {
+            m_observers.erase(m_observers.begin() + i);
+            break;
+        }
+    }
 }
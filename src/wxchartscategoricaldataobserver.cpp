@@ -23,3 +23,28 @@
 /// @file
 
 #include "wxchartscategoricaldataobserver.h"
+
+wxChartsCategoricalDataObserver::~wxChartsCategoricalDataObserver()
+{
+}
+
+void wxChartsCategoricalDataObserver::OnValueChanged(const wxChartsCategoricalData &data,
+                                                     size_t datasetIndex,
+                                                     size_t index,
+                                                     wxDouble oldValue)
+{
+}
+
+void wxChartsCategoricalDataObserver::OnCategoryAppended(const wxChartsCategoricalData &data)
+{
+}
+
+void wxChartsCategoricalDataObserver::OnDatasetAdded(const wxChartsCategoricalData &data,
+                                                     size_t datasetIndex)
+{
+}
+
+void wxChartsCategoricalDataObserver::OnDatasetRemoved(const wxChartsCategoricalData &data,
+                                                       size_t datasetIndex)
+{
+}
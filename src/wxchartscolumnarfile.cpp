@@ -0,0 +1,525 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#include "wxchartscolumnarfile.h"
+#include "wxchartutilities.h"
+#include "wxchartdecimation.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string.h>
+#include <stdint.h>
+#ifdef __WINDOWS__
+#include <wx/msw/wrapwin.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char Magic[8] = { 'W', 'X', 'C', 'C', 'O', 'L', '0', '1' };
+    const uint32_t Version = 1;
+    const size_t HeaderSize = 32;
+    const size_t ColumnEntrySize = 64;
+    const size_t ColumnNameSize = 48;
+
+    bool IsLittleEndian()
+    {
+        const uint16_t value = 1;
+        return (*reinterpret_cast<const unsigned char*>(&value) == 1);
+    }
+
+    uint32_t ReadUInt32(const char *data)
+    {
+        const unsigned char *bytes = reinterpret_cast<const unsigned char*>(data);
+        return (uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) |
+            (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24));
+    }
+
+    uint64_t ReadUInt64(const char *data)
+    {
+        return (uint64_t(ReadUInt32(data)) | (uint64_t(ReadUInt32(data + 4)) << 32));
+    }
+
+    void WriteUInt32(char *data, uint32_t value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+        {
+            data[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void WriteUInt64(char *data, uint64_t value)
+    {
+        WriteUInt32(data, static_cast<uint32_t>(value & 0xFFFFFFFF));
+        WriteUInt32(data + 4, static_cast<uint32_t>(value >> 32));
+    }
+}
+
+wxChartsColumnarFile::wxChartsColumnarFile()
+    : m_data(0), m_size(0), m_rowCount(0)
+{
+}
+
+wxChartsColumnarFile::~wxChartsColumnarFile()
+{
+    Close();
+}
+
+bool wxChartsColumnarFile::Open(const wxString &filename)
+{
+    Close();
+
+    // The values are used in place so they must already
+    // be in the byte order of the machine
+    if (!IsLittleEndian() || !Map(filename))
+    {
+        return false;
+    }
+
+    if (!ReadHeader())
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void wxChartsColumnarFile::Close()
+{
+    Unmap();
+    m_rowCount = 0;
+    m_columnNames.clear();
+    m_columnFlags.clear();
+    m_columns.clear();
+}
+
+bool wxChartsColumnarFile::IsOpen() const
+{
+    return (m_data != 0);
+}
+
+size_t wxChartsColumnarFile::GetRowCount() const
+{
+    return m_rowCount;
+}
+
+size_t wxChartsColumnarFile::GetColumnCount() const
+{
+    return m_columns.size();
+}
+
+const wxString& wxChartsColumnarFile::GetColumnName(size_t index) const
+{
+    return m_columnNames[index];
+}
+
+unsigned int wxChartsColumnarFile::GetColumnFlags(size_t index) const
+{
+    return m_columnFlags[index];
+}
+
+int wxChartsColumnarFile::FindColumn(const wxString &name) const
+{
+    for (size_t i = 0; i < m_columnNames.size(); ++i)
+    {
+        if (m_columnNames[i] == name)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return wxNOT_FOUND;
+}
+
+const wxDouble* wxChartsColumnarFile::GetColumn(size_t index) const
+{
+    return m_columns[index];
+}
+
+bool wxChartsColumnarFile::Write(const wxString &filename,
+                                 const wxVector<wxString> &names,
+                                 const wxVector<wxVector<wxDouble> > &columns)
+{
+    if (names.size() != columns.size())
+    {
+        return false;
+    }
+
+    uint64_t rowCount = columns.empty() ? 0 : columns[0].size();
+    for (size_t i = 1; i < columns.size(); ++i)
+    {
+        if (columns[i].size() != rowCount)
+        {
+            return false;
+        }
+    }
+
+    std::ofstream stream(filename.fn_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        return false;
+    }
+
+    char header[HeaderSize] = { 0 };
+    memcpy(header, Magic, sizeof(Magic));
+    WriteUInt32(header + 8, Version);
+    WriteUInt32(header + 12, static_cast<uint32_t>(columns.size()));
+    WriteUInt64(header + 16, rowCount);
+    stream.write(header, HeaderSize);
+
+    uint64_t offset = HeaderSize + (columns.size() * ColumnEntrySize);
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        char entry[ColumnEntrySize] = { 0 };
+        std::string name = names[i].utf8_str();
+        memcpy(entry, name.c_str(), std::min(name.size(), ColumnNameSize - 1));
+        uint32_t flags = 0;
+        // A NaN compares false to everything so a column
+        // containing one would pass for sorted
+        if (std::is_sorted(columns[i].begin(), columns[i].end()) &&
+            std::none_of(columns[i].begin(), columns[i].end(), [](wxDouble value) { return std::isnan(value); }))
+        {
+            flags |= wxCHARTSCOLUMN_SORTED;
+        }
+        WriteUInt32(entry + ColumnNameSize, flags);
+        WriteUInt64(entry + ColumnNameSize + 8, offset);
+        stream.write(entry, ColumnEntrySize);
+        offset += rowCount * sizeof(wxDouble);
+    }
+
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        if (IsLittleEndian())
+        {
+            if (rowCount > 0)
+            {
+                stream.write(reinterpret_cast<const char*>(&columns[i][0]), rowCount * sizeof(wxDouble));
+            }
+        }
+        else
+        {
+            for (size_t j = 0; j < rowCount; ++j)
+            {
+                uint64_t bits;
+                memcpy(&bits, &columns[i][j], sizeof(bits));
+                char bytes[8];
+                WriteUInt64(bytes, bits);
+                stream.write(bytes, sizeof(bytes));
+            }
+        }
+    }
+
+    return stream.good();
+}
+
+bool wxChartsColumnarFile::Map(const wxString &filename)
+{
+#ifdef __WINDOWS__
+    HANDLE file = ::CreateFileW(filename.wc_str(), GENERIC_READ, FILE_SHARE_READ,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (::GetFileSizeEx(file, &size) && (size.QuadPart > 0) &&
+        (static_cast<uint64_t>(size.QuadPart) <= static_cast<uint64_t>(SIZE_MAX)))
+    {
+        mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    if (mapping != NULL)
+    {
+        m_data = static_cast<const char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        m_size = m_data ? static_cast<size_t>(size.QuadPart) : 0;
+        // The view keeps the mapping alive
+        ::CloseHandle(mapping);
+    }
+    ::CloseHandle(file);
+#else
+    int fd = ::open(filename.fn_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat status;
+    if ((::fstat(fd, &status) == 0) && (status.st_size > 0) &&
+        (static_cast<uint64_t>(status.st_size) <= static_cast<uint64_t>(SIZE_MAX)))
+    {
+        void *data = ::mmap(NULL, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            m_data = static_cast<const char*>(data);
+            m_size = static_cast<size_t>(status.st_size);
+        }
+    }
+    // The mapping stays valid after the file is closed
+    ::close(fd);
+#endif
+
+    return (m_data != 0);
+}
+
+void wxChartsColumnarFile::Unmap()
+{
+    if (m_data)
+    {
+#ifdef __WINDOWS__
+        ::UnmapViewOfFile(m_data);
+#else
+        ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+        m_data = 0;
+        m_size = 0;
+    }
+}
+
+bool wxChartsColumnarFile::ReadHeader()
+{
+    if ((m_size < HeaderSize) || (memcmp(m_data, Magic, sizeof(Magic)) != 0) ||
+        (ReadUInt32(m_data + 8) != Version) || (ReadUInt64(m_data + 24) != 0))
+    {
+        return false;
+    }
+
+    uint64_t columnCount = ReadUInt32(m_data + 12);
+    uint64_t rowCount = ReadUInt64(m_data + 16);
+    if ((columnCount * ColumnEntrySize) > (m_size - HeaderSize) ||
+        (rowCount > (m_size / sizeof(wxDouble))))
+    {
+        return false;
+    }
+
+    const uint64_t columnSize = rowCount * sizeof(wxDouble);
+    for (size_t i = 0; i < columnCount; ++i)
+    {
+        const char *entry = m_data + HeaderSize + (i * ColumnEntrySize);
+        uint64_t offset = ReadUInt64(entry + ColumnNameSize + 8);
+        if ((ReadUInt32(entry + ColumnNameSize + 4) != 0) || ((offset % sizeof(wxDouble)) != 0) ||
+            (offset > m_size) || (columnSize > (m_size - offset)))
+        {
+            return false;
+        }
+
+        // The name may not be terminated if it uses all the bytes
+        m_columnNames.push_back(wxString::FromUTF8(std::string(entry, strnlen(entry, ColumnNameSize)).c_str()));
+        m_columnFlags.push_back(ReadUInt32(entry + ColumnNameSize));
+        m_columns.push_back(reinterpret_cast<const wxDouble*>(m_data + offset));
+    }
+    m_rowCount = static_cast<size_t>(rowCount);
+
+    return true;
+}
+
+wxChartsColumnarSeries::wxChartsColumnarSeries(wxChartsColumnarFile::ptr file,
+                                               size_t xColumn,
+                                               size_t yColumn)
+    : m_file(file), m_x(0), m_y(0), m_count(0), m_xSorted(false)
+{
+    // The indices may come from a FindColumn() call that
+    // failed, the series is then empty
+    wxCHECK_RET((xColumn < file->GetColumnCount()) && (yColumn < file->GetColumnCount()),
+        "Invalid column index");
+
+    m_x = file->GetColumn(xColumn);
+    m_y = file->GetColumn(yColumn);
+    m_count = file->GetRowCount();
+    m_xSorted = ((file->GetColumnFlags(xColumn) & wxCHARTSCOLUMN_SORTED) != 0);
+}
+
+size_t wxChartsColumnarSeries::GetCount() const
+{
+    return m_count;
+}
+
+wxPoint2DDouble wxChartsColumnarSeries::GetValue(size_t index) const
+{
+    return wxPoint2DDouble(m_x[index], m_y[index]);
+}
+
+bool wxChartsColumnarSeries::IsXSorted() const
+{
+    return m_xSorted;
+}
+
+void wxChartsColumnarSeries::FindXRange(wxDouble minX,
+                                        wxDouble maxX,
+                                        size_t &begin,
+                                        size_t &end) const
+{
+    if (m_xSorted)
+    {
+        begin = std::lower_bound(m_x, m_x + m_count, minX) - m_x;
+        end = std::upper_bound(m_x + begin, m_x + m_count, maxX) - m_x;
+    }
+    else
+    {
+        begin = 0;
+        end = m_count;
+    }
+}
+
+bool wxChartsColumnarSeries::GetExtents(wxDouble &minX,
+                                        wxDouble &maxX,
+                                        wxDouble &minY,
+                                        wxDouble &maxY) const
+{
+    if (m_count == 0)
+    {
+        return false;
+    }
+
+    bool found = false;
+    if (m_xSorted)
+    {
+        minX = m_x[0];
+        maxX = m_x[m_count - 1];
+    }
+    else
+    {
+        wxChartUtilities::UpdateExtents(m_x, m_count, 1, found, minX, maxX);
+    }
+    found = false;
+    wxChartUtilities::UpdateExtents(m_y, m_count, 1, found, minY, maxY);
+    return true;
+}
+
+void wxChartsColumnarSeries::Decimate(wxDouble minX,
+                                      wxDouble maxX,
+                                      size_t bucketCount,
+                                      wxVector<wxPoint2DDouble> &result) const
+{
+    result.clear();
+
+    size_t begin = 0;
+    size_t end = 0;
+    FindXRange(minX, maxX, begin, end);
+    const size_t count = end - begin;
+    if (bucketCount == 0)
+    {
+        bucketCount = 1;
+    }
+    wxDouble step = (maxX - minX) / bucketCount;
+    if (!(step > 0))
+    {
+        bucketCount = 1;
+    }
+
+    if (count <= (4 * bucketCount))
+    {
+        result.reserve(count);
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (m_xSorted || ((m_x[i] >= minX) && (m_x[i] <= maxX)))
+            {
+                result.push_back(GetValue(i));
+            }
+        }
+        return;
+    }
+
+    result.reserve(4 * bucketCount);
+    if (m_xSorted)
+    {
+        // Each bucket covers the same range of X values so that
+        // it maps to a pixel column, its limits are found with
+        // a binary search
+        size_t bucketBegin = begin;
+        for (size_t bucket = 0; (bucket < bucketCount) && (bucketBegin < end); ++bucket)
+        {
+            size_t bucketEnd = end;
+            if (bucket < (bucketCount - 1))
+            {
+                bucketEnd = std::lower_bound(m_x + bucketBegin, m_x + end,
+                    minX + ((bucket + 1) * step)) - m_x;
+            }
+            if (bucketEnd > bucketBegin)
+            {
+                wxChartDecimation::AppendMinMax(m_x, m_y, 1, bucketBegin, bucketEnd - 1, result);
+            }
+            bucketBegin = bucketEnd;
+        }
+        return;
+    }
+
+    // The points of a bucket aren't consecutive so the
+    // first, minimum, maximum and last points of all the
+    // buckets are found in a single pass
+    const size_t none = m_count;
+    wxVector<size_t> firstIndices(bucketCount, none);
+    wxVector<size_t> minIndices(bucketCount, none);
+    wxVector<size_t> maxIndices(bucketCount, none);
+    wxVector<size_t> lastIndices(bucketCount, none);
+    for (size_t i = begin; i < end; ++i)
+    {
+        // The comparisons are false for a NaN so it is
+        // skipped explicitly
+        if (!std::isfinite(m_x[i]) || (m_x[i] < minX) || (m_x[i] > maxX))
+        {
+            continue;
+        }
+        size_t bucket = bucketCount - 1;
+        if (bucketCount > 1)
+        {
+            bucket = std::min(static_cast<size_t>((m_x[i] - minX) / step), bucketCount - 1);
+        }
+        if (firstIndices[bucket] == none)
+        {
+            firstIndices[bucket] = minIndices[bucket] = maxIndices[bucket] = i;
+        }
+        if (m_y[i] < m_y[minIndices[bucket]])
+        {
+            minIndices[bucket] = i;
+        }
+        if (m_y[i] > m_y[maxIndices[bucket]])
+        {
+            maxIndices[bucket] = i;
+        }
+        lastIndices[bucket] = i;
+    }
+    for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        if (firstIndices[bucket] == none)
+        {
+            continue;
+        }
+        size_t indices[4] = { firstIndices[bucket],
+            std::min(minIndices[bucket], maxIndices[bucket]),
+            std::max(minIndices[bucket], maxIndices[bucket]),
+            lastIndices[bucket] };
+        for (size_t j = 0; j < 4; ++j)
+        {
+            if ((j == 0) || (indices[j] != indices[j - 1]))
+            {
+                result.push_back(GetValue(indices[j]));
+            }
+        }
+    }
+}
@@ -45,3 +45,13 @@ const wxVector<wxDouble>& wxChartsDoubleDataset::GetData() const
 {
     return m_data;
 }
+
+void wxChartsDoubleDataset::SetValue(size_t index, wxDouble value)
+{
+    m_data[index] = value;
+}
+
+void wxChartsDoubleDataset::AppendValue(wxDouble value)
+{
+    m_data.push_back(value);
+}
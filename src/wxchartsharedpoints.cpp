@@ -0,0 +1,128 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartsharedpoints.h"
+#include <algorithm>
+
+wxChartSharedPoints::wxChartSharedPoints()
+    : m_removed(0), m_count(0)
+{
+}
+
+size_t wxChartSharedPoints::GetCount() const
+{
+    return m_count;
+}
+
+const wxPoint2DDouble& wxChartSharedPoints::GetValue(size_t index) const
+{
+    size_t sequence = m_removed + index;
+    size_t block = (std::upper_bound(m_starts.begin(), m_starts.end(), sequence) - m_starts.begin()) - 1;
+    return (*m_blocks[block])[sequence - m_starts[block]];
+}
+
+void wxChartSharedPoints::Clear()
+{
+    m_blocks.clear();
+    m_starts.clear();
+    m_removed = 0;
+    m_count = 0;
+}
+
+void wxChartSharedPoints::Append(const wxVector<wxPoint2DDouble> &values)
+{
+    if (values.empty())
+    {
+        return;
+    }
+
+    m_blocks.push_back(Block(new wxVector<wxPoint2DDouble>(values)));
+    m_starts.push_back(m_removed + m_count);
+    m_count += values.size();
+
+    while (m_blocks.size() > 1)
+    {
+        size_t last = m_blocks.size() - 1;
+        // The values of the first block that were removed
+        // are not copied
+        size_t offset = std::max(m_starts[last - 1], m_removed) - m_starts[last - 1];
+        size_t previousSize = m_blocks[last - 1]->size() - offset;
+        if (previousSize > m_blocks[last]->size())
+        {
+            break;
+        }
+
+        wxVector<wxPoint2DDouble>* merged = new wxVector<wxPoint2DDouble>();
+        merged->reserve(previousSize + m_blocks[last]->size());
+        for (size_t i = offset; i < m_blocks[last - 1]->size(); ++i)
+        {
+            merged->push_back((*m_blocks[last - 1])[i]);
+        }
+        for (size_t i = 0; i < m_blocks[last]->size(); ++i)
+        {
+            merged->push_back((*m_blocks[last])[i]);
+        }
+        m_blocks[last - 1] = Block(merged);
+        m_starts[last - 1] += offset;
+        m_blocks.pop_back();
+        m_starts.pop_back();
+    }
+}
+
+void wxChartSharedPoints::RemoveFirst(size_t count)
+{
+    m_removed += count;
+    m_count -= count;
+
+    size_t released = 0;
+    while ((released < m_blocks.size()) &&
+        ((m_starts[released] + m_blocks[released]->size()) <= m_removed))
+    {
+        ++released;
+    }
+    if (released > 0)
+    {
+        m_blocks.erase(m_blocks.begin(), m_blocks.begin() + released);
+        m_starts.erase(m_starts.begin(), m_starts.begin() + released);
+    }
+}
+
+size_t wxChartSharedPoints::FindFirstX(wxDouble x,
+                                       const std::function<wxDouble(wxDouble)> &transformX) const
+{
+    size_t first = 0;
+    size_t count = m_count;
+    while (count > 0)
+    {
+        size_t step = count / 2;
+        if (transformX(GetValue(first + step).m_x) < x)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    return first;
+}
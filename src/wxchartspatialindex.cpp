@@ -0,0 +1,280 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartspatialindex.h"
+#include <algorithm>
+#include <cmath>
+
+wxChartSpatialIndex::wxChartSpatialIndex()
+    : m_count(0), m_sorted(true), m_cellSize(0), m_minX(0),
+    m_minY(0), m_columns(0), m_rows(0)
+{
+}
+
+void wxChartSpatialIndex::Build(const wxVector<wxPoint2DDouble> &positions,
+                                wxDouble cellSize)
+{
+    Clear();
+
+    m_count = positions.size();
+
+    for (size_t i = 1; i < m_count; ++i)
+    {
+        if (positions[i].m_x < positions[i - 1].m_x)
+        {
+            m_sorted = false;
+            break;
+        }
+    }
+
+    if (!m_sorted)
+    {
+        m_order.resize(m_count);
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            m_order[i] = i;
+        }
+        std::sort(m_order.begin(), m_order.end(),
+            [&positions](size_t a, size_t b)
+            {
+                return (positions[a].m_x < positions[b].m_x);
+            });
+    }
+
+    if ((cellSize <= 0) || (m_count == 0))
+    {
+        return;
+    }
+
+    // Compute the bounding box of the points, points with
+    // invalid coordinates are left out of the grid
+    bool foundValue = false;
+    wxDouble maxX = 0;
+    wxDouble maxY = 0;
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        const wxPoint2DDouble &position = positions[i];
+        if (!std::isfinite(position.m_x) || !std::isfinite(position.m_y))
+        {
+            continue;
+        }
+        if (!foundValue)
+        {
+            m_minX = maxX = position.m_x;
+            m_minY = maxY = position.m_y;
+            foundValue = true;
+        }
+        else
+        {
+            m_minX = std::min(m_minX, position.m_x);
+            maxX = std::max(maxX, position.m_x);
+            m_minY = std::min(m_minY, position.m_y);
+            maxY = std::max(maxY, position.m_y);
+        }
+    }
+    if (!foundValue)
+    {
+        return;
+    }
+
+    // Limit the number of cells when the points are spread
+    // over a large area, for instance when zoomed in
+    const wxDouble maxCells = std::max<wxDouble>(m_count, 1024);
+    while ((((maxX - m_minX) / cellSize) + 1) * (((maxY - m_minY) / cellSize) + 1) > maxCells)
+    {
+        cellSize *= 2;
+    }
+    m_cellSize = cellSize;
+    m_columns = static_cast<size_t>((maxX - m_minX) / m_cellSize) + 1;
+    m_rows = static_cast<size_t>((maxY - m_minY) / m_cellSize) + 1;
+
+    // Counting sort of the points by cell
+    m_cellStart.resize(m_columns * m_rows + 1, 0);
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        const wxPoint2DDouble &position = positions[i];
+        if (std::isfinite(position.m_x) && std::isfinite(position.m_y))
+        {
+            ++m_cellStart[GetCellIndex(GetColumn(position.m_x), GetRow(position.m_y)) + 1];
+        }
+    }
+    for (size_t i = 1; i < m_cellStart.size(); ++i)
+    {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+
+    wxVector<size_t> next(m_cellStart);
+    m_cellPoints.resize(m_cellStart[m_cellStart.size() - 1]);
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        const wxPoint2DDouble &position = positions[i];
+        if (std::isfinite(position.m_x) && std::isfinite(position.m_y))
+        {
+            m_cellPoints[next[GetCellIndex(GetColumn(position.m_x), GetRow(position.m_y))]++] = i;
+        }
+    }
+}
+
+void wxChartSpatialIndex::Clear()
+{
+    m_count = 0;
+    m_sorted = true;
+    m_order.clear();
+    m_cellSize = 0;
+    m_columns = 0;
+    m_rows = 0;
+    m_cellStart.clear();
+    m_cellPoints.clear();
+}
+
+void wxChartSpatialIndex::FindInXRange(const wxVector<wxPoint2DDouble> &positions,
+                                       wxDouble minX,
+                                       wxDouble maxX,
+                                       wxVector<size_t> &indices) const
+{
+    size_t count = std::min(m_count, positions.size());
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (m_sorted)
+    {
+        const wxPoint2DDouble *begin = &positions[0];
+        const wxPoint2DDouble *it = std::lower_bound(begin, begin + count, minX,
+            [](const wxPoint2DDouble &position, wxDouble x)
+            {
+                return (position.m_x < x);
+            });
+        for (; (it != (begin + count)) && (it->m_x <= maxX); ++it)
+        {
+            indices.push_back(it - begin);
+        }
+    }
+    else if (count < m_count)
+    {
+        // Points were removed since the index was built so
+        // some of the indices are past the end of the positions
+        // and the binary search can't be used until it is rebuilt
+        for (size_t i = 0; i < m_order.size(); ++i)
+        {
+            size_t index = m_order[i];
+            if ((index < count) && (positions[index].m_x >= minX) && (positions[index].m_x <= maxX))
+            {
+                indices.push_back(index);
+            }
+        }
+    }
+    else
+    {
+        wxVector<size_t>::const_iterator it = std::lower_bound(m_order.begin(), m_order.end(), minX,
+            [&positions](size_t index, wxDouble x)
+            {
+                return (positions[index].m_x < x);
+            });
+        for (; (it != m_order.end()) && (positions[*it].m_x <= maxX); ++it)
+        {
+            indices.push_back(*it);
+        }
+    }
+}
+
+void wxChartSpatialIndex::FindInRadius(const wxVector<wxPoint2DDouble> &positions,
+                                       const wxPoint2DDouble &center,
+                                       wxDouble radius,
+                                       wxVector<size_t> &indices) const
+{
+    size_t start = indices.size();
+
+    if (m_cellSize <= 0)
+    {
+        // No grid, use the points in the vertical band
+        wxVector<size_t> candidates;
+        FindInXRange(positions, center.m_x - radius, center.m_x + radius, candidates);
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            wxDouble dx = positions[candidates[i]].m_x - center.m_x;
+            wxDouble dy = positions[candidates[i]].m_y - center.m_y;
+            if (((dx * dx) + (dy * dy)) <= (radius * radius))
+            {
+                indices.push_back(candidates[i]);
+            }
+        }
+    }
+    else
+    {
+        size_t firstColumn = GetColumn(center.m_x - radius);
+        size_t lastColumn = GetColumn(center.m_x + radius);
+        size_t firstRow = GetRow(center.m_y - radius);
+        size_t lastRow = GetRow(center.m_y + radius);
+        for (size_t row = firstRow; row <= lastRow; ++row)
+        {
+            for (size_t column = firstColumn; column <= lastColumn; ++column)
+            {
+                size_t cell = GetCellIndex(column, row);
+                for (size_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i)
+                {
+                    size_t index = m_cellPoints[i];
+                    if (index >= positions.size())
+                    {
+                        continue;
+                    }
+                    wxDouble dx = positions[index].m_x - center.m_x;
+                    wxDouble dy = positions[index].m_y - center.m_y;
+                    if (((dx * dx) + (dy * dy)) <= (radius * radius))
+                    {
+                        indices.push_back(index);
+                    }
+                }
+            }
+        }
+    }
+
+    // Return the points in the order in which they
+    // appear in the dataset
+    std::sort(indices.begin() + start, indices.end());
+}
+
+size_t wxChartSpatialIndex::GetCellIndex(size_t column, size_t row) const
+{
+    return ((row * m_columns) + column);
+}
+
+size_t wxChartSpatialIndex::GetColumn(wxDouble x) const
+{
+    if (!(x > m_minX))
+    {
+        return 0;
+    }
+    size_t column = static_cast<size_t>(std::min((x - m_minX) / m_cellSize, static_cast<wxDouble>(m_columns - 1)));
+    return column;
+}
+
+size_t wxChartSpatialIndex::GetRow(wxDouble y) const
+{
+    if (!(y > m_minY))
+    {
+        return 0;
+    }
+    size_t row = static_cast<size_t>(std::min((y - m_minY) / m_cellSize, static_cast<wxDouble>(m_rows - 1)));
+    return row;
+}
@@ -0,0 +1,134 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxcharttextsizecache.h"
+#include <wx/hashmap.h>
+#include <functional>
+
+wxChartTextSizeCache wxChartsTextSizeCache;
+
+wxChartTextSizeCache::Key::Key(const wxChartFontOptions &font,
+                               const wxString &text,
+                               const wxGraphicsRenderer *renderer,
+                               wxDouble scaleFactor)
+    : m_family(font.GetFamily()), m_size(font.GetSize()),
+    m_style(font.GetStyle()), m_weight(font.GetWeight()),
+    m_text(text), m_renderer(renderer), m_scaleFactor(scaleFactor)
+{
+}
+
+bool wxChartTextSizeCache::Key::operator==(const Key &other) const
+{
+    return ((m_family == other.m_family) && (m_size == other.m_size) &&
+        (m_style == other.m_style) && (m_weight == other.m_weight) &&
+        (m_text == other.m_text) && (m_renderer == other.m_renderer) &&
+        (m_scaleFactor == other.m_scaleFactor));
+}
+
+size_t wxChartTextSizeCache::KeyHash::operator()(const Key &key) const
+{
+    size_t result = wxStringHash()(key.m_text);
+    result = (result * 31) + key.m_family;
+    result = (result * 31) + key.m_size;
+    result = (result * 31) + key.m_style;
+    result = (result * 31) + key.m_weight;
+    result = (result * 31) + std::hash<const wxGraphicsRenderer*>()(key.m_renderer);
+    result = (result * 31) + std::hash<wxDouble>()(key.m_scaleFactor);
+    return result;
+}
+
+wxChartTextSizeCache::wxChartTextSizeCache(size_t maxCount)
+    : m_maxCount(maxCount)
+{
+}
+
+bool wxChartTextSizeCache::Find(const wxChartFontOptions &font,
+                                const wxString &text,
+                                const wxGraphicsRenderer *renderer,
+                                wxDouble scaleFactor,
+                                wxDouble &width,
+                                wxDouble &height) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unordered_map<Key, Size, KeyHash>::const_iterator it =
+        m_sizes.find(Key(font, text, renderer, scaleFactor));
+    if (it == m_sizes.end())
+    {
+        return false;
+    }
+    width = it->second.m_width;
+    height = it->second.m_height;
+    return true;
+}
+
+void wxChartTextSizeCache::Insert(const wxChartFontOptions &font,
+                                  const wxString &text,
+                                  const wxGraphicsRenderer *renderer,
+                                  wxDouble scaleFactor,
+                                  wxDouble width,
+                                  wxDouble height)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_maxCount == 0)
+    {
+        return;
+    }
+    // Keeping track of the least recently used sizes would
+    // slow down lookups, the cache is simply emptied when
+    // it is full
+    if (m_sizes.size() >= m_maxCount)
+    {
+        m_sizes.clear();
+    }
+    Size size;
+    size.m_width = width;
+    size.m_height = height;
+    m_sizes[Key(font, text, renderer, scaleFactor)] = size;
+}
+
+void wxChartTextSizeCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sizes.clear();
+}
+
+size_t wxChartTextSizeCache::GetCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_sizes.size();
+}
+
+size_t wxChartTextSizeCache::GetMaxCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxCount;
+}
+
+void wxChartTextSizeCache::SetMaxCount(size_t maxCount)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxCount = maxCount;
+    if (m_sizes.size() > m_maxCount)
+    {
+        m_sizes.clear();
+    }
+}
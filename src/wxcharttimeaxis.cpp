@@ -20,10 +20,386 @@
     IN THE SOFTWARE.
 */
 
+
 #include "wxcharttimeaxis.h"
+#include <algorithm>
+
+namespace
+{
+    const wxInt64 MillisecondsPerUnit[] =
+    {
+        1, 1000, 60 * 1000, 60 * 60 * 1000, 24 * 60 * 60 * 1000
+    };
+
+    struct TimeStep
+    {
+        wxChartTimeUnit unit;
+        unsigned int step;
+        // Approximate length of the interval in milliseconds,
+        // only used to skip the steps that are obviously too small
+        wxDouble length;
+    };
+
+    const TimeStep TimeSteps[] =
+    {
+        { wxCHARTTIMEUNIT_MILLISECOND, 1, 1 },
+        { wxCHARTTIMEUNIT_MILLISECOND, 2, 2 },
+        { wxCHARTTIMEUNIT_MILLISECOND, 5, 5 },
+        { wxCHARTTIMEUNIT_MILLISECOND, 10, 10 },
+        { wxCHARTTIMEUNIT_MILLISECOND, 20, 20 },
+        { wxCHARTTIMEUNIT_MILLISECOND, 50, 50 },
+        { wxCHARTTIMEUNIT_MILLISECOND, 100, 100 },
+        { wxCHARTTIMEUNIT_MILLISECOND, 200, 200 },
+        { wxCHARTTIMEUNIT_MILLISECOND, 500, 500 },
+        { wxCHARTTIMEUNIT_SECOND, 1, 1e3 },
+        { wxCHARTTIMEUNIT_SECOND, 2, 2e3 },
+        { wxCHARTTIMEUNIT_SECOND, 5, 5e3 },
+        { wxCHARTTIMEUNIT_SECOND, 10, 10e3 },
+        { wxCHARTTIMEUNIT_SECOND, 15, 15e3 },
+        { wxCHARTTIMEUNIT_SECOND, 30, 30e3 },
+        { wxCHARTTIMEUNIT_MINUTE, 1, 60e3 },
+        { wxCHARTTIMEUNIT_MINUTE, 2, 120e3 },
+        { wxCHARTTIMEUNIT_MINUTE, 5, 300e3 },
+        { wxCHARTTIMEUNIT_MINUTE, 10, 600e3 },
+        { wxCHARTTIMEUNIT_MINUTE, 15, 900e3 },
+        { wxCHARTTIMEUNIT_MINUTE, 30, 1800e3 },
+        { wxCHARTTIMEUNIT_HOUR, 1, 3600e3 },
+        { wxCHARTTIMEUNIT_HOUR, 2, 7200e3 },
+        { wxCHARTTIMEUNIT_HOUR, 3, 10800e3 },
+        { wxCHARTTIMEUNIT_HOUR, 6, 21600e3 },
+        { wxCHARTTIMEUNIT_HOUR, 12, 43200e3 },
+        { wxCHARTTIMEUNIT_DAY, 1, 86400e3 },
+        { wxCHARTTIMEUNIT_DAY, 2, 172800e3 },
+        { wxCHARTTIMEUNIT_DAY, 7, 604800e3 },
+        { wxCHARTTIMEUNIT_MONTH, 1, 2629746e3 },
+        { wxCHARTTIMEUNIT_MONTH, 2, 5259492e3 },
+        { wxCHARTTIMEUNIT_MONTH, 3, 7889238e3 },
+        { wxCHARTTIMEUNIT_MONTH, 6, 15778476e3 }
+    };
+
+    const wxDouble MillisecondsPerYear = 31556952e3;
+
+    wxInt64 FloorDivide(wxInt64 value, wxInt64 divisor)
+    {
+        wxInt64 quotient = value / divisor;
+        if ((value % divisor) < 0)
+        {
+            --quotient;
+        }
+        return quotient;
+    }
+
+    // Conversions between a number of days since 1970-01-01
+    // and a date in the proleptic Gregorian calendar, see
+    // http://howardhinnant.github.io/date_algorithms.html
+    wxInt64 DaysFromCivil(wxInt64 year, int month, int day)
+    {
+        year -= (month <= 2);
+        wxInt64 era = FloorDivide(year, 400);
+        wxInt64 yearOfEra = year - (era * 400);
+        wxInt64 dayOfYear = ((153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5) + day - 1;
+        wxInt64 dayOfEra = (yearOfEra * 365) + (yearOfEra / 4) - (yearOfEra / 100) + dayOfYear;
+        return (era * 146097) + dayOfEra - 719468;
+    }
+
+    void CivilFromDays(wxInt64 days, wxInt64 &year, int &month, int &day)
+    {
+        days += 719468;
+        wxInt64 era = FloorDivide(days, 146097);
+        wxInt64 dayOfEra = days - (era * 146097);
+        wxInt64 yearOfEra = (dayOfEra - (dayOfEra / 1460) + (dayOfEra / 36524) - (dayOfEra / 146096)) / 365;
+        wxInt64 dayOfYear = dayOfEra - ((365 * yearOfEra) + (yearOfEra / 4) - (yearOfEra / 100));
+        wxInt64 shiftedMonth = ((5 * dayOfYear) + 2) / 153;
+        day = static_cast<int>(dayOfYear - (((153 * shiftedMonth) + 2) / 5) + 1);
+        month = static_cast<int>((shiftedMonth < 10) ? (shiftedMonth + 3) : (shiftedMonth - 9));
+        year = yearOfEra + (era * 400) + (month <= 2);
+    }
+
+    void SplitTimestamp(wxInt64 timestamp, wxInt64 &year, int &month,
+        int &day, wxInt64 &millisecondOfDay)
+    {
+        const wxInt64 millisecondsPerDay = MillisecondsPerUnit[wxCHARTTIMEUNIT_DAY];
+        wxInt64 days = FloorDivide(timestamp, millisecondsPerDay);
+        millisecondOfDay = timestamp - (days * millisecondsPerDay);
+        CivilFromDays(days, year, month, day);
+    }
+
+    size_t CountTickMarks(wxInt64 start, wxInt64 end,
+        wxChartTimeUnit unit, unsigned int step)
+    {
+        size_t count = 1;
+        for (wxInt64 t = wxChartTimeAxis::Floor(start, unit, step); t < end;
+            t = wxChartTimeAxis::Advance(t, unit, step))
+        {
+            ++count;
+        }
+        return count;
+    }
+}
 
 wxChartTimeAxis::wxChartTimeAxis(const std::string &id,
                                  const wxChartAxisOptions &options)
-    : wxChartAxis(id, options)
+    : wxChartAxis(id, options), m_requestedStart(0), m_requestedEnd(0),
+    m_maxTickMarks(0), m_unit(wxCHARTTIMEUNIT_MILLISECOND), m_step(1)
+{
+}
+
+bool wxChartTimeAxis::UpdateRange(wxInt64 start,
+                                  wxInt64 end,
+                                  size_t maxTickMarks)
+{
+    if (end <= start)
+    {
+        end = start + 1;
+    }
+    maxTickMarks = std::max(maxTickMarks, size_t(2));
+
+    if (!m_tickMarks.empty() &&
+        (start == m_requestedStart) &&
+        (end == m_requestedEnd) &&
+        (maxTickMarks == m_maxTickMarks))
+    {
+        return false;
+    }
+    m_requestedStart = start;
+    m_requestedEnd = end;
+    m_maxTickMarks = maxTickMarks;
+
+    wxChartTimeUnit unit;
+    unsigned int step;
+    SelectStep(start, end, maxTickMarks, unit, step);
+
+    wxInt64 first = Floor(start, unit, step);
+    wxInt64 last = Floor(end, unit, step);
+    if (last < end)
+    {
+        last = Advance(last, unit, step);
+    }
+
+    // Panning by less than a tick mark gives the same
+    // tick marks, in which case the labels and their
+    // measured sizes can be kept as they are
+    if (!m_tickMarks.empty() &&
+        (unit == m_unit) &&
+        (step == m_step) &&
+        (first == m_tickMarks.front()) &&
+        (last == m_tickMarks.back()))
+    {
+        return false;
+    }
+
+    m_unit = unit;
+    m_step = step;
+    m_tickMarks.clear();
+
+    const wxChartAxisOptions &options = GetOptions();
+    wxChartLabelOptions labelOptions(options.GetFontOptions(), false,
+        wxChartBackgroundOptions(*wxWHITE, 0));
+
+    wxVector<wxChartLabel> labels;
+    for (wxInt64 t = first; t <= last; t = Advance(t, unit, step))
+    {
+        m_tickMarks.push_back(t);
+        labels.push_back(wxChartLabel(FormatLabel(t, unit), labelOptions));
+    }
+    SetLabels(labels);
+
+    return true;
+}
+
+wxInt64 wxChartTimeAxis::GetStart() const
+{
+    return (m_tickMarks.empty() ? 0 : m_tickMarks.front());
+}
+
+wxInt64 wxChartTimeAxis::GetEnd() const
+{
+    return (m_tickMarks.empty() ? 0 : m_tickMarks.back());
+}
+
+wxChartTimeUnit wxChartTimeAxis::GetUnit() const
+{
+    return m_unit;
+}
+
+unsigned int wxChartTimeAxis::GetStep() const
 {
+    return m_step;
+}
+
+const wxVector<wxInt64>& wxChartTimeAxis::GetTickMarks() const
+{
+    return m_tickMarks;
+}
+
+wxDouble wxChartTimeAxis::GetRelativePosition(wxInt64 timestamp) const
+{
+    size_t n = m_tickMarks.size();
+    if (n < 2)
+    {
+        return 0;
+    }
+
+    // Find the interval that contains the timestamp, the
+    // first or last one is extended for timestamps outside
+    // of the axis
+    size_t index = 0;
+    if (timestamp >= m_tickMarks[n - 1])
+    {
+        index = n - 2;
+    }
+    else if (timestamp > m_tickMarks[0])
+    {
+        index = (std::upper_bound(m_tickMarks.begin(), m_tickMarks.end(), timestamp) - m_tickMarks.begin()) - 1;
+    }
+
+    wxDouble fraction = static_cast<wxDouble>(timestamp - m_tickMarks[index]) /
+        (m_tickMarks[index + 1] - m_tickMarks[index]);
+    return ((index + fraction) / (n - 1));
+}
+
+wxInt64 wxChartTimeAxis::Floor(wxInt64 timestamp,
+                               wxChartTimeUnit unit,
+                               unsigned int step)
+{
+    if (unit == wxCHARTTIMEUNIT_MONTH || unit == wxCHARTTIMEUNIT_YEAR)
+    {
+        wxInt64 year;
+        int month;
+        int day;
+        wxInt64 millisecondOfDay;
+        SplitTimestamp(timestamp, year, month, day, millisecondOfDay);
+
+        if (unit == wxCHARTTIMEUNIT_MONTH)
+        {
+            wxInt64 months = FloorDivide((year * 12) + month - 1, step) * step;
+            year = FloorDivide(months, 12);
+            month = static_cast<int>(months - (year * 12)) + 1;
+        }
+        else
+        {
+            year = FloorDivide(year, step) * step;
+            month = 1;
+        }
+        return (DaysFromCivil(year, month, 1) * MillisecondsPerUnit[wxCHARTTIMEUNIT_DAY]);
+    }
+
+    wxInt64 interval = MillisecondsPerUnit[unit] * step;
+    return (FloorDivide(timestamp, interval) * interval);
+}
+
+wxInt64 wxChartTimeAxis::Advance(wxInt64 timestamp,
+                                 wxChartTimeUnit unit,
+                                 unsigned int step)
+{
+    if (unit == wxCHARTTIMEUNIT_MONTH || unit == wxCHARTTIMEUNIT_YEAR)
+    {
+        wxInt64 year;
+        int month;
+        int day;
+        wxInt64 millisecondOfDay;
+        SplitTimestamp(timestamp, year, month, day, millisecondOfDay);
+
+        wxInt64 months = (year * 12) + month - 1;
+        months += (unit == wxCHARTTIMEUNIT_MONTH) ? step : (wxInt64(step) * 12);
+        year = FloorDivide(months, 12);
+        month = static_cast<int>(months - (year * 12)) + 1;
+
+        // The day is clamped so that January 31st
+        // plus one month is February 28th or 29th
+        wxInt64 nextMonthYear = (month == 12) ? (year + 1) : year;
+        int nextMonth = (month == 12) ? 1 : (month + 1);
+        int daysInMonth = static_cast<int>(DaysFromCivil(nextMonthYear, nextMonth, 1) - DaysFromCivil(year, month, 1));
+        day = std::min(day, daysInMonth);
+
+        return ((DaysFromCivil(year, month, day) * MillisecondsPerUnit[wxCHARTTIMEUNIT_DAY]) + millisecondOfDay);
+    }
+
+    return (timestamp + (MillisecondsPerUnit[unit] * step));
+}
+
+wxString wxChartTimeAxis::FormatLabel(wxInt64 timestamp,
+                                      wxChartTimeUnit unit)
+{
+    wxInt64 year;
+    int month;
+    int day;
+    wxInt64 millisecondOfDay;
+    SplitTimestamp(timestamp, year, month, day, millisecondOfDay);
+
+    int hour = static_cast<int>(millisecondOfDay / 3600000);
+    int minute = static_cast<int>((millisecondOfDay / 60000) % 60);
+    int second = static_cast<int>((millisecondOfDay / 1000) % 60);
+    int millisecond = static_cast<int>(millisecondOfDay % 1000);
+
+    switch (unit)
+    {
+    case wxCHARTTIMEUNIT_MILLISECOND:
+        return wxString::Format("%02d:%02d:%02d.%03d", hour, minute, second, millisecond);
+
+    case wxCHARTTIMEUNIT_SECOND:
+    case wxCHARTTIMEUNIT_MINUTE:
+    case wxCHARTTIMEUNIT_HOUR:
+        // Show the date at midnight so that ranges
+        // spanning several days can be read
+        if (millisecondOfDay == 0)
+        {
+            return wxString::Format("%04d-%02d-%02d", static_cast<int>(year), month, day);
+        }
+        if (unit == wxCHARTTIMEUNIT_SECOND)
+        {
+            return wxString::Format("%02d:%02d:%02d", hour, minute, second);
+        }
+        return wxString::Format("%02d:%02d", hour, minute);
+
+    case wxCHARTTIMEUNIT_DAY:
+        return wxString::Format("%04d-%02d-%02d", static_cast<int>(year), month, day);
+
+    case wxCHARTTIMEUNIT_MONTH:
+        return wxString::Format("%04d-%02d", static_cast<int>(year), month);
+
+    case wxCHARTTIMEUNIT_YEAR:
+        return wxString::Format("%04d", static_cast<int>(year));
+    }
+
+    return wxString();
+}
+
+void wxChartTimeAxis::SelectStep(wxInt64 start,
+                                 wxInt64 end,
+                                 size_t maxTickMarks,
+                                 wxChartTimeUnit &unit,
+                                 unsigned int &step) const
+{
+    wxDouble range = static_cast<wxDouble>(end - start);
+
+    // Pick the smallest step that doesn't produce too many
+    // tick marks once the range has been extended to the
+    // surrounding calendar boundaries
+    for (size_t i = 0; i < (sizeof(TimeSteps) / sizeof(TimeSteps[0])); ++i)
+    {
+        if ((range / TimeSteps[i].length) + 1 > maxTickMarks)
+        {
+            continue;
+        }
+        if (CountTickMarks(start, end, TimeSteps[i].unit, TimeSteps[i].step) <= maxTickMarks)
+        {
+            unit = TimeSteps[i].unit;
+            step = TimeSteps[i].step;
+            return;
+        }
+    }
+
+    // Years follow the 1, 2, 5 progression
+    unit = wxCHARTTIMEUNIT_YEAR;
+    step = 1;
+    for (size_t i = 0; ; ++i)
+    {
+        if ((((range / (step * MillisecondsPerYear)) + 1) <= maxTickMarks) &&
+            (CountTickMarks(start, end, unit, step) <= maxTickMarks))
+        {
+            return;
+        }
+        step = ((i % 3) == 1) ? ((step / 2) * 5) : (step * 2);
+    }
 }
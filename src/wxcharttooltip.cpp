@@ -35,41 +35,61 @@
 #include "wxchartbackground.h"
 #include "wxchartutilities.h"
 #include <wx/brush.h>
+#include <cmath>
 
 wxChartTooltip::wxChartTooltip(const wxPoint2DDouble &position,
                                const wxString &text)
-    : m_position(position), m_provider(new wxChartTooltipProviderStatic("", text, *wxBLACK))
+    : m_position(position), m_provider(new wxChartTooltipProviderStatic("", text, *wxBLACK)),
+    m_needsFit(true), m_width(0), m_height(0)
 {
 }
 
 wxChartTooltip::wxChartTooltip(const wxPoint2DDouble &position,
                                const wxChartTooltipProvider::ptr provider)
-    : m_position(position), m_provider(provider)
+    : m_position(position), m_provider(provider),
+    m_needsFit(true), m_width(0), m_height(0)
 {
 }
 
 void wxChartTooltip::Draw(wxGraphicsContext &gc)
 {
-    wxString text = m_provider->GetTooltipText();
+    Fit(gc);
 
-    wxFont font(wxSize(0, m_options.GetFontSize()),
-        m_options.GetFontFamily(), m_options.GetFontStyle(), wxFONTWEIGHT_NORMAL);
-    wxDouble tooltipWidth;
-    wxDouble tooltipHeight;
-    wxChartUtilities::GetTextSize(gc, font, text, tooltipWidth, tooltipHeight);
-    tooltipWidth += 2 * m_options.GetHorizontalPadding();
-    tooltipHeight += 2 * m_options.GetVerticalPadding();
+    wxDouble tooltipX = m_position.m_x - (m_width / 2);
+    wxDouble tooltipY = m_position.m_y - m_height;
 
+    wxChartBackground background(m_options.GetBackgroundOptions());
+    background.Draw(tooltipX, tooltipY, m_width, m_height, gc);
 
-    wxDouble tooltipX = m_position.m_x - (tooltipWidth / 2);
-    wxDouble tooltipY = m_position.m_y - tooltipHeight;
+    gc.SetFont(m_font, m_options.GetFontColor());
+    gc.DrawText(m_text, tooltipX + m_options.GetHorizontalPadding(), tooltipY + m_options.GetVerticalPadding());
+}
 
+void wxChartTooltip::Fit(wxGraphicsContext &gc)
+{
+    if (!m_needsFit)
+    {
+        return;
+    }
 
-    wxChartBackground background(m_options.GetBackgroundOptions());
-    background.Draw(tooltipX, tooltipY, tooltipWidth, tooltipHeight, gc);
+    m_text = m_provider->GetTooltipText();
 
-    gc.SetFont(font, m_options.GetFontColor());
-    gc.DrawText(text, tooltipX + m_options.GetHorizontalPadding(), tooltipY + m_options.GetVerticalPadding());
+    m_font = wxFont(wxSize(0, m_options.GetFontSize()),
+        m_options.GetFontFamily(), m_options.GetFontStyle(), wxFONTWEIGHT_NORMAL);
+    wxChartUtilities::GetTextSize(gc, m_font, m_text, m_width, m_height);
+    m_width += 2 * m_options.GetHorizontalPadding();
+    m_height += 2 * m_options.GetVerticalPadding();
+
+    m_needsFit = false;
+}
+
+wxRect wxChartTooltip::GetBounds() const
+{
+    int left = floor(m_position.m_x - (m_width / 2));
+    int top = floor(m_position.m_y - m_height);
+    int right = ceil(m_position.m_x + (m_width / 2));
+    int bottom = ceil(m_position.m_y);
+    return wxRect(left, top, right - left, bottom - top);
 }
 
 const wxPoint2DDouble& wxChartTooltip::GetPosition() const
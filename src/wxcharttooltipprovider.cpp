@@ -47,3 +47,42 @@ wxColor wxChartTooltipProviderStatic::GetAssociatedColor() const
 {
     return m_color;
 }
+
+wxChartTooltipProviderLazy::wxChartTooltipProviderLazy(const Generator &title,
+                                                       const Generator &text,
+                                                       const wxColor &color)
+    : m_titleGenerator(title), m_textGenerator(text), m_color(color),
+    m_titleGenerated(false), m_textGenerated(false)
+{
+}
+
+wxString wxChartTooltipProviderLazy::GetTooltipTitle() const
+{
+    if (!m_titleGenerated)
+    {
+        if (m_titleGenerator)
+        {
+            m_title = m_titleGenerator();
+        }
+        m_titleGenerated = true;
+    }
+    return m_title;
+}
+
+wxString wxChartTooltipProviderLazy::GetTooltipText() const
+{
+    if (!m_textGenerated)
+    {
+        if (m_textGenerator)
+        {
+            m_text = m_textGenerator();
+        }
+        m_textGenerated = true;
+    }
+    return m_text;
+}
+
+wxColor wxChartTooltipProviderLazy::GetAssociatedColor() const
+{
+    return m_color;
+}
@@ -32,7 +32,95 @@
 */
 
 #include "wxchartutilities.h"
+#include "wxcharttextsizecache.h"
 #include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Below this number of values per thread the cost of
+    // starting the threads outweighs the gain
+    const size_t MinValuesPerThread = 1 << 18;
+
+    struct Range
+    {
+        Range() : found(false), minValue(0), maxValue(0) {}
+
+        void Merge(const Range &other)
+        {
+            if (!other.found)
+            {
+                return;
+            }
+            if (!found)
+            {
+                *this = other;
+                return;
+            }
+            if (minValue > other.minValue)
+            {
+                minValue = other.minValue;
+            }
+            if (maxValue < other.maxValue)
+            {
+                maxValue = other.maxValue;
+            }
+        }
+
+        bool found;
+        wxDouble minValue;
+        wxDouble maxValue;
+    };
+
+    struct Range2D
+    {
+        void Merge(const Range2D &other)
+        {
+            x.Merge(other.x);
+            y.Merge(other.y);
+        }
+
+        Range x;
+        Range y;
+    };
+
+    // Calls reduce(begin, end, result) on consecutive chunks of
+    // [0, count) and merges the results. The chunks are processed
+    // in parallel if there are enough values.
+    template<typename Result, typename Reduce>
+    Result ParallelReduce(size_t count, const Reduce &reduce)
+    {
+        Result result;
+        size_t chunkCount = wxChartUtilities::GetParallelChunkCount(count);
+        if (chunkCount <= 1)
+        {
+            reduce(0, count, result);
+            return result;
+        }
+
+        wxVector<Result> results(chunkCount);
+        wxChartUtilities::ParallelFor(count,
+            [&reduce, &results](size_t chunk, size_t begin, size_t end)
+            {
+                reduce(begin, end, results[chunk]);
+            });
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            result.Merge(results[i]);
+        }
+        return result;
+    }
+
+    void MergeInto(const Range &range, bool &found, wxDouble &minValue, wxDouble &maxValue)
+    {
+        if (range.found)
+        {
+            wxChartUtilities::MergeExtents(range.minValue, range.maxValue,
+                found, minValue, maxValue);
+        }
+    }
+}
 
 size_t wxChartUtilities::GetDecimalPlaces()
 {
@@ -105,3 +193,217 @@ void wxChartUtilities::GetTextSize(wxGraphicsContext &gc,
     gc.SetFont(font, *wxBLACK);
     gc.GetTextExtent(string, &width, &height, &descent, &externalLeading);
 }
+
+void wxChartUtilities::GetTextSize(wxGraphicsContext &gc,
+                                   const wxChartFontOptions &font,
+                                   const wxString &string,
+                                   wxDouble &width,
+                                   wxDouble &height)
+{
+    const wxGraphicsRenderer *renderer = gc.GetRenderer();
+    wxDouble scaleFactor = gc.GetContentScaleFactor();
+    if (wxChartsTextSizeCache.Find(font, string, renderer, scaleFactor, width, height))
+    {
+        return;
+    }
+    GetTextSize(gc, font.GetFont(), string, width, height);
+    wxChartsTextSizeCache.Insert(font, string, renderer, scaleFactor, width, height);
+}
+
+void wxChartUtilities::UpdateExtents(const wxDouble *values,
+                                     size_t count,
+                                     size_t stride,
+                                     bool &found,
+                                     wxDouble &minValue,
+                                     wxDouble &maxValue)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    Range range = ParallelReduce<Range>(count,
+        [values, stride](size_t begin, size_t end, Range &result)
+        {
+            // The loop has no branches so that the compiler
+            // can vectorize it
+            const wxDouble *value = values + (begin * stride);
+            wxDouble lo = *value;
+            wxDouble hi = *value;
+            for (size_t i = begin + 1; i < end; ++i)
+            {
+                value += stride;
+                wxDouble v = *value;
+                lo = (v < lo) ? v : lo;
+                hi = (v > hi) ? v : hi;
+            }
+            result.found = true;
+            result.minValue = lo;
+            result.maxValue = hi;
+        });
+    MergeInto(range, found, minValue, maxValue);
+}
+
+void wxChartUtilities::UpdateExtents(const wxDouble *values,
+                                     size_t count,
+                                     const std::function<wxDouble(wxDouble)> &transform,
+                                     bool &found,
+                                     wxDouble &minValue,
+                                     wxDouble &maxValue)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // The transform is user code that may not be thread-safe
+    // so the values aren't split between threads
+    wxDouble lo = transform(values[0]);
+    wxDouble hi = lo;
+    for (size_t i = 1; i < count; ++i)
+    {
+        wxDouble v = transform(values[i]);
+        lo = (v < lo) ? v : lo;
+        hi = (v > hi) ? v : hi;
+    }
+    MergeExtents(lo, hi, found, minValue, maxValue);
+}
+
+void wxChartUtilities::UpdateExtents(const wxVector<wxDouble> &values,
+                                     bool &found,
+                                     wxDouble &minValue,
+                                     wxDouble &maxValue)
+{
+    if (!values.empty())
+    {
+        UpdateExtents(&values[0], values.size(), 1, found, minValue, maxValue);
+    }
+}
+
+void wxChartUtilities::UpdateExtents(const wxVector<wxPoint2DDouble> &points,
+                                     bool &found,
+                                     wxDouble &minX,
+                                     wxDouble &maxX,
+                                     wxDouble &minY,
+                                     wxDouble &maxY)
+{
+    if (points.empty())
+    {
+        return;
+    }
+
+    const wxPoint2DDouble *data = &points[0];
+    Range2D range = ParallelReduce<Range2D>(points.size(),
+        [data](size_t begin, size_t end, Range2D &result)
+        {
+            wxDouble loX = data[begin].m_x;
+            wxDouble hiX = loX;
+            wxDouble loY = data[begin].m_y;
+            wxDouble hiY = loY;
+            for (size_t i = begin + 1; i < end; ++i)
+            {
+                wxDouble x = data[i].m_x;
+                wxDouble y = data[i].m_y;
+                loX = (x < loX) ? x : loX;
+                hiX = (x > hiX) ? x : hiX;
+                loY = (y < loY) ? y : loY;
+                hiY = (y > hiY) ? y : hiY;
+            }
+            result.x.found = result.y.found = true;
+            result.x.minValue = loX;
+            result.x.maxValue = hiX;
+            result.y.minValue = loY;
+            result.y.maxValue = hiY;
+        });
+
+    // Both ranges are always found together
+    bool foundY = found;
+    MergeInto(range.x, found, minX, maxX);
+    MergeInto(range.y, foundY, minY, maxY);
+}
+
+bool wxChartUtilities::ReplaceInExtents(wxDouble oldValue,
+                                        wxDouble newValue,
+                                        wxDouble &minValue,
+                                        wxDouble &maxValue)
+{
+    if (((oldValue == minValue) && (newValue > oldValue)) ||
+        ((oldValue == maxValue) && (newValue < oldValue)))
+    {
+        return false;
+    }
+
+    if (newValue < minValue)
+    {
+        minValue = newValue;
+    }
+    if (newValue > maxValue)
+    {
+        maxValue = newValue;
+    }
+    return true;
+}
+
+void wxChartUtilities::MergeExtents(wxDouble lo,
+                                    wxDouble hi,
+                                    bool &found,
+                                    wxDouble &minValue,
+                                    wxDouble &maxValue)
+{
+    if (!found)
+    {
+        minValue = lo;
+        maxValue = hi;
+        found = true;
+        return;
+    }
+    if (minValue > lo)
+    {
+        minValue = lo;
+    }
+    if (maxValue < hi)
+    {
+        maxValue = hi;
+    }
+}
+
+size_t wxChartUtilities::GetParallelChunkCount(size_t count)
+{
+    size_t chunkCount = std::thread::hardware_concurrency();
+    if (chunkCount > (count / MinValuesPerThread))
+    {
+        chunkCount = (count / MinValuesPerThread);
+    }
+    return ((chunkCount > 1) ? chunkCount : 1);
+}
+
+void wxChartUtilities::ParallelFor(size_t count,
+                                   const std::function<void(size_t chunk, size_t begin, size_t end)> &func)
+{
+    size_t chunkCount = GetParallelChunkCount(count);
+    if (chunkCount <= 1)
+    {
+        func(0, 0, count);
+        return;
+    }
+
+    // std::thread can only be moved, wxVector requires copies
+    std::vector<std::thread> threads;
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    // The calling thread handles the first chunk
+    for (size_t i = 1; i < chunkCount; ++i)
+    {
+        size_t begin = i * chunkSize;
+        size_t end = ((begin + chunkSize) < count) ? (begin + chunkSize) : count;
+        threads.push_back(std::thread([&func, i, begin, end]()
+            {
+                func(i, begin, end);
+            }));
+    }
+    func(0, 0, chunkSize);
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
+}
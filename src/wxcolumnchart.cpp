@@ -35,16 +35,15 @@
 #include "wxchartstheme.h"
 #include "wxchartcategoricalaxis.h"
 #include "wxchartnumericalaxis.h"
+#include "wxchartutilities.h"
 #include <sstream>
 
 wxColumnChart::Column::Column(wxDouble value,
                               const wxChartTooltipProvider::ptr tooltipProvider,
                               wxDouble x,
                               wxDouble y,
-                              const wxColor &fillColor,
-                              const wxColor &strokeColor,
-                              int directions)
-    : wxChartRectangle(x, y, tooltipProvider, wxChartRectangleOptions(fillColor, strokeColor, directions)),
+                              const wxChartRectangleOptions &options)
+    : wxChartRectangle(x, y, tooltipProvider, options),
     m_value(value)
 {
 }
@@ -54,10 +53,16 @@ wxDouble wxColumnChart::Column::GetValue() const
     return m_value;
 }
 
-wxColumnChart::Dataset::Dataset()
+wxColumnChart::Dataset::Dataset(const wxChartRectangleOptions &options)
+    : m_rectangleOptions(options)
 {
 }
 
+const wxChartRectangleOptions& wxColumnChart::Dataset::GetRectangleOptions() const
+{
+    return m_rectangleOptions;
+}
+
 const wxVector<wxColumnChart::Column::ptr>& wxColumnChart::Dataset::GetColumns() const
 {
     return m_columns;
@@ -68,39 +73,26 @@ void wxColumnChart::Dataset::AppendColumn(Column::ptr column)
     m_columns.push_back(column);
 }
 
+void wxColumnChart::Dataset::SetColumn(size_t index, Column::ptr column)
+{
+    m_columns[index] = column;
+}
+
 wxColumnChart::wxColumnChart(wxChartsCategoricalData::ptr &data,
                              const wxSize &size)
     : m_options(wxChartsDefaultTheme->GetColumnChartOptions()), 
+    m_extents(GetExtents(data->GetDatasets())),
     m_grid(
         wxPoint2DDouble(m_options->GetPadding().GetLeft(), m_options->GetPadding().GetRight()),
         size,
         wxChartCategoricalAxis::make_shared("x", data->GetCategories(), m_options->GetGridOptions().GetXAxisOptions()),
-        wxChartNumericalAxis::make_shared("y", GetMinValue(data->GetDatasets()), GetMaxValue(data->GetDatasets()), m_options->GetGridOptions().GetYAxisOptions()),
+        wxChartNumericalAxis::make_shared("y", m_extents.m_minValue, m_extents.m_maxValue, m_options->GetGridOptions().GetYAxisOptions()),
         m_options->GetGridOptions()
         )
 {
-    const wxVector<wxChartsDoubleDataset::ptr>& datasets = data->GetDatasets();
-    for (size_t i = 0; i < datasets.size(); ++i)
+    for (size_t i = 0; i < data->GetDatasets().size(); ++i)
     {
-        const wxChartsDoubleDataset& dataset = *datasets[i];
-        Dataset::ptr newDataset(new Dataset());
-
-        const wxVector<wxDouble>& datasetData = dataset.GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << datasetData[j];
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic(data->GetCategories()[j], tooltip.str(), dataset.GetFillColor())
-                );
-
-            newDataset->AppendColumn(Column::ptr(new Column(
-                datasetData[j], tooltipProvider, 25, 50, dataset.GetFillColor(),
-                dataset.GetStrokeColor(), wxLEFT | wxTOP | wxRIGHT
-                )));
-        }
-
-        m_datasets.push_back(newDataset);
+        m_datasets.push_back(CreateDataset(*data, i));
     }
 }
 
@@ -109,54 +101,74 @@ const wxChartCommonOptions& wxColumnChart::GetCommonOptions() const
     return m_options->GetCommonOptions();
 }
 
-wxDouble wxColumnChart::GetMinValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets)
+void wxColumnChart::OnValueChanged(const wxChartsCategoricalData &data,
+                                   size_t datasetIndex,
+                                   size_t index,
+                                   wxDouble oldValue)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
+    // Only the column of the value is replaced and, unless
+    // the axis changes, laid out again
+    DeactivateElements();
+    m_datasets[datasetIndex]->SetColumn(index, CreateColumn(data, datasetIndex, index,
+        m_datasets[datasetIndex]->GetRectangleOptions()));
+
+    wxDouble value = data.GetDatasets()[datasetIndex]->GetData()[index];
+    bool upToDate = wxChartUtilities::ReplaceInExtents(oldValue, value, m_extents.m_minValue, m_extents.m_maxValue);
+    if (!UpdateValueAxis(data, !upToDate))
+    {
+        FitColumn(datasetIndex, index, GetColumnWidth());
+    }
+}
 
-    for (size_t i = 0; i < datasets.size(); ++i)
+void wxColumnChart::OnCategoryAppended(const wxChartsCategoricalData &data)
+{
+    size_t index = data.GetCategories().size() - 1;
+    bool found = (index > 0);
+    for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<wxDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j];
-                foundValue = true;
-            }
-            else if (result > values[j])
-            {
-                result = values[j];
-            }
-        }
+        m_datasets[i]->AppendColumn(CreateColumn(data, i, index,
+            m_datasets[i]->GetRectangleOptions()));
+        wxChartUtilities::UpdateExtents(&data.GetDatasets()[i]->GetData()[index], 1, 1,
+            found, m_extents.m_minValue, m_extents.m_maxValue);
     }
 
-    return result;
+    m_grid.ChangeLabels("x", data.GetCategories(), m_options->GetGridOptions().GetXAxisOptions());
+    UpdateValueAxis(data, false);
+    InvalidateFit();
 }
 
-wxDouble wxColumnChart::GetMaxValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets)
+void wxColumnChart::OnDatasetAdded(const wxChartsCategoricalData &data,
+                                   size_t datasetIndex)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
+    m_datasets.insert(m_datasets.begin() + datasetIndex, CreateDataset(data, datasetIndex));
+
+    bool found = ((m_datasets.size() > 1) && !data.GetCategories().empty());
+    wxChartUtilities::UpdateExtents(data.GetDatasets()[datasetIndex]->GetData(),
+        found, m_extents.m_minValue, m_extents.m_maxValue);
+    UpdateValueAxis(data, false);
+    // The width of all the columns changes
+    InvalidateFit();
+}
 
+void wxColumnChart::OnDatasetRemoved(const wxChartsCategoricalData &data,
+                                     size_t datasetIndex)
+{
+    DeactivateElements();
+    m_datasets.erase(m_datasets.begin() + datasetIndex);
+    UpdateValueAxis(data, true);
+    InvalidateFit();
+}
+
+wxColumnChart::Extents wxColumnChart::GetExtents(const wxVector<wxChartsDoubleDataset::ptr>& datasets)
+{
+    Extents extents = { 0, 0 };
+    bool foundValue = false;
     for (size_t i = 0; i < datasets.size(); ++i)
     {
-        const wxVector<wxDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j];
-                foundValue = true;
-            }
-            else if (result < values[j])
-            {
-                result = values[j];
-            }
-        }
+        wxChartUtilities::UpdateExtents(datasets[i]->GetData(), foundValue,
+            extents.m_minValue, extents.m_maxValue);
     }
-
-    return result;
+    return extents;
 }
 
 void wxColumnChart::DoSetSize(const wxSize &size)
@@ -170,17 +182,9 @@ void wxColumnChart::DoFit()
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetColumns().size(); ++j)
+        for (size_t j = 0; j < m_datasets[i]->GetColumns().size(); ++j)
         {
-            Column& column = *(currentDataset.GetColumns()[j]);
-            wxPoint2DDouble position = m_grid.GetMapping().GetWindowPositionAtTickMark(j, column.GetValue());
-            position.m_x += m_options->GetColumnSpacing() + (i * (columnWidth + m_options->GetDatasetSpacing()));
-
-            wxPoint2DDouble bottomLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j);
-
-            column.SetPosition(position);
-            column.SetSize(columnWidth, bottomLeftCornerPosition.m_y - position.m_y);
+            FitColumn(i, j, columnWidth);
         }
     }
 }
@@ -188,18 +192,19 @@ void wxColumnChart::DoFit()
 void wxColumnChart::DoDraw(wxGraphicsContext &gc,
                            bool suppressTooltips)
 {
-    m_grid.Fit(gc);
+    if (m_grid.Fit(gc))
+    {
+        InvalidateFit();
+    }
     m_grid.Draw(gc);
 
     Fit();
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetColumns().size(); ++j)
-        {
-            currentDataset.GetColumns()[j]->Draw(gc);
-        }
+        // All the elements of a dataset share the same colors
+        // and are drawn with a single fill and stroke
+        wxChartRectangle::DrawAll(gc, m_datasets[i]->GetColumns());
     }
 
     if (!suppressTooltips)
@@ -232,7 +237,75 @@ wxSharedPtr<wxVector<const wxChartElement*> > wxColumnChart::GetActiveElements(c
 
 wxDouble wxColumnChart::GetColumnWidth() const
 {
+    if (m_datasets.empty())
+    {
+        return 0;
+    }
+
     wxDouble availableWidth = m_grid.GetMapping().GetXAxis().GetDistanceBetweenTickMarks() -
         (2 * m_options->GetColumnSpacing()) - ((m_datasets.size() - 1) * m_options->GetDatasetSpacing());
     return (availableWidth / m_datasets.size());
 }
+
+wxColumnChart::Column::ptr wxColumnChart::CreateColumn(const wxChartsCategoricalData &data,
+                                                       size_t datasetIndex,
+                                                       size_t index,
+                                                       const wxChartRectangleOptions &options) const
+{
+    const wxChartsDoubleDataset& dataset = *data.GetDatasets()[datasetIndex];
+    wxDouble value = dataset.GetData()[index];
+
+    std::stringstream tooltip;
+    tooltip << value;
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderStatic(data.GetCategories()[index], tooltip.str(), dataset.GetFillColor())
+        );
+
+    return Column::ptr(new Column(value, tooltipProvider, 25, 50, options));
+}
+
+wxColumnChart::Dataset::ptr wxColumnChart::CreateDataset(const wxChartsCategoricalData &data,
+                                                         size_t datasetIndex) const
+{
+    // The pen and brush are shared by all the columns of the dataset
+    const wxChartsDoubleDataset& dataset = *data.GetDatasets()[datasetIndex];
+    Dataset::ptr newDataset(new Dataset(wxChartRectangleOptions(dataset.GetFillColor(),
+        dataset.GetStrokeColor(), wxLEFT | wxTOP | wxRIGHT)));
+    const wxVector<wxDouble>& datasetData = dataset.GetData();
+    for (size_t j = 0; j < datasetData.size(); ++j)
+    {
+        newDataset->AppendColumn(CreateColumn(data, datasetIndex, j,
+            newDataset->GetRectangleOptions()));
+    }
+    return newDataset;
+}
+
+void wxColumnChart::FitColumn(size_t datasetIndex,
+                              size_t index,
+                              wxDouble columnWidth)
+{
+    Column& column = *(m_datasets[datasetIndex]->GetColumns()[index]);
+    wxPoint2DDouble position = m_grid.GetMapping().GetWindowPositionAtTickMark(index, column.GetValue());
+    position.m_x += m_options->GetColumnSpacing() + (datasetIndex * (columnWidth + m_options->GetDatasetSpacing()));
+
+    wxPoint2DDouble bottomLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(index);
+
+    column.SetPosition(position);
+    column.SetSize(columnWidth, bottomLeftCornerPosition.m_y - position.m_y);
+}
+
+bool wxColumnChart::UpdateValueAxis(const wxChartsCategoricalData &data,
+                                    bool recompute)
+{
+    if (recompute)
+    {
+        m_extents = GetExtents(data.GetDatasets());
+    }
+
+    if (m_grid.UpdateAxisLimit("y", m_extents.m_minValue, m_extents.m_maxValue))
+    {
+        InvalidateFit();
+        return true;
+    }
+    return false;
+}
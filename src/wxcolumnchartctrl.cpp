@@ -40,12 +40,48 @@ wxColumnChartCtrl::wxColumnChartCtrl(wxWindow *parent,
                                      const wxSize &size,
                                      long style)
     : wxChartCtrl(parent, id, pos, size, style), 
+    m_data(data),
     m_columnChart(data, size)
 {
     SetMinSize(wxSize(300, 150));
+    m_data->AddObserver(this);
+}
+
+wxColumnChartCtrl::~wxColumnChartCtrl()
+{
+    m_data->RemoveObserver(this);
 }
 
 wxColumnChart& wxColumnChartCtrl::GetChart()
 {
     return m_columnChart;
 }
+
+void wxColumnChartCtrl::OnValueChanged(const wxChartsCategoricalData &data,
+                                       size_t datasetIndex,
+                                       size_t index,
+                                       wxDouble oldValue)
+{
+    m_columnChart.OnValueChanged(data, datasetIndex, index, oldValue);
+    Refresh();
+}
+
+void wxColumnChartCtrl::OnCategoryAppended(const wxChartsCategoricalData &data)
+{
+    m_columnChart.OnCategoryAppended(data);
+    Refresh();
+}
+
+void wxColumnChartCtrl::OnDatasetAdded(const wxChartsCategoricalData &data,
+                                       size_t datasetIndex)
+{
+    m_columnChart.OnDatasetAdded(data, datasetIndex);
+    Refresh();
+}
+
+void wxColumnChartCtrl::OnDatasetRemoved(const wxChartsCategoricalData &data,
+                                         size_t datasetIndex)
+{
+    m_columnChart.OnDatasetRemoved(data, datasetIndex);
+    Refresh();
+}
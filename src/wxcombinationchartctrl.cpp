@@ -34,6 +34,7 @@ wxCombinationChartCtrl::wxCombinationChartCtrl(wxWindow *parent,
 void wxCombinationChartCtrl::AddColumnChart(const wxChartsCategoricalData &data)
 {
     m_combinationChart.AddColumnChart(data);
+    Refresh();
 }
 
 wxCombinationChart& wxCombinationChartCtrl::GetChart()
@@ -32,6 +32,43 @@
 */
 
 #include "wxdoughnutandpiechartbase.h"
+#include <algorithm>
+#include <cmath>
+
+wxPieChartDataDelta::wxPieChartDataDelta()
+    : m_fullUpdate(false)
+{
+}
+
+bool wxPieChartDataDelta::IsFullUpdate() const
+{
+    return m_fullUpdate;
+}
+
+const std::set<wxString>& wxPieChartDataDelta::GetChangedSlices() const
+{
+    return m_changedSlices;
+}
+
+void wxPieChartDataDelta::AddChangedSlice(const wxString &label)
+{
+    if (!m_fullUpdate)
+    {
+        m_changedSlices.insert(label);
+    }
+}
+
+void wxPieChartDataDelta::SetFullUpdate()
+{
+    m_fullUpdate = true;
+    m_changedSlices.clear();
+}
+
+void wxPieChartDataDelta::Clear()
+{
+    m_fullUpdate = false;
+    m_changedSlices.clear();
+}
 
 wxPieChartData::wxPieChartData()
 {
@@ -56,6 +93,7 @@ void wxPieChartData::AppendSlice(const wxChartSliceData &slice)
 void wxPieChartData::UpdateSlices(const wxVector<wxChartSliceData> &slices)
 {
     m_value.clear();
+    m_delta.SetFullUpdate();
     AddSlices(slices);
 }
 
@@ -75,6 +113,7 @@ void wxPieChartData::Add(const wxChartSliceData &slice)
         m_value.insert(std::make_pair(key, slice));
     else
         it->second.SetValue(it->second.GetValue() + slice.GetValue());
+    m_delta.AddChangedSlice(key);
 }
 
 wxDoughnutAndPieChartBase::SliceArc::SliceArc(const wxChartSliceData &slice,
@@ -87,7 +126,7 @@ wxDoughnutAndPieChartBase::SliceArc::SliceArc(const wxChartSliceData &slice,
                                               unsigned int strokeWidth)
     : wxChartArc(x, y, startAngle, endAngle, outerRadius, innerRadius, 
         slice.GetTooltipText(), wxChartArcOptions(strokeWidth, slice.GetColor())),
-    m_value(slice.GetValue())
+    m_value(slice.GetValue()), m_label(slice.GetLabel())
 {
 }
 
@@ -108,36 +147,98 @@ wxDouble wxDoughnutAndPieChartBase::SliceArc::GetValue() const
     return m_value;
 }
 
+const wxString& wxDoughnutAndPieChartBase::SliceArc::GetLabel() const
+{
+    return m_label;
+}
+
 wxDoughnutAndPieChartBase::wxDoughnutAndPieChartBase(wxPieChartData::ptr data)
-    : m_data(data), m_total(0)
+    : m_data(data), m_needsSlices(true), m_total(0)
 {
 }
 
 wxDoughnutAndPieChartBase::wxDoughnutAndPieChartBase(const wxPieChartData::ptr data,
                                                      const wxSize &size)
-    : m_data(data), m_size(size), m_total(0)
+    : m_data(data), m_needsSlices(true), m_size(size), m_total(0)
 {
 }
 
 void wxDoughnutAndPieChartBase::SetData(const std::map<wxString, wxChartSliceData> &data)
 {
+    // The slices the tooltips refer to are about to be destroyed
+    DeactivateElements();
+
     m_slices.resize(data.size());
     m_total = 0;
-	size_t i = 0;
+    size_t i = 0;
     for (const auto &pair : data)
     {
-        auto slice = pair.second;
+        m_total += pair.second.GetValue();
+        m_slices[i++] = CreateSliceArc(pair.second);
+    }
 
-        m_total += slice.GetValue();
-        wxDouble x = (m_size.GetX() / 2) - 2;
-        wxDouble y = (m_size.GetY() / 2) - 2;
-        wxDouble outerRadius = ((x < y) ? x : y) - (GetOptions().GetSliceStrokeWidth() / 2);
-        wxDouble innerRadius = outerRadius * ((wxDouble)GetOptions().GetPercentageInnerCutout()) / 100;
+    m_needsSlices = false;
+    InvalidateFit();
+}
 
-        SliceArc::ptr newSlice = SliceArc::ptr(new SliceArc(slice,
-                                               x, y, 0, 0, outerRadius, innerRadius, GetOptions().GetSliceStrokeWidth()));
-        m_slices[i++] = newSlice;
+void wxDoughnutAndPieChartBase::UpdateData(const std::map<wxString, wxChartSliceData> &data,
+                                           const wxPieChartDataDelta &delta)
+{
+    if (m_needsSlices || delta.IsFullUpdate())
+    {
+        SetData(data);
+        return;
     }
+
+    DeactivateElements();
+
+    // Both the slices and the changed labels are sorted so
+    // they are merged into a new list of slices in a single
+    // pass. Inserting and erasing in place would move the
+    // slices that follow for each changed label.
+    const std::set<wxString> &changedSlices = delta.GetChangedSlices();
+    wxVector<SliceArc::ptr> slices;
+    slices.reserve(m_slices.size() + changedSlices.size());
+    size_t i = 0;
+    for (std::set<wxString>::const_iterator it = changedSlices.begin(); it != changedSlices.end(); ++it)
+    {
+        while ((i < m_slices.size()) && (m_slices[i]->GetLabel() < *it))
+        {
+            slices.push_back(m_slices[i++]);
+        }
+
+        // The old slice, if any, is dropped
+        if ((i < m_slices.size()) && (m_slices[i]->GetLabel() == *it))
+        {
+            m_total -= m_slices[i]->GetValue();
+            ++i;
+        }
+
+        std::map<wxString, wxChartSliceData>::const_iterator slice = data.find(*it);
+        if (slice != data.end())
+        {
+            slices.push_back(CreateSliceArc(slice->second));
+            m_total += slice->second.GetValue();
+        }
+    }
+    while (i < m_slices.size())
+    {
+        slices.push_back(m_slices[i++]);
+    }
+    m_slices = slices;
+
+    InvalidateFit();
+}
+
+wxDoughnutAndPieChartBase::SliceArc::ptr wxDoughnutAndPieChartBase::CreateSliceArc(const wxChartSliceData &slice) const
+{
+    wxDouble x = (m_size.GetX() / 2) - 2;
+    wxDouble y = (m_size.GetY() / 2) - 2;
+    wxDouble outerRadius = ((x < y) ? x : y) - (GetOptions().GetSliceStrokeWidth() / 2);
+    wxDouble innerRadius = outerRadius * ((wxDouble)GetOptions().GetPercentageInnerCutout()) / 100;
+
+    return SliceArc::ptr(new SliceArc(slice, x, y, 0, 0, outerRadius, innerRadius,
+        GetOptions().GetSliceStrokeWidth()));
 }
 
 void wxDoughnutAndPieChartBase::DoSetSize(const wxSize &size)
@@ -147,13 +248,17 @@ void wxDoughnutAndPieChartBase::DoSetSize(const wxSize &size)
 
 void wxDoughnutAndPieChartBase::DoFit()
 {
-    SetData(m_data->GetSlices());
+    if (m_needsSlices)
+    {
+        SetData(m_data->GetSlices());
+    }
 
     for (size_t i = 0; i < m_slices.size(); ++i)
     {
         m_slices[i]->Resize(m_size, GetOptions());
     }
 
+    m_endAngles.resize(m_slices.size());
     wxDouble startAngle = 0.0;
     for (size_t i = 0; i < m_slices.size(); ++i)
     {
@@ -161,6 +266,7 @@ void wxDoughnutAndPieChartBase::DoFit()
 
         wxDouble endAngle = startAngle + CalculateCircumference(currentSlice.GetValue());
         currentSlice.SetAngles(startAngle, endAngle);
+        m_endAngles[i] = endAngle;
         startAngle = endAngle;
     }
 }
@@ -184,8 +290,30 @@ void wxDoughnutAndPieChartBase::DoDraw(wxGraphicsContext &gc,
 wxSharedPtr<wxVector<const wxChartElement*> > wxDoughnutAndPieChartBase::GetActiveElements(const wxPoint &point)
 {
     wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-    for (size_t i = 0; i < m_slices.size(); ++i)
+    if (m_slices.empty() || (m_endAngles.size() != m_slices.size()))
+    {
+        return activeElements;
+    }
+
+    // All the slices share the same center
+    const wxPoint2DDouble center = m_slices[0]->GetCenter();
+    wxDouble angle = atan2(point.y - center.m_y, point.x - center.m_x);
+    if (angle < 0)
     {
+        angle += 2 * M_PI;
+    }
+
+    // Only the slices whose angular range contains the angle
+    // need to be tested, there can be more than one if the
+    // angle is on the boundary between slices
+    size_t i = std::lower_bound(m_endAngles.begin(), m_endAngles.end(), angle) - m_endAngles.begin();
+    for (; i < m_slices.size(); ++i)
+    {
+        wxDouble startAngle = (i > 0) ? m_endAngles[i - 1] : 0;
+        if (startAngle > angle)
+        {
+            break;
+        }
         if (m_slices[i]->HitTest(point))
         {
             activeElements->push_back(m_slices[i].get());
@@ -56,7 +56,13 @@ void wxDoughnutChartCtrl::OnUpdate(const std::map<wxString,
 	                               wxChartSliceData> &data)
 {
     m_doughnutChart.SetData(data);
-    auto parent = this->GetParent();
-    if(parent)
-        parent->Layout();
+    ScheduleRefresh(true);
+}
+
+void wxDoughnutChartCtrl::OnDeltaUpdate(const std::map<wxString, wxChartSliceData> &data,
+                                        const wxPieChartDataDelta &delta)
+{
+    // Only the slices that changed are rebuilt
+    m_doughnutChart.UpdateData(data, delta);
+    ScheduleRefresh(true);
 }
@@ -32,14 +32,13 @@
 */
 
 #include "wxhistchart.h"
-#include <wx/dcmemory.h>
+#include "wxchartutilities.h"
 #include <sstream>
-#include <algorithm>
 
 wxHistogramChartDataset::wxHistogramChartDataset(
     const wxColor &lineColor,
     const wxColor &fillColor,
-    wxVector<wxDouble> &data)
+    const wxVector<wxDouble> &data)
     : m_lineColor(lineColor),m_fill(true),
       m_fillColor(fillColor),m_data(data)
 {
@@ -60,11 +59,30 @@ const wxColor& wxHistogramChartDataset::GetLineColor() const
     return m_lineColor;
 }
 
+wxHistogramChartDataset::wxHistogramChartDataset(
+    const wxColor &lineColor,
+    const wxColor &fillColor,
+    const wxHistogramChartSketch &sketch)
+    : m_lineColor(lineColor),m_fill(true),
+      m_fillColor(fillColor),m_sketch(new wxHistogramChartSketch(sketch))
+{
+}
+
 const wxVector<wxDouble>& wxHistogramChartDataset::GetData() const
 {
     return m_data;
 }
 
+bool wxHistogramChartDataset::HasSketch() const
+{
+    return (m_sketch.get() != 0);
+}
+
+const wxHistogramChartSketch& wxHistogramChartDataset::GetSketch() const
+{
+    return *m_sketch;
+}
+
 wxHistogramChartData::wxHistogramChartData(
     wxHistogramChartDataset::ptr dataset, std::size_t n) : m_dataset(dataset),m_nbins(n)
 {
@@ -83,14 +101,18 @@ std::size_t wxHistogramChartData::GetNBins() const
 wxHistogramChart::Dataset::Dataset(
     wxDouble min,wxDouble max,std::size_t n,
     const wxColor &lineColor,const wxColor &fillColor)
-    :  m_lineColor(lineColor), m_fillColor(fillColor), m_fill(true)
+    :  m_lineColor(lineColor), m_fillColor(fillColor), m_fill(true),
+       m_min(min), m_step(0), m_maxCount(0)
 {
     m_buckets = wxVector<Bucket>(n);
-    double step = (max-min)/n;
+    if (n > 0)
+    {
+        m_step = (max-min)/n;
+    }
     for(std::size_t i = 0; i<n; i++)
     {
-        m_buckets[i].m_begin = min+i*step;
-        m_buckets[i].m_end = min+(i+1)*step;
+        m_buckets[i].m_begin = min+i*m_step;
+        m_buckets[i].m_end = min+(i+1)*m_step;
         m_buckets[i].m_count = 0;
     }
 }
@@ -115,24 +137,106 @@ const wxVector<wxHistogramChart::Bucket>& wxHistogramChart::Dataset::GetBuckets(
     return m_buckets;
 }
 
+std::size_t wxHistogramChart::Dataset::GetMaxCount() const
+{
+    return m_maxCount;
+}
+
+std::size_t wxHistogramChart::Dataset::GetBucketIndex(wxDouble value) const
+{
+    std::size_t last = m_buckets.size() - 1;
+    if (value < m_min)
+    {
+        return 0;
+    }
+    // This also catches NaN values and the case where all
+    // the buckets are empty because all the values are the same
+    if (!(value < m_buckets[last].m_end))
+    {
+        return last;
+    }
+
+    std::size_t index = static_cast<std::size_t>((value - m_min) / m_step);
+    if (index > last)
+    {
+        index = last;
+    }
+    // The division may be off by one because of rounding, the
+    // limits of the buckets are used to decide
+    if ((index > 0) && (value < m_buckets[index].m_begin))
+    {
+        --index;
+    }
+    else if ((index < last) && (value >= m_buckets[index].m_end))
+    {
+        ++index;
+    }
+    return index;
+}
+
 void wxHistogramChart::Dataset::AppendValue(wxDouble value)
 {
-    auto it = std::find_if(m_buckets.begin(),m_buckets.end(),
-                           [&value](const Bucket &b)
+    AppendValues(&value, 1);
+}
+
+void wxHistogramChart::Dataset::AppendValues(const wxDouble *values,
+                                             std::size_t count)
+{
+    if (m_buckets.empty() || (count == 0))
     {
-        return (value>=b.m_begin && value<b.m_end);
-    });
-    if(it != m_buckets.end())
-        it->m_count++;
-    else
-        m_buckets.rbegin()->m_count++;
+        return;
+    }
+
+    // Each chunk has its own counts so that large inputs can be
+    // binned by several threads without any synchronization
+    std::size_t chunkCount = wxChartUtilities::GetParallelChunkCount(count);
+    wxVector<wxVector<std::size_t> > counts(chunkCount,
+        wxVector<std::size_t>(m_buckets.size(), 0));
+    wxChartUtilities::ParallelFor(count,
+        [this, values, &counts](std::size_t chunk, std::size_t begin, std::size_t end)
+        {
+            wxVector<std::size_t> &chunkCounts = counts[chunk];
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                ++chunkCounts[GetBucketIndex(values[i])];
+            }
+        });
+
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+        for (std::size_t j = 0; j < m_buckets.size(); ++j)
+        {
+            m_buckets[j].m_count += counts[i][j];
+        }
+    }
+    for (std::size_t j = 0; j < m_buckets.size(); ++j)
+    {
+        if (m_buckets[j].m_count > m_maxCount)
+        {
+            m_maxCount = m_buckets[j].m_count;
+        }
+    }
+}
+
+void wxHistogramChart::Dataset::SetCounts(const wxVector<std::size_t> &counts)
+{
+    m_maxCount = 0;
+    for (std::size_t j = 0; (j < m_buckets.size()) && (j < counts.size()); ++j)
+    {
+        m_buckets[j].m_count = counts[j];
+        if (counts[j] > m_maxCount)
+        {
+            m_maxCount = counts[j];
+        }
+    }
 }
 
 wxHistogramChart::wxHistogramChart(const wxHistogramChartData &data,
                                    const wxSize &size)
     : m_grid(
           wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
-          size,0,0,0,0, m_options.GetGridOptions())
+          size,0,0,0,0, m_options.GetGridOptions()),
+      m_nbins(0), m_axisMinX(0), m_axisMaxX(0), m_axisMaxY(0)
 {
     Initialize(data);
 }
@@ -143,57 +247,152 @@ wxHistogramChart::wxHistogramChart(const wxHistogramChartData &data,
     : m_options(options),
       m_grid(
           wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
-          size,0,0,0,0, m_options.GetGridOptions())
+          size,0,0,0,0, m_options.GetGridOptions()),
+      m_nbins(0), m_axisMinX(0), m_axisMaxX(0), m_axisMaxY(0)
 {
     Initialize(data);
 }
 
 void wxHistogramChart::Initialize(const wxHistogramChartData &data)
 {
-    auto dataset = data.GetDataset();
-    auto datasetData = dataset->GetData();
+    const wxHistogramChartDataset::ptr &dataset = data.GetDataset();
+    m_nbins = data.GetNBins();
+    m_lineColor = dataset->GetLineColor();
+    m_fillColor = dataset->GetFillColor();
+
+    if (dataset->HasSketch())
+    {
+        m_sketch.reset(new wxHistogramChartSketch(dataset->GetSketch()));
+        if (!m_sketch->IsEmpty())
+        {
+            UpdateFromSketch();
+        }
+        return;
+    }
+
+    const wxVector<wxDouble> &datasetData = dataset->GetData();
     if(datasetData.empty())
         return;
-    auto minmax = std::minmax_element(datasetData.begin(),datasetData.end());
-    m_dataset.reset(new Dataset(*minmax.first,*minmax.second,data.GetNBins(),
-                                dataset->GetLineColor(),dataset->GetFillColor()));
+    CreateDataset(datasetData);
+}
+
+void wxHistogramChart::CreateDataset(const wxVector<wxDouble> &values)
+{
+    bool found = false;
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    wxChartUtilities::UpdateExtents(values, found, minValue, maxValue);
+    m_dataset.reset(new Dataset(minValue, maxValue, m_nbins,
+                                m_lineColor, m_fillColor));
+    m_dataset->AppendValues(&values[0], values.size());
+
+    m_grid.UpdateAxisLimit("x", minValue, maxValue);
+    m_axisMinX = minValue;
+    m_axisMaxX = maxValue;
+    m_grid.UpdateAxisLimit("y", 0, m_dataset->GetMaxCount());
+    m_axisMaxY = m_dataset->GetMaxCount();
+}
+
+void wxHistogramChart::UpdateFromSketch()
+{
+    // The bins are rebuilt from the sketch so that they
+    // always cover the whole range of the values
+    wxDouble minValue = m_sketch->GetMin();
+    wxDouble maxValue = m_sketch->GetMax();
+    bool newDataset = !m_dataset;
+    m_dataset.reset(new Dataset(minValue, maxValue, m_nbins,
+                                m_lineColor, m_fillColor));
+    wxVector<std::size_t> counts;
+    m_sketch->Rebin(minValue, maxValue, m_nbins, counts);
+    m_dataset->SetCounts(counts);
+
+    if (newDataset || (minValue != m_axisMinX) || (maxValue != m_axisMaxX))
+    {
+        m_grid.UpdateAxisLimit("x", minValue, maxValue);
+        m_axisMinX = minValue;
+        m_axisMaxX = maxValue;
+    }
+    if (newDataset)
+    {
+        m_grid.UpdateAxisLimit("y", 0, m_dataset->GetMaxCount());
+        m_axisMaxY = m_dataset->GetMaxCount();
+    }
+    else
+    {
+        UpdateYAxis();
+    }
+}
 
-    for (size_t j = 0; j < datasetData.size(); ++j)
-        m_dataset->AppendValue(datasetData[j]);
+void wxHistogramChart::AddValues(const wxVector<wxDouble> &values)
+{
+    if (values.empty())
+    {
+        return;
+    }
 
-    auto buckets = m_dataset->GetBuckets();
+    if (m_sketch)
+    {
+        m_sketch->Add(values);
+        if (!m_sketch->IsEmpty())
+        {
+            UpdateFromSketch();
+        }
+        return;
+    }
 
-    auto maxY = std::max_element(buckets.begin(),buckets.end(),
-                                 [](const Bucket &a,const Bucket b)
+    if (!m_dataset)
     {
-        return a.m_count < b.m_count;
-    });
+        CreateDataset(values);
+        return;
+    }
 
-    m_grid.UpdateAxisLimit("x",*minmax.first,*minmax.second);
-    m_grid.UpdateAxisLimit("y",0,maxY->m_count);
+    m_dataset->AppendValues(&values[0], values.size());
+    UpdateYAxis();
 }
 
-const wxChartCommonOptions& wxHistogramChart::GetCommonOptions() const
+bool wxHistogramChart::MergeSketch(const wxHistogramChartSketch &sketch)
 {
-    return m_options.GetCommonOptions();
+    if (!m_sketch || !m_sketch->Merge(sketch))
+    {
+        return false;
+    }
+    if (!m_sketch->IsEmpty())
+    {
+        UpdateFromSketch();
+    }
+    return true;
+}
+
+bool wxHistogramChart::SetNBins(std::size_t n)
+{
+    if (!m_sketch)
+    {
+        return false;
+    }
+    m_nbins = n;
+    if (!m_sketch->IsEmpty())
+    {
+        UpdateFromSketch();
+    }
+    return true;
 }
 
-void wxHistogramChart::Save(const wxString &filename,
-                            const wxBitmapType &type,
-                            const wxSize &size)
+void wxHistogramChart::UpdateYAxis()
 {
-    wxBitmap bmp(size.GetWidth(), size.GetHeight());
-    wxMemoryDC mdc(bmp);
-    mdc.Clear();
-    wxGraphicsContext* gc = wxGraphicsContext::Create(mdc);
-    if (gc)
+    // The axis only needs to be rebuilt when
+    // the highest count changes
+    if (m_dataset->GetMaxCount() != m_axisMaxY)
     {
-        DoDraw(*gc, true);
-        bmp.SaveFile(filename, type);
-        delete gc;
+        m_grid.UpdateAxisLimit("y", 0, m_dataset->GetMaxCount());
+        m_axisMaxY = m_dataset->GetMaxCount();
     }
 }
 
+const wxChartCommonOptions& wxHistogramChart::GetCommonOptions() const
+{
+    return m_options.GetCommonOptions();
+}
+
 void wxHistogramChart::DoSetSize(const wxSize &size)
 {
     wxSize newSize(
@@ -210,10 +409,20 @@ void wxHistogramChart::DoFit()
 void wxHistogramChart::DoDraw(wxGraphicsContext &gc,
                               bool suppressTooltips)
 {
+    // The counts or the layout changed so the rectangle
+    // of the active bucket is stale
+    m_activeBuckets.Invalidate();
+
+    m_grid.Fit(gc);
     m_grid.Draw(gc);
     Fit();
 
-    auto buckets = m_dataset->GetBuckets();
+    if (!m_dataset)
+    {
+        return;
+    }
+
+    const wxVector<Bucket> &buckets = m_dataset->GetBuckets();
 
     if (buckets.size() > 0)
     {
@@ -222,7 +431,7 @@ void wxHistogramChart::DoDraw(wxGraphicsContext &gc,
 
         for (size_t j = 0; j < buckets.size(); ++j)
         {
-            Bucket value = buckets[j];
+            const Bucket &value = buckets[j];
             if(is_first)
             {
                 path.MoveToPoint(m_grid.GetMapping().GetWindowPosition(value.m_begin, 0));
@@ -250,5 +459,57 @@ void wxHistogramChart::DoDraw(wxGraphicsContext &gc,
 
 wxSharedPtr<wxVector<const wxChartElement*> > wxHistogramChart::GetActiveElements(const wxPoint &point)
 {
-    return wxSharedPtr<wxVector<const wxChartElement*> >(new wxVector<const wxChartElement*>());
+    m_activeBuckets.Begin();
+    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
+    if (!m_dataset || m_dataset->GetBuckets().empty())
+    {
+        return activeElements;
+    }
+
+    // The buckets all have the same width so the bucket under
+    // the mouse is found directly from its position
+    const wxVector<Bucket> &buckets = m_dataset->GetBuckets();
+    wxDouble left = m_grid.GetMapping().GetWindowPosition(buckets.front().m_begin, 0).m_x;
+    wxDouble right = m_grid.GetMapping().GetWindowPosition(buckets.back().m_end, 0).m_x;
+    if (!(right > left) || (point.x < left) || (point.x >= right))
+    {
+        return activeElements;
+    }
+    std::size_t index = static_cast<std::size_t>((point.x - left) * buckets.size() / (right - left));
+    if (index >= buckets.size())
+    {
+        index = buckets.size() - 1;
+    }
+
+    const Bucket &bucket = buckets[index];
+    wxDouble top = m_grid.GetMapping().GetWindowPosition(bucket.m_begin, bucket.m_count).m_y;
+    wxDouble bottom = m_grid.GetMapping().GetWindowPosition(bucket.m_begin, 0).m_y;
+    if ((point.y >= top) && (point.y <= bottom) && (top < bottom))
+    {
+        const BucketRectangle &rectangle = m_activeBuckets.Add(0, index,
+            [this, index]() { return CreateBucketRectangle(index); });
+        activeElements->push_back(rectangle.get());
+    }
+    return activeElements;
+}
+
+wxHistogramChart::BucketRectangle wxHistogramChart::CreateBucketRectangle(std::size_t index) const
+{
+    const Bucket &bucket = m_dataset->GetBuckets()[index];
+
+    std::stringstream title;
+    title << "[" << bucket.m_begin << ", " << bucket.m_end << ")";
+    std::stringstream text;
+    text << bucket.m_count;
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderStatic(title.str(), text.str(), m_dataset->GetFillColor())
+        );
+
+    wxPoint2DDouble topLeft = m_grid.GetMapping().GetWindowPosition(bucket.m_begin, bucket.m_count);
+    wxPoint2DDouble bottomRight = m_grid.GetMapping().GetWindowPosition(bucket.m_end, 0);
+    BucketRectangle rectangle(new wxChartRectangle(topLeft.m_x, topLeft.m_y, tooltipProvider,
+        wxChartRectangleOptions(m_dataset->GetFillColor(), m_dataset->GetLineColor(),
+            wxTOP | wxLEFT | wxRIGHT)));
+    rectangle->SetSize(bottomRight.m_x - topLeft.m_x, bottomRight.m_y - topLeft.m_y);
+    return rectangle;
 }
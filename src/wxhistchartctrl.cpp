@@ -61,6 +61,28 @@ wxHistogramChartCtrl::wxHistogramChartCtrl(wxWindow *parent,
     CreateContextMenu();
 }
 
+void wxHistogramChartCtrl::AddValues(const wxVector<wxDouble> &values)
+{
+    m_histChart.AddValues(values);
+    Refresh();
+}
+
+bool wxHistogramChartCtrl::MergeSketch(const wxHistogramChartSketch &sketch)
+{
+    if (!m_histChart.MergeSketch(sketch))
+        return false;
+    Refresh();
+    return true;
+}
+
+bool wxHistogramChartCtrl::SetNBins(std::size_t n)
+{
+    if (!m_histChart.SetNBins(n))
+        return false;
+    Refresh();
+    return true;
+}
+
 wxHistogramChart& wxHistogramChartCtrl::GetChart()
 {
     return m_histChart;
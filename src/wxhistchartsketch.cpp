@@ -0,0 +1,473 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxhistchartsketch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static const wxDouble MinRelativeAccuracy = 1e-6;
+// Denormal values are counted as 0
+static const wxDouble MinIndexableValue = std::numeric_limits<wxDouble>::min();
+
+wxHistogramChartSketch::Store::Store()
+    : m_offset(0)
+{
+}
+
+bool wxHistogramChartSketch::Store::IsEmpty() const
+{
+    return m_counts.empty();
+}
+
+int wxHistogramChartSketch::Store::GetMinKey() const
+{
+    return m_offset;
+}
+
+int wxHistogramChartSketch::Store::GetMaxKey() const
+{
+    return (m_offset + static_cast<int>(m_counts.size()) - 1);
+}
+
+size_t wxHistogramChartSketch::Store::GetCount(int key) const
+{
+    if ((key < GetMinKey()) || (key > GetMaxKey()))
+    {
+        return 0;
+    }
+    return m_counts[key - m_offset];
+}
+
+void wxHistogramChartSketch::Store::Add(int key,
+                                        size_t count,
+                                        size_t maxBucketCount)
+{
+    if (m_counts.empty())
+    {
+        m_offset = key;
+        m_counts.push_back(count);
+        return;
+    }
+
+    int maxKey = GetMaxKey();
+    if ((key > maxKey) && (static_cast<size_t>(key - m_offset) < maxBucketCount))
+    {
+        for (int i = maxKey; i < key; ++i)
+        {
+            m_counts.push_back(0);
+        }
+    }
+    else if (key > maxKey)
+    {
+        // Merge the buckets closest to zero to stay
+        // within the maximum number of buckets
+        int offset = key - static_cast<int>(maxBucketCount) + 1;
+        if (offset < m_offset)
+        {
+            offset = m_offset;
+        }
+        wxVector<size_t> counts(key - offset + 1, 0);
+        for (size_t i = 0; i < m_counts.size(); ++i)
+        {
+            int oldKey = m_offset + static_cast<int>(i);
+            counts[((oldKey > offset) ? oldKey : offset) - offset] += m_counts[i];
+        }
+        m_counts = counts;
+        m_offset = offset;
+    }
+    else if (key < m_offset)
+    {
+        int lowestKey = maxKey - static_cast<int>(maxBucketCount) + 1;
+        if (key < lowestKey)
+        {
+            key = lowestKey;
+        }
+        if (key < m_offset)
+        {
+            wxVector<size_t> counts(m_offset - key, 0);
+            for (size_t i = 0; i < m_counts.size(); ++i)
+            {
+                counts.push_back(m_counts[i]);
+            }
+            m_counts = counts;
+            m_offset = key;
+        }
+    }
+
+    m_counts[key - m_offset] += count;
+}
+
+void wxHistogramChartSketch::Store::Clear()
+{
+    m_offset = 0;
+    m_counts.clear();
+}
+
+wxHistogramChartSketch::wxHistogramChartSketch(wxDouble relativeAccuracy,
+                                               size_t maxBucketCount)
+    : m_relativeAccuracy(relativeAccuracy), m_maxBucketCount(maxBucketCount),
+    m_zeroCount(0), m_count(0), m_min(0), m_max(0)
+{
+    // Below this accuracy the keys of the largest values
+    // wouldn't fit in an int
+    if (!(m_relativeAccuracy >= MinRelativeAccuracy) || !(m_relativeAccuracy < 1))
+    {
+        m_relativeAccuracy = 0.01;
+    }
+    if (m_maxBucketCount == 0)
+    {
+        m_maxBucketCount = 1;
+    }
+    m_gamma = (1 + m_relativeAccuracy) / (1 - m_relativeAccuracy);
+    m_logGamma = std::log(m_gamma);
+}
+
+wxDouble wxHistogramChartSketch::GetRelativeAccuracy() const
+{
+    return m_relativeAccuracy;
+}
+
+size_t wxHistogramChartSketch::GetMaxBucketCount() const
+{
+    return m_maxBucketCount;
+}
+
+void wxHistogramChartSketch::Add(wxDouble value)
+{
+    if (!std::isfinite(value))
+    {
+        return;
+    }
+
+    if (value > MinIndexableValue)
+    {
+        m_positiveValues.Add(GetKey(value), 1, m_maxBucketCount);
+    }
+    else if (value < -MinIndexableValue)
+    {
+        m_negativeValues.Add(GetKey(-value), 1, m_maxBucketCount);
+    }
+    else
+    {
+        ++m_zeroCount;
+    }
+
+    if ((m_count == 0) || (value < m_min))
+    {
+        m_min = value;
+    }
+    if ((m_count == 0) || (value > m_max))
+    {
+        m_max = value;
+    }
+    ++m_count;
+}
+
+void wxHistogramChartSketch::Add(const wxVector<wxDouble> &values)
+{
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        Add(values[i]);
+    }
+}
+
+bool wxHistogramChartSketch::Merge(const wxHistogramChartSketch &other)
+{
+    if (other.m_gamma != m_gamma)
+    {
+        return false;
+    }
+    if (other.IsEmpty())
+    {
+        return true;
+    }
+
+    if (!other.m_positiveValues.IsEmpty())
+    {
+        for (int key = other.m_positiveValues.GetMinKey(); key <= other.m_positiveValues.GetMaxKey(); ++key)
+        {
+            size_t count = other.m_positiveValues.GetCount(key);
+            if (count != 0)
+            {
+                m_positiveValues.Add(key, count, m_maxBucketCount);
+            }
+        }
+    }
+    if (!other.m_negativeValues.IsEmpty())
+    {
+        for (int key = other.m_negativeValues.GetMinKey(); key <= other.m_negativeValues.GetMaxKey(); ++key)
+        {
+            size_t count = other.m_negativeValues.GetCount(key);
+            if (count != 0)
+            {
+                m_negativeValues.Add(key, count, m_maxBucketCount);
+            }
+        }
+    }
+    m_zeroCount += other.m_zeroCount;
+
+    if (IsEmpty() || (other.m_min < m_min))
+    {
+        m_min = other.m_min;
+    }
+    if (IsEmpty() || (other.m_max > m_max))
+    {
+        m_max = other.m_max;
+    }
+    m_count += other.m_count;
+    return true;
+}
+
+void wxHistogramChartSketch::Clear()
+{
+    m_positiveValues.Clear();
+    m_negativeValues.Clear();
+    m_zeroCount = 0;
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+}
+
+bool wxHistogramChartSketch::IsEmpty() const
+{
+    return (m_count == 0);
+}
+
+size_t wxHistogramChartSketch::GetCount() const
+{
+    return m_count;
+}
+
+wxDouble wxHistogramChartSketch::GetMin() const
+{
+    return m_min;
+}
+
+wxDouble wxHistogramChartSketch::GetMax() const
+{
+    return m_max;
+}
+
+wxDouble wxHistogramChartSketch::GetQuantile(wxDouble quantile) const
+{
+    if (IsEmpty())
+    {
+        return 0;
+    }
+    if (quantile <= 0)
+    {
+        return m_min;
+    }
+    if (quantile >= 1)
+    {
+        return m_max;
+    }
+
+    // The buckets are visited in increasing order of the
+    // values they contain until the rank is reached
+    size_t rank = static_cast<size_t>(quantile * (m_count - 1));
+    size_t total = 0;
+    if (!m_negativeValues.IsEmpty())
+    {
+        for (int key = m_negativeValues.GetMaxKey(); key >= m_negativeValues.GetMinKey(); --key)
+        {
+            total += m_negativeValues.GetCount(key);
+            if (total > rank)
+            {
+                return Clamp(-GetValue(key));
+            }
+        }
+    }
+    total += m_zeroCount;
+    if (total > rank)
+    {
+        return Clamp(0);
+    }
+    if (!m_positiveValues.IsEmpty())
+    {
+        for (int key = m_positiveValues.GetMinKey(); key <= m_positiveValues.GetMaxKey(); ++key)
+        {
+            total += m_positiveValues.GetCount(key);
+            if (total > rank)
+            {
+                return Clamp(GetValue(key));
+            }
+        }
+    }
+    return m_max;
+}
+
+void wxHistogramChartSketch::Rebin(wxDouble minValue,
+                                   wxDouble maxValue,
+                                   size_t binCount,
+                                   wxVector<size_t> &counts) const
+{
+    counts = wxVector<size_t>(binCount, 0);
+    if ((binCount == 0) || IsEmpty())
+    {
+        return;
+    }
+
+    // The buckets of the sketch don't line up with the bins so
+    // the bins first receive fractional counts
+    wxVector<wxDouble> weights(binCount, 0);
+    wxDouble step = (maxValue - minValue) / binCount;
+    auto addToBin = [&weights, binCount, minValue, step](wxDouble value, wxDouble count)
+    {
+        // Like the exact histogram, values that fall outside
+        // of the bins are counted in the first or last bin
+        size_t index = binCount - 1;
+        if (value < minValue)
+        {
+            index = 0;
+        }
+        else if (step > 0)
+        {
+            wxDouble position = (value - minValue) / step;
+            if (position < (binCount - 1))
+            {
+                index = static_cast<size_t>(position);
+            }
+        }
+        weights[index] += count;
+    };
+    auto addRangeToBins = [this, &weights, &addToBin, binCount, minValue, maxValue, step](
+        wxDouble lower, wxDouble upper, size_t count)
+    {
+        // The values of a bucket are assumed to be spread
+        // uniformly over [lower, upper), which is kept within
+        // the exact minimum and maximum, so each bin gets the
+        // part of the count its overlap with the bucket
+        lower = Clamp(lower);
+        upper = Clamp(upper);
+        if (!(upper > lower) || !(step > 0))
+        {
+            addToBin(lower, count);
+            return;
+        }
+
+        wxDouble density = count / (upper - lower);
+        if (lower < minValue)
+        {
+            weights[0] += density * (std::min(upper, minValue) - lower);
+        }
+        if (upper > maxValue)
+        {
+            weights[binCount - 1] += density * (upper - std::max(lower, maxValue));
+        }
+        wxDouble begin = std::max(lower, minValue);
+        wxDouble end = std::min(upper, maxValue);
+        if (!(end > begin))
+        {
+            return;
+        }
+        // The division may be off by one because of rounding,
+        // bins without any overlap are skipped below
+        size_t first = static_cast<size_t>((begin - minValue) / step);
+        first = std::min(first, binCount - 1);
+        for (size_t i = ((first > 0) ? (first - 1) : 0); i < binCount; ++i)
+        {
+            wxDouble binBegin = minValue + (i * step);
+            wxDouble binEnd = (i == (binCount - 1)) ? maxValue : (binBegin + step);
+            if (binBegin >= end)
+            {
+                break;
+            }
+            wxDouble overlap = std::min(end, binEnd) - std::max(begin, binBegin);
+            if (overlap > 0)
+            {
+                weights[i] += density * overlap;
+            }
+        }
+    };
+
+    // A bucket with key k contains the magnitudes in
+    // (gamma^(k-1), gamma^k]
+    if (!m_negativeValues.IsEmpty())
+    {
+        for (int key = m_negativeValues.GetMinKey(); key <= m_negativeValues.GetMaxKey(); ++key)
+        {
+            size_t count = m_negativeValues.GetCount(key);
+            if (count != 0)
+            {
+                addRangeToBins(-std::exp(key * m_logGamma),
+                    -std::exp((key - 1) * m_logGamma), count);
+            }
+        }
+    }
+    if (m_zeroCount != 0)
+    {
+        addToBin(Clamp(0), m_zeroCount);
+    }
+    if (!m_positiveValues.IsEmpty())
+    {
+        for (int key = m_positiveValues.GetMinKey(); key <= m_positiveValues.GetMaxKey(); ++key)
+        {
+            size_t count = m_positiveValues.GetCount(key);
+            if (count != 0)
+            {
+                addRangeToBins(std::exp((key - 1) * m_logGamma),
+                    std::exp(key * m_logGamma), count);
+            }
+        }
+    }
+
+    // The running total is rounded rather than each bin so
+    // that the counts still add up to the number of values
+    wxDouble total = 0;
+    size_t roundedTotal = 0;
+    for (size_t i = 0; i < binCount; ++i)
+    {
+        total += weights[i];
+        size_t newRoundedTotal = static_cast<size_t>(total + 0.5);
+        counts[i] = newRoundedTotal - roundedTotal;
+        roundedTotal = newRoundedTotal;
+    }
+}
+
+int wxHistogramChartSketch::GetKey(wxDouble magnitude) const
+{
+    return static_cast<int>(std::ceil(std::log(magnitude) / m_logGamma));
+}
+
+wxDouble wxHistogramChartSketch::GetValue(int key) const
+{
+    // The value in the middle of the bucket in terms of
+    // relative error
+    return (2 * std::exp(key * m_logGamma) / (m_gamma + 1));
+}
+
+wxDouble wxHistogramChartSketch::Clamp(wxDouble value) const
+{
+    // The exact minimum and maximum are known so the
+    // approximations are kept within them
+    if (value < m_min)
+    {
+        return m_min;
+    }
+    if (value > m_max)
+    {
+        return m_max;
+    }
+    return value;
+}
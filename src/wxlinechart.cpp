@@ -34,10 +34,13 @@
 #include "wxlinechart.h"
 #include "wxchartcategoricalaxis.h"
 #include "wxchartnumericalaxis.h"
+#include "wxchartdecimation.h"
+#include "wxchartutilities.h"
 #include <wx/brush.h>
 #include <wx/pen.h>
-#include <wx/dcmemory.h>
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 
 wxLineChartDataset::wxLineChartDataset(const wxString &label,
     const wxColor &dotColor,
@@ -48,7 +51,7 @@ wxLineChartDataset::wxLineChartDataset(const wxString &label,
     : m_label(label), m_showDots(true), m_dotColor(dotColor),
     m_dotStrokeColor(dotStrokeColor), m_showLine(true),
     m_lineColor(dotColor), m_fill(true), m_fillColor(fillColor),
-    m_data(data),m_type(lineType)
+    m_data(data),m_type(lineType), m_useMinMaxPyramid(false)
 {
 }
 
@@ -102,6 +105,26 @@ const wxVector<double>& wxLineChartDataset::GetData() const
     return m_data;
 }
 
+const wxLineChartDataset::TooltipFormatter& wxLineChartDataset::GetTooltipFormatter() const
+{
+    return m_tooltipFormatter;
+}
+
+void wxLineChartDataset::SetTooltipFormatter(const TooltipFormatter &formatter)
+{
+    m_tooltipFormatter = formatter;
+}
+
+bool wxLineChartDataset::UsesMinMaxPyramid() const
+{
+    return m_useMinMaxPyramid;
+}
+
+void wxLineChartDataset::SetUseMinMaxPyramid(bool use)
+{
+    m_useMinMaxPyramid = use;
+}
+
 wxLineChartData::wxLineChartData(const wxVector<wxString> &labels)
     : m_labels(labels)
 {
@@ -152,14 +175,19 @@ wxDouble wxLineChart::Point::GetValue() const
 }
 
 wxLineChart::Dataset::Dataset(bool showDots,
+    const wxColor &dotColor,
+    const wxColor &dotStrokeColor,
     bool showLine,
     const wxColor &lineColor,
     bool fill,
     const wxColor &fillColor,
-    const wxLineType &lineType)
-    : m_showDots(showDots), m_showLine(showLine),
+    const wxLineType &lineType,
+    const wxLineChartDataset::TooltipFormatter &tooltipFormatter)
+    : m_showDots(showDots), m_dotColor(dotColor),
+    m_dotStrokeColor(dotStrokeColor), m_showLine(showLine),
     m_lineColor(lineColor), m_fill(fill),
-    m_fillColor(fillColor), m_type(lineType)
+    m_fillColor(fillColor), m_type(lineType),
+    m_tooltipFormatter(tooltipFormatter)
 {
 }
 
@@ -168,6 +196,16 @@ bool wxLineChart::Dataset::ShowDots() const
     return m_showDots;
 }
 
+const wxColor& wxLineChart::Dataset::GetDotColor() const
+{
+    return m_dotColor;
+}
+
+const wxColor& wxLineChart::Dataset::GetDotStrokeColor() const
+{
+    return m_dotStrokeColor;
+}
+
 bool wxLineChart::Dataset::ShowLine() const
 {
     return m_showLine;
@@ -193,14 +231,29 @@ const wxLineType& wxLineChart::Dataset::GetType() const
      return m_type;
 }
 
-const wxVector<wxLineChart::Point::ptr>& wxLineChart::Dataset::GetPoints() const
+const wxLineChartDataset::TooltipFormatter& wxLineChart::Dataset::GetTooltipFormatter() const
+{
+    return m_tooltipFormatter;
+}
+
+const wxChartPointSeries& wxLineChart::Dataset::GetPoints() const
+{
+    return m_points;
+}
+
+wxChartPointSeries& wxLineChart::Dataset::GetPoints()
 {
     return m_points;
 }
 
-void wxLineChart::Dataset::AppendPoint(Point::ptr point)
+const wxVector<size_t>& wxLineChart::Dataset::GetLineIndices() const
+{
+    return m_lineIndices;
+}
+
+wxVector<size_t>& wxLineChart::Dataset::GetLineIndices()
 {
-    m_points.push_back(point);
+    return m_lineIndices;
 }
 
 wxLineChart::wxLineChart(const wxLineChartData &data,
@@ -208,10 +261,13 @@ wxLineChart::wxLineChart(const wxLineChartData &data,
     : m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetTop()),
         size,
-        wxChartCategoricalAxis::make_shared("x", data.GetLabels(), m_options.GetGridOptions().GetXAxisOptions()),
-        wxChartNumericalAxis::make_shared("y", GetMinValue(data.GetDatasets()), GetMaxValue(data.GetDatasets()), m_options.GetGridOptions().GetYAxisOptions()),
+        wxChartCategoricalAxis::make_shared("x", data.GetLabels().size(),
+            [this](size_t index) { return GetLabel(index); },
+            m_options.GetGridOptions().GetXAxisOptions()),
+        CreateValueAxis(data.GetDatasets(), m_options.GetGridOptions().GetYAxisOptions()),
         m_options.GetGridOptions()
-        )
+        ),
+    m_labelCount(0), m_removedLabelCount(0), m_generatedCount(0)
 {
     Initialize(data);
 }
@@ -223,10 +279,13 @@ wxLineChart::wxLineChart(const wxLineChartData &data,
     m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetTop()),
         size,
-        wxChartCategoricalAxis::make_shared("x", data.GetLabels(), m_options.GetGridOptions().GetXAxisOptions()),
-        wxChartNumericalAxis::make_shared("y", GetMinValue(data.GetDatasets()), GetMaxValue(data.GetDatasets()), m_options.GetGridOptions().GetYAxisOptions()),
+        wxChartCategoricalAxis::make_shared("x", data.GetLabels().size(),
+            [this](size_t index) { return GetLabel(index); },
+            m_options.GetGridOptions().GetXAxisOptions()),
+        CreateValueAxis(data.GetDatasets(), m_options.GetGridOptions().GetYAxisOptions()),
         m_options.GetGridOptions()
-        )
+        ),
+    m_labelCount(0), m_removedLabelCount(0), m_generatedCount(0)
 {
     Initialize(data);
 }
@@ -236,103 +295,366 @@ const wxChartCommonOptions& wxLineChart::GetCommonOptions() const
     return m_options.GetCommonOptions();
 }
 
-void wxLineChart::Save(const wxString &filename,
-                       const wxBitmapType &type,
-                       const wxSize &size)
-{
-    wxBitmap bmp(size.GetWidth(), size.GetHeight());
-    wxMemoryDC mdc(bmp);
-    mdc.Clear();
-    wxGraphicsContext* gc = wxGraphicsContext::Create(mdc);
-    if (gc)
-    {
-        DoDraw(*gc, true);
-        bmp.SaveFile(filename, type);
-        delete gc;
-    }
-}
-
 void wxLineChart::Initialize(const wxLineChartData &data)
 {
+    // The labels are only created for the tick marks
+    // that are labelled when the chart is drawn
+    AppendLabels(data.GetLabels());
+
     const wxVector<wxLineChartDataset::ptr>& datasets = data.GetDatasets();
     for (size_t i = 0; i < datasets.size(); ++i)
     {
         Dataset::ptr newDataset(new Dataset(datasets[i]->ShowDots(),
+            datasets[i]->GetDotColor(), datasets[i]->GetDotStrokeColor(),
             datasets[i]->ShowLine(), datasets[i]->GetLineColor(),
             datasets[i]->Fill(), datasets[i]->GetFillColor(),
-            datasets[i]->GetType()));
+            datasets[i]->GetType(), datasets[i]->GetTooltipFormatter()));
 
         const wxVector<wxDouble>& datasetData = datasets[i]->GetData();
+        wxChartPointSeries& points = newDataset->GetPoints();
+        points.SetMaxCount(m_options.GetMaxCount());
+        points.SetUseMinMaxPyramid(datasets[i]->UsesMinMaxPyramid());
+        points.Reserve(datasetData.size());
         for (size_t j = 0; j < datasetData.size(); ++j)
         {
-            std::stringstream tooltip;
-            tooltip << datasetData[j];
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic(data.GetLabels()[j], tooltip.str(), datasets[i]->GetLineColor())
-                );
-
-            Point::ptr point(
-                new Point(datasetData[j], tooltipProvider, 20 + j * 10, 0,
-                    m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
-                    datasets[i]->GetDotStrokeColor(), datasets[i]->GetDotColor(),
-                    m_options.GetHitDetectionRange())
-                );
-
-            newDataset->AppendPoint(point);
+            points.Append(j, datasetData[j]);
         }
 
         m_datasets.push_back(newDataset);
     }
+
+    RemoveExtraLabels();
 }
 
-wxDouble wxLineChart::GetMinValue(const wxVector<wxLineChartDataset::ptr>& datasets)
+bool wxLineChart::AddData(const wxString &label,
+                          const wxVector<wxDouble> &values)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
+    if (values.size() != m_datasets.size())
+    {
+        return false;
+    }
 
-    for (size_t i = 0; i < datasets.size(); ++i)
+    // The values are placed at the tick mark of the new
+    // label whatever the number of values of their dataset
+    wxDouble x = m_removedLabelCount + m_labelCount;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        m_datasets[i]->GetPoints().Append(x, values[i]);
+    }
+
+    AppendLabels(wxVector<wxString>(1, label));
+    m_grid.AppendTickMarks("x", 1);
+    RemoveExtraLabels();
+
+    UpdateAxes();
+    return true;
+}
+
+bool wxLineChart::AddData(const wxVector<wxString> &labels,
+                          const wxVector<wxVector<wxDouble> > &values)
+{
+    if (values.size() != m_datasets.size())
     {
-        const wxVector<wxDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
+        return false;
+    }
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        if (values[i].size() != labels.size())
         {
-            if (!foundValue)
-            {
-                result = values[j];
-                foundValue = true;
-            }
-            else if (result > values[j])
-            {
-                result = values[j];
-            }
+            return false;
         }
     }
 
-    return result;
+    wxDouble x = m_removedLabelCount + m_labelCount;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        for (size_t j = 0; j < values[i].size(); ++j)
+        {
+            points.Append(x + j, values[i][j]);
+        }
+    }
+
+    AppendLabels(labels);
+    m_grid.AppendTickMarks("x", labels.size());
+    RemoveExtraLabels();
+
+    UpdateAxes();
+    return true;
 }
 
-wxDouble wxLineChart::GetMaxValue(const wxVector<wxLineChartDataset::ptr>& datasets)
+bool wxLineChart::AddData(const wxVector<wxVector<wxDouble> > &values)
 {
-    wxDouble result = 0;
+    if ((values.size() != m_datasets.size()) || values.empty())
+    {
+        return false;
+    }
+    size_t count = values[0].size();
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        if (values[i].size() != count)
+        {
+            return false;
+        }
+    }
+
+    wxDouble x = m_removedLabelCount + m_labelCount;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        for (size_t j = 0; j < count; ++j)
+        {
+            points.Append(x + j, values[i][j]);
+        }
+    }
+
+    AppendGeneratedLabels(count);
+    m_grid.AppendTickMarks("x", count);
+    RemoveExtraLabels();
+
+    UpdateAxes();
+    return true;
+}
+
+void wxLineChart::SetLabelGenerator(const LabelGenerator &generator)
+{
+    m_labelGenerator = generator;
+    m_grid.InvalidateFit();
+}
+
+size_t wxLineChart::GetDatasetCount() const
+{
+    return m_datasets.size();
+}
+
+void wxLineChart::UpdateAxes()
+{
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
     bool foundValue = false;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        // The series keeps its extents up to date so
+        // the points don't need to be read
+        wxDouble minX = 0;
+        wxDouble maxX = 0;
+        wxDouble minY = 0;
+        wxDouble maxY = 0;
+        if (!m_datasets[i]->GetPoints().GetExtents(minX, maxX, minY, maxY))
+        {
+            continue;
+        }
+        if (!foundValue)
+        {
+            minValue = minY;
+            maxValue = maxY;
+            foundValue = true;
+        }
+        else
+        {
+            minValue = std::min(minValue, minY);
+            maxValue = std::max(maxValue, maxY);
+        }
+    }
 
-    for (size_t i = 0; i < datasets.size(); ++i)
+    // The labels of the X axis are appended to it
+    // as the values are added
+    m_grid.UpdateAxisLimit("y", minValue, maxValue);
+}
+
+wxString wxLineChart::GetLabel(size_t index) const
+{
+    size_t labelIndex = 0;
+    for (size_t i = 0; i < m_labelRuns.size(); ++i)
     {
-        const wxVector<wxDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
+        const LabelRun& run = m_labelRuns[i];
+        if (index < run.count)
         {
-            if (!foundValue)
+            if (!run.generated)
             {
-                result = values[j];
-                foundValue = true;
-            }
-            else if (result < values[j])
-            {
-                result = values[j];
+                return m_labels[labelIndex + index];
             }
+            return (m_labelGenerator ? m_labelGenerator(run.generatorIndex + index) : wxString());
+        }
+        if (!run.generated)
+        {
+            labelIndex += run.count;
         }
+        index -= run.count;
     }
+    return wxString();
+}
 
-    return result;
+void wxLineChart::AppendLabels(const wxVector<wxString> &labels)
+{
+    if (labels.empty())
+    {
+        return;
+    }
+    if (m_labelRuns.empty() || m_labelRuns.back().generated)
+    {
+        LabelRun run = { 0, false, 0 };
+        m_labelRuns.push_back(run);
+    }
+    m_labelRuns.back().count += labels.size();
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        m_labels.push_back(labels[i]);
+    }
+    m_labelCount += labels.size();
+}
+
+void wxLineChart::AppendGeneratedLabels(size_t count)
+{
+    if (m_labelRuns.empty() || !m_labelRuns.back().generated)
+    {
+        LabelRun run = { 0, true, m_generatedCount };
+        m_labelRuns.push_back(run);
+    }
+    m_labelRuns.back().count += count;
+    m_generatedCount += count;
+    m_labelCount += count;
+}
+
+void wxLineChart::RemoveExtraLabels()
+{
+    if ((m_options.GetMaxCount() == 0) || (m_labelCount <= m_options.GetMaxCount()))
+    {
+        return;
+    }
+
+    size_t count = m_labelCount - m_options.GetMaxCount();
+    m_labelCount -= count;
+    m_removedLabelCount += count;
+    m_grid.RemoveFirstTickMarks("x", count);
+
+    // All the datasets are trimmed to the same labels
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        m_datasets[i]->GetPoints().RemoveBeforeX(m_removedLabelCount);
+    }
+
+    while (count > 0)
+    {
+        LabelRun& run = m_labelRuns.front();
+        size_t removed = std::min(count, run.count);
+        if (run.generated)
+        {
+            run.generatorIndex += removed;
+        }
+        else
+        {
+            m_labels.erase(m_labels.begin(), m_labels.begin() + removed);
+        }
+        run.count -= removed;
+        if (run.count == 0)
+        {
+            m_labelRuns.pop_front();
+        }
+        count -= removed;
+    }
+}
+
+wxPoint2DDouble wxLineChart::GetPointPosition(const wxChartPointSeries &points,
+                                              size_t index) const
+{
+    size_t tickMark = static_cast<size_t>(points.GetX(index)) - m_removedLabelCount;
+    return m_grid.GetMapping().GetWindowPositionAtTickMark(tickMark, points.GetY(index));
+}
+
+void wxLineChart::UpdateLinePositions(Dataset &dataset)
+{
+    wxChartPointSeries& points = dataset.GetPoints();
+    wxVector<size_t>& indices = dataset.GetLineIndices();
+    indices.clear();
+
+    size_t count = points.GetCount();
+    if (count == 0)
+    {
+        return;
+    }
+
+    // There is at most one point per tick mark and the
+    // points are sorted by tick mark so the columns are
+    // obtained by splitting the X values evenly
+    wxDouble firstX = points.GetX(0);
+    wxDouble lastX = points.GetX(count - 1);
+    wxDouble width = std::abs(GetPointPosition(points, count - 1).m_x -
+        GetPointPosition(points, 0).m_x);
+    size_t columns = static_cast<size_t>(std::max(width, 1.0));
+
+    if (count <= (4 * columns))
+    {
+        for (size_t j = 0; j < count; ++j)
+        {
+            indices.push_back(j);
+        }
+    }
+    else
+    {
+        wxVector<size_t> boundaries;
+        boundaries.reserve(columns + 1);
+        std::function<wxDouble(wxDouble)> identity = [](wxDouble x) { return x; };
+        boundaries.push_back(0);
+        for (size_t c = 1; c < columns; ++c)
+        {
+            boundaries.push_back(points.FindFirstX(firstX + (((lastX - firstX) * c) / columns), identity));
+        }
+        boundaries.push_back(count);
+        points.Decimate(boundaries, indices);
+    }
+
+    for (size_t j = 0; j < indices.size(); ++j)
+    {
+        points.SetPosition(indices[j], GetPointPosition(points, indices[j]));
+    }
+}
+
+wxLineChart::Point::ptr wxLineChart::CreatePoint(const Dataset &dataset,
+                                                 size_t index) const
+{
+    const wxChartPointSeries& points = dataset.GetPoints();
+    wxDouble value = points.GetY(index);
+
+    wxString title = GetLabel(static_cast<size_t>(points.GetX(index)) - m_removedLabelCount);
+    wxLineChartDataset::TooltipFormatter formatter = dataset.GetTooltipFormatter();
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderLazy(
+            [title]() -> wxString
+            {
+                return title;
+            },
+            [formatter, value]() -> wxString
+            {
+                if (formatter)
+                {
+                    return formatter(value);
+                }
+                std::stringstream tooltip;
+                tooltip << value;
+                return tooltip.str();
+            },
+            dataset.GetLineColor())
+        );
+
+    const wxPoint2DDouble& position = points.GetPosition(index);
+    return Point::ptr(new Point(value, tooltipProvider, position.m_x, position.m_y,
+        m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
+        dataset.GetDotStrokeColor(), dataset.GetDotColor(),
+        m_options.GetHitDetectionRange()));
+}
+
+wxChartAxis::ptr wxLineChart::CreateValueAxis(const wxVector<wxLineChartDataset::ptr>& datasets,
+                                              const wxChartAxisOptions &options)
+{
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    bool foundValue = false;
+    for (size_t i = 0; i < datasets.size(); ++i)
+    {
+        wxChartUtilities::UpdateExtents(datasets[i]->GetData(), foundValue, minValue, maxValue);
+    }
+    return wxChartNumericalAxis::make_shared("y", minValue, maxValue, options);
 }
 
 void wxLineChart::DoSetSize(const wxSize &size)
@@ -351,64 +673,99 @@ void wxLineChart::DoFit()
 void wxLineChart::DoDraw(wxGraphicsContext &gc,
                          bool suppressTooltips)
 {
-    m_grid.Fit(gc);
-    m_grid.Draw(gc);
+    // The chart is only redrawn when the data or the layout
+    // changed, in which case the active points are stale
+    m_activePoints.Invalidate();
 
-    for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-
-        wxGraphicsPath path = gc.CreatePath();
+        wxChartInstrumentation::Scope scope(GetInstrumentation(), wxCHARTSTAGE_GRID);
+        m_grid.Fit(gc);
+        m_grid.Draw(gc);
+    }
 
-        if (points.size() > 0)
+    {
+        wxChartInstrumentation::Scope scope(GetInstrumentation(), wxCHARTSTAGE_DATASETS);
+        for (size_t i = 0; i < m_datasets.size(); ++i)
         {
-            const Point::ptr& point = points[0];
-            wxPoint2DDouble firstPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(0, point->GetValue());
-            path.MoveToPoint(firstPosition);
-
-            wxPoint2DDouble lastPosition;
-            for (size_t j = 1; j < points.size(); ++j)
-            {
-                const Point::ptr& point = points[j];
-                lastPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j, point->GetValue());
-                if(m_datasets[i]->GetType()==wxLINETYPE_STEPPEDLINE)
-                 {
-                     wxPoint2DDouble temp = m_grid.GetMapping().GetWindowPositionAtTickMark(j, points[j-1]->GetValue());
-                     path.AddLineToPoint(temp);
-                 }
-                path.AddLineToPoint(lastPosition);
-            }
-
-            if (m_datasets[i]->ShowLine())
+            wxChartPointSeries& points = m_datasets[i]->GetPoints();
+            wxVector<wxPoint2DDouble> line;
+            if (points.UsesMinMaxPyramid())
             {
-                wxPen pen(m_datasets[i]->GetLineColor(), m_options.GetLineWidth());
-                gc.SetPen(pen);
+                // Only the points that are drawn are positioned,
+                // the line doesn't need to be decimated again
+                UpdateLinePositions(*m_datasets[i]);
+                const wxVector<size_t>& indices = m_datasets[i]->GetLineIndices();
+                line.reserve(indices.size());
+                for (size_t j = 0; j < indices.size(); ++j)
+                {
+                    line.push_back(points.GetPosition(indices[j]));
+                }
             }
             else
             {
-                // TODO : transparent pen
+                for (size_t j = 0; j < points.GetCount(); ++j)
+                {
+                    points.SetPosition(j, GetPointPosition(points, j));
+                }
+                points.BuildIndex();
+                if (points.GetCount() > 0)
+                {
+                    wxChartDecimation::Decimate(m_options.GetDecimationMode(), points.GetPositions(), line);
+                }
             }
 
-            gc.StrokePath(path);
-
-            wxPoint2DDouble yPos = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(0);
-
-            path.AddLineToPoint(lastPosition.m_x, yPos.m_y);
-            path.AddLineToPoint(firstPosition.m_x, yPos.m_y);
-            path.CloseSubpath();
-
-            wxBrush brush(m_datasets[i]->GetFillColor());
-            gc.SetBrush(brush);
-            gc.FillPath(path);
-        }
+            if (line.size() > 0)
+            {
+                wxGraphicsPath path = gc.CreatePath();
+
+                wxPoint2DDouble firstPosition = line[0];
+                path.MoveToPoint(firstPosition);
+
+                for (size_t j = 1; j < line.size(); ++j)
+                {
+                    if (m_datasets[i]->GetType() == wxLINETYPE_STEPPEDLINE)
+                    {
+                        path.AddLineToPoint(line[j].m_x, line[j - 1].m_y);
+                    }
+                    path.AddLineToPoint(line[j]);
+                }
+                wxPoint2DDouble lastPosition = line[line.size() - 1];
+
+                if (m_datasets[i]->ShowLine())
+                {
+                    wxPen pen(m_datasets[i]->GetLineColor(), m_options.GetLineWidth());
+                    gc.SetPen(pen);
+                }
+                else
+                {
+                    // TODO : transparent pen
+                }
+
+                gc.StrokePath(path);
+                GetInstrumentation().AddPrimitives(wxCHARTSTAGE_DATASETS, 1);
+
+                wxPoint2DDouble yPos = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(0);
+
+                path.AddLineToPoint(lastPosition.m_x, yPos.m_y);
+                path.AddLineToPoint(firstPosition.m_x, yPos.m_y);
+                path.CloseSubpath();
+
+                wxBrush brush(m_datasets[i]->GetFillColor());
+                gc.SetBrush(brush);
+                gc.FillPath(path);
+                GetInstrumentation().AddPrimitives(wxCHARTSTAGE_DATASETS, 1);
+            }
+            GetInstrumentation().AddPoints(wxCHARTSTAGE_DATASETS, points.GetCount(), line.size());
 
-        if (m_datasets[i]->ShowDots())
-        {
-            for (size_t j = 0; j < points.size(); ++j)
+            if (m_datasets[i]->ShowDots())
             {
-                const Point::ptr& point = points[j];
-                point->SetPosition(m_grid.GetMapping().GetWindowPositionAtTickMark(j, point->GetValue()));
-                point->Draw(gc);
+                // All the points of the dataset are drawn as
+                // a single path
+                wxChartPoint::DrawAll(gc, points.UsesMinMaxPyramid() ? line : points.GetPositions(), m_options.GetDotRadius(),
+                    wxChartPointOptions(m_options.GetDotStrokeWidth(),
+                        m_datasets[i]->GetDotStrokeColor(), m_datasets[i]->GetDotColor()));
+                GetInstrumentation().AddPrimitives(wxCHARTSTAGE_DATASETS,
+                    points.UsesMinMaxPyramid() ? line.size() : points.GetCount());
             }
         }
     }
@@ -421,15 +778,39 @@ void wxLineChart::DoDraw(wxGraphicsContext &gc,
 
 wxSharedPtr<wxVector<const wxChartElement*> > wxLineChart::GetActiveElements(const wxPoint &point)
 {
+    m_activePoints.Begin();
     wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
+    wxDouble range = m_options.GetHitDetectionRange();
+    wxVector<size_t> candidates;
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        const wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        candidates.clear();
+        if (points.UsesMinMaxPyramid())
         {
-            if (points[j]->HitTest(point))
+            // Only the points that are drawn have a position,
+            // they are sorted by X
+            points.FindInXRange(m_datasets[i]->GetLineIndices(),
+                point.x - range, point.x + range, candidates);
+        }
+        else
+        {
+            points.FindInXRange(point.x - range, point.x + range, candidates);
+        }
+        for (size_t j = 0; j < candidates.size(); ++j)
+        {
+            // The range search is inclusive but the hit detection
+            // range is not
+            wxDouble distance = (point.x - points.GetPosition(candidates[j]).m_x);
+            if (distance < 0)
+            {
+                distance = -distance;
+            }
+            if (distance < range)
             {
-                activeElements->push_back(points[j].get());
+                const Point::ptr &activePoint = m_activePoints.Add(i, candidates[j],
+                    [&]() { return CreatePoint(*m_datasets[i], candidates[j]); });
+                activeElements->push_back(activePoint.get());
             }
         }
     }
@@ -64,6 +64,74 @@ wxLineChart& wxLineChartCtrl::GetChart()
     return m_lineChart;
 }
 
+bool wxLineChartCtrl::AddData(const wxString &label,
+                              const wxVector<wxDouble> &values)
+{
+    if (!m_lineChart.AddData(label, values))
+    {
+        return false;
+    }
+    Refresh();
+    return true;
+}
+
+wxLineChartCtrl::IngestionQueue::ptr wxLineChartCtrl::CreateIngestionQueue(size_t index,
+                                                                          size_t capacity)
+{
+    if (index >= m_lineChart.GetDatasetCount())
+    {
+        return IngestionQueue::ptr();
+    }
+
+    m_ingestionQueues.resize(m_lineChart.GetDatasetCount());
+    m_ingestionQueues[index].reset(new IngestionQueue(capacity));
+    StartIngestion();
+    return m_ingestionQueues[index];
+}
+
+void wxLineChartCtrl::SetIngestionLabelGenerator(const LabelGenerator &generator)
+{
+    m_lineChart.SetLabelGenerator(generator);
+}
+
+bool wxLineChartCtrl::DrainIngestionQueues()
+{
+    // Each label applies to a value of every dataset so only
+    // the values that are available in all the queues are added
+    size_t count = 0;
+    for (size_t i = 0; i < m_ingestionQueues.size(); ++i)
+    {
+        if (!m_ingestionQueues[i])
+        {
+            return false;
+        }
+        size_t size = m_ingestionQueues[i]->GetSize();
+        if ((i == 0) || (size < count))
+        {
+            count = size;
+        }
+    }
+    if (count == 0)
+    {
+        return false;
+    }
+
+    m_ingestionBuffers.resize(m_ingestionQueues.size());
+    for (size_t i = 0; i < m_ingestionQueues.size(); ++i)
+    {
+        m_ingestionBuffers[i].clear();
+        m_ingestionQueues[i]->Pop(m_ingestionBuffers[i], count);
+    }
+
+    // The labels are only created for the tick
+    // marks that are labelled
+    m_lineChart.AddData(m_ingestionBuffers);
+    m_lineChart.GetInstrumentation().AddPoints(wxCHARTSTAGE_INGEST,
+        count * m_ingestionBuffers.size(), count * m_ingestionBuffers.size());
+    Refresh();
+    return true;
+}
+
 void wxLineChartCtrl::CreateContextMenu()
 {
     m_contextMenu.Append(wxID_SAVEAS, wxString("Save as"));
@@ -24,7 +24,8 @@
 
 wxLineChartOptions::wxLineChartOptions()
     : m_dotRadius(4), m_dotStrokeWidth(1),
-    m_lineWidth(2), m_hitDetectionRange(24)
+    m_lineWidth(2), m_hitDetectionRange(24),
+    m_decimationMode(wxCHARTDECIMATION_MINMAX), m_maxCount(0)
 {
 }
 
@@ -57,3 +58,23 @@ wxDouble wxLineChartOptions::GetHitDetectionRange() const
 {
     return m_hitDetectionRange;
 }
+
+wxChartDecimationMode wxLineChartOptions::GetDecimationMode() const
+{
+    return m_decimationMode;
+}
+
+void wxLineChartOptions::SetDecimationMode(wxChartDecimationMode mode)
+{
+    m_decimationMode = mode;
+}
+
+size_t wxLineChartOptions::GetMaxCount() const
+{
+    return m_maxCount;
+}
+
+void wxLineChartOptions::SetMaxCount(size_t maxCount)
+{
+    m_maxCount = maxCount;
+}
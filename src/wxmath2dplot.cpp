@@ -32,9 +32,11 @@
 */
 
 #include "wxmath2dplot.h"
-#include <wx/dcmemory.h>
+#include "wxchartdecimation.h"
+#include "wxchartnumericalaxis.h"
 #include <sstream>
-#include <limits>
+#include <algorithm>
+#include <cmath>
 
 wxMath2DPlotDataset::wxMath2DPlotDataset(
     const wxColor &lineColor,
@@ -46,7 +48,8 @@ wxMath2DPlotDataset::wxMath2DPlotDataset(
     const bool &showLine)
     : m_showDots(showDots), m_dotColor(dotColor),
       m_dotStrokeColor(dotStrokeColor), m_showLine(showLine),
-      m_lineColor(lineColor),m_data(data),m_type(chartType)
+      m_lineColor(lineColor),m_data(data),m_type(chartType),
+      m_maxCount(0), m_maxXSpan(0), m_useMinMaxPyramid(false)
 {
 }
 
@@ -85,6 +88,46 @@ const wxVector<wxPoint2DDouble>& wxMath2DPlotDataset::GetData() const
     return m_data;
 }
 
+const wxMath2DPlotDataset::TooltipFormatter& wxMath2DPlotDataset::GetTooltipFormatter() const
+{
+    return m_tooltipFormatter;
+}
+
+void wxMath2DPlotDataset::SetTooltipFormatter(const TooltipFormatter &formatter)
+{
+    m_tooltipFormatter = formatter;
+}
+
+size_t wxMath2DPlotDataset::GetMaxCount() const
+{
+    return m_maxCount;
+}
+
+void wxMath2DPlotDataset::SetMaxCount(size_t maxCount)
+{
+    m_maxCount = maxCount;
+}
+
+wxDouble wxMath2DPlotDataset::GetMaxXSpan() const
+{
+    return m_maxXSpan;
+}
+
+void wxMath2DPlotDataset::SetMaxXSpan(wxDouble maxXSpan)
+{
+    m_maxXSpan = maxXSpan;
+}
+
+bool wxMath2DPlotDataset::UsesMinMaxPyramid() const
+{
+    return m_useMinMaxPyramid;
+}
+
+void wxMath2DPlotDataset::SetUseMinMaxPyramid(bool use)
+{
+    m_useMinMaxPyramid = use;
+}
+
 wxMath2DPlotData::wxMath2DPlotData()
 {
 }
@@ -139,11 +182,14 @@ wxPoint2DDouble wxMath2DPlot::Point::GetValue() const
 wxMath2DPlot::Dataset::Dataset(bool showDots,
                                bool showLine,
                                const wxColor &lineColor,
+                               const wxColor &dotColor,
                                const wxColor &dotStrokeColor,
-                               const wxChartType &chartType)
+                               const wxChartType &chartType,
+                               const wxMath2DPlotDataset::TooltipFormatter &tooltipFormatter)
     : m_showDots(showDots), m_showLine(showLine),
-      m_lineColor(lineColor), m_dotStrokeColor(dotStrokeColor),
-      m_dotColor(lineColor), m_type(chartType)
+      m_lineColor(lineColor), m_dotColor(dotColor),
+      m_dotStrokeColor(dotStrokeColor), m_type(chartType),
+      m_tooltipFormatter(tooltipFormatter)
 {
 }
 
@@ -182,14 +228,39 @@ void wxMath2DPlot::Dataset::SetType(const wxChartType &chartType)
     m_type = chartType;
 }
 
-const wxVector<wxMath2DPlot::Point::ptr>& wxMath2DPlot::Dataset::GetPoints() const
+const wxMath2DPlotDataset::TooltipFormatter& wxMath2DPlot::Dataset::GetTooltipFormatter() const
+{
+    return m_tooltipFormatter;
+}
+
+const wxChartPointSeries& wxMath2DPlot::Dataset::GetPoints() const
+{
+    return m_points;
+}
+
+wxChartPointSeries& wxMath2DPlot::Dataset::GetPoints()
 {
     return m_points;
 }
 
-void wxMath2DPlot::Dataset::AppendPoint(Point::ptr point)
+const wxVector<size_t>& wxMath2DPlot::Dataset::GetLineIndices() const
+{
+    return m_lineIndices;
+}
+
+wxVector<size_t>& wxMath2DPlot::Dataset::GetLineIndices()
+{
+    return m_lineIndices;
+}
+
+const wxChartSharedPoints& wxMath2DPlot::Dataset::GetSharedValues() const
+{
+    return m_sharedValues;
+}
+
+wxChartSharedPoints& wxMath2DPlot::Dataset::GetSharedValues()
 {
-    m_points.push_back(point);
+    return m_sharedValues;
 }
 
 wxMath2DPlot::wxMath2DPlot(const wxMath2DPlotData &data,
@@ -197,11 +268,9 @@ wxMath2DPlot::wxMath2DPlot(const wxMath2DPlotData &data,
     : m_grid(
           wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
           size,
-          GetMinXValue(data.GetDatasets(),m_options.GetAxisFuncX()),
-          GetMaxXValue(data.GetDatasets(),m_options.GetAxisFuncX()),
-          GetMinYValue(data.GetDatasets(),m_options.GetAxisFuncY()),
-          GetMaxYValue(data.GetDatasets(),m_options.GetAxisFuncY()),
-          m_options.GetGridOptions())
+          0, 0, 0, 0,
+          m_options.GetGridOptions()),
+      m_preparedGeneration(0)
 {
     Initialize(data);
 }
@@ -213,11 +282,9 @@ wxMath2DPlot::wxMath2DPlot(const wxMath2DPlotData &data,
       m_grid(
           wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
           size,
-          GetMinXValue(data.GetDatasets(),m_options.GetAxisFuncX()),
-          GetMaxXValue(data.GetDatasets(),m_options.GetAxisFuncX()),
-          GetMinYValue(data.GetDatasets(),m_options.GetAxisFuncY()),
-          GetMaxYValue(data.GetDatasets(),m_options.GetAxisFuncY()),
-          m_options.GetGridOptions())
+          0, 0, 0, 0,
+          m_options.GetGridOptions()),
+      m_preparedGeneration(0)
 {
     Initialize(data);
 }
@@ -245,7 +312,14 @@ const wxMath2DPlotOptions& wxMath2DPlot::GetChartOptions() const
 void wxMath2DPlot::SetChartOptions(const wxMath2DPlotOptions& opt)
 {
     m_options = opt;
-    Update();
+
+    // The axis functions may have changed
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        m_datasets[i]->GetPoints().SetExtentsTransforms(m_options.GetAxisFuncX(),
+            m_options.GetAxisFuncY());
+    }
+    Update(true);
 }
 
 bool wxMath2DPlot::SetChartType(std::size_t index,const wxChartType &type)
@@ -257,20 +331,48 @@ bool wxMath2DPlot::SetChartType(std::size_t index,const wxChartType &type)
     return true;
 }
 
-void wxMath2DPlot::Save(const wxString &filename,
-                        const wxBitmapType &type,
-                        const wxSize &size)
+bool wxMath2DPlot::UsesBackgroundPreparation() const
+{
+    return (m_worker.get() != 0);
+}
+
+void wxMath2DPlot::SetBackgroundPreparation(bool enable,
+                                            const wxChartPreparationWorker::Callback &callback)
 {
-    wxBitmap bmp(size.GetWidth(), size.GetHeight());
-    wxMemoryDC mdc(bmp);
-    mdc.Clear();
-    wxGraphicsContext* gc = wxGraphicsContext::Create(mdc);
-    if (gc)
+    if (enable)
     {
-        DoDraw(*gc, true);
-        bmp.SaveFile(filename, type);
-        delete gc;
+        if (!m_worker)
+        {
+            m_worker.reset(new wxChartPreparationWorker());
+
+            // The values are copied once here, after that the
+            // copies are updated along with the datasets
+            for (size_t i = 0; i < m_datasets.size(); ++i)
+            {
+                const wxChartPointSeries& points = m_datasets[i]->GetPoints();
+                wxVector<wxPoint2DDouble> values;
+                values.reserve(points.GetCount());
+                for (size_t j = 0; j < points.GetCount(); ++j)
+                {
+                    values.push_back(points.GetValue(j));
+                }
+                m_datasets[i]->GetSharedValues().Clear();
+                m_datasets[i]->GetSharedValues().Append(values);
+            }
+        }
+        m_worker->SetCallback(callback);
+    }
+    else
+    {
+        // This waits for the running job to complete
+        m_worker.reset();
+        for (size_t i = 0; i < m_datasets.size(); ++i)
+        {
+            m_datasets[i]->GetSharedValues().Clear();
+        }
     }
+    DeactivateElements();
+    InvalidateFit();
 }
 
 bool wxMath2DPlot::Scale(int coeff)
@@ -288,29 +390,15 @@ bool wxMath2DPlot::UpdateData(std::size_t index,const wxVector<wxPoint2DDouble>
     if(index >= m_datasets.size())
         return false;
 
-    auto transformX = m_options.GetAxisFuncX();
-    auto transformY = m_options.GetAxisFuncY();
-    Dataset::ptr newDataset(new Dataset(m_datasets[index]->ShowDots(),
-        m_datasets[index]->ShowLine(),m_datasets[index]->GetLineColor(),
-        m_datasets[index]->GetDotStrokeColor(),m_datasets[index]->GetType()));
-
-    for (size_t j = 0; j < points.size(); ++j)
-        {
-        std::stringstream tooltip;
-        tooltip << "(" << transformX(points[j].m_x) << "," << transformY(points[j].m_y) << ")";
-        wxChartTooltipProvider::ptr tooltipProvider(
-            new wxChartTooltipProviderStatic("", tooltip.str(), m_datasets[index]->GetLineColor())
-            );
-
-        Point::ptr point(
-            new Point(points[j], tooltipProvider, 20 + j * 10, 0,
-            m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
-            m_datasets[index]->GetDotStrokeColor(), m_datasets[index]->GetDotColor(),
-            m_options.GetHitDetectionRange()));
-
-        newDataset->AppendPoint(point);
-        }
-    m_datasets[index] = newDataset;
+    Dataset& dataset = *m_datasets[index];
+    dataset.GetPoints().Clear();
+    size_t removed = dataset.GetPoints().Append(points);
+    if (m_worker)
+    {
+        dataset.GetSharedValues().Clear();
+        dataset.GetSharedValues().Append(points);
+        dataset.GetSharedValues().RemoveFirst(removed);
+    }
     Update();
     return true;
 }
@@ -320,61 +408,45 @@ bool wxMath2DPlot::AddData(std::size_t index,const wxVector<wxPoint2DDouble> &po
     if(index >= m_datasets.size())
         return false;
 
-    auto transformX = m_options.GetAxisFuncX();
-    auto transformY = m_options.GetAxisFuncY();
-    auto shift = m_datasets[index]->GetPoints().size();
-
-    for (size_t j = 0; j < points.size(); ++j)
-        {
-        std::stringstream tooltip;
-        tooltip << "(" << transformX(points[j].m_x) << "," << transformY(points[j].m_y) << ")";
-        wxChartTooltipProvider::ptr tooltipProvider(
-            new wxChartTooltipProviderStatic("", tooltip.str(), m_datasets[index]->GetLineColor())
-            );
-
-        Point::ptr point(
-            new Point(points[j], tooltipProvider, 20 + (shift+j)* 10, 0,
-            m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
-            m_datasets[index]->GetDotStrokeColor(), m_datasets[index]->GetDotColor(),
-            m_options.GetHitDetectionRange()));
-
-        m_datasets[index]->AppendPoint(point);
-        }
+    // The series updates its extents as points are
+    // appended and discarded
+    size_t removed = m_datasets[index]->GetPoints().Append(points);
+    if (m_worker)
+    {
+        m_datasets[index]->GetSharedValues().Append(points);
+        m_datasets[index]->GetSharedValues().RemoveFirst(removed);
+    }
     Update();
     return true;
 }
 
 void wxMath2DPlot::AddDataset(const wxMath2DPlotDataset::ptr &newset,bool is_new)
 {
-    auto transformX = m_options.GetAxisFuncX();
-    auto transformY = m_options.GetAxisFuncY();
-
     Dataset::ptr newDataset(new Dataset(newset->ShowDots(),newset->ShowLine(),
-        newset->GetLineColor(),newset->GetDotStrokeColor(),newset->GetType()));
-
-    const wxVector<wxPoint2DDouble>& datasetData = newset->GetData();
-    for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-        std::stringstream tooltip;
-        tooltip << "(" << transformX(datasetData[j].m_x) << "," << transformY(datasetData[j].m_y) << ")";
-        wxChartTooltipProvider::ptr tooltipProvider(
-            new wxChartTooltipProviderStatic("", tooltip.str(), newset->GetLineColor())
-            );
-
-        Point::ptr point(
-            new Point(datasetData[j], tooltipProvider, 20 + j * 10, 0,
-            m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
-            newset->GetDotStrokeColor(), newset->GetDotColor(),
-            m_options.GetHitDetectionRange()));
-
-        newDataset->AppendPoint(point);
-        }
+        newset->GetLineColor(),newset->GetDotColor(),newset->GetDotStrokeColor(),
+        newset->GetType(),newset->GetTooltipFormatter()));
+    newDataset->GetPoints().SetMaxCount(newset->GetMaxCount());
+    newDataset->GetPoints().SetMaxXSpan(newset->GetMaxXSpan());
+    newDataset->GetPoints().SetUseMinMaxPyramid(newset->UsesMinMaxPyramid());
+    newDataset->GetPoints().SetExtentsTransforms(m_options.GetAxisFuncX(),
+        m_options.GetAxisFuncY());
+    size_t removed = newDataset->GetPoints().Append(newset->GetData());
+    if (m_worker)
+    {
+        newDataset->GetSharedValues().Append(newset->GetData());
+        newDataset->GetSharedValues().RemoveFirst(removed);
+    }
     m_datasets.push_back(newDataset);
 
     if(is_new)
         Update();
 }
 
+std::size_t wxMath2DPlot::GetDatasetCount() const
+{
+    return m_datasets.size();
+}
+
 bool wxMath2DPlot::RemoveDataset(std::size_t index)
 {
     if(index >= m_datasets.size())
@@ -384,249 +456,471 @@ bool wxMath2DPlot::RemoveDataset(std::size_t index)
     return true;
 }
 
-void wxMath2DPlot::Update()
+void wxMath2DPlot::Update(bool forceAxesUpdate)
 {
-    wxDouble minX = std::numeric_limits<wxDouble>::max();
-    wxDouble maxX = std::numeric_limits<wxDouble>::min();
-    wxDouble minY = minX;
-    wxDouble maxY = maxX;
-    auto transformX = m_options.GetAxisFuncX();
-    auto transformY = m_options.GetAxisFuncY();
+    wxDouble minX = 0;
+    wxDouble maxX = 0;
+    wxDouble minY = 0;
+    wxDouble maxY = 0;
+    if (!GetExtents(minX, maxX, minY, maxY))
+    {
+        minX = maxX = m_options.GetAxisFuncX()(0);
+        minY = maxY = m_options.GetAxisFuncY()(0);
+    }
+
+    // Rebuilding the axes resets the zoom and requires
+    // the grid to be fitted again so only do it if the
+    // limits actually changed
+    if (forceAxesUpdate || (minX != m_axisMinX) || (maxX != m_axisMaxX))
+    {
+        m_grid.UpdateAxisLimit("x",minX,maxX);
+        m_axisMinX = minX;
+        m_axisMaxX = maxX;
+    }
+    if (forceAxesUpdate || (minY != m_axisMinY) || (maxY != m_axisMaxY))
+    {
+        m_grid.UpdateAxisLimit("y",minY,maxY);
+        m_axisMinY = minY;
+        m_axisMaxY = maxY;
+    }
+
+    // The indices of the snapshot and of the active points
+    // may no longer match the datasets, the hit test ignores
+    // the snapshot until the next one is prepared
+    m_preparedGeneration = 0;
+    m_activePoints.Invalidate();
+    InvalidateFit();
+}
+
+bool wxMath2DPlot::GetExtents(wxDouble &minX,
+                              wxDouble &maxX,
+                              wxDouble &minY,
+                              wxDouble &maxY) const
+{
+    bool foundValue = false;
     for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        wxDouble datasetMinX = 0;
+        wxDouble datasetMaxX = 0;
+        wxDouble datasetMinY = 0;
+        wxDouble datasetMaxY = 0;
+        if (!m_datasets[i]->GetPoints().GetExtents(datasetMinX, datasetMaxX,
+            datasetMinY, datasetMaxY))
         {
-        for (const auto &el : m_datasets[i]->GetPoints())
-            {
-            auto value = el->GetValue();
-            auto tX = transformX(value.m_x);
-            auto tY = transformY(value.m_y);
-            if (maxX < tX)
-                maxX = tX;
-            if (minX > tX)
-                minX = tX;
-            if (maxY < tY)
-                maxY = tY;
-            if (minY > tY)
-                minY = tY;
-            }
+            continue;
+        }
+        if (!foundValue)
+        {
+            minX = datasetMinX;
+            maxX = datasetMaxX;
+            minY = datasetMinY;
+            maxY = datasetMaxY;
+            foundValue = true;
+        }
+        else
+        {
+            minX = std::min(minX, datasetMinX);
+            maxX = std::max(maxX, datasetMaxX);
+            minY = std::min(minY, datasetMinY);
+            maxY = std::max(maxY, datasetMaxY);
         }
-    if (maxX == std::numeric_limits<wxDouble>::min())
-            maxX = transformX(0);
-    if (minX == std::numeric_limits<wxDouble>::max())
-            minX = transformX(0);
-    if (maxY == std::numeric_limits<wxDouble>::min())
-            maxY = transformY(0);
-    if (minY == std::numeric_limits<wxDouble>::max())
-            minY = transformY(0);
-    m_grid.UpdateAxisLimit("x",minX,maxX);
-    m_grid.UpdateAxisLimit("y",minY,maxY);
+    }
+    return foundValue;
 }
 
 void wxMath2DPlot::Initialize(const wxMath2DPlotData &data)
 {
     for (const auto &el : data.GetDatasets())
         AddDataset(el,false);
+
+    // The grid is created with empty limits, the real
+    // ones come from the extents computed while adding the
+    // datasets so the data is only scanned once
+    Update(true);
 }
 
-wxDouble wxMath2DPlot::GetMinXValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets,const AxisFunc &F)
+void wxMath2DPlot::DoSetSize(const wxSize &size)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
-    for (size_t i = 0; i < datasets.size(); ++i)
+    wxSize newSize(
+        size.GetWidth() - m_options.GetPadding().GetTotalHorizontalPadding(),
+        size.GetHeight() - m_options.GetPadding().GetTotalVerticalPadding()
+    );
+    m_grid.Resize(newSize);
+}
+
+void wxMath2DPlot::DoFit()
+{
+    if (m_worker)
+    {
+        SubmitPreparation();
+    }
+    else
+    {
+        UpdatePositions();
+    }
+}
+
+void wxMath2DPlot::UpdatePositions()
+{
+    auto transformX = m_options.GetAxisFuncX();
+    auto transformY = m_options.GetAxisFuncY();
+    for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
+        wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        if (points.UsesMinMaxPyramid())
         {
-            if (!foundValue)
-            {
-                result = F(values[j].m_x);
-                foundValue = true;
-            }
-            else if (result > F(values[j].m_x))
-            {
-                result = F(values[j].m_x);
-            }
+            UpdateLinePositions(*m_datasets[i]);
+            continue;
         }
+        for (size_t j = 0; j < points.GetCount(); ++j)
+        {
+            points.SetPosition(j, m_grid.GetMapping().GetWindowPosition(
+                transformX(points.GetX(j)), transformY(points.GetY(j))));
+        }
+        points.BuildIndex();
     }
-
-    return result;
 }
 
-wxDouble wxMath2DPlot::GetMaxXValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets,const AxisFunc &F)
+void wxMath2DPlot::UpdateLinePositions(Dataset &dataset)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
+    auto transformX = m_options.GetAxisFuncX();
+    auto transformY = m_options.GetAxisFuncY();
+    wxChartPointSeries& points = dataset.GetPoints();
+    wxVector<size_t>& indices = dataset.GetLineIndices();
+    indices.clear();
+
+    const wxChartNumericalAxis& xAxis = static_cast<const wxChartNumericalAxis&>(m_grid.GetMapping().GetXAxis());
+    wxDouble minX = xAxis.GetMinValue();
+    wxDouble maxX = xAxis.GetMaxValue();
+    wxPoint2DDouble axisStart = xAxis.GetPosition(0);
+    wxPoint2DDouble axisEnd = xAxis.GetPosition(1);
+    wxDouble axisLength = std::max(std::abs(axisEnd.m_x - axisStart.m_x), std::abs(axisEnd.m_y - axisStart.m_y));
+    size_t columns = static_cast<size_t>(std::max(axisLength, 1.0));
+
+    // The points on either side of the visible range are
+    // kept so that the line extends to the edges of the grid
+    size_t first = points.FindFirstX(minX, transformX);
+    size_t last = std::min(points.FindFirstX(maxX, transformX) + 1, points.GetCount());
+    if (first > 0)
+    {
+        --first;
+    }
 
-    for (size_t i = 0; i < datasets.size(); ++i)
+    if (last <= (first + (4 * columns)))
     {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
+        for (size_t j = first; j < last; ++j)
         {
-            if (!foundValue)
-            {
-                result = F(values[j].m_x);
-                foundValue = true;
-            }
-            else if (result < F(values[j].m_x))
-            {
-                result = F(values[j].m_x);
-            }
+            indices.push_back(j);
         }
     }
+    else
+    {
+        // Only the first, minimum, maximum and last points of
+        // each pixel column are positioned and drawn
+        wxVector<size_t> boundaries;
+        boundaries.reserve(columns + 1);
+        boundaries.push_back(first);
+        for (size_t c = 1; c < columns; ++c)
+        {
+            size_t boundary = points.FindFirstX(minX + ((maxX - minX) * c) / columns, transformX);
+            boundaries.push_back(std::min(std::max(boundary, boundaries.back()), last));
+        }
+        boundaries.push_back(last);
+        points.Decimate(boundaries, indices);
+    }
 
-    return result;
+    for (size_t j = 0; j < indices.size(); ++j)
+    {
+        points.SetPosition(indices[j], m_grid.GetMapping().GetWindowPosition(
+            transformX(points.GetX(indices[j])), transformY(points.GetY(indices[j]))));
+    }
 }
 
-wxDouble wxMath2DPlot::GetMinYValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets,const AxisFunc &F)
-{
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
+void wxMath2DPlot::SubmitPreparation()
+{
+    // The job can't access the chart since the GUI thread
+    // keeps modifying it so it gets the shared copies of the
+    // values, which are never modified, and a copy of the grid
+    // mapping, which is linear between the limits of the axes
+    const wxChartNumericalAxis& xAxis = static_cast<const wxChartNumericalAxis&>(m_grid.GetMapping().GetXAxis());
+    const wxChartNumericalAxis& yAxis = static_cast<const wxChartNumericalAxis&>(m_grid.GetMapping().GetYAxis());
+    wxDouble minX = xAxis.GetMinValue();
+    wxDouble maxX = xAxis.GetMaxValue();
+    wxDouble rangeX = maxX - minX;
+    wxDouble minY = yAxis.GetMinValue();
+    wxDouble rangeY = yAxis.GetMaxValue() - minY;
+    wxPoint2DDouble origin = m_grid.GetMapping().GetWindowPosition(minX, minY);
+    wxPoint2DDouble endX = m_grid.GetMapping().GetWindowPosition(minX + rangeX, minY);
+    wxPoint2DDouble endY = m_grid.GetMapping().GetWindowPosition(minX, minY + rangeY);
+    wxPoint2DDouble stepX((endX.m_x - origin.m_x) / rangeX, (endX.m_y - origin.m_y) / rangeX);
+    wxPoint2DDouble stepY((endY.m_x - origin.m_x) / rangeY, (endY.m_y - origin.m_y) / rangeY);
+
+    // As in UpdateLinePositions() only the visible part of the
+    // datasets that maintain a pyramid is prepared since their
+    // values are sorted by X value
+    struct Input
+    {
+        wxChartSharedPoints values;
+        bool sorted;
+    };
+    wxVector<Input> inputs;
+    inputs.reserve(m_datasets.size());
+    for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
+        Input input = { m_datasets[i]->GetSharedValues(), m_datasets[i]->GetPoints().UsesMinMaxPyramid() };
+        inputs.push_back(input);
+    }
+
+    AxisFunc transformX = m_options.GetAxisFuncX();
+    AxisFunc transformY = m_options.GetAxisFuncY();
+    wxChartDecimationMode decimationMode = m_options.GetDecimationMode();
+    m_preparedGeneration = m_worker->Submit(
+        [inputs, transformX, transformY, decimationMode, minX, maxX, minY, origin, stepX, stepY]
+        (wxChartRenderSnapshot &snapshot, const std::atomic<bool> &cancelled)
         {
-            if (!foundValue)
-            {
-                result = F(values[j].m_y);
-                foundValue = true;
-            }
-            else if (result > F(values[j].m_y))
+            wxVector<wxPoint2DDouble> positions;
+            wxVector<size_t> selected;
+            for (size_t i = 0; (i < inputs.size()) && !cancelled; ++i)
             {
-                result = F(values[j].m_y);
-            }
-        }
-    }
+                const wxChartSharedPoints& datasetValues = inputs[i].values;
+                size_t first = 0;
+                size_t last = datasetValues.GetCount();
+                if (inputs[i].sorted && (last > 0))
+                {
+                    // The points on either side of the visible range
+                    // are kept so that the line extends to the edges
+                    first = datasetValues.FindFirstX(minX, transformX);
+                    last = std::min(datasetValues.FindFirstX(maxX, transformX) + 1, last);
+                    if (first > 0)
+                    {
+                        --first;
+                    }
+                }
+
+                positions.clear();
+                positions.reserve(last - first);
+                for (size_t j = first; j < last; ++j)
+                {
+                    const wxPoint2DDouble& value = datasetValues.GetValue(j);
+                    wxDouble x = transformX(value.m_x) - minX;
+                    wxDouble y = transformY(value.m_y) - minY;
+                    positions.push_back(wxPoint2DDouble(
+                        origin.m_x + (x * stepX.m_x) + (y * stepY.m_x),
+                        origin.m_y + (x * stepX.m_y) + (y * stepY.m_y)));
+                }
 
-    return result;
+                // Only the markers that UpdateLinePositions() would
+                // position are kept, the others would be drawn on
+                // top of them
+                wxChartRenderSnapshot::Series& series = snapshot.AddSeries();
+                SelectMarkers(positions, selected);
+                wxVector<wxPoint2DDouble>& markers = series.GetMarkers();
+                wxVector<size_t>& indices = series.GetMarkerIndices();
+                wxVector<wxPoint2DDouble>& markerValues = series.GetMarkerValues();
+                markers.reserve(selected.size());
+                indices.reserve(selected.size());
+                markerValues.reserve(selected.size());
+                for (size_t j = 0; j < selected.size(); ++j)
+                {
+                    markers.push_back(positions[selected[j]]);
+                    indices.push_back(first + selected[j]);
+                    markerValues.push_back(datasetValues.GetValue(first + selected[j]));
+                }
+                if (positions.size() > 0)
+                {
+                    wxChartDecimation::Decimate(decimationMode, positions, series.GetLine());
+                }
+                series.BuildIndex();
+            }
+        });
 }
 
-wxDouble wxMath2DPlot::GetMaxYValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets,const AxisFunc &F)
+void wxMath2DPlot::SelectMarkers(const wxVector<wxPoint2DDouble> &positions,
+                                 wxVector<size_t> &selected)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
+    selected.clear();
+    size_t start = 0;
+    while (start < positions.size())
     {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
+        // A run is a sequence of consecutive points in
+        // the same pixel column
+        wxDouble column = std::floor(positions[start].m_x);
+        size_t minIndex = start;
+        size_t maxIndex = start;
+        size_t end = start + 1;
+        while ((end < positions.size()) && (std::floor(positions[end].m_x) == column))
         {
-            if (!foundValue)
+            if (positions[end].m_y < positions[minIndex].m_y)
             {
-                result = F(values[j].m_y);
-                foundValue = true;
+                minIndex = end;
             }
-            else if (result < F(values[j].m_y))
+            if (positions[end].m_y > positions[maxIndex].m_y)
             {
-                result = F(values[j].m_y);
+                maxIndex = end;
             }
+            ++end;
         }
-    }
 
-    return result;
+        size_t run[4] = { start, std::min(minIndex, maxIndex),
+            std::max(minIndex, maxIndex), end - 1 };
+        for (size_t k = 0; k < 4; ++k)
+        {
+            if (selected.empty() || (selected.back() != run[k]))
+            {
+                selected.push_back(run[k]);
+            }
+        }
+        start = end;
+    }
 }
 
-void wxMath2DPlot::DoSetSize(const wxSize &size)
+wxMath2DPlot::Point::ptr wxMath2DPlot::CreatePoint(const Dataset &dataset,
+                                                   const wxPoint2DDouble &value,
+                                                   const wxPoint2DDouble &position) const
 {
-    wxSize newSize(
-        size.GetWidth() - m_options.GetPadding().GetTotalHorizontalPadding(),
-        size.GetHeight() - m_options.GetPadding().GetTotalVerticalPadding()
-    );
-    m_grid.Resize(newSize);
+    wxDouble x = m_options.GetAxisFuncX()(value.m_x);
+    wxDouble y = m_options.GetAxisFuncY()(value.m_y);
+    wxMath2DPlotDataset::TooltipFormatter formatter = dataset.GetTooltipFormatter();
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderLazy(
+            wxChartTooltipProviderLazy::Generator(),
+            [formatter, x, y]() -> wxString
+            {
+                if (formatter)
+                {
+                    return formatter(x, y);
+                }
+                std::stringstream tooltip;
+                tooltip << "(" << x << "," << y << ")";
+                return tooltip.str();
+            },
+            dataset.GetLineColor())
+        );
+
+    return Point::ptr(new Point(value, tooltipProvider, position.m_x, position.m_y,
+        m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
+        dataset.GetDotStrokeColor(), dataset.GetDotColor(),
+        m_options.GetHitDetectionRange()));
 }
 
-void wxMath2DPlot::DoFit()
+void wxMath2DPlot::DoDraw(wxGraphicsContext &gc,
+                          bool suppressTooltips)
 {
+    // The chart is only redrawn when the data or the layout
+    // changed, in which case the active points are stale
+    m_activePoints.Invalidate();
 
-    auto transformX = m_options.GetAxisFuncX();
-    auto transformY = m_options.GetAxisFuncY();
-    for (size_t i = 0; i < m_datasets.size(); ++i)
+    // The points only need to be positioned again if the
+    // data or the grid mapping changed
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        wxChartInstrumentation::Scope scope(GetInstrumentation(), wxCHARTSTAGE_GRID);
+        if (m_grid.Fit(gc))
         {
-            const Point::ptr& point = points[j];
-            point->SetPosition(m_grid.GetMapping().GetWindowPosition(
-                transformX(point->GetValue().m_x), transformY(point->GetValue().m_y)));
+            InvalidateFit();
         }
+        m_grid.Draw(gc);
     }
-}
-
-void wxMath2DPlot::DoDraw(wxGraphicsContext &gc,
-                          bool suppressTooltips)
-{
-    m_grid.Fit(gc);
-    m_grid.Draw(gc);
     Fit();
 
-    auto transformX = m_options.GetAxisFuncX();
-    auto transformY = m_options.GetAxisFuncY();
-
-    for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
+        wxChartInstrumentation::Scope datasetsScope(GetInstrumentation(), wxCHARTSTAGE_DATASETS);
 
-        wxGraphicsPath path = gc.CreatePath();
+        auto transformX = m_options.GetAxisFuncX();
+        auto transformY = m_options.GetAxisFuncY();
 
-        if (points.size() > 0)
+        // With a background thread the latest snapshot is drawn,
+        // until the first one is ready only the grid is drawn
+        wxChartRenderSnapshot::ptr snapshot;
+        if (m_worker)
         {
-            const Point::ptr& point = points[0];
-            auto value = point->GetValue();
+            snapshot = m_worker->GetSnapshot();
+        }
 
-            wxPoint2DDouble firstPosition = m_grid.GetMapping().GetWindowPosition(transformX(value.m_x),transformY(value.m_y));
-            path.MoveToPoint(firstPosition);
+        for (size_t i = 0; i < m_datasets.size(); ++i)
+        {
+            const wxChartPointSeries& points = m_datasets[i]->GetPoints();
+            const wxVector<wxPoint2DDouble>* positions = &points.GetPositions();
 
-            wxPoint2DDouble lastPosition;
-            for (size_t j = 1; j < points.size(); ++j)
+            wxVector<wxPoint2DDouble> decimatedLine;
+            const wxVector<wxPoint2DDouble>* line = &decimatedLine;
+            if (m_worker)
             {
-                const Point::ptr& point = points[j];
-                value = point->GetValue();
-                lastPosition =  m_grid.GetMapping().GetWindowPosition(transformX(value.m_x),transformY(value.m_y));
-
-                if(m_datasets[i]->GetType()==wxCHARTTYPE_STEPPED)
+                if (!snapshot || (i >= snapshot->GetSeriesCount()))
+                {
+                    continue;
+                }
+                const wxChartRenderSnapshot::Series& series = snapshot->GetSeries(i);
+                positions = &series.GetMarkers();
+                line = &series.GetLine();
+            }
+            else if (points.UsesMinMaxPyramid())
+            {
+                // With the pyramid the line was already decimated
+                // when the positions were updated
+                const wxVector<size_t>& indices = m_datasets[i]->GetLineIndices();
+                decimatedLine.reserve(indices.size());
+                for (size_t j = 0; j < indices.size(); ++j)
                 {
-                    wxDouble y = transformY(value.m_y);
-                    value = points[j-1]->GetValue();
-                    value = m_grid.GetMapping().GetWindowPosition(transformX(value.m_x),y);
-                    path.AddLineToPoint(value);
+                    decimatedLine.push_back(points.GetPosition(indices[j]));
                 }
+                positions = &decimatedLine;
+            }
+            else if (positions->size() > 0)
+            {
+                wxChartDecimation::Decimate(m_options.GetDecimationMode(), *positions, decimatedLine);
+            }
+
+            if (line->size() > 0)
+            {
+                wxGraphicsPath path = gc.CreatePath();
 
-                if(m_datasets[i]->GetType()==wxCHARTTYPE_STEM)
+                if (m_datasets[i]->GetType() == wxCHARTTYPE_STEM)
                 {
-                    value = points[j-1]->GetValue();
-                    value = m_grid.GetMapping().GetWindowPosition(transformX(value.m_x),transformY(0));
-                    path.AddLineToPoint(value);
-                    path.MoveToPoint(lastPosition);
-                    if(j+1==points.size())
+                    // The snapshot may have more points than the dataset
+                    wxDouble baseline = m_grid.GetMapping().GetWindowPosition(
+                        transformX((points.GetCount() > 0) ? points.GetX(0) : 0), transformY(0)).m_y;
+                    for (size_t j = 0; j < line->size(); ++j)
                     {
-                        value = points[j]->GetValue();
-                        value = m_grid.GetMapping().GetWindowPosition(transformX(value.m_x),transformY(0));
-                        path.AddLineToPoint(value);
+                        path.MoveToPoint((*line)[j]);
+                        path.AddLineToPoint((*line)[j].m_x, baseline);
                     }
                 }
                 else
                 {
-                    path.AddLineToPoint(lastPosition);
+                    path.MoveToPoint((*line)[0]);
+                    for (size_t j = 1; j < line->size(); ++j)
+                    {
+                        if (m_datasets[i]->GetType() == wxCHARTTYPE_STEPPED)
+                        {
+                            path.AddLineToPoint((*line)[j - 1].m_x, (*line)[j].m_y);
+                        }
+                        path.AddLineToPoint((*line)[j]);
+                    }
                 }
+
+                wxPen pen;
+                if (m_datasets[i]->ShowLine())
+                {
+                    pen = wxPen(m_datasets[i]->GetLineColor(), m_options.GetLineWidth());
+                }
+                else
+                {
+                    pen = wxPen(wxColor(255, 255, 255, 0), 0);
+                }
+                gc.SetPen(pen);
+                gc.StrokePath(path);
+                GetInstrumentation().AddPrimitives(wxCHARTSTAGE_DATASETS, 1);
             }
-            wxPen pen;
-            if (m_datasets[i]->ShowLine())
-            {
-                pen = wxPen(m_datasets[i]->GetLineColor(), m_options.GetLineWidth());
-            }
-            else
-            {
-                pen = wxPen(wxColor(255, 255, 255, 0), 0);
-            }
-            gc.SetPen(pen);
-            gc.StrokePath(path);
-        }
+            GetInstrumentation().AddPoints(wxCHARTSTAGE_DATASETS, points.GetCount(), line->size());
 
-        if (m_datasets[i]->ShowDots())
-        {
-            for (size_t j = 0; j < points.size(); ++j)
+            if (m_datasets[i]->ShowDots())
             {
-                points[j]->Draw(gc);
+                // All the points of the dataset are drawn as
+                // a single path
+                wxChartPoint::DrawAll(gc, *positions, m_options.GetDotRadius(),
+                    wxChartPointOptions(m_options.GetDotStrokeWidth(),
+                        m_datasets[i]->GetDotStrokeColor(), m_datasets[i]->GetDotColor()));
+                GetInstrumentation().AddPrimitives(wxCHARTSTAGE_DATASETS, positions->size());
             }
         }
     }
@@ -639,15 +933,81 @@ void wxMath2DPlot::DoDraw(wxGraphicsContext &gc,
 
 wxSharedPtr<wxVector<const wxChartElement*> > wxMath2DPlot::GetActiveElements(const wxPoint &point)
 {
+    m_activePoints.Begin();
     wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
+    wxDouble range = m_options.GetHitDetectionRange();
+    wxVector<size_t> candidates;
+    wxVector<wxPoint2DDouble> candidatePositions;
+    wxVector<wxPoint2DDouble> candidateValues;
+    wxVector<size_t> markers;
+
+    // The indices of a snapshot that was prepared for
+    // older data may no longer be valid
+    wxChartRenderSnapshot::ptr snapshot;
+    if (m_worker)
+    {
+        snapshot = m_worker->GetSnapshot();
+        if (snapshot && (snapshot->GetGeneration() != m_preparedGeneration))
+        {
+            snapshot.reset();
+        }
+    }
+
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        const wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        candidates.clear();
+        candidatePositions.clear();
+        candidateValues.clear();
+        if (m_worker)
+        {
+            if (!snapshot || (i >= snapshot->GetSeriesCount()))
+            {
+                continue;
+            }
+            const wxChartRenderSnapshot::Series& series = snapshot->GetSeries(i);
+            markers.clear();
+            series.FindInXRange(point.x - range, point.x + range, markers);
+            for (size_t j = 0; j < markers.size(); ++j)
+            {
+                candidates.push_back(series.GetMarkerIndices()[markers[j]]);
+                candidatePositions.push_back(series.GetMarkers()[markers[j]]);
+                candidateValues.push_back(series.GetMarkerValues()[markers[j]]);
+            }
+        }
+        else
+        {
+            if (points.UsesMinMaxPyramid())
+            {
+                // Only the points that are drawn have a position,
+                // they are sorted by X
+                points.FindInXRange(m_datasets[i]->GetLineIndices(),
+                    point.x - range, point.x + range, candidates);
+            }
+            else
+            {
+                points.FindInXRange(point.x - range, point.x + range, candidates);
+            }
+            for (size_t j = 0; j < candidates.size(); ++j)
+            {
+                candidatePositions.push_back(points.GetPosition(candidates[j]));
+                candidateValues.push_back(points.GetValue(candidates[j]));
+            }
+        }
+        for (size_t j = 0; j < candidates.size(); ++j)
         {
-            if (points[j]->HitTest(point,m_options.GetAxisFuncX()))
+            // The positions are already in window coordinates so
+            // the hit detection range is measured in pixels
+            wxDouble distance = (point.x - candidatePositions[j].m_x);
+            if (distance < 0)
+            {
+                distance = -distance;
+            }
+            if (distance < range)
             {
-                activeElements->push_back(points[j].get());
+                const Point::ptr &activePoint = m_activePoints.Add(i, candidates[j],
+                    [&]() { return CreatePoint(*m_datasets[i], candidateValues[j], candidatePositions[j]); });
+                activeElements->push_back(activePoint.get());
             }
         }
     }
@@ -61,6 +61,13 @@ wxMath2DPlotCtrl::wxMath2DPlotCtrl(wxWindow *parent,
     CreateContextMenu();
 }
 
+wxMath2DPlotCtrl::~wxMath2DPlotCtrl()
+{
+    // The worker must not post events to a
+    // control that is being destroyed
+    m_math2dPlot.SetBackgroundPreparation(false);
+}
+
 wxMath2DPlot& wxMath2DPlotCtrl::GetChart()
 {
     return m_math2dPlot;
@@ -121,15 +128,80 @@ bool wxMath2DPlotCtrl::RemoveDataset(std::size_t index)
 {
     if (!m_math2dPlot.RemoveDataset(index))
         return false;
+
+    // The datasets that follow the removed one move down
+    for (size_t i = m_ingestionQueues.size(); i > 0; --i)
+    {
+        std::size_t& queueIndex = m_ingestionQueues[i - 1].first;
+        if (queueIndex == index)
+        {
+            m_ingestionQueues.erase(m_ingestionQueues.begin() + (i - 1));
+        }
+        else if (queueIndex > index)
+        {
+            --queueIndex;
+        }
+    }
     Update();
     return true;
 }
 
+void wxMath2DPlotCtrl::SetBackgroundPreparation(bool enable)
+{
+    // The callback runs on the worker thread, CallAfter()
+    // can be used from any thread
+    m_math2dPlot.SetBackgroundPreparation(enable,
+        [this]() { CallAfter(&wxMath2DPlotCtrl::OnSnapshotReady); });
+    Refresh();
+}
+
+void wxMath2DPlotCtrl::OnSnapshotReady()
+{
+    Refresh();
+}
+
+wxMath2DPlotCtrl::IngestionQueue::ptr wxMath2DPlotCtrl::CreateIngestionQueue(std::size_t index,
+                                                                            std::size_t capacity)
+{
+    if (index >= m_math2dPlot.GetDatasetCount())
+    {
+        return IngestionQueue::ptr();
+    }
+
+    IngestionQueue::ptr queue(new IngestionQueue(capacity));
+    m_ingestionQueues.push_back(std::make_pair(index, queue));
+    StartIngestion();
+    return queue;
+}
+
+bool wxMath2DPlotCtrl::DrainIngestionQueues()
+{
+    // All the points that are waiting are added at once
+    // and the chart is only refreshed once
+    bool added = false;
+    for (size_t i = 0; i < m_ingestionQueues.size(); ++i)
+    {
+        m_ingestionBuffer.clear();
+        if (m_ingestionQueues[i].second->Pop(m_ingestionBuffer) > 0)
+        {
+            m_math2dPlot.AddData(m_ingestionQueues[i].first, m_ingestionBuffer);
+            m_math2dPlot.GetInstrumentation().AddPoints(wxCHARTSTAGE_INGEST,
+                m_ingestionBuffer.size(), m_ingestionBuffer.size());
+            added = true;
+        }
+    }
+    if (added)
+    {
+        Refresh();
+    }
+    return added;
+}
+
 void wxMath2DPlotCtrl::Update()
 {
-    auto parent = this->GetParent();
-    if(parent)
-        parent->Layout();
+    // Several updates in a row only lay out
+    // the parent and redraw the chart once
+    ScheduleRefresh(true);
 }
 
 void wxMath2DPlotCtrl::CreateContextMenu()
@@ -158,6 +230,7 @@ void wxMath2DPlotCtrl::CreateContextMenu()
         auto parent = this->GetParent();
         if(parent)
             parent->Layout();
+        Refresh();
     },wxID_DEFAULT);
     m_contextMenu.Bind(wxEVT_MENU,
                        [this](wxCommandEvent &)
@@ -168,6 +241,7 @@ void wxMath2DPlotCtrl::CreateContextMenu()
         auto parent = this->GetParent();
         if(parent)
             parent->Layout();
+        Refresh();
     },wxID_UP);
     m_contextMenu.Bind(wxEVT_MENU,
                        [this](wxCommandEvent &)
@@ -177,6 +251,7 @@ void wxMath2DPlotCtrl::CreateContextMenu()
         auto parent = this->GetParent();
         if(parent)
             parent->Layout();
+        Refresh();
     },wxID_DOWN);
 
     m_contextMenu.Bind(wxEVT_MENU,
@@ -248,6 +323,7 @@ void wxMath2DPlotCtrl::CreateContextMenu()
                     m_posX = evt.m_x;
                     m_posY = evt.m_y;
                     parent->Layout();
+                    Refresh();
                 }
             }
         }
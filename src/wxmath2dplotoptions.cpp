@@ -24,7 +24,8 @@
 
 wxMath2DPlotOptions::wxMath2DPlotOptions()
     : m_dotRadius(4), m_dotStrokeWidth(1),
-    m_lineWidth(2), m_hitDetectionRange(24)
+    m_lineWidth(2), m_hitDetectionRange(24),
+    m_decimationMode(wxCHARTDECIMATION_MINMAX)
 {
     auto temp = [](wxDouble x){return x;};
     m_axisFuncX = temp;
@@ -64,6 +65,16 @@ wxDouble wxMath2DPlotOptions::GetHitDetectionRange() const
     return m_hitDetectionRange;
 }
 
+wxChartDecimationMode wxMath2DPlotOptions::GetDecimationMode() const
+{
+    return m_decimationMode;
+}
+
+void wxMath2DPlotOptions::SetDecimationMode(wxChartDecimationMode mode)
+{
+    m_decimationMode = mode;
+}
+
 const AxisFunc& wxMath2DPlotOptions::GetAxisFuncX() const
 {
     return m_axisFuncX;
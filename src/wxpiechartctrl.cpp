@@ -57,7 +57,13 @@ void wxPieChartCtrl::OnUpdate(const std::map<wxString,
 	                          wxChartSliceData> &data)
 {
     m_pieChart.SetData(data);
-    auto parent = this->GetParent();
-    if(parent)
-        parent->Layout();
+    ScheduleRefresh(true);
+}
+
+void wxPieChartCtrl::OnDeltaUpdate(const std::map<wxString, wxChartSliceData> &data,
+                                   const wxPieChartDataDelta &delta)
+{
+    // Only the slices that changed are rebuilt
+    m_pieChart.UpdateData(data, delta);
+    ScheduleRefresh(true);
 }
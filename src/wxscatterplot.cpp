@@ -23,8 +23,13 @@
 /// @file
 
 #include "wxscatterplot.h"
+#include "wxchartutilities.h"
 #include <sstream>
 
+// The distance in pixels within which a point is considered
+// to be under the mouse
+static const wxDouble HitDetectionRange = 20;
+
 wxScatterPlotDataset::wxScatterPlotDataset(const wxColor& fillColor,
                                            const wxColor& strokeColor,
                                            wxVector<wxPoint2DDouble> &data)
@@ -66,7 +71,7 @@ wxScatterPlot::Point::Point(wxPoint2DDouble value,
                             wxDouble x,
                             wxDouble y,
                             const wxChartPointOptions &options)
-    : wxChartPoint(x, y, 5, 20, tooltipProvider, options), m_value(value)
+    : wxChartPoint(x, y, 5, HitDetectionRange, tooltipProvider, options), m_value(value)
 {
 }
 
@@ -82,27 +87,35 @@ wxPoint2DDouble wxScatterPlot::Point::GetValue() const
     return m_value;
 }
 
-wxScatterPlot::Dataset::Dataset()
+wxScatterPlot::Dataset::Dataset(const wxColor &fillColor,
+                                const wxColor &strokeColor)
+    : m_pointOptions(2, strokeColor, fillColor)
+{
+}
+
+const wxChartPointOptions& wxScatterPlot::Dataset::GetPointOptions() const
 {
+    return m_pointOptions;
 }
 
-const wxVector<wxScatterPlot::Point::ptr>& wxScatterPlot::Dataset::GetPoints() const
+const wxChartPointSeries& wxScatterPlot::Dataset::GetPoints() const
 {
     return m_points;
 }
 
-void wxScatterPlot::Dataset::AppendPoint(Point::ptr point)
+wxChartPointSeries& wxScatterPlot::Dataset::GetPoints()
 {
-    m_points.push_back(point);
+    return m_points;
 }
 
 wxScatterPlot::wxScatterPlot(const wxScatterPlotData &data,
                              const wxSize &size)
-    : m_grid(
+    : m_extents(GetExtents(data.GetDatasets())),
+    m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
-        GetMinXValue(data.GetDatasets()), GetMaxXValue(data.GetDatasets()),
-        GetMinYValue(data.GetDatasets()), GetMaxYValue(data.GetDatasets()),
+        m_extents.m_minX, m_extents.m_maxX,
+        m_extents.m_minY, m_extents.m_maxY,
         m_options.GetGridOptions()
         )
 {
@@ -113,11 +126,12 @@ wxScatterPlot::wxScatterPlot(const wxScatterPlotData &data,
                              const wxScatterPlotOptions &options, 
                              const wxSize &size)
     : m_options(options),
+    m_extents(GetExtents(data.GetDatasets())),
     m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
-        GetMinXValue(data.GetDatasets()), GetMaxXValue(data.GetDatasets()),
-        GetMinYValue(data.GetDatasets()), GetMaxYValue(data.GetDatasets()),
+        m_extents.m_minX, m_extents.m_maxX,
+        m_extents.m_minY, m_extents.m_maxY,
         m_options.GetGridOptions()
         )
 {
@@ -134,137 +148,56 @@ void wxScatterPlot::Initialize(const wxScatterPlotData &data)
     const wxVector<wxScatterPlotDataset::ptr>& datasets = data.GetDatasets();
     for (size_t i = 0; i < datasets.size(); ++i)
     {
-        Dataset::ptr newDataset(new Dataset());
-
-        const wxVector<wxPoint2DDouble>& datasetData = datasets[i]->GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << "(" << datasetData[j].m_x << "," << datasetData[j].m_y << ")";
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic("", tooltip.str(), datasets[i]->GetFillColor())
-                );
-
-            Point::ptr point(
-                new Point(datasetData[j], tooltipProvider, 20 + j * 10, 0,
-                    wxChartPointOptions(2, datasets[i]->GetStrokeColor(), datasets[i]->GetFillColor()))
-                );
-
-            newDataset->AppendPoint(point);
-        }
-
+        Dataset::ptr newDataset(new Dataset(datasets[i]->GetFillColor(),
+            datasets[i]->GetStrokeColor()));
+        newDataset->GetPoints().Append(datasets[i]->GetData());
         m_datasets.push_back(newDataset);
     }
 }
 
-bool wxScatterPlot::Scale(int coeff)
-{
-    return m_grid.Scale(coeff);
-}
-
-void wxScatterPlot::Shift(double dx,double dy)
-{
-    m_grid.Shift(dx,-dy);
-}
-
-wxDouble wxScatterPlot::GetMinXValue(const wxVector<wxScatterPlotDataset::ptr>& datasets)
+wxScatterPlot::Point::ptr wxScatterPlot::CreatePoint(const Dataset &dataset,
+                                                     size_t index) const
 {
-    wxDouble result = 0;
-    bool foundValue = false;
+    const wxChartPointSeries& points = dataset.GetPoints();
+    wxPoint2DDouble value = points.GetValue(index);
 
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderLazy(
+            wxChartTooltipProviderLazy::Generator(),
+            [value]() -> wxString
             {
-                result = values[j].m_x;
-                foundValue = true;
-            }
-            else if (result > values[j].m_x)
-            {
-                result = values[j].m_x;
-            }
-        }
-    }
+                std::stringstream tooltip;
+                tooltip << "(" << value.m_x << "," << value.m_y << ")";
+                return tooltip.str();
+            },
+            dataset.GetPointOptions().GetFillColor())
+        );
 
-    return result;
+    const wxPoint2DDouble& position = points.GetPosition(index);
+    return Point::ptr(new Point(value, tooltipProvider, position.m_x, position.m_y,
+        dataset.GetPointOptions()));
 }
 
-wxDouble wxScatterPlot::GetMaxXValue(const wxVector<wxScatterPlotDataset::ptr>& datasets)
+bool wxScatterPlot::Scale(int coeff)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_x;
-                foundValue = true;
-            }
-            else if (result < values[j].m_x)
-            {
-                result = values[j].m_x;
-            }
-        }
-    }
-
-    return result;
+    return m_grid.Scale(coeff);
 }
 
-wxDouble wxScatterPlot::GetMinYValue(const wxVector<wxScatterPlotDataset::ptr>& datasets)
+void wxScatterPlot::Shift(double dx,double dy)
 {
-    wxDouble result = 0;
-    bool foundValue = false;
-
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_y;
-                foundValue = true;
-            }
-            else if (result > values[j].m_y)
-            {
-                result = values[j].m_y;
-            }
-        }
-    }
-
-    return result;
+    m_grid.Shift(dx,-dy);
 }
 
-wxDouble wxScatterPlot::GetMaxYValue(const wxVector<wxScatterPlotDataset::ptr>& datasets)
+wxScatterPlot::Extents wxScatterPlot::GetExtents(const wxVector<wxScatterPlotDataset::ptr>& datasets)
 {
-    wxDouble result = 0;
+    Extents extents = { 0, 0, 0, 0 };
     bool foundValue = false;
-
     for (size_t i = 0; i < datasets.size(); ++i)
     {
-        const wxVector<wxPoint2DDouble>& values = datasets[i]->GetData();
-        for (size_t j = 0; j < values.size(); ++j)
-        {
-            if (!foundValue)
-            {
-                result = values[j].m_y;
-                foundValue = true;
-            }
-            else if (result < values[j].m_y)
-            {
-                result = values[j].m_y;
-            }
-        }
+        wxChartUtilities::UpdateExtents(datasets[i]->GetData(), foundValue,
+            extents.m_minX, extents.m_maxX, extents.m_minY, extents.m_maxY);
     }
-
-    return result;
+    return extents;
 }
 
 void wxScatterPlot::DoSetSize(const wxSize &size)
@@ -280,30 +213,38 @@ void wxScatterPlot::DoFit()
 {
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        for (size_t j = 0; j < points.GetCount(); ++j)
         {
-            const Point::ptr& point = points[j];
-            point->SetPosition(m_grid.GetMapping().GetWindowPosition(point->GetValue().m_x, point->GetValue().m_y));
+            points.SetPosition(j, m_grid.GetMapping().GetWindowPosition(points.GetX(j), points.GetY(j)));
         }
+        points.BuildIndex(HitDetectionRange);
     }
 }
 
 void wxScatterPlot::DoDraw(wxGraphicsContext &gc,
                            bool suppressTooltips)
 {
-    m_grid.Fit(gc);
+    // The chart is only redrawn when the data or the layout
+    // changed, in which case the active points are stale
+    m_activePoints.Invalidate();
+
+    // Zooming and panning change the grid mapping so
+    // the points need to be positioned again
+    if (m_grid.Fit(gc))
+    {
+        InvalidateFit();
+    }
     m_grid.Draw(gc);
 
     Fit();
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
-        {
-            points[j]->Draw(gc);
-        }
+        // All the points of the dataset are drawn as a single
+        // path
+        wxChartPoint::DrawAll(gc, m_datasets[i]->GetPoints().GetPositions(), 5,
+            m_datasets[i]->GetPointOptions());
     }
 
     if (!suppressTooltips)
@@ -314,16 +255,19 @@ void wxScatterPlot::DoDraw(wxGraphicsContext &gc,
 
 wxSharedPtr<wxVector<const wxChartElement*> > wxScatterPlot::GetActiveElements(const wxPoint &point)
 {
+    m_activePoints.Begin();
     wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
+    wxVector<size_t> indices;
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        indices.clear();
+        m_datasets[i]->GetPoints().FindInRadius(wxPoint2DDouble(point.x, point.y),
+            HitDetectionRange, indices);
+        for (size_t j = 0; j < indices.size(); ++j)
         {
-            if (points[j]->HitTest(point))
-            {
-                activeElements->push_back(points[j].get());
-            }
+            const Point::ptr &activePoint = m_activePoints.Add(i, indices[j],
+                [&]() { return CreatePoint(*m_datasets[i], indices[j]); });
+            activeElements->push_back(activePoint.get());
         }
     }
     return activeElements;
@@ -79,6 +79,7 @@ void wxScatterPlotCtrl::CreateContextMenu()
         auto parent = this->GetParent();
         if(parent)
             parent->Layout();
+        Refresh();
     },wxID_DEFAULT);
     m_contextMenu.Bind(wxEVT_MENU,
                        [this](wxCommandEvent &)
@@ -89,6 +90,7 @@ void wxScatterPlotCtrl::CreateContextMenu()
         auto parent = this->GetParent();
         if(parent)
             parent->Layout();
+        Refresh();
     },wxID_UP);
     m_contextMenu.Bind(wxEVT_MENU,
                        [this](wxCommandEvent &)
@@ -98,6 +100,7 @@ void wxScatterPlotCtrl::CreateContextMenu()
         auto parent = this->GetParent();
         if(parent)
             parent->Layout();
+        Refresh();
     },wxID_DOWN);
 
     this->Bind(wxEVT_LEFT_DOWN,
@@ -133,6 +136,7 @@ void wxScatterPlotCtrl::CreateContextMenu()
                     m_posX = evt.m_x;
                     m_posY = evt.m_y;
                     parent->Layout();
+                    Refresh();
                 }
             }
         }
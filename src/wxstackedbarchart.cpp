@@ -23,16 +23,16 @@
 #include "wxstackedbarchart.h"
 #include "wxchartcategoricalaxis.h"
 #include "wxchartnumericalaxis.h"
+#include "wxchartutilities.h"
 #include <sstream>
+#include <algorithm>
 
 wxStackedBarChart::Bar::Bar(wxDouble value,
                             const wxChartTooltipProvider::ptr tooltipProvider,
                             wxDouble x,
                             wxDouble y,
-                            const wxColor &fillColor,
-                            const wxColor &strokeColor,
-                            int directions)
-    : wxChartRectangle(x, y, tooltipProvider, wxChartRectangleOptions(fillColor, strokeColor, directions)),
+                            const wxChartRectangleOptions &options)
+    : wxChartRectangle(x, y, tooltipProvider, options),
     m_value(value)
 {
 }
@@ -48,10 +48,16 @@ wxDouble wxStackedBarChart::Bar::GetValue() const
     return m_value;
 }
 
-wxStackedBarChart::Dataset::Dataset()
+wxStackedBarChart::Dataset::Dataset(const wxChartRectangleOptions &options)
+    : m_rectangleOptions(options)
 {
 }
 
+const wxChartRectangleOptions& wxStackedBarChart::Dataset::GetRectangleOptions() const
+{
+    return m_rectangleOptions;
+}
+
 const wxVector<wxStackedBarChart::Bar::ptr>& wxStackedBarChart::Dataset::GetBars() const
 {
     return m_bars;
@@ -62,99 +68,152 @@ void wxStackedBarChart::Dataset::AppendBar(Bar::ptr column)
     m_bars.push_back(column);
 }
 
+void wxStackedBarChart::Dataset::SetBar(size_t index, Bar::ptr bar)
+{
+    m_bars[index] = bar;
+}
+
 wxStackedBarChart::wxStackedBarChart(wxChartsCategoricalData::ptr &data,
                                      const wxSize &size)
-    : m_grid(
+    : m_minValue(GetCumulativeMinValue(data->GetDatasets())),
+    m_maxValue(GetCumulativeMaxValue(data->GetDatasets())),
+    m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
         wxChartCategoricalAxis::make_shared("x", data->GetCategories(), m_options.GetGridOptions().GetXAxisOptions()),
-        wxChartNumericalAxis::make_shared("y", GetCumulativeMinValue(data->GetDatasets()), GetCumulativeMaxValue(data->GetDatasets()), m_options.GetGridOptions().GetYAxisOptions()),
+        wxChartNumericalAxis::make_shared("y", m_minValue, m_maxValue, m_options.GetGridOptions().GetYAxisOptions()),
         m_options.GetGridOptions()
         )
 {
-    const wxVector<wxChartsDoubleDataset::ptr>& datasets = data->GetDatasets();
-    for (size_t i = 0; i < datasets.size(); ++i)
-    {
-        const wxChartsDoubleDataset& dataset = *datasets[i];
-        Dataset::ptr newDataset(new Dataset());
-
-        int border = wxTOP | wxBOTTOM;
-        if (i == (datasets.size() - 1))
-        {
-            border |= wxRIGHT;
-        }
-
-        const wxVector<wxDouble>& datasetData = dataset.GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << datasetData[j];
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic(data->GetCategories()[j], tooltip.str(), dataset.GetFillColor())
-                );
-
-            newDataset->AppendBar(Bar::ptr(new Bar(
-                datasetData[j],
-                tooltipProvider,
-                25, 50,
-                dataset.GetFillColor(), dataset.GetStrokeColor(),
-                border
-                )));
-        }
-
-        m_datasets.push_back(newDataset);
-    }
+    Initialize(data);
 }
 
 wxStackedBarChart::wxStackedBarChart(wxChartsCategoricalData::ptr &data,
                                      const wxStackedBarChartOptions &options, 
                                      const wxSize &size)
     : m_options(options),
+    m_minValue(GetCumulativeMinValue(data->GetDatasets())),
+    m_maxValue(GetCumulativeMaxValue(data->GetDatasets())),
     m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
         wxChartCategoricalAxis::make_shared("x", data->GetCategories(), m_options.GetGridOptions().GetXAxisOptions()),
-        wxChartNumericalAxis::make_shared("y", GetCumulativeMinValue(data->GetDatasets()), GetCumulativeMaxValue(data->GetDatasets()), m_options.GetGridOptions().GetYAxisOptions()),
+        wxChartNumericalAxis::make_shared("y", m_minValue, m_maxValue, m_options.GetGridOptions().GetYAxisOptions()),
         m_options.GetGridOptions()
         )
 {
-    const wxVector<wxChartsDoubleDataset::ptr>& datasets = data->GetDatasets();
-    for (size_t i = 0; i < datasets.size(); ++i)
+    Initialize(data);
+}
+
+const wxChartCommonOptions& wxStackedBarChart::GetCommonOptions() const
+{
+    return m_options.GetCommonOptions();
+}
+
+void wxStackedBarChart::OnValueChanged(const wxChartsCategoricalData &data,
+                                       size_t datasetIndex,
+                                       size_t index,
+                                       wxDouble oldValue)
+{
+    // Only the bar of the value is replaced and, unless
+    // the axis changes, only its stack is laid out again
+    DeactivateElements();
+    m_datasets[datasetIndex]->SetBar(index, CreateBar(data, datasetIndex, index,
+        m_datasets[datasetIndex]->GetRectangleOptions()));
+
+    // The old sum is added up again rather than derived from
+    // the new one: the values are added in the same order as
+    // when the extents were computed so that a stack that was
+    // at a bound is recognized exactly, despite the rounding
+    wxDouble newSum = GetCumulativeValue(data.GetDatasets(), index);
+    wxDouble oldSum = GetCumulativeValue(data.GetDatasets(), index, datasetIndex, oldValue);
+    bool upToDate = wxChartUtilities::ReplaceInExtents(oldSum, newSum, m_minValue, m_maxValue);
+    if (!UpdateValueAxis(data, !upToDate))
+    {
+        FitBars(index);
+    }
+}
+
+void wxStackedBarChart::OnCategoryAppended(const wxChartsCategoricalData &data)
+{
+    size_t index = data.GetCategories().size() - 1;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxChartsDoubleDataset& dataset = *datasets[i];
-        Dataset::ptr newDataset(new Dataset());
+        m_datasets[i]->AppendBar(CreateBar(data, i, index,
+            m_datasets[i]->GetRectangleOptions()));
+    }
 
-        int border = wxTOP | wxBOTTOM;
-        if (i == (datasets.size() - 1))
-        {
-            border |= wxRIGHT;
-        }
+    // The range always includes 0 so it only needs
+    // to be extended
+    wxDouble sum = GetCumulativeValue(data.GetDatasets(), index);
+    m_minValue = std::min(m_minValue, sum);
+    m_maxValue = std::max(m_maxValue, sum);
 
-        const wxVector<wxDouble>& datasetData = dataset.GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << datasetData[j];
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic(data->GetCategories()[j], tooltip.str(), dataset.GetFillColor())
-                );
-
-            newDataset->AppendBar(Bar::ptr(new Bar(
-                datasetData[j],
-                tooltipProvider,
-                25, 50,
-                dataset.GetFillColor(), dataset.GetStrokeColor(),
-                border
-                )));
-        }
+    m_grid.ChangeLabels("x", data.GetCategories(), m_options.GetGridOptions().GetXAxisOptions());
+    UpdateValueAxis(data, false);
+    InvalidateFit();
+}
 
-        m_datasets.push_back(newDataset);
+void wxStackedBarChart::OnDatasetAdded(const wxChartsCategoricalData &data,
+                                       size_t datasetIndex)
+{
+    m_datasets.insert(m_datasets.begin() + datasetIndex, CreateDataset(data, datasetIndex));
+    if ((datasetIndex > 0) && (datasetIndex == (m_datasets.size() - 1)))
+    {
+        // The previous last dataset loses its right border
+        DeactivateElements();
+        m_datasets[datasetIndex - 1] = CreateDataset(data, datasetIndex - 1);
     }
+
+    // All the stacks change
+    UpdateValueAxis(data, true);
+    InvalidateFit();
 }
 
-const wxChartCommonOptions& wxStackedBarChart::GetCommonOptions() const
+void wxStackedBarChart::OnDatasetRemoved(const wxChartsCategoricalData &data,
+                                         size_t datasetIndex)
 {
-    return m_options.GetCommonOptions();
+    DeactivateElements();
+    m_datasets.erase(m_datasets.begin() + datasetIndex);
+    if (!m_datasets.empty() && (datasetIndex == m_datasets.size()))
+    {
+        // The new last dataset needs a right border
+        m_datasets.back() = CreateDataset(data, datasetIndex - 1);
+    }
+
+    UpdateValueAxis(data, true);
+    InvalidateFit();
+}
+
+void wxStackedBarChart::Initialize(wxChartsCategoricalData::ptr &data)
+{
+    for (size_t i = 0; i < data->GetDatasets().size(); ++i)
+    {
+        m_datasets.push_back(CreateDataset(*data, i));
+    }
+}
+
+wxDouble wxStackedBarChart::GetCumulativeValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets,
+                                               size_t index)
+{
+    return GetCumulativeValue(datasets, index, datasets.size(), 0);
+}
+
+wxDouble wxStackedBarChart::GetCumulativeValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets,
+                                               size_t index,
+                                               size_t replacedDataset,
+                                               wxDouble replacement)
+{
+    wxDouble sum = 0;
+    for (size_t i = 0; i < datasets.size(); ++i)
+    {
+        const wxVector<wxDouble>& data = datasets[i]->GetData();
+        if (index < data.size())
+        {
+            sum += ((i == replacedDataset) ? replacement : data[index]);
+        }
+    }
+    return sum;
 }
 
 wxDouble wxStackedBarChart::GetCumulativeMinValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets)
@@ -232,53 +291,33 @@ void wxStackedBarChart::DoSetSize(const wxSize &size)
 
 void wxStackedBarChart::DoFit()
 {
-    wxVector<wxDouble> widthOfPreviousDatasets;
-    for (size_t i = 0; i < m_datasets[0]->GetBars().size(); ++i)
+    if (m_datasets.empty())
     {
-        widthOfPreviousDatasets.push_back(0);
+        return;
     }
 
-    for (size_t i = 0; i < m_datasets.size(); ++i)
+    for (size_t i = 0; i < m_datasets[0]->GetBars().size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetBars().size(); ++j)
-        {
-            Bar& bar = *(currentDataset.GetBars()[j]);
-
-            wxPoint2DDouble upperLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j + 1);
-            upperLeftCornerPosition.m_x += widthOfPreviousDatasets[j];
-            upperLeftCornerPosition.m_y += m_options.GetBarSpacing();
-            wxPoint2DDouble bottomLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j);
-            bottomLeftCornerPosition.m_x += widthOfPreviousDatasets[j];
-            bottomLeftCornerPosition.m_y -= m_options.GetBarSpacing();
-
-            wxPoint2DDouble upperRightCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j + 1, bar.GetValue());
-            upperRightCornerPosition.m_x += widthOfPreviousDatasets[j];
-
-            bar.SetPosition(upperLeftCornerPosition);
-            bar.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
-                bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y);
-
-            widthOfPreviousDatasets[j] += (upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x);
-        }
+        FitBars(i);
     }
 }
 
 void wxStackedBarChart::DoDraw(wxGraphicsContext &gc,
                                bool suppressTooltips)
 {
-    m_grid.Fit(gc);
+    if (m_grid.Fit(gc))
+    {
+        InvalidateFit();
+    }
     m_grid.Draw(gc);
 
     Fit();
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetBars().size(); ++j)
-        {
-            currentDataset.GetBars()[j]->Draw(gc);
-        }
+        // All the elements of a dataset share the same colors
+        // and are drawn with a single fill and stroke
+        wxChartRectangle::DrawAll(gc, m_datasets[i]->GetBars());
     }
 
     if (!suppressTooltips)
@@ -305,3 +344,89 @@ wxSharedPtr<wxVector<const wxChartElement*> > wxStackedBarChart::GetActiveElemen
 
     return activeElements;
 }
+
+wxStackedBarChart::Bar::ptr wxStackedBarChart::CreateBar(const wxChartsCategoricalData &data,
+                                                         size_t datasetIndex,
+                                                         size_t index,
+                                                         const wxChartRectangleOptions &options) const
+{
+    const wxChartsDoubleDataset& dataset = *data.GetDatasets()[datasetIndex];
+    wxDouble value = dataset.GetData()[index];
+
+    std::stringstream tooltip;
+    tooltip << value;
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderStatic(data.GetCategories()[index], tooltip.str(), dataset.GetFillColor())
+        );
+
+    return Bar::ptr(new Bar(
+        value,
+        tooltipProvider,
+        25, 50,
+        options
+        ));
+}
+
+wxStackedBarChart::Dataset::ptr wxStackedBarChart::CreateDataset(const wxChartsCategoricalData &data,
+                                                                 size_t datasetIndex) const
+{
+    const wxChartsDoubleDataset& dataset = *data.GetDatasets()[datasetIndex];
+    int border = wxTOP | wxBOTTOM;
+    if (datasetIndex == (data.GetDatasets().size() - 1))
+    {
+        border |= wxRIGHT;
+    }
+
+    // The pen and brush are shared by all the bars of the dataset
+    Dataset::ptr newDataset(new Dataset(wxChartRectangleOptions(dataset.GetFillColor(),
+        dataset.GetStrokeColor(), border)));
+    const wxVector<wxDouble>& datasetData = dataset.GetData();
+    for (size_t j = 0; j < datasetData.size(); ++j)
+    {
+        newDataset->AppendBar(CreateBar(data, datasetIndex, j,
+            newDataset->GetRectangleOptions()));
+    }
+    return newDataset;
+}
+
+void wxStackedBarChart::FitBars(size_t index)
+{
+    wxDouble widthOfPreviousDatasets = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        Bar& bar = *(m_datasets[i]->GetBars()[index]);
+
+        wxPoint2DDouble upperLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(index + 1);
+        upperLeftCornerPosition.m_x += widthOfPreviousDatasets;
+        upperLeftCornerPosition.m_y += m_options.GetBarSpacing();
+        wxPoint2DDouble bottomLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(index);
+        bottomLeftCornerPosition.m_x += widthOfPreviousDatasets;
+        bottomLeftCornerPosition.m_y -= m_options.GetBarSpacing();
+
+        wxPoint2DDouble upperRightCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(index + 1, bar.GetValue());
+        upperRightCornerPosition.m_x += widthOfPreviousDatasets;
+
+        bar.SetPosition(upperLeftCornerPosition);
+        bar.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
+            bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y);
+
+        widthOfPreviousDatasets += (upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x);
+    }
+}
+
+bool wxStackedBarChart::UpdateValueAxis(const wxChartsCategoricalData &data,
+                                        bool recompute)
+{
+    if (recompute)
+    {
+        m_minValue = GetCumulativeMinValue(data.GetDatasets());
+        m_maxValue = GetCumulativeMaxValue(data.GetDatasets());
+    }
+
+    if (m_grid.UpdateAxisLimit("y", m_minValue, m_maxValue))
+    {
+        InvalidateFit();
+        return true;
+    }
+    return false;
+}
@@ -29,8 +29,10 @@ wxStackedBarChartCtrl::wxStackedBarChartCtrl(wxWindow *parent,
                                              const wxSize &size,
                                              long style)
     : wxChartCtrl(parent, id, pos, size, style),
+    m_data(data),
     m_stackedBarChart(data, size)
 {
+    m_data->AddObserver(this);
 }
 
 wxStackedBarChartCtrl::wxStackedBarChartCtrl(wxWindow *parent,
@@ -41,11 +43,47 @@ wxStackedBarChartCtrl::wxStackedBarChartCtrl(wxWindow *parent,
                                              const wxSize &size,
                                              long style)
     : wxChartCtrl(parent, id, pos, size, style), 
+    m_data(data),
     m_stackedBarChart(data, options, size)
 {
+    m_data->AddObserver(this);
+}
+
+wxStackedBarChartCtrl::~wxStackedBarChartCtrl()
+{
+    m_data->RemoveObserver(this);
 }
 
 wxStackedBarChart& wxStackedBarChartCtrl::GetChart()
 {
     return m_stackedBarChart;
 }
+
+void wxStackedBarChartCtrl::OnValueChanged(const wxChartsCategoricalData &data,
+                                           size_t datasetIndex,
+                                           size_t index,
+                                           wxDouble oldValue)
+{
+    m_stackedBarChart.OnValueChanged(data, datasetIndex, index, oldValue);
+    Refresh();
+}
+
+void wxStackedBarChartCtrl::OnCategoryAppended(const wxChartsCategoricalData &data)
+{
+    m_stackedBarChart.OnCategoryAppended(data);
+    Refresh();
+}
+
+void wxStackedBarChartCtrl::OnDatasetAdded(const wxChartsCategoricalData &data,
+                                           size_t datasetIndex)
+{
+    m_stackedBarChart.OnDatasetAdded(data, datasetIndex);
+    Refresh();
+}
+
+void wxStackedBarChartCtrl::OnDatasetRemoved(const wxChartsCategoricalData &data,
+                                             size_t datasetIndex)
+{
+    m_stackedBarChart.OnDatasetRemoved(data, datasetIndex);
+    Refresh();
+}
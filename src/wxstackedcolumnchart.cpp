@@ -34,16 +34,16 @@
 #include "wxstackedcolumnchart.h"
 #include "wxchartcategoricalaxis.h"
 #include "wxchartnumericalaxis.h"
+#include "wxchartutilities.h"
 #include <sstream>
+#include <algorithm>
 
 wxStackedColumnChart::Column::Column(wxDouble value,
                                      const wxChartTooltipProvider::ptr tooltipProvider,
                                      wxDouble x,
                                      wxDouble y,
-                                     const wxColor &fillColor,
-                                     const wxColor &strokeColor,
-                                     int directions)
-    : wxChartRectangle(x, y, tooltipProvider, wxChartRectangleOptions(fillColor, strokeColor, directions)),
+                                     const wxChartRectangleOptions &options)
+    : wxChartRectangle(x, y, tooltipProvider, options),
     m_value(value)
 {
 }
@@ -59,10 +59,16 @@ wxDouble wxStackedColumnChart::Column::GetValue() const
     return m_value;
 }
 
-wxStackedColumnChart::Dataset::Dataset()
+wxStackedColumnChart::Dataset::Dataset(const wxChartRectangleOptions &options)
+    : m_rectangleOptions(options)
 {
 }
 
+const wxChartRectangleOptions& wxStackedColumnChart::Dataset::GetRectangleOptions() const
+{
+    return m_rectangleOptions;
+}
+
 const wxVector<wxStackedColumnChart::Column::ptr>& wxStackedColumnChart::Dataset::GetColumns() const
 {
     return m_columns;
@@ -73,53 +79,130 @@ void wxStackedColumnChart::Dataset::AppendColumn(Column::ptr column)
     m_columns.push_back(column);
 }
 
+void wxStackedColumnChart::Dataset::SetColumn(size_t index, Column::ptr column)
+{
+    m_columns[index] = column;
+}
+
 wxStackedColumnChart::wxStackedColumnChart(wxChartsCategoricalData::ptr &data,
                                            const wxSize &size)
-    : m_grid(
+    : m_minValue(GetCumulativeMinValue(data->GetDatasets())),
+    m_maxValue(GetCumulativeMaxValue(data->GetDatasets())),
+    m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
         wxChartCategoricalAxis::make_shared("x", data->GetCategories(), m_options.GetGridOptions().GetXAxisOptions()),
-        wxChartNumericalAxis::make_shared("y", GetCumulativeMinValue(data->GetDatasets()), GetCumulativeMaxValue(data->GetDatasets()), m_options.GetGridOptions().GetYAxisOptions()),
+        wxChartNumericalAxis::make_shared("y", m_minValue, m_maxValue, m_options.GetGridOptions().GetYAxisOptions()),
         m_options.GetGridOptions()
         )
 {
-    const wxVector<wxChartsDoubleDataset::ptr>& datasets = data->GetDatasets();
-    for (size_t i = 0; i < datasets.size(); ++i)
+    for (size_t i = 0; i < data->GetDatasets().size(); ++i)
     {
-        const wxChartsDoubleDataset& dataset = *datasets[i];
-        Dataset::ptr newDataset(new Dataset());
+        m_datasets.push_back(CreateDataset(*data, i));
+    }
+}
 
-        int border = wxLEFT | wxRIGHT;
-        if (i == (datasets.size() - 1))
-        {
-            border |= wxTOP;
-        }
+const wxChartCommonOptions& wxStackedColumnChart::GetCommonOptions() const
+{
+    return m_options.GetCommonOptions();
+}
 
-        const wxVector<wxDouble>& datasetData = dataset.GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << datasetData[j];
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic(data->GetCategories()[j], tooltip.str(), dataset.GetFillColor())
-                );
-
-            newDataset->AppendColumn(Column::ptr(new Column(
-                datasetData[j],
-                tooltipProvider,
-                25, 50,
-                dataset.GetFillColor(), dataset.GetStrokeColor(),
-                border
-                )));
-        }
+void wxStackedColumnChart::OnValueChanged(const wxChartsCategoricalData &data,
+                                          size_t datasetIndex,
+                                          size_t index,
+                                          wxDouble oldValue)
+{
+    // Only the column of the value is replaced and, unless
+    // the axis changes, only its stack is laid out again
+    DeactivateElements();
+    m_datasets[datasetIndex]->SetColumn(index, CreateColumn(data, datasetIndex, index,
+        m_datasets[datasetIndex]->GetRectangleOptions()));
+
+    // The old sum is added up again rather than derived from
+    // the new one: the values are added in the same order as
+    // when the extents were computed so that a stack that was
+    // at a bound is recognized exactly, despite the rounding
+    wxDouble newSum = GetCumulativeValue(data.GetDatasets(), index);
+    wxDouble oldSum = GetCumulativeValue(data.GetDatasets(), index, datasetIndex, oldValue);
+    bool upToDate = wxChartUtilities::ReplaceInExtents(oldSum, newSum, m_minValue, m_maxValue);
+    if (!UpdateValueAxis(data, !upToDate))
+    {
+        FitColumns(index);
+    }
+}
 
-        m_datasets.push_back(newDataset);
+void wxStackedColumnChart::OnCategoryAppended(const wxChartsCategoricalData &data)
+{
+    size_t index = data.GetCategories().size() - 1;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        m_datasets[i]->AppendColumn(CreateColumn(data, i, index,
+            m_datasets[i]->GetRectangleOptions()));
     }
+
+    // The range always includes 0 so it only needs
+    // to be extended
+    wxDouble sum = GetCumulativeValue(data.GetDatasets(), index);
+    m_minValue = std::min(m_minValue, sum);
+    m_maxValue = std::max(m_maxValue, sum);
+
+    m_grid.ChangeLabels("x", data.GetCategories(), m_options.GetGridOptions().GetXAxisOptions());
+    UpdateValueAxis(data, false);
+    InvalidateFit();
 }
 
-const wxChartCommonOptions& wxStackedColumnChart::GetCommonOptions() const
+void wxStackedColumnChart::OnDatasetAdded(const wxChartsCategoricalData &data,
+                                          size_t datasetIndex)
 {
-    return m_options.GetCommonOptions();
+    m_datasets.insert(m_datasets.begin() + datasetIndex, CreateDataset(data, datasetIndex));
+    if ((datasetIndex > 0) && (datasetIndex == (m_datasets.size() - 1)))
+    {
+        // The previous top dataset loses its top border
+        DeactivateElements();
+        m_datasets[datasetIndex - 1] = CreateDataset(data, datasetIndex - 1);
+    }
+
+    // All the stacks change
+    UpdateValueAxis(data, true);
+    InvalidateFit();
+}
+
+void wxStackedColumnChart::OnDatasetRemoved(const wxChartsCategoricalData &data,
+                                            size_t datasetIndex)
+{
+    DeactivateElements();
+    m_datasets.erase(m_datasets.begin() + datasetIndex);
+    if (!m_datasets.empty() && (datasetIndex == m_datasets.size()))
+    {
+        // The new top dataset needs a top border
+        m_datasets.back() = CreateDataset(data, datasetIndex - 1);
+    }
+
+    UpdateValueAxis(data, true);
+    InvalidateFit();
+}
+
+wxDouble wxStackedColumnChart::GetCumulativeValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets,
+                                                  size_t index)
+{
+    return GetCumulativeValue(datasets, index, datasets.size(), 0);
+}
+
+wxDouble wxStackedColumnChart::GetCumulativeValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets,
+                                                  size_t index,
+                                                  size_t replacedDataset,
+                                                  wxDouble replacement)
+{
+    wxDouble sum = 0;
+    for (size_t i = 0; i < datasets.size(); ++i)
+    {
+        const wxVector<wxDouble>& data = datasets[i]->GetData();
+        if (index < data.size())
+        {
+            sum += ((i == replacedDataset) ? replacement : data[index]);
+        }
+    }
+    return sum;
 }
 
 wxDouble wxStackedColumnChart::GetCumulativeMinValue(const wxVector<wxChartsDoubleDataset::ptr>& datasets)
@@ -193,52 +276,33 @@ void wxStackedColumnChart::DoSetSize(const wxSize &size)
 
 void wxStackedColumnChart::DoFit()
 {
-    wxVector<wxDouble> heightOfPreviousDatasets;
-    for (size_t i = 0; i < m_datasets[0]->GetColumns().size(); ++i)
+    if (m_datasets.empty())
     {
-        heightOfPreviousDatasets.push_back(0);
+        return;
     }
 
-    for (size_t i = 0; i < m_datasets.size(); ++i)
+    for (size_t i = 0; i < m_datasets[0]->GetColumns().size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetColumns().size(); ++j)
-        {
-            Column& column = *(currentDataset.GetColumns()[j]);
-
-            wxPoint2DDouble upperLeftCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j, column.GetValue());
-            upperLeftCornerPosition.m_x += m_options.GetColumnSpacing();
-            upperLeftCornerPosition.m_y -= heightOfPreviousDatasets[j];
-            wxPoint2DDouble upperRightCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j + 1, column.GetValue());
-            upperRightCornerPosition.m_x -= m_options.GetColumnSpacing();
-            upperRightCornerPosition.m_y -= heightOfPreviousDatasets[j];
-
-            wxPoint2DDouble bottomLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j);
-
-            column.SetPosition(upperLeftCornerPosition);
-            column.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
-                (bottomLeftCornerPosition.m_y - heightOfPreviousDatasets[j]) - upperLeftCornerPosition.m_y);
-
-            heightOfPreviousDatasets[j] = bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y;
-        }
+        FitColumns(i);
     }
 }
 
 void wxStackedColumnChart::DoDraw(wxGraphicsContext &gc,
                                   bool suppressTooltips)
 {
-    m_grid.Fit(gc);
+    if (m_grid.Fit(gc))
+    {
+        InvalidateFit();
+    }
     m_grid.Draw(gc);
 
     Fit();
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetColumns().size(); ++j)
-        {
-            currentDataset.GetColumns()[j]->Draw(gc);
-        }
+        // All the elements of a dataset share the same colors
+        // and are drawn with a single fill and stroke
+        wxChartRectangle::DrawAll(gc, m_datasets[i]->GetColumns());
     }
 
     if (!suppressTooltips)
@@ -267,3 +331,88 @@ wxSharedPtr<wxVector<const wxChartElement*> > wxStackedColumnChart::GetActiveEle
 
     return activeElements;
 }
+
+wxStackedColumnChart::Column::ptr wxStackedColumnChart::CreateColumn(const wxChartsCategoricalData &data,
+                                                                     size_t datasetIndex,
+                                                                     size_t index,
+                                                                     const wxChartRectangleOptions &options) const
+{
+    const wxChartsDoubleDataset& dataset = *data.GetDatasets()[datasetIndex];
+    wxDouble value = dataset.GetData()[index];
+
+    std::stringstream tooltip;
+    tooltip << value;
+    wxChartTooltipProvider::ptr tooltipProvider(
+        new wxChartTooltipProviderStatic(data.GetCategories()[index], tooltip.str(), dataset.GetFillColor())
+        );
+
+    return Column::ptr(new Column(
+        value,
+        tooltipProvider,
+        25, 50,
+        options
+        ));
+}
+
+wxStackedColumnChart::Dataset::ptr wxStackedColumnChart::CreateDataset(const wxChartsCategoricalData &data,
+                                                                       size_t datasetIndex) const
+{
+    const wxChartsDoubleDataset& dataset = *data.GetDatasets()[datasetIndex];
+    int border = wxLEFT | wxRIGHT;
+    if (datasetIndex == (data.GetDatasets().size() - 1))
+    {
+        border |= wxTOP;
+    }
+
+    // The pen and brush are shared by all the columns of the dataset
+    Dataset::ptr newDataset(new Dataset(wxChartRectangleOptions(dataset.GetFillColor(),
+        dataset.GetStrokeColor(), border)));
+    const wxVector<wxDouble>& datasetData = dataset.GetData();
+    for (size_t j = 0; j < datasetData.size(); ++j)
+    {
+        newDataset->AppendColumn(CreateColumn(data, datasetIndex, j,
+            newDataset->GetRectangleOptions()));
+    }
+    return newDataset;
+}
+
+void wxStackedColumnChart::FitColumns(size_t index)
+{
+    wxDouble heightOfPreviousDatasets = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        Column& column = *(m_datasets[i]->GetColumns()[index]);
+
+        wxPoint2DDouble upperLeftCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(index, column.GetValue());
+        upperLeftCornerPosition.m_x += m_options.GetColumnSpacing();
+        upperLeftCornerPosition.m_y -= heightOfPreviousDatasets;
+        wxPoint2DDouble upperRightCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(index + 1, column.GetValue());
+        upperRightCornerPosition.m_x -= m_options.GetColumnSpacing();
+        upperRightCornerPosition.m_y -= heightOfPreviousDatasets;
+
+        wxPoint2DDouble bottomLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(index);
+
+        column.SetPosition(upperLeftCornerPosition);
+        column.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
+            (bottomLeftCornerPosition.m_y - heightOfPreviousDatasets) - upperLeftCornerPosition.m_y);
+
+        heightOfPreviousDatasets = bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y;
+    }
+}
+
+bool wxStackedColumnChart::UpdateValueAxis(const wxChartsCategoricalData &data,
+                                           bool recompute)
+{
+    if (recompute)
+    {
+        m_minValue = GetCumulativeMinValue(data.GetDatasets());
+        m_maxValue = GetCumulativeMaxValue(data.GetDatasets());
+    }
+
+    if (m_grid.UpdateAxisLimit("y", m_minValue, m_maxValue))
+    {
+        InvalidateFit();
+        return true;
+    }
+    return false;
+}
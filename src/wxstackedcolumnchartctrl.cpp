@@ -40,11 +40,47 @@ wxStackedColumnChartCtrl::wxStackedColumnChartCtrl(wxWindow *parent,
                                                    const wxSize &size,
                                                    long style)
     : wxChartCtrl(parent, id, pos, size, style), 
+    m_data(data),
     m_stackedColumnChart(data, size)
 {
+    m_data->AddObserver(this);
+}
+
+wxStackedColumnChartCtrl::~wxStackedColumnChartCtrl()
+{
+    m_data->RemoveObserver(this);
 }
 
 wxStackedColumnChart& wxStackedColumnChartCtrl::GetChart()
 {
     return m_stackedColumnChart;
 }
+
+void wxStackedColumnChartCtrl::OnValueChanged(const wxChartsCategoricalData &data,
+                                              size_t datasetIndex,
+                                              size_t index,
+                                              wxDouble oldValue)
+{
+    m_stackedColumnChart.OnValueChanged(data, datasetIndex, index, oldValue);
+    Refresh();
+}
+
+void wxStackedColumnChartCtrl::OnCategoryAppended(const wxChartsCategoricalData &data)
+{
+    m_stackedColumnChart.OnCategoryAppended(data);
+    Refresh();
+}
+
+void wxStackedColumnChartCtrl::OnDatasetAdded(const wxChartsCategoricalData &data,
+                                              size_t datasetIndex)
+{
+    m_stackedColumnChart.OnDatasetAdded(data, datasetIndex);
+    Refresh();
+}
+
+void wxStackedColumnChartCtrl::OnDatasetRemoved(const wxChartsCategoricalData &data,
+                                                size_t datasetIndex)
+{
+    m_stackedColumnChart.OnDatasetRemoved(data, datasetIndex);
+    Refresh();
+}
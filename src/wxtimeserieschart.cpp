@@ -20,16 +20,282 @@
     IN THE SOFTWARE.
 */
 
+
 #include "wxtimeserieschart.h"
+#include "wxchartutilities.h"
+#include <algorithm>
+
+wxTimeSeriesDataset::wxTimeSeriesDataset(const wxString &label,
+                                         const wxColor &lineColor)
+    : m_label(label), m_lineColor(lineColor), m_first(0),
+    m_maxCount(0), m_maxTimeSpan(0), m_usePyramid(false), m_removed(0)
+{
+}
+
+wxTimeSeriesDataset::wxTimeSeriesDataset(const wxString &label,
+                                         const wxColor &lineColor,
+                                         const wxVector<wxInt64> &timestamps,
+                                         const wxVector<wxDouble> &values)
+    : m_label(label), m_lineColor(lineColor),
+    m_timestamps(timestamps), m_values(values), m_first(0),
+    m_maxCount(0), m_maxTimeSpan(0), m_usePyramid(false), m_removed(0)
+{
+    wxASSERT(m_timestamps.size() == m_values.size());
+}
+
+const wxString& wxTimeSeriesDataset::GetLabel() const
+{
+    return m_label;
+}
+
+const wxColor& wxTimeSeriesDataset::GetLineColor() const
+{
+    return m_lineColor;
+}
+
+size_t wxTimeSeriesDataset::GetCount() const
+{
+    return (m_timestamps.size() - m_first);
+}
+
+void wxTimeSeriesDataset::Reserve(size_t count)
+{
+    m_timestamps.reserve(m_first + count);
+    m_values.reserve(m_first + count);
+}
+
+bool wxTimeSeriesDataset::Append(wxInt64 timestamp,
+                                 wxDouble value)
+{
+    if ((GetCount() > 0) && (timestamp < m_timestamps.back()))
+    {
+        return false;
+    }
+    m_timestamps.push_back(timestamp);
+    m_values.push_back(value);
+    RemoveOldSamples();
+    if (m_usePyramid)
+    {
+        UpdatePyramid();
+    }
+    return true;
+}
+
+const wxInt64* wxTimeSeriesDataset::GetTimestamps() const
+{
+    return (GetCount() > 0) ? &m_timestamps[m_first] : 0;
+}
+
+const wxDouble* wxTimeSeriesDataset::GetValues() const
+{
+    return (GetCount() > 0) ? &m_values[m_first] : 0;
+}
+
+size_t wxTimeSeriesDataset::GetMaxCount() const
+{
+    return m_maxCount;
+}
+
+void wxTimeSeriesDataset::SetMaxCount(size_t maxCount)
+{
+    m_maxCount = maxCount;
+    RemoveOldSamples();
+    if (m_usePyramid)
+    {
+        UpdatePyramid();
+    }
+}
+
+wxInt64 wxTimeSeriesDataset::GetMaxTimeSpan() const
+{
+    return m_maxTimeSpan;
+}
+
+void wxTimeSeriesDataset::SetMaxTimeSpan(wxInt64 maxTimeSpan)
+{
+    m_maxTimeSpan = maxTimeSpan;
+    RemoveOldSamples();
+    if (m_usePyramid)
+    {
+        UpdatePyramid();
+    }
+}
+
+bool wxTimeSeriesDataset::UsesMinMaxPyramid() const
+{
+    return m_usePyramid;
+}
+
+void wxTimeSeriesDataset::SetUseMinMaxPyramid(bool use)
+{
+    m_usePyramid = use;
+    m_pyramid.Clear();
+    if (m_usePyramid)
+    {
+        UpdatePyramid();
+    }
+}
+
+void wxTimeSeriesDataset::UpdateExtents(size_t first,
+                                        size_t last,
+                                        bool &found,
+                                        wxDouble &minValue,
+                                        wxDouble &maxValue) const
+{
+    if (last <= first)
+    {
+        return;
+    }
+
+    const wxDouble *values = GetValues();
+    if (!m_usePyramid)
+    {
+        wxChartUtilities::UpdateExtents(values + first, last - first,
+            1, found, minValue, maxValue);
+        return;
+    }
+
+    size_t removed = m_removed;
+    size_t minIndex;
+    size_t maxIndex;
+    m_pyramid.FindMinMax(first + removed, last + removed,
+        [values, removed](size_t index) { return values[index - removed]; },
+        minIndex, maxIndex);
+    minIndex -= removed;
+    maxIndex -= removed;
+    if (!found || (values[minIndex] < minValue))
+    {
+        minValue = values[minIndex];
+    }
+    if (!found || (values[maxIndex] > maxValue))
+    {
+        maxValue = values[maxIndex];
+    }
+    found = true;
+}
+
+void wxTimeSeriesDataset::Decimate(const wxVector<size_t> &boundaries,
+                                   wxVector<size_t> &indices) const
+{
+    if (GetCount() == 0)
+    {
+        indices.clear();
+        return;
+    }
+
+    const wxDouble *values = GetValues();
+    size_t removed = m_removed;
+    wxVector<size_t> pyramidBoundaries;
+    pyramidBoundaries.reserve(boundaries.size());
+    for (size_t i = 0; i < boundaries.size(); ++i)
+    {
+        pyramidBoundaries.push_back(boundaries[i] + removed);
+    }
+    m_pyramid.Decimate(pyramidBoundaries,
+        [values, removed](size_t index) { return values[index - removed]; },
+        indices);
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        indices[i] -= removed;
+    }
+}
+
+void wxTimeSeriesDataset::FindRange(wxInt64 start,
+                                    wxInt64 end,
+                                    size_t &first,
+                                    size_t &last) const
+{
+    wxVector<wxInt64>::const_iterator begin = m_timestamps.begin() + m_first;
+    first = std::lower_bound(begin, m_timestamps.end(), start) - begin;
+    last = std::upper_bound(begin + first, m_timestamps.end(), end) - begin;
+}
+
+void wxTimeSeriesDataset::RemoveOldSamples()
+{
+    size_t count = GetCount();
+    size_t removed = 0;
+    if ((m_maxCount > 0) && (count > m_maxCount))
+    {
+        removed = count - m_maxCount;
+    }
+    if ((m_maxTimeSpan > 0) && (count > 0))
+    {
+        // The timestamps are sorted so the samples to keep
+        // are found by binary search
+        wxVector<wxInt64>::const_iterator begin = m_timestamps.begin() + m_first;
+        size_t tooOld = std::lower_bound(begin, m_timestamps.end(),
+            m_timestamps.back() - m_maxTimeSpan) - begin;
+        removed = std::max(removed, tooOld);
+    }
+    if (removed == 0)
+    {
+        return;
+    }
+
+    m_first += removed;
+    m_removed += removed;
+
+    // The discarded samples are only erased once they outnumber
+    // the samples that are kept, which makes the cost of
+    // erasing them constant per sample
+    if (m_first > GetCount())
+    {
+        m_timestamps.erase(m_timestamps.begin(), m_timestamps.begin() + m_first);
+        m_values.erase(m_values.begin(), m_values.begin() + m_first);
+        m_first = 0;
+    }
+}
 
-wxTimeSeriesChart::wxTimeSeriesChart(const wxSize &size)
+void wxTimeSeriesDataset::UpdatePyramid()
 {
+    const wxDouble *values = GetValues();
+    size_t removed = m_removed;
+    m_pyramid.Update(removed, removed + GetCount(),
+        [values, removed](size_t index) { return values[index - removed]; });
 }
 
-wxTimeSeriesChart::wxTimeSeriesChart(const wxTimeSeriesChartOptions &options,
+wxTimeSeriesData::wxTimeSeriesData()
+{
+}
+
+void wxTimeSeriesData::AddDataset(wxTimeSeriesDataset::ptr dataset)
+{
+    m_datasets.push_back(dataset);
+}
+
+const wxVector<wxTimeSeriesDataset::ptr>& wxTimeSeriesData::GetDatasets() const
+{
+    return m_datasets;
+}
+
+wxTimeSeriesChart::wxTimeSeriesChart(const wxTimeSeriesData &data,
+                                     const wxSize &size)
+    : m_timeAxis(new wxChartTimeAxis("x", m_options.GetGridOptions().GetXAxisOptions())),
+    m_valueAxis(new wxChartNumericalAxis("y", 0, 0, m_options.GetGridOptions().GetYAxisOptions())),
+    m_grid(
+        wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
+        size,
+        wxChartAxis::ptr(m_timeAxis),
+        wxChartAxis::ptr(m_valueAxis),
+        m_options.GetGridOptions())
+{
+    Initialize(data);
+}
+
+wxTimeSeriesChart::wxTimeSeriesChart(const wxTimeSeriesData &data,
+                                     const wxTimeSeriesChartOptions &options,
                                      const wxSize &size)
-    : m_options(options)
+    : m_options(options),
+    m_timeAxis(new wxChartTimeAxis("x", m_options.GetGridOptions().GetXAxisOptions())),
+    m_valueAxis(new wxChartNumericalAxis("y", 0, 0, m_options.GetGridOptions().GetYAxisOptions())),
+    m_grid(
+        wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
+        size,
+        wxChartAxis::ptr(m_timeAxis),
+        wxChartAxis::ptr(m_valueAxis),
+        m_options.GetGridOptions())
 {
+    Initialize(data);
 }
 
 const wxChartCommonOptions& wxTimeSeriesChart::GetCommonOptions() const
@@ -37,17 +303,304 @@ const wxChartCommonOptions& wxTimeSeriesChart::GetCommonOptions() const
     return m_options.GetCommonOptions();
 }
 
+bool wxTimeSeriesChart::Append(size_t datasetIndex,
+                               wxInt64 timestamp,
+                               wxDouble value)
+{
+    if (datasetIndex >= m_datasets.size())
+    {
+        return false;
+    }
+    size_t count = m_datasets[datasetIndex]->GetCount();
+    if (!m_datasets[datasetIndex]->Append(timestamp, value))
+    {
+        return false;
+    }
+
+    if (m_datasets[datasetIndex]->GetCount() != (count + 1))
+    {
+        // Samples fell out of the retention window, the indices
+        // of the visible range changed and the range itself may
+        // need to shrink
+        UpdateVisibleRange();
+    }
+    else if (m_autoRange)
+    {
+        bool empty = true;
+        for (size_t i = 0; i < m_datasets.size(); ++i)
+        {
+            if ((i != datasetIndex) && (m_datasets[i]->GetCount() > 0))
+            {
+                empty = false;
+            }
+        }
+        if (empty && (m_datasets[datasetIndex]->GetCount() == 1))
+        {
+            UpdateVisibleRange();
+            return true;
+        }
+
+        // The start of the range doesn't move and its end can
+        // only grow so the other datasets are not affected and
+        // the extents can be updated without a rescan
+        m_start = std::min(m_start, timestamp);
+        m_end = std::max(m_end, timestamp);
+        m_visibleRanges[datasetIndex].last = m_datasets[datasetIndex]->GetCount();
+        m_minValue = std::min(m_minValue, value);
+        m_maxValue = std::max(m_maxValue, value);
+        UpdateAxes();
+    }
+    else if (timestamp > m_end)
+    {
+        // The sample is after the visible range but the line
+        // going to it may be visible in which case it must
+        // be included
+        const wxTimeSeriesDataset &dataset = *m_datasets[datasetIndex];
+        size_t first;
+        size_t last;
+        dataset.FindRange(m_start, m_end, first, last);
+        last = std::min(last + 1, dataset.GetCount());
+        if (last != m_visibleRanges[datasetIndex].last)
+        {
+            m_visibleRanges[datasetIndex].last = last;
+            InvalidateFit();
+        }
+    }
+    else
+    {
+        UpdateVisibleRange();
+    }
+
+    return true;
+}
+
+void wxTimeSeriesChart::SetVisibleRange(wxInt64 start,
+                                        wxInt64 end)
+{
+    m_autoRange = false;
+    m_start = start;
+    m_end = end;
+    UpdateVisibleRange();
+}
+
+void wxTimeSeriesChart::ResetVisibleRange()
+{
+    m_autoRange = true;
+    UpdateVisibleRange();
+}
+
+void wxTimeSeriesChart::Initialize(const wxTimeSeriesData &data)
+{
+    m_datasets = data.GetDatasets();
+    m_autoRange = true;
+    m_start = 0;
+    m_end = 0;
+    m_minValue = 0;
+    m_maxValue = 0;
+    UpdateVisibleRange();
+}
+
+void wxTimeSeriesChart::UpdateVisibleRange()
+{
+    if (m_autoRange)
+    {
+        bool found = false;
+        for (size_t i = 0; i < m_datasets.size(); ++i)
+        {
+            size_t count = m_datasets[i]->GetCount();
+            if (count > 0)
+            {
+                const wxInt64 *timestamps = m_datasets[i]->GetTimestamps();
+                m_start = found ? std::min(m_start, timestamps[0]) : timestamps[0];
+                m_end = found ? std::max(m_end, timestamps[count - 1]) : timestamps[count - 1];
+                found = true;
+            }
+        }
+    }
+
+    m_visibleRanges.resize(m_datasets.size());
+
+    bool found = false;
+    m_minValue = 0;
+    m_maxValue = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        const wxTimeSeriesDataset &dataset = *m_datasets[i];
+
+        size_t first;
+        size_t last;
+        dataset.FindRange(m_start, m_end, first, last);
+        dataset.UpdateExtents(first, last, found, m_minValue, m_maxValue);
+
+        // The samples on either side of the range are kept so
+        // that the line extends to the edges of the grid
+        m_visibleRanges[i].first = (first > 0) ? (first - 1) : 0;
+        m_visibleRanges[i].last = std::min(last + 1, dataset.GetCount());
+    }
+
+    UpdateAxes();
+}
+
+void wxTimeSeriesChart::UpdateAxes()
+{
+    if (m_timeAxis->UpdateRange(m_start, m_end, GetMaxTickMarks()))
+    {
+        m_grid.InvalidateFit();
+    }
+    m_grid.UpdateAxisLimit("y", m_minValue, m_maxValue);
+    InvalidateFit();
+}
+
+size_t wxTimeSeriesChart::GetMaxTickMarks() const
+{
+    size_t spacing = std::max(m_options.GetTickMarkSpacing(), 1u);
+    return ((m_grid.GetMapping().GetSize().GetWidth() / spacing) + 1);
+}
+
+wxPoint2DDouble wxTimeSeriesChart::GetWindowPosition(wxInt64 timestamp,
+                                                     wxDouble value) const
+{
+    wxDouble valueRange = m_valueAxis->GetMaxValue() - m_valueAxis->GetMinValue();
+    wxDouble relativeValue = 0;
+    if (valueRange != 0)
+    {
+        relativeValue = (value - m_valueAxis->GetMinValue()) / valueRange;
+    }
+    return wxPoint2DDouble(
+        m_timeAxis->GetPosition(m_timeAxis->GetRelativePosition(timestamp)).m_x,
+        m_valueAxis->GetPosition(relativeValue).m_y
+        );
+}
+
+void wxTimeSeriesChart::BuildLine(const wxTimeSeriesDataset &dataset,
+                                  size_t first,
+                                  size_t last,
+                                  wxVector<wxPoint2DDouble> &line) const
+{
+    line.clear();
+
+    const wxInt64 *timestamps = dataset.GetTimestamps();
+    const wxDouble *values = dataset.GetValues();
+
+    wxDouble width = m_timeAxis->GetPosition(1).m_x - m_timeAxis->GetPosition(0).m_x;
+    size_t columns = static_cast<size_t>(std::max(width, 1.0));
+    if ((last - first) <= (4 * columns))
+    {
+        line.reserve(last - first);
+        for (size_t i = first; i < last; ++i)
+        {
+            line.push_back(GetWindowPosition(timestamps[i], values[i]));
+        }
+        return;
+    }
+
+    // Keep the first, minimum, maximum and last samples of each
+    // pixel column. The columns are found by binary search and
+    // only the kept samples are mapped to window coordinates.
+    wxInt64 start = m_timeAxis->GetStart();
+    wxDouble millisecondsPerColumn = (m_timeAxis->GetEnd() - start) / static_cast<wxDouble>(columns);
+
+    wxVector<size_t> boundaries;
+    boundaries.reserve(columns + 1);
+    boundaries.push_back(first);
+    for (size_t c = 1; c < columns; ++c)
+    {
+        wxInt64 columnStart = start + static_cast<wxInt64>(c * millisecondsPerColumn);
+        size_t boundary = std::lower_bound(timestamps + boundaries.back(),
+            timestamps + last, columnStart) - timestamps;
+        boundaries.push_back(boundary);
+    }
+    boundaries.push_back(last);
+
+    wxVector<size_t> indices;
+    dataset.Decimate(boundaries, indices);
+
+    line.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        line.push_back(GetWindowPosition(timestamps[indices[i]], values[indices[i]]));
+    }
+}
+
 void wxTimeSeriesChart::DoSetSize(const wxSize &size)
 {
+    wxSize newSize(
+        size.GetWidth() - m_options.GetPadding().GetTotalHorizontalPadding(),
+        size.GetHeight() - m_options.GetPadding().GetTotalVerticalPadding()
+        );
+    m_grid.Resize(newSize);
+
+    // The number of tick marks depends on the width
+    UpdateAxes();
 }
 
 void wxTimeSeriesChart::DoFit()
 {
+    m_lines.resize(m_datasets.size());
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        const VisibleRange &range = m_visibleRanges[i];
+        if (range.last > range.first)
+        {
+            BuildLine(*m_datasets[i], range.first, range.last, m_lines[i]);
+        }
+        else
+        {
+            m_lines[i].clear();
+        }
+    }
 }
 
 void wxTimeSeriesChart::DoDraw(wxGraphicsContext &gc,
                                bool suppressTooltips)
 {
+    // The lines only need to be built again if the
+    // data or the layout of the grid changed
+    {
+        wxChartInstrumentation::Scope scope(GetInstrumentation(), wxCHARTSTAGE_GRID);
+        if (m_grid.Fit(gc))
+        {
+            InvalidateFit();
+        }
+        m_grid.Draw(gc);
+    }
+    Fit();
+
+    {
+        wxChartInstrumentation::Scope scope(GetInstrumentation(), wxCHARTSTAGE_DATASETS);
+
+        // The samples on either side of the visible range
+        // are part of the lines and must not be drawn
+        // outside of the grid
+        wxPoint2DDouble topLeft(m_timeAxis->GetPosition(0).m_x, m_valueAxis->GetPosition(1).m_y);
+        wxPoint2DDouble bottomRight(m_timeAxis->GetPosition(1).m_x, m_valueAxis->GetPosition(0).m_y);
+        gc.Clip(topLeft.m_x, topLeft.m_y, bottomRight.m_x - topLeft.m_x, bottomRight.m_y - topLeft.m_y);
+
+        for (size_t i = 0; i < m_lines.size(); ++i)
+        {
+            const wxVector<wxPoint2DDouble> &line = m_lines[i];
+            if (line.empty())
+            {
+                continue;
+            }
+
+            wxGraphicsPath path = gc.CreatePath();
+            path.MoveToPoint(line[0]);
+            for (size_t j = 1; j < line.size(); ++j)
+            {
+                path.AddLineToPoint(line[j]);
+            }
+
+            wxPen pen(m_datasets[i]->GetLineColor(), m_options.GetLineWidth());
+            gc.SetPen(pen);
+            gc.StrokePath(path);
+            GetInstrumentation().AddPrimitives(wxCHARTSTAGE_DATASETS, 1);
+            GetInstrumentation().AddPoints(wxCHARTSTAGE_DATASETS, m_datasets[i]->GetCount(), line.size());
+        }
+
+        gc.ResetClip();
+    }
+
     if (!suppressTooltips)
     {
         DrawTooltips(gc);
@@ -1,5 +1,5 @@
 /*
-    Copyright (c) 2017 Xavier Leclercq
+    Copyright (c) 2017-2018 Xavier Leclercq
 
     Permission is hereby granted, free of charge, to any person obtaining a
     copy of this software and associated documentation files (the "Software"),
@@ -20,27 +20,55 @@
     IN THE SOFTWARE.
 */
 
+
 #include "wxtimeserieschartctrl.h"
 
 wxTimeSeriesChartCtrl::wxTimeSeriesChartCtrl(wxWindow *parent,
                                              wxWindowID id,
+                                             const wxTimeSeriesData &data,
                                              const wxPoint &pos,
                                              const wxSize &size,
                                              long style)
     : wxChartCtrl(parent, id, pos, size, style),
-    m_timeSeriesChart(size)
+    m_timeSeriesChart(data, size)
 {
 }
 
 wxTimeSeriesChartCtrl::wxTimeSeriesChartCtrl(wxWindow *parent,
                                              wxWindowID id,
+                                             const wxTimeSeriesData &data,
                                              const wxTimeSeriesChartOptions &options,
                                              const wxPoint &pos,
                                              const wxSize &size,
                                              long style)
     : wxChartCtrl(parent, id, pos, size, style),
-    m_timeSeriesChart(size)
+    m_timeSeriesChart(data, options, size)
+{
+}
+
+bool wxTimeSeriesChartCtrl::Append(size_t datasetIndex,
+                                   wxInt64 timestamp,
+                                   wxDouble value)
+{
+    if (!m_timeSeriesChart.Append(datasetIndex, timestamp, value))
+    {
+        return false;
+    }
+    Refresh();
+    return true;
+}
+
+void wxTimeSeriesChartCtrl::SetVisibleRange(wxInt64 start,
+                                            wxInt64 end)
+{
+    m_timeSeriesChart.SetVisibleRange(start, end);
+    Refresh();
+}
+
+void wxTimeSeriesChartCtrl::ResetVisibleRange()
 {
+    m_timeSeriesChart.ResetVisibleRange();
+    Refresh();
 }
 
 wxTimeSeriesChart& wxTimeSeriesChartCtrl::GetChart()
@@ -1,5 +1,5 @@
 /*
-    Copyright (c) 2017 Xavier Leclercq
+    Copyright (c) 2017-2018 Xavier Leclercq
 
     Permission is hereby granted, free of charge, to any person obtaining a
     copy of this software and associated documentation files (the "Software"),
@@ -20,8 +20,40 @@
     IN THE SOFTWARE.
 */
 
+
 #include "wxtimeserieschartoptions.h"
 
 wxTimeSeriesChartOptions::wxTimeSeriesChartOptions()
+    : m_lineWidth(1), m_tickMarkSpacing(100)
+{
+}
+
+const wxChartGridOptions& wxTimeSeriesChartOptions::GetGridOptions() const
+{
+    return m_gridOptions;
+}
+
+wxChartGridOptions& wxTimeSeriesChartOptions::GetGridOptions()
+{
+    return m_gridOptions;
+}
+
+unsigned int wxTimeSeriesChartOptions::GetLineWidth() const
+{
+    return m_lineWidth;
+}
+
+void wxTimeSeriesChartOptions::SetLineWidth(unsigned int width)
+{
+    m_lineWidth = width;
+}
+
+unsigned int wxTimeSeriesChartOptions::GetTickMarkSpacing() const
+{
+    return m_tickMarkSpacing;
+}
+
+void wxTimeSeriesChartOptions::SetTickMarkSpacing(unsigned int spacing)
 {
+    m_tickMarkSpacing = spacing;
 }
@@ -0,0 +1,381 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/*
+    Measures the time it takes to create, lay out, draw and hit-test
+    each chart type at several data sizes. The layout (wxChart::Fit)
+    runs inside the first draw, once the grid has been measured, so
+    its time is taken from the instrumentation of the chart and
+    reported separately from the rest of the first draw. The charts are drawn to
+    a wxImage so no window is created. With the GTK port a display
+    is still needed to initialize wxWidgets, on a headless machine
+    run the program under xvfb-run ("make run-benchmarks" does
+    this). Without a display nothing is measured and the program
+    exits with 77, the code automated runs use for skipped tests,
+    so that a missing display is never mistaken for a success.
+
+    Usage: wxchartsbenchmarks [count...]
+
+    The counts are the numbers of data points, by default the
+    charts are measured with 100, 1000 and 10000 points.
+*/
+
+#include <wx/charts/wxcharts.h>
+#include <wx/init.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+namespace
+{
+
+const wxSize ChartSize(800, 600);
+const size_t HitTestCount = 200;
+// The exit code when the benchmarks can't run
+const int SkippedExitCode = 77;
+
+class Timer
+{
+public:
+    Timer()
+        : m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double GetElapsedMilliseconds() const
+    {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+        return elapsed.count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+wxVector<wxString> CreateLabels(size_t count)
+{
+    wxVector<wxString> labels;
+    labels.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        labels.push_back(wxString::Format("%lu", static_cast<unsigned long>(i)));
+    }
+    return labels;
+}
+
+wxVector<wxDouble> CreateValues(size_t count, std::mt19937 &generator)
+{
+    std::uniform_real_distribution<wxDouble> distribution(0, 100);
+    wxVector<wxDouble> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        values.push_back(distribution(generator));
+    }
+    return values;
+}
+
+wxVector<wxPoint2DDouble> CreatePoints(size_t count, std::mt19937 &generator)
+{
+    std::uniform_real_distribution<wxDouble> distribution(0, 100);
+    wxVector<wxPoint2DDouble> points;
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        points.push_back(wxPoint2DDouble(i, distribution(generator)));
+    }
+    return points;
+}
+
+// Runs the benchmark for one chart type and one data size. The
+// chart is created by the factory so that its construction is
+// included in the measurements.
+template<typename Chart, typename Factory>
+void RunBenchmark(const char *name, size_t count, Factory factory)
+{
+    Timer constructionTimer;
+    std::unique_ptr<Chart> chart(factory());
+    double construction = constructionTimer.GetElapsedMilliseconds();
+
+    chart->SetSize(ChartSize);
+
+    // The first draw lays out the chart
+    wxChartInstrumentation& instrumentation = chart->GetInstrumentation();
+    instrumentation.Enable();
+    wxImage image;
+    Timer firstDrawTimer;
+    chart->RenderTo(image, ChartSize);
+    double firstDraw = firstDrawTimer.GetElapsedMilliseconds();
+    double fit = instrumentation.GetLastFrame(wxCHARTSTAGE_FIT).GetTime();
+    firstDraw -= fit;
+    instrumentation.Enable(false);
+
+    Timer drawTimer;
+    chart->RenderTo(image, ChartSize);
+    double draw = drawTimer.GetElapsedMilliseconds();
+
+    // Move the mouse across the middle of the chart
+    Timer hitTestTimer;
+    for (size_t i = 0; i < HitTestCount; ++i)
+    {
+        wxPoint point((i * ChartSize.GetWidth()) / HitTestCount, ChartSize.GetHeight() / 2);
+        chart->ActivateElementsAt(point);
+    }
+    double hitTest = (hitTestTimer.GetElapsedMilliseconds() * 1000) / HitTestCount;
+
+    std::printf("%-16s %10lu %14.3f %14.3f %14.3f %14.3f %14.3f\n", name,
+        static_cast<unsigned long>(count), construction, fit, firstDraw, draw, hitTest);
+}
+
+void RunBenchmarks(size_t count)
+{
+    std::mt19937 generator(12345);
+    wxColor fillColor(220, 220, 220, 0x7F);
+    wxColor strokeColor(151, 187, 205);
+
+    RunBenchmark<wxLineChart>("line", count, [&]()
+    {
+        wxLineChartData data(CreateLabels(count));
+        data.AddDataset(wxLineChartDataset::ptr(new wxLineChartDataset("dataset",
+            strokeColor, *wxWHITE, fillColor, CreateValues(count, generator))));
+        return new wxLineChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxMath2DPlot>("math2d", count, [&]()
+    {
+        wxMath2DPlotData data;
+        wxVector<wxPoint2DDouble> points = CreatePoints(count, generator);
+        data.AddDataset(wxMath2DPlotDataset::ptr(new wxMath2DPlotDataset(
+            strokeColor, fillColor, strokeColor, points)));
+        return new wxMath2DPlot(data, ChartSize);
+    });
+
+    RunBenchmark<wxScatterPlot>("scatter", count, [&]()
+    {
+        wxScatterPlotData data;
+        wxVector<wxPoint2DDouble> points = CreatePoints(count, generator);
+        data.AddDataset(wxScatterPlotDataset::ptr(new wxScatterPlotDataset(
+            fillColor, strokeColor, points)));
+        return new wxScatterPlot(data, ChartSize);
+    });
+
+    RunBenchmark<wxAreaChart>("area", count, [&]()
+    {
+        wxAreaChartData data;
+        wxVector<wxPoint2DDouble> points = CreatePoints(count, generator);
+        data.AddDataset(wxAreaChartDataset::ptr(new wxAreaChartDataset(
+            strokeColor, points)));
+        return new wxAreaChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxBubbleChart>("bubble", count, [&]()
+    {
+        std::uniform_real_distribution<wxDouble> distribution(0, 100);
+        wxVector<wxDoubleTriplet> triplets;
+        for (size_t i = 0; i < count; ++i)
+        {
+            triplets.push_back(wxDoubleTriplet(distribution(generator),
+                distribution(generator), distribution(generator) / 10));
+        }
+        wxBubbleChartData data;
+        data.AddDataset(wxBubbleChartDataset::ptr(new wxBubbleChartDataset(
+            fillColor, strokeColor, triplets)));
+        return new wxBubbleChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxColumnChart>("column", count, [&]()
+    {
+        wxChartsCategoricalData::ptr data = wxChartsCategoricalData::make_shared(CreateLabels(count));
+        data->AddDataset(wxChartsDoubleDataset::ptr(new wxChartsDoubleDataset(
+            fillColor, strokeColor, CreateValues(count, generator))));
+        return new wxColumnChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxBarChart>("bar", count, [&]()
+    {
+        wxChartsCategoricalData::ptr data = wxChartsCategoricalData::make_shared(CreateLabels(count));
+        data->AddDataset(wxChartsDoubleDataset::ptr(new wxChartsDoubleDataset(
+            fillColor, strokeColor, CreateValues(count, generator))));
+        return new wxBarChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxStackedColumnChart>("stacked column", count, [&]()
+    {
+        wxChartsCategoricalData::ptr data = wxChartsCategoricalData::make_shared(CreateLabels(count));
+        data->AddDataset(wxChartsDoubleDataset::ptr(new wxChartsDoubleDataset(
+            fillColor, strokeColor, CreateValues(count, generator))));
+        data->AddDataset(wxChartsDoubleDataset::ptr(new wxChartsDoubleDataset(
+            strokeColor, fillColor, CreateValues(count, generator))));
+        return new wxStackedColumnChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxStackedBarChart>("stacked bar", count, [&]()
+    {
+        wxChartsCategoricalData::ptr data = wxChartsCategoricalData::make_shared(CreateLabels(count));
+        data->AddDataset(wxChartsDoubleDataset::ptr(new wxChartsDoubleDataset(
+            fillColor, strokeColor, CreateValues(count, generator))));
+        data->AddDataset(wxChartsDoubleDataset::ptr(new wxChartsDoubleDataset(
+            strokeColor, fillColor, CreateValues(count, generator))));
+        return new wxStackedBarChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxCandlestickChart>("candlestick", count, [&]()
+    {
+        std::uniform_real_distribution<wxDouble> distribution(0, 10);
+        wxVector<wxChartOHLCData> ohlcData;
+        wxDouble close = 50;
+        for (size_t i = 0; i < count; ++i)
+        {
+            wxDouble open = close;
+            close = open + distribution(generator) - 5;
+            ohlcData.push_back(wxChartOHLCData(open,
+                std::max(open, close) + distribution(generator),
+                std::min(open, close) - distribution(generator), close));
+        }
+        wxCandlestickChartData data(CreateLabels(count), ohlcData);
+        return new wxCandlestickChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxPieChart>("pie", count, [&]()
+    {
+        wxPieChartData::ptr data = wxPieChartData::make_shared();
+        wxVector<wxDouble> values = CreateValues(count, generator);
+        wxVector<wxString> labels = CreateLabels(count);
+        wxVector<wxChartSliceData> slices;
+        for (size_t i = 0; i < count; ++i)
+        {
+            slices.push_back(wxChartSliceData(values[i], fillColor, labels[i]));
+        }
+        data->AddSlices(slices);
+        return new wxPieChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxDoughnutChart>("doughnut", count, [&]()
+    {
+        wxPieChartData::ptr data = wxPieChartData::make_shared();
+        wxVector<wxDouble> values = CreateValues(count, generator);
+        wxVector<wxString> labels = CreateLabels(count);
+        wxVector<wxChartSliceData> slices;
+        for (size_t i = 0; i < count; ++i)
+        {
+            slices.push_back(wxChartSliceData(values[i], fillColor, labels[i]));
+        }
+        data->AddSlices(slices);
+        return new wxDoughnutChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxPolarAreaChart>("polar area", count, [&]()
+    {
+        wxPolarAreaChartData data;
+        wxVector<wxDouble> values = CreateValues(count, generator);
+        wxVector<wxString> labels = CreateLabels(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            data.AppendSlice(wxChartSliceData(values[i], fillColor, labels[i]));
+        }
+        return new wxPolarAreaChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxHistogramChart>("histogram", count, [&]()
+    {
+        wxVector<wxDouble> values = CreateValues(count, generator);
+        wxHistogramChartData data(wxHistogramChartDataset::ptr(
+            new wxHistogramChartDataset(strokeColor, fillColor, values)), 20);
+        return new wxHistogramChart(data, ChartSize);
+    });
+
+    RunBenchmark<wxTimeSeriesChart>("time series", count, [&]()
+    {
+        // One sample per minute
+        wxVector<wxInt64> timestamps;
+        timestamps.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            timestamps.push_back(1500000000000LL + (static_cast<wxInt64>(i) * 60000));
+        }
+        wxTimeSeriesData data;
+        data.AddDataset(wxTimeSeriesDataset::ptr(new wxTimeSeriesDataset("dataset",
+            strokeColor, timestamps, CreateValues(count, generator))));
+        return new wxTimeSeriesChart(data, ChartSize);
+    });
+
+    // The radar and combination charts don't display data
+    // yet, only their grid is measured
+    RunBenchmark<wxRadarChart>("radar", count, [&]()
+    {
+        return new wxRadarChart(ChartSize);
+    });
+
+    RunBenchmark<wxCombinationChart>("combination", count, [&]()
+    {
+        wxChartsCategoricalData::ptr data = wxChartsCategoricalData::make_shared(CreateLabels(count));
+        data->AddDataset(wxChartsDoubleDataset::ptr(new wxChartsDoubleDataset(
+            fillColor, strokeColor, CreateValues(count, generator))));
+        wxCombinationChart* chart = new wxCombinationChart();
+        chart->AddColumnChart(*data);
+        return chart;
+    });
+}
+
+}
+
+int main(int argc, char **argv)
+{
+#ifdef __WXGTK__
+    if (!std::getenv("DISPLAY") && !std::getenv("WAYLAND_DISPLAY"))
+    {
+        std::fprintf(stderr, "No display, the benchmarks are skipped. Run them under xvfb-run.\n");
+        return SkippedExitCode;
+    }
+#endif
+
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        std::fprintf(stderr, "Failed to initialize wxWidgets\n");
+        return 1;
+    }
+
+    wxVector<size_t> counts;
+    for (int i = 1; i < argc; ++i)
+    {
+        counts.push_back(std::strtoul(argv[i], 0, 10));
+    }
+    if (counts.empty())
+    {
+        counts.push_back(100);
+        counts.push_back(1000);
+        counts.push_back(10000);
+    }
+
+    std::printf("%-16s %10s %14s %14s %14s %14s %14s\n", "chart", "points",
+        "create (ms)", "fit (ms)", "1st draw (ms)", "draw (ms)", "hit-test (us)");
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        RunBenchmarks(counts[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,584 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/*
+    Measures the memory used by each chart type at several data
+    sizes and compares it with the budgets checked in next to this
+    file. The global operator new is replaced by a counting one so
+    that every allocation made through new, including those made by
+    the containers, is counted with its size. Memory allocated with
+    malloc by the C libraries of the port is not seen.
+
+    For each chart four phases are measured: the construction of
+    the chart from data that has already been created, the layout
+    of the chart with wxChart::Fit() which doesn't draw anything,
+    the first draw and the draws that follow it. For each phase
+    the number of allocations and the peak of the memory in use
+    above its level at the start of the phase are reported per
+    element.
+
+    Usage: wxchartsmemorytests [--budgets file] [--write-budgets] [count...]
+
+    The budgets are read from src/memory/wxchartsmemorybudgets.txt
+    by default. The program exits with 1 if a measurement exceeds
+    its budget or has no budget. The phases that have no budget at
+    all in the file are reported but not checked, so that a phase
+    can be left out until it has been measured on a real port. With
+    --write-budgets it prints the measurements with
+    some headroom in the format of the budget file instead, this is
+    how the budget file is updated after an intended change.
+
+    The counts are the numbers of elements, by default the charts
+    are measured with 1000, 100000 and 1000000 elements.
+*/
+
+#include <wx/charts/wxcharts.h>
+#include <wx/init.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <set>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+namespace
+{
+
+// Every block starts with a header that stores its size. The
+// header is big enough to keep the alignment malloc guarantees.
+const size_t HeaderSize = 16;
+
+std::atomic<size_t> bytesInUse(0);
+std::atomic<size_t> peakBytesInUse(0);
+
+void* CountedAllocate(size_t size)
+{
+    void *block = std::malloc(size + HeaderSize);
+    if (!block)
+    {
+        return 0;
+    }
+    *static_cast<size_t*>(block) = size;
+
+    wxChartInstrumentation::RecordAllocation();
+    size_t inUse = bytesInUse.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = peakBytesInUse.load(std::memory_order_relaxed);
+    while ((inUse > peak) &&
+        !peakBytesInUse.compare_exchange_weak(peak, inUse, std::memory_order_relaxed))
+    {
+    }
+
+    return static_cast<char*>(block) + HeaderSize;
+}
+
+void CountedFree(void *ptr)
+{
+    if (ptr)
+    {
+        void *block = static_cast<char*>(ptr) - HeaderSize;
+        bytesInUse.fetch_sub(*static_cast<size_t*>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+}
+
+void* operator new(size_t size)
+{
+    void *ptr = CountedAllocate(size);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) throw()
+{
+    return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) throw()
+{
+    return CountedAllocate(size);
+}
+
+void operator delete(void *ptr) throw()
+{
+    CountedFree(ptr);
+}
+
+void operator delete[](void *ptr) throw()
+{
+    CountedFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) throw()
+{
+    CountedFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) throw()
+{
+    CountedFree(ptr);
+}
+
+namespace
+{
+
+const wxSize ChartSize(800, 600);
+const size_t DrawCount = 3;
+// The headroom given to the measurements by --write-budgets
+const double BudgetHeadroom = 1.25;
+// The smallest budgets written by --write-budgets, per element,
+// so that a phase that allocates nothing on one port doesn't
+// fail on the first allocation made by another
+const double MinAllocationsBudget = 0.01;
+const double MinPeakBytesBudget = 1.0;
+
+// The allocations and the peak memory of one phase, in total
+// and not yet divided by the number of elements
+class Usage
+{
+public:
+    Usage()
+        : m_allocations(0), m_peakBytes(0)
+    {
+    }
+
+    size_t GetAllocations() const
+    {
+        return m_allocations;
+    }
+
+    size_t GetPeakBytes() const
+    {
+        return m_peakBytes;
+    }
+
+    void Max(const Usage &other)
+    {
+        m_allocations = std::max(m_allocations, other.m_allocations);
+        m_peakBytes = std::max(m_peakBytes, other.m_peakBytes);
+    }
+
+    static Usage Measure(const std::function<void()> &phase)
+    {
+        size_t allocations = wxChartInstrumentation::GetAllocationCount();
+        size_t baseline = bytesInUse.load(std::memory_order_relaxed);
+        peakBytesInUse.store(baseline, std::memory_order_relaxed);
+
+        phase();
+
+        Usage usage;
+        usage.m_allocations = wxChartInstrumentation::GetAllocationCount() - allocations;
+        usage.m_peakBytes = peakBytesInUse.load(std::memory_order_relaxed) - baseline;
+        return usage;
+    }
+
+private:
+    size_t m_allocations;
+    size_t m_peakBytes;
+};
+
+// The budget of one phase, per element
+struct Budget
+{
+    double allocations;
+    double peakBytes;
+};
+
+typedef std::tuple<std::string, std::string, size_t> BudgetKey;
+
+class Budgets
+{
+public:
+    Budgets()
+        : m_writeBudgets(false), m_failures(0)
+    {
+    }
+
+    // Each line of the file is: chart phase count allocations bytes,
+    // where the last two are per element. Lines starting with a #
+    // are comments.
+    bool Load(const std::string &filename)
+    {
+        std::ifstream file(filename.c_str());
+        if (!file)
+        {
+            return false;
+        }
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || (line[0] == '#'))
+            {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            std::string chart;
+            std::string phase;
+            size_t count;
+            Budget budget;
+            if (fields >> chart >> phase >> count >> budget.allocations >> budget.peakBytes)
+            {
+                m_budgets[BudgetKey(chart, phase, count)] = budget;
+                m_phases.insert(phase);
+            }
+        }
+        return true;
+    }
+
+    void SetWriteBudgets(bool write)
+    {
+        m_writeBudgets = write;
+    }
+
+    void Check(const std::string &chart, const std::string &phase,
+        size_t count, const Usage &usage)
+    {
+        double allocations = static_cast<double>(usage.GetAllocations()) / count;
+        double peakBytes = static_cast<double>(usage.GetPeakBytes()) / count;
+
+        if (m_writeBudgets)
+        {
+            // Rounded up to the precision of the file or the
+            // measurement could exceed its own budget
+            double allocationsBudget = std::max(MinAllocationsBudget,
+                std::ceil(allocations * BudgetHeadroom * 100) / 100);
+            double peakBytesBudget = std::max(MinPeakBytesBudget,
+                std::ceil(peakBytes * BudgetHeadroom * 10) / 10);
+            std::printf("%-12s %-10s %8lu %12.2f %12.1f\n", chart.c_str(), phase.c_str(),
+                static_cast<unsigned long>(count), allocationsBudget, peakBytesBudget);
+            return;
+        }
+
+        // A measurement without a budget fails too, or a chart or a
+        // count missing from the file would never be checked
+        const char *result = "FAILED (no budget)";
+        std::map<BudgetKey, Budget>::const_iterator it = m_budgets.find(BudgetKey(chart, phase, count));
+        if (m_phases.find(phase) == m_phases.end())
+        {
+            result = "not checked";
+        }
+        else if (it == m_budgets.end())
+        {
+            ++m_failures;
+        }
+        else
+        {
+            if ((allocations > it->second.allocations) || (peakBytes > it->second.peakBytes))
+            {
+                result = "FAILED";
+                ++m_failures;
+            }
+            else
+            {
+                result = "ok";
+            }
+        }
+
+        std::printf("%-12s %-10s %8lu %12.2f %12.1f  %s\n", chart.c_str(), phase.c_str(),
+            static_cast<unsigned long>(count), allocations, peakBytes, result);
+    }
+
+    size_t GetFailures() const
+    {
+        return m_failures;
+    }
+
+private:
+    std::map<BudgetKey, Budget> m_budgets;
+    std::set<std::string> m_phases;
+    bool m_writeBudgets;
+    size_t m_failures;
+};
+
+wxVector<wxString> CreateLabels(size_t count)
+{
+    wxVector<wxString> labels;
+    labels.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        labels.push_back(wxString::Format("%lu", static_cast<unsigned long>(i)));
+    }
+    return labels;
+}
+
+wxVector<wxDouble> CreateValues(size_t count, std::mt19937 &generator)
+{
+    std::uniform_real_distribution<wxDouble> distribution(0, 100);
+    wxVector<wxDouble> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        values.push_back(distribution(generator));
+    }
+    return values;
+}
+
+wxVector<wxPoint2DDouble> CreatePoints(size_t count, std::mt19937 &generator)
+{
+    std::uniform_real_distribution<wxDouble> distribution(0, 100);
+    wxVector<wxPoint2DDouble> points;
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        points.push_back(wxPoint2DDouble(i, distribution(generator)));
+    }
+    return points;
+}
+
+// Measures one chart type at one data size. The data is created
+// by the caller, the factory only creates the chart so that the
+// construction phase doesn't include the input data.
+template<typename Chart, typename Factory>
+void MeasureChart(Budgets &budgets, const char *name, size_t count, Factory factory)
+{
+    std::unique_ptr<Chart> chart;
+    Usage construction = Usage::Measure([&]()
+    {
+        chart.reset(factory());
+        chart->SetSize(ChartSize);
+    });
+    budgets.Check(name, "create", count, construction);
+
+    // Some charts create their elements when they are laid
+    // out, this doesn't depend on the drawing backend
+    Usage fit = Usage::Measure([&]()
+    {
+        chart->Fit();
+    });
+    budgets.Check(name, "fit", count, fit);
+
+    wxImage image;
+    Usage firstDraw = Usage::Measure([&]()
+    {
+        chart->RenderTo(image, ChartSize);
+    });
+    budgets.Check(name, "firstdraw", count, firstDraw);
+
+    Usage draw;
+    for (size_t i = 1; i < DrawCount; ++i)
+    {
+        draw.Max(Usage::Measure([&]()
+        {
+            chart->RenderTo(image, ChartSize);
+        }));
+    }
+    budgets.Check(name, "draw", count, draw);
+}
+
+void MeasureCharts(Budgets &budgets, size_t count)
+{
+    std::mt19937 generator(12345);
+    wxColor fillColor(220, 220, 220, 0x7F);
+    wxColor strokeColor(151, 187, 205);
+
+    {
+        wxLineChartData data(CreateLabels(count));
+        data.AddDataset(wxLineChartDataset::ptr(new wxLineChartDataset("dataset",
+            strokeColor, *wxWHITE, fillColor, CreateValues(count, generator))));
+        MeasureChart<wxLineChart>(budgets, "line", count, [&]()
+        {
+            return new wxLineChart(data, ChartSize);
+        });
+    }
+
+    {
+        wxMath2DPlotData data;
+        wxVector<wxPoint2DDouble> points = CreatePoints(count, generator);
+        data.AddDataset(wxMath2DPlotDataset::ptr(new wxMath2DPlotDataset(
+            strokeColor, fillColor, strokeColor, points)));
+        MeasureChart<wxMath2DPlot>(budgets, "math2d", count, [&]()
+        {
+            return new wxMath2DPlot(data, ChartSize);
+        });
+    }
+
+    {
+        wxScatterPlotData data;
+        wxVector<wxPoint2DDouble> points = CreatePoints(count, generator);
+        data.AddDataset(wxScatterPlotDataset::ptr(new wxScatterPlotDataset(
+            fillColor, strokeColor, points)));
+        MeasureChart<wxScatterPlot>(budgets, "scatter", count, [&]()
+        {
+            return new wxScatterPlot(data, ChartSize);
+        });
+    }
+
+    {
+        std::uniform_real_distribution<wxDouble> distribution(0, 100);
+        wxVector<wxDoubleTriplet> triplets;
+        triplets.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            triplets.push_back(wxDoubleTriplet(distribution(generator),
+                distribution(generator), distribution(generator) / 10));
+        }
+        wxBubbleChartData data;
+        data.AddDataset(wxBubbleChartDataset::ptr(new wxBubbleChartDataset(
+            fillColor, strokeColor, triplets)));
+        MeasureChart<wxBubbleChart>(budgets, "bubble", count, [&]()
+        {
+            return new wxBubbleChart(data, ChartSize);
+        });
+    }
+
+    {
+        wxChartsCategoricalData::ptr data = wxChartsCategoricalData::make_shared(CreateLabels(count));
+        data->AddDataset(wxChartsDoubleDataset::ptr(new wxChartsDoubleDataset(
+            fillColor, strokeColor, CreateValues(count, generator))));
+        MeasureChart<wxColumnChart>(budgets, "column", count, [&]()
+        {
+            return new wxColumnChart(data, ChartSize);
+        });
+    }
+
+    {
+        std::uniform_real_distribution<wxDouble> distribution(0, 10);
+        wxVector<wxChartOHLCData> ohlcData;
+        ohlcData.reserve(count);
+        wxDouble close = 50;
+        for (size_t i = 0; i < count; ++i)
+        {
+            wxDouble open = close;
+            close = open + distribution(generator) - 5;
+            ohlcData.push_back(wxChartOHLCData(open,
+                std::max(open, close) + distribution(generator),
+                std::min(open, close) - distribution(generator), close));
+        }
+        wxCandlestickChartData data(CreateLabels(count), ohlcData);
+        MeasureChart<wxCandlestickChart>(budgets, "candlestick", count, [&]()
+        {
+            return new wxCandlestickChart(data, ChartSize);
+        });
+    }
+
+    {
+        wxHistogramChartData data(wxHistogramChartDataset::ptr(
+            new wxHistogramChartDataset(strokeColor, fillColor, CreateValues(count, generator))), 20);
+        MeasureChart<wxHistogramChart>(budgets, "histogram", count, [&]()
+        {
+            return new wxHistogramChart(data, ChartSize);
+        });
+    }
+
+    {
+        wxPieChartData::ptr data = wxPieChartData::make_shared();
+        wxVector<wxDouble> values = CreateValues(count, generator);
+        wxVector<wxString> labels = CreateLabels(count);
+        wxVector<wxChartSliceData> slices;
+        slices.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            slices.push_back(wxChartSliceData(values[i], fillColor, labels[i]));
+        }
+        data->AddSlices(slices);
+
+        MeasureChart<wxPieChart>(budgets, "pie", count, [&]()
+        {
+            return new wxPieChart(data, ChartSize);
+        });
+        MeasureChart<wxDoughnutChart>(budgets, "doughnut", count, [&]()
+        {
+            return new wxDoughnutChart(data, ChartSize);
+        });
+    }
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        std::fprintf(stderr, "Failed to initialize wxWidgets\n");
+        return 2;
+    }
+
+    std::string budgetsFilename = "src/memory/wxchartsmemorybudgets.txt";
+    bool writeBudgets = false;
+    Budgets budgets;
+    wxVector<size_t> counts;
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((std::strcmp(argv[i], "--budgets") == 0) && ((i + 1) < argc))
+        {
+            budgetsFilename = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--write-budgets") == 0)
+        {
+            writeBudgets = true;
+        }
+        else
+        {
+            counts.push_back(std::strtoul(argv[i], 0, 10));
+        }
+    }
+    budgets.SetWriteBudgets(writeBudgets);
+    if (counts.empty())
+    {
+        counts.push_back(1000);
+        counts.push_back(100000);
+        counts.push_back(1000000);
+    }
+
+    if (!writeBudgets && !budgets.Load(budgetsFilename))
+    {
+        std::fprintf(stderr, "Failed to read the budgets from %s\n", budgetsFilename.c_str());
+        return 2;
+    }
+
+    std::printf("%-12s %-10s %8s %12s %12s\n", "# chart", "phase", "elements",
+        "allocs/elem", "bytes/elem");
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        MeasureCharts(budgets, counts[i]);
+    }
+
+    if (budgets.GetFailures() != 0)
+    {
+        std::printf("%lu measurements exceed their budget or have none\n",
+            static_cast<unsigned long>(budgets.GetFailures()));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartactivepoints.h>
+#include <wx/sharedptr.h>
+#include <catch.hpp>
+
+TEST_CASE("wxChartActivePoints reuses the points of the previous hit test")
+{
+    wxChartActivePoints<wxSharedPtr<int> > activePoints;
+    int created = 0;
+    auto create = [&created]() { ++created; return wxSharedPtr<int>(new int(created)); };
+
+    activePoints.Begin();
+    const int* first = activePoints.Add(0, 3, create).get();
+    const int* second = activePoints.Add(1, 3, create).get();
+    REQUIRE(created == 2);
+
+    activePoints.Begin();
+    CHECK(activePoints.Add(0, 3, create).get() == first);
+    CHECK(activePoints.Add(1, 3, create).get() == second);
+    CHECK(created == 2);
+
+    activePoints.Begin();
+    CHECK(activePoints.Add(0, 4, create).get() != first);
+    CHECK(created == 3);
+}
+
+TEST_CASE("wxChartActivePoints Invalidate")
+{
+    wxChartActivePoints<wxSharedPtr<int> > activePoints;
+    int created = 0;
+    auto create = [&created]() { ++created; return wxSharedPtr<int>(new int(created)); };
+
+    activePoints.Begin();
+    activePoints.Add(0, 3, create);
+    activePoints.Invalidate();
+
+    activePoints.Begin();
+    activePoints.Add(0, 3, create);
+    CHECK(created == 2);
+
+    // Only the next hit test is affected
+    activePoints.Begin();
+    activePoints.Add(0, 3, create);
+    CHECK(created == 2);
+}
+
+TEST_CASE("wxChartActivePoints reuses many points in any order")
+{
+    wxChartActivePoints<wxSharedPtr<size_t> > activePoints;
+    size_t created = 0;
+    auto create = [&created]() { ++created; return wxSharedPtr<size_t>(new size_t(created)); };
+
+    const size_t count = 5000;
+    activePoints.Begin();
+    for (size_t i = 0; i < count; ++i)
+    {
+        activePoints.Add(i % 3, i, create);
+    }
+    REQUIRE(created == count);
+
+    // The same points in the reverse order and one new point
+    activePoints.Begin();
+    for (size_t i = count; i > 0; --i)
+    {
+        CHECK(*activePoints.Add((i - 1) % 3, i - 1, create) == i);
+    }
+    activePoints.Add(1, 0, create);
+    CHECK(created == (count + 1));
+}
@@ -0,0 +1,86 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartcategoricalaxis.h>
+#include <catch.hpp>
+#include <wx/image.h>
+#include <sstream>
+
+TEST_CASE("wxChartCategoricalAxis lazy labels are only created for the labelled tick marks")
+{
+    size_t calls = 0;
+    wxChartAxisOptions options(wxCHARTAXISPOSITION_BOTTOM);
+    wxChartAxis::ptr axis = wxChartCategoricalAxis::make_shared("x", 100000,
+        [&calls](size_t index)
+        {
+            ++calls;
+            std::stringstream label;
+            label << index;
+            return wxString(label.str());
+        },
+        options);
+    axis->Fit(wxPoint2DDouble(0, 0), wxPoint2DDouble(1000, 0));
+
+    wxImage image;
+    wxGraphicsContext* gc = wxGraphicsContext::Create(image);
+    axis->UpdateLabelSizes(*gc);
+    delete gc;
+
+    REQUIRE(axis->HasLazyLabels());
+    CHECK(axis->GetNumberOfTickMarks() == 100000);
+    CHECK(axis->GetLabels().size() > 1);
+    CHECK(axis->GetLabels().size() < 100);
+    CHECK(calls < 1000);
+
+    // The labels don't overlap
+    size_t first = axis->GetNextShownTickMark(0);
+    size_t second = axis->GetNextShownTickMark(first + 1);
+    wxDouble spacing = axis->GetTickMarkPosition(second).m_x - axis->GetTickMarkPosition(first).m_x;
+    CHECK(spacing >= axis->GetLabels().GetMaxWidth());
+    CHECK(axis->GetLabels()[0].GetText() == "0");
+}
+
+TEST_CASE("wxChartCategoricalAxis lazy labels follow the tick marks as they scroll")
+{
+    wxChartAxisOptions options(wxCHARTAXISPOSITION_BOTTOM);
+    wxChartAxis::ptr axis = wxChartCategoricalAxis::make_shared("x", 1000,
+        [](size_t index) { return wxString(); }, options);
+    axis->Fit(wxPoint2DDouble(0, 0), wxPoint2DDouble(100, 0));
+
+    wxImage image;
+    wxGraphicsContext* gc = wxGraphicsContext::Create(image);
+    axis->UpdateLabelSizes(*gc);
+    delete gc;
+
+    size_t first = axis->GetNextShownTickMark(0);
+    size_t stride = axis->GetNextShownTickMark(first + 1) - first;
+    REQUIRE(stride > 1);
+
+    // Appending doesn't move the labelled tick marks and removing
+    // shifts them by the number of tick marks removed
+    axis->AppendTickMarks(10);
+    CHECK(axis->GetNumberOfTickMarks() == 1010);
+    CHECK(axis->GetNextShownTickMark(0) == first);
+    axis->RemoveFirstTickMarks(1);
+    CHECK(axis->GetNumberOfTickMarks() == 1009);
+    CHECK(axis->GetNextShownTickMark(0) == (stride - 1));
+}
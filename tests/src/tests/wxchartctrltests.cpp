@@ -0,0 +1,93 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+
+#include <wx/charts/wxmath2dplotctrl.h>
+#include <catch.hpp>
+#include <wx/frame.h>
+
+// Counts how many times the chart lays out its parent
+class wxChartCtrlTestFrame : public wxFrame
+{
+public:
+    wxChartCtrlTestFrame()
+        : wxFrame(NULL, wxID_ANY, "wxChartCtrl tests"), m_layoutCount(0)
+    {
+    }
+
+    virtual bool Layout()
+    {
+        ++m_layoutCount;
+        return wxFrame::Layout();
+    }
+
+    int m_layoutCount;
+};
+
+TEST_CASE("wxChartCtrl coalesces refreshes when a frame is due")
+{
+    wxChartCtrlTestFrame* frame = new wxChartCtrlTestFrame();
+    wxMath2DPlotCtrl* ctrl = new wxMath2DPlotCtrl(frame, wxID_ANY, wxMath2DPlotData());
+    // Long enough for the test not to depend on how
+    // fast it runs
+    ctrl->SetFrameInterval(3600000);
+    wxChartGridOptions options = ctrl->GetGridOptions();
+
+    // Each change of the options lays out the parent. Nothing
+    // was refreshed yet so the first change is flushed and the
+    // others wait for the next frame.
+    frame->m_layoutCount = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        ctrl->SetGridOptions(options);
+    }
+    CHECK(frame->m_layoutCount == 1);
+
+    frame->Destroy();
+}
+
+TEST_CASE("wxChartCtrl refreshes each time without a frame interval")
+{
+    wxChartCtrlTestFrame* frame = new wxChartCtrlTestFrame();
+    wxMath2DPlotCtrl* ctrl = new wxMath2DPlotCtrl(frame, wxID_ANY, wxMath2DPlotData());
+    ctrl->SetFrameInterval(0);
+    wxChartGridOptions options = ctrl->GetGridOptions();
+
+    frame->m_layoutCount = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        ctrl->SetGridOptions(options);
+    }
+    CHECK(frame->m_layoutCount == 3);
+
+    {
+        wxChartCtrlUpdateLocker locker(*ctrl);
+        for (int i = 0; i < 3; ++i)
+        {
+            ctrl->SetGridOptions(options);
+        }
+        CHECK(frame->m_layoutCount == 3);
+    }
+    CHECK(frame->m_layoutCount == 4);
+
+    frame->Destroy();
+}
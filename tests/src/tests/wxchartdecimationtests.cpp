@@ -0,0 +1,67 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxcharts.h>
+#include <catch.hpp>
+
+TEST_CASE("wxChartDecimation MinMax keeps the extrema of each column")
+{
+    wxVector<wxPoint2DDouble> points;
+    points.push_back(wxPoint2DDouble(10.1, 5));
+    points.push_back(wxPoint2DDouble(10.2, 1));
+    points.push_back(wxPoint2DDouble(10.3, 3));
+    points.push_back(wxPoint2DDouble(10.4, 9));
+    points.push_back(wxPoint2DDouble(10.5, 4));
+    points.push_back(wxPoint2DDouble(11.5, 2));
+
+    wxVector<wxPoint2DDouble> result;
+    wxChartDecimation::MinMax(points, result);
+
+    REQUIRE(result.size() == 5);
+    REQUIRE(result[0].m_y == 5);
+    REQUIRE(result[1].m_y == 1);
+    REQUIRE(result[2].m_y == 9);
+    REQUIRE(result[3].m_y == 4);
+    REQUIRE(result[4].m_y == 2);
+}
+
+TEST_CASE("wxChartDecimation LTTB keeps the first and last points")
+{
+    wxVector<wxPoint2DDouble> points;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        points.push_back(wxPoint2DDouble(i * 0.1, (i == 500) ? 100 : 0));
+    }
+
+    wxVector<wxPoint2DDouble> result;
+    wxChartDecimation::LTTB(points, 20, result);
+
+    REQUIRE(result.size() == 20);
+    REQUIRE(result[0].m_x == points[0].m_x);
+    REQUIRE(result[19].m_x == points[999].m_x);
+    bool foundPeak = false;
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        foundPeak |= (result[i].m_y == 100);
+    }
+    REQUIRE(foundPeak);
+}
@@ -45,3 +45,13 @@ TEST_CASE("wxChartFontOptions copy constructor")
     REQUIRE(optionsCopy.GetWeight() == wxFONTWEIGHT_NORMAL);
     REQUIRE(optionsCopy.GetColor() == 0x666666);
 }
+
+TEST_CASE("wxChartFontOptions comparison")
+{
+    wxChartFontOptions options(wxFONTFAMILY_SWISS, 12, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, 0x666666);
+    wxChartFontOptions sameOptions(wxFONTFAMILY_SWISS, 12, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, 0x666666);
+    wxChartFontOptions biggerOptions(wxFONTFAMILY_SWISS, 14, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, 0x666666);
+
+    REQUIRE(options == sameOptions);
+    REQUIRE(options != biggerOptions);
+}
@@ -0,0 +1,97 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartingestionqueue.h>
+#include <catch.hpp>
+#include <thread>
+
+TEST_CASE("wxChartIngestionQueue rejects the values that don't fit")
+{
+    wxChartIngestionQueue<int> queue(5);
+    CHECK(queue.GetCapacity() == 8);
+
+    wxVector<int> values;
+    for (int i = 0; i < 6; ++i)
+    {
+        values.push_back(i);
+    }
+    CHECK(queue.Push(values) == 6);
+    CHECK(queue.Push(values) == 2);
+    CHECK(!queue.Push(100));
+    CHECK(queue.GetSize() == 8);
+
+    wxVector<int> popped;
+    CHECK(queue.Pop(popped, 7) == 7);
+    REQUIRE(popped.size() == 7);
+    CHECK(popped[5] == 5);
+    CHECK(popped[6] == 0);
+
+    // The values wrap around the end of the buffer
+    CHECK(queue.Push(values) == 6);
+    popped.clear();
+    CHECK(queue.Pop(popped) == 7);
+    REQUIRE(popped.size() == 7);
+    CHECK(popped[0] == 1);
+    CHECK(popped[1] == 0);
+    CHECK(popped[6] == 5);
+    CHECK(queue.GetSize() == 0);
+}
+
+TEST_CASE("wxChartIngestionQueue transfers values between threads in order")
+{
+    const size_t count = 1000000;
+    wxChartIngestionQueue<size_t> queue(1024);
+
+    std::thread producer([&queue, count]()
+    {
+        size_t values[64];
+        size_t next = 0;
+        while (next < count)
+        {
+            size_t batchSize = 0;
+            while ((batchSize < 64) && ((next + batchSize) < count))
+            {
+                values[batchSize] = next + batchSize;
+                ++batchSize;
+            }
+            next += queue.Push(values, batchSize);
+        }
+    });
+
+    bool ordered = true;
+    size_t received = 0;
+    wxVector<size_t> popped;
+    while (received < count)
+    {
+        popped.clear();
+        queue.Pop(popped);
+        for (size_t i = 0; i < popped.size(); ++i)
+        {
+            ordered = ordered && (popped[i] == (received + i));
+        }
+        received += popped.size();
+    }
+    producer.join();
+
+    CHECK(ordered);
+    CHECK(received == count);
+}
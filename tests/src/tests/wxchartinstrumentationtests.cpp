@@ -0,0 +1,145 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartinstrumentation.h>
+#include <catch.hpp>
+#include <sstream>
+
+TEST_CASE("wxChartInstrumentation only counts when enabled")
+{
+    wxChartInstrumentation instrumentation;
+    CHECK(!instrumentation.IsEnabled());
+
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_GRID);
+        instrumentation.AddPrimitives(wxCHARTSTAGE_GRID, 10);
+    }
+    instrumentation.EndFrame();
+    CHECK(instrumentation.GetFrameCount() == 0);
+    CHECK(instrumentation.GetTotal(wxCHARTSTAGE_GRID).GetCalls() == 0);
+    CHECK(instrumentation.GetTotal(wxCHARTSTAGE_GRID).GetPrimitives() == 0);
+
+    instrumentation.Enable();
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_GRID);
+        instrumentation.AddPrimitives(wxCHARTSTAGE_GRID, 10);
+    }
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_DATASETS);
+        instrumentation.AddPoints(wxCHARTSTAGE_DATASETS, 1000, 200);
+    }
+    instrumentation.EndFrame();
+
+    CHECK(instrumentation.GetFrameCount() == 1);
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_GRID).GetCalls() == 1);
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_GRID).GetPrimitives() == 10);
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_GRID).GetTime() >= 0);
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_DATASETS).GetPointsConsidered() == 1000);
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_DATASETS).GetPointsDrawn() == 200);
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_TOOLTIPS).GetCalls() == 0);
+}
+
+TEST_CASE("wxChartInstrumentation keeps the last frame and the totals")
+{
+    wxChartInstrumentation instrumentation;
+    instrumentation.Enable();
+
+    for (size_t i = 1; i <= 3; ++i)
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_HITTEST);
+        instrumentation.AddPoints(wxCHARTSTAGE_HITTEST, i, 0);
+    }
+    instrumentation.EndFrame();
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_HITTEST);
+        instrumentation.AddPoints(wxCHARTSTAGE_HITTEST, 4, 0);
+    }
+    instrumentation.EndFrame();
+
+    CHECK(instrumentation.GetFrameCount() == 2);
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_HITTEST).GetCalls() == 1);
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_HITTEST).GetPointsConsidered() == 4);
+    CHECK(instrumentation.GetTotal(wxCHARTSTAGE_HITTEST).GetCalls() == 4);
+    CHECK(instrumentation.GetTotal(wxCHARTSTAGE_HITTEST).GetPointsConsidered() == 10);
+
+    instrumentation.Reset();
+    CHECK(instrumentation.GetFrameCount() == 0);
+    CHECK(instrumentation.GetTotal(wxCHARTSTAGE_HITTEST).GetCalls() == 0);
+}
+
+TEST_CASE("wxChartInstrumentation ignores the discarded scopes")
+{
+    wxChartInstrumentation instrumentation;
+    instrumentation.Enable();
+
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_INGEST);
+        scope.Discard();
+    }
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_INGEST);
+    }
+    instrumentation.EndFrame();
+
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_INGEST).GetCalls() == 1);
+}
+
+TEST_CASE("wxChartInstrumentation attributes the recorded allocations")
+{
+    wxChartInstrumentation instrumentation;
+    instrumentation.Enable();
+
+    wxChartInstrumentation::RecordAllocation();
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_INGEST);
+        wxChartInstrumentation::RecordAllocation();
+        wxChartInstrumentation::RecordAllocation();
+    }
+    instrumentation.EndFrame();
+
+    CHECK(instrumentation.GetLastFrame(wxCHARTSTAGE_INGEST).GetAllocations() == 2);
+}
+
+TEST_CASE("wxChartInstrumentation writes the trace events")
+{
+    wxChartInstrumentation instrumentation;
+    instrumentation.Enable();
+    instrumentation.StartTrace(1);
+    CHECK(instrumentation.IsTracing());
+
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_GRID);
+    }
+    {
+        wxChartInstrumentation::Scope scope(instrumentation, wxCHARTSTAGE_DATASETS);
+    }
+    instrumentation.StopTrace();
+    CHECK(!instrumentation.IsTracing());
+
+    std::stringstream stream;
+    instrumentation.WriteTrace(stream);
+    std::string trace = stream.str();
+    CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+    CHECK(trace.find("\"name\":\"grid\"") != std::string::npos);
+    CHECK(trace.find("\"ph\":\"X\"") != std::string::npos);
+    CHECK(trace.find("\"name\":\"datasets\"") == std::string::npos);
+}
@@ -0,0 +1,158 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartminmaxpyramid.h>
+#include <catch.hpp>
+#include <cstdlib>
+
+namespace
+{
+    wxVector<wxDouble> CreateValues(size_t count)
+    {
+        wxVector<wxDouble> values;
+        std::srand(42);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values.push_back(std::rand() % 1000);
+        }
+        return values;
+    }
+
+    void FindMinMaxBruteForce(const wxVector<wxDouble> &values, size_t first,
+        size_t last, wxDouble &minValue, wxDouble &maxValue)
+    {
+        minValue = maxValue = values[first];
+        for (size_t i = first + 1; i < last; ++i)
+        {
+            if (values[i] < minValue)
+            {
+                minValue = values[i];
+            }
+            if (values[i] > maxValue)
+            {
+                maxValue = values[i];
+            }
+        }
+    }
+}
+
+TEST_CASE("wxChartMinMaxPyramid finds the same extremes as a full scan")
+{
+    wxVector<wxDouble> values = CreateValues(5000);
+    wxChartMinMaxPyramid::Accessor accessor = [&values](size_t index) { return values[index]; };
+
+    wxChartMinMaxPyramid pyramid(4);
+    pyramid.Update(0, values.size(), accessor);
+    CHECK(pyramid.GetNumberOfLevels() == 6);
+
+    for (size_t first = 0; first < values.size(); first += 37)
+    {
+        for (size_t last = first + 1; last <= values.size(); last += 113)
+        {
+            size_t minIndex = 0;
+            size_t maxIndex = 0;
+            pyramid.FindMinMax(first, last, accessor, minIndex, maxIndex);
+            wxDouble minValue = 0;
+            wxDouble maxValue = 0;
+            FindMinMaxBruteForce(values, first, last, minValue, maxValue);
+            REQUIRE(values[minIndex] == minValue);
+            REQUIRE(values[maxIndex] == maxValue);
+            REQUIRE(minIndex >= first);
+            REQUIRE(minIndex < last);
+            REQUIRE(maxIndex >= first);
+            REQUIRE(maxIndex < last);
+        }
+    }
+}
+
+TEST_CASE("wxChartMinMaxPyramid can be updated incrementally")
+{
+    wxVector<wxDouble> values = CreateValues(3000);
+    wxChartMinMaxPyramid::Accessor accessor = [&values](size_t index) { return values[index]; };
+
+    // The start moves forward like a series with a
+    // retention window
+    wxChartMinMaxPyramid pyramid(8);
+    size_t start = 0;
+    for (size_t end = 1; end <= values.size(); end += 7)
+    {
+        if (end > 500)
+        {
+            start = end - 500;
+        }
+        pyramid.Update(start, end, accessor);
+    }
+    CHECK(pyramid.GetStart() == start);
+    CHECK(pyramid.GetEnd() == 2997);
+
+    wxChartMinMaxPyramid rebuilt(8);
+    rebuilt.Update(start, pyramid.GetEnd(), accessor);
+    for (size_t first = start; first < pyramid.GetEnd(); first += 11)
+    {
+        size_t minIndex1 = 0;
+        size_t maxIndex1 = 0;
+        pyramid.FindMinMax(first, pyramid.GetEnd(), accessor, minIndex1, maxIndex1);
+        size_t minIndex2 = 0;
+        size_t maxIndex2 = 0;
+        rebuilt.FindMinMax(first, pyramid.GetEnd(), accessor, minIndex2, maxIndex2);
+        REQUIRE(values[minIndex1] == values[minIndex2]);
+        REQUIRE(values[maxIndex1] == values[maxIndex2]);
+    }
+}
+
+TEST_CASE("wxChartMinMaxPyramid keeps the first, minimum, maximum and last value of each column")
+{
+    wxVector<wxDouble> values;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        values.push_back(10);
+    }
+    values[3] = 0;
+    values[7] = 50;
+    values[12] = 80;
+    values[15] = -5;
+    wxChartMinMaxPyramid::Accessor accessor = [&values](size_t index) { return values[index]; };
+
+    wxChartMinMaxPyramid pyramid(4);
+    pyramid.Update(0, values.size(), accessor);
+
+    wxVector<size_t> boundaries;
+    boundaries.push_back(0);
+    boundaries.push_back(1);
+    boundaries.push_back(10);
+    boundaries.push_back(19);
+    boundaries.push_back(20);
+    wxVector<size_t> indices;
+    pyramid.Decimate(boundaries, accessor, indices);
+
+    REQUIRE(indices.size() == 10);
+    CHECK(indices[0] == 0);
+    CHECK(indices[1] == 1);
+    CHECK(indices[2] == 3);
+    CHECK(indices[3] == 7);
+    CHECK(indices[4] == 9);
+    CHECK(indices[5] == 10);
+    CHECK(indices[6] == 12);
+    CHECK(indices[7] == 15);
+    CHECK(indices[8] == 18);
+    CHECK(indices[9] == 19);
+}
@@ -0,0 +1,51 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartnumericalaxis.h>
+#include <catch.hpp>
+
+TEST_CASE("wxChartNumericalAxis UpdateRange keeps the labels for the same grid range")
+{
+    wxChartAxisOptions options(wxCHARTAXISPOSITION_LEFT);
+    wxChartNumericalAxis axis("y", 1, 99, options);
+
+    wxDouble minValue = axis.GetMinValue();
+    wxDouble maxValue = axis.GetMaxValue();
+    size_t numberOfLabels = axis.GetLabels().size();
+
+    // A slightly different range snaps to the same round values
+    REQUIRE(!axis.UpdateRange(2, 98));
+    CHECK(axis.GetMinValue() == minValue);
+    CHECK(axis.GetMaxValue() == maxValue);
+    CHECK(axis.GetLabels().size() == numberOfLabels);
+}
+
+TEST_CASE("wxChartNumericalAxis UpdateRange rebuilds the labels for a new grid range")
+{
+    wxChartAxisOptions options(wxCHARTAXISPOSITION_LEFT);
+    wxChartNumericalAxis axis("y", 0, 100, options);
+
+    REQUIRE(axis.UpdateRange(1000, 5000));
+    CHECK(axis.GetMinValue() <= 1000);
+    CHECK(axis.GetMaxValue() >= 5000);
+    CHECK(axis.GetLabels().front().GetText() != "0");
+}
@@ -0,0 +1,263 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxcharts.h>
+#include <catch.hpp>
+#include <algorithm>
+
+TEST_CASE("wxChartPointSeries constructor")
+{
+    wxChartPointSeries points;
+
+    REQUIRE(points.GetCount() == 0);
+}
+
+TEST_CASE("wxChartPointSeries Append")
+{
+    wxVector<wxPoint2DDouble> values;
+    values.push_back(wxPoint2DDouble(1, 2));
+    values.push_back(wxPoint2DDouble(3, 4));
+
+    wxChartPointSeries points;
+    points.Append(values);
+    points.Append(5, 6);
+
+    REQUIRE(points.GetCount() == 3);
+    REQUIRE(points.GetX(1) == 3);
+    REQUIRE(points.GetY(2) == 6);
+    REQUIRE(points.GetPositions().size() == 3);
+
+    points.Clear();
+
+    REQUIRE(points.GetCount() == 0);
+    REQUIRE(points.GetPositions().size() == 0);
+}
+
+TEST_CASE("wxChartPointSeries SetMaxCount")
+{
+    wxChartPointSeries points;
+    points.SetMaxCount(3);
+
+    REQUIRE(points.Append(1, 10) == 0);
+    REQUIRE(points.Append(2, 20) == 0);
+    REQUIRE(points.Append(3, 30) == 0);
+    REQUIRE(points.Append(4, 40) == 1);
+    REQUIRE(points.Append(5, 50) == 1);
+
+    REQUIRE(points.GetCount() == 3);
+    REQUIRE(points.GetPositions().size() == 3);
+    CHECK(points.GetX(0) == 3);
+    CHECK(points.GetY(1) == 40);
+    CHECK(points.GetX(2) == 5);
+
+    points.SetMaxCount(2);
+
+    REQUIRE(points.GetCount() == 2);
+    CHECK(points.GetX(0) == 4);
+    CHECK(points.GetX(1) == 5);
+}
+
+TEST_CASE("wxChartPointSeries SetMaxXSpan")
+{
+    wxChartPointSeries points;
+    points.SetMaxXSpan(10);
+
+    for (size_t i = 0; i <= 20; ++i)
+    {
+        points.Append(i, i * 2);
+    }
+
+    REQUIRE(points.GetCount() == 11);
+    CHECK(points.GetX(0) == 10);
+    CHECK(points.GetY(10) == 40);
+
+    wxVector<wxPoint2DDouble> values;
+    values.push_back(wxPoint2DDouble(25, 0));
+    values.push_back(wxPoint2DDouble(30, 0));
+
+    REQUIRE(points.Append(values) == 10);
+    REQUIRE(points.GetCount() == 3);
+    CHECK(points.GetX(0) == 20);
+    CHECK(points.GetX(2) == 30);
+}
+
+TEST_CASE("wxChartPointSeries FindInXRange of a subset")
+{
+    wxChartPointSeries points;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        points.Append(i, 0);
+        points.SetPosition(i, wxPoint2DDouble(i * 2, 0));
+    }
+
+    // Only the positions of the points of the subset are read
+    wxVector<size_t> subset;
+    for (size_t i = 0; i < 100; i += 10)
+    {
+        subset.push_back(i);
+    }
+
+    wxVector<size_t> indices;
+    points.FindInXRange(subset, 40, 80, indices);
+    REQUIRE(indices.size() == 3);
+    CHECK(indices[0] == 20);
+    CHECK(indices[1] == 30);
+    CHECK(indices[2] == 40);
+
+    indices.clear();
+    points.FindInXRange(subset, 41, 59, indices);
+    CHECK(indices.empty());
+    points.FindInXRange(subset, 300, 400, indices);
+    CHECK(indices.empty());
+}
+
+TEST_CASE("wxChartPointSeries GetExtents")
+{
+    wxChartPointSeries points;
+    points.SetMaxCount(4);
+
+    wxDouble minX = 0;
+    wxDouble maxX = 0;
+    wxDouble minY = 0;
+    wxDouble maxY = 0;
+    CHECK(!points.GetExtents(minX, maxX, minY, maxY));
+
+    // The buffer wraps around after the sixth point
+    for (size_t i = 0; i < 6; ++i)
+    {
+        points.Append(i, 10.0 - i);
+    }
+
+    REQUIRE(points.GetExtents(minX, maxX, minY, maxY));
+    CHECK(minX == 2);
+    CHECK(maxX == 5);
+    CHECK(minY == 5);
+    CHECK(maxY == 8);
+
+    points.SetExtentsTransforms(std::function<wxDouble(wxDouble)>(),
+        [](wxDouble value) { return 2 * value; });
+
+    REQUIRE(points.GetExtents(minX, maxX, minY, maxY));
+    CHECK(minX == 2);
+    CHECK(maxX == 5);
+    CHECK(minY == 10);
+    CHECK(maxY == 16);
+
+    points.Clear();
+
+    CHECK(!points.GetExtents(minX, maxX, minY, maxY));
+}
+
+TEST_CASE("wxChartPointSeries RemoveBeforeX updates the extents")
+{
+    wxChartPointSeries points;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        points.Append(i, 10.0 - i);
+    }
+
+    // The points with the largest Y value and the
+    // smallest X value are removed
+    CHECK(points.RemoveBeforeX(2) == 2);
+    CHECK(points.GetCount() == 3);
+
+    wxDouble minX = 0;
+    wxDouble maxX = 0;
+    wxDouble minY = 0;
+    wxDouble maxY = 0;
+    REQUIRE(points.GetExtents(minX, maxX, minY, maxY));
+    CHECK(minX == 2);
+    CHECK(maxX == 4);
+    CHECK(minY == 6);
+    CHECK(maxY == 8);
+
+    CHECK(points.RemoveBeforeX(5) == 3);
+    CHECK(!points.GetExtents(minX, maxX, minY, maxY));
+}
+
+TEST_CASE("wxChartPointSeries keeps the extents of the retention window")
+{
+    wxChartPointSeries countPoints;
+    countPoints.SetMaxCount(50);
+    wxChartPointSeries spanPoints;
+    spanPoints.SetMaxXSpan(30);
+    wxChartPointSeries allPoints;
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        // Mix slow trends with jumps so that the extremes are
+        // sometimes the oldest points of the window
+        wxDouble y = ((i * 7919) % 101) + ((i / 200) % 2 ? 100.0 : -100.0);
+        countPoints.Append(i, y);
+        spanPoints.Append(i, y);
+        allPoints.Append(i, y);
+
+        wxChartPointSeries* series[] = { &countPoints, &spanPoints, &allPoints };
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const wxChartPointSeries& points = *series[j];
+            wxDouble expectedMinY = points.GetY(0);
+            wxDouble expectedMaxY = points.GetY(0);
+            for (size_t k = 1; k < points.GetCount(); ++k)
+            {
+                expectedMinY = std::min(expectedMinY, points.GetY(k));
+                expectedMaxY = std::max(expectedMaxY, points.GetY(k));
+            }
+
+            wxDouble minX = 0;
+            wxDouble maxX = 0;
+            wxDouble minY = 0;
+            wxDouble maxY = 0;
+            REQUIRE(points.GetExtents(minX, maxX, minY, maxY));
+            REQUIRE(minX == points.GetX(0));
+            REQUIRE(maxX == i);
+            REQUIRE(minY == expectedMinY);
+            REQUIRE(maxY == expectedMaxY);
+        }
+    }
+}
+
+TEST_CASE("wxChartPointSeries keeps the pyramid in sync with the retained points")
+{
+    wxChartPointSeries points;
+    points.SetMaxCount(100);
+    points.SetUseMinMaxPyramid(true);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        points.Append(i, static_cast<wxDouble>((i * 37) % 101));
+    }
+
+    REQUIRE(points.GetCount() == 100);
+    size_t minIndex = 0;
+    size_t maxIndex = 0;
+    points.FindMinMaxY(10, 90, minIndex, maxIndex);
+
+    wxDouble minY = points.GetY(10);
+    wxDouble maxY = points.GetY(10);
+    for (size_t i = 11; i < 90; ++i)
+    {
+        minY = std::min(minY, points.GetY(i));
+        maxY = std::max(maxY, points.GetY(i));
+    }
+    CHECK(points.GetY(minIndex) == minY);
+    CHECK(points.GetY(maxIndex) == maxY);
+}
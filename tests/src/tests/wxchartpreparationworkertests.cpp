@@ -0,0 +1,129 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartpreparationworker.h>
+#include <catch.hpp>
+#include <atomic>
+
+TEST_CASE("wxChartPreparationWorker publishes the snapshot of a job")
+{
+    std::atomic<int> callbackCount(0);
+    wxChartPreparationWorker worker;
+    worker.SetCallback([&callbackCount]() { ++callbackCount; });
+    CHECK(!worker.GetSnapshot());
+
+    unsigned long generation = worker.Submit(
+        [](wxChartRenderSnapshot &snapshot, const std::atomic<bool> &cancelled)
+        {
+            wxChartRenderSnapshot::Series& series = snapshot.AddSeries();
+            series.GetMarkers().push_back(wxPoint2DDouble(10, 20));
+            series.GetMarkers().push_back(wxPoint2DDouble(30, 40));
+            series.GetMarkerIndices().push_back(5);
+            series.GetMarkerIndices().push_back(6);
+            series.BuildIndex();
+        });
+    worker.Wait();
+
+    wxChartRenderSnapshot::ptr snapshot = worker.GetSnapshot();
+    REQUIRE(snapshot);
+    CHECK(snapshot->GetGeneration() == generation);
+    CHECK(worker.GetGeneration() == generation);
+    CHECK(callbackCount == 1);
+    REQUIRE(snapshot->GetSeriesCount() == 1);
+
+    wxVector<size_t> markers;
+    snapshot->GetSeries(0).FindInXRange(25, 35, markers);
+    REQUIRE(markers.size() == 1);
+    CHECK(snapshot->GetSeries(0).GetMarkerIndices()[markers[0]] == 6);
+}
+
+TEST_CASE("wxChartPreparationWorker discards the jobs that are superseded")
+{
+    std::atomic<bool> started(false);
+    std::atomic<bool> released(false);
+    std::atomic<int> runCount(0);
+    wxChartPreparationWorker worker;
+
+    // The first job blocks the worker until the
+    // other jobs have been submitted
+    worker.Submit(
+        [&](wxChartRenderSnapshot &snapshot, const std::atomic<bool> &cancelled)
+        {
+            started = true;
+            while (!released)
+            {
+                std::this_thread::yield();
+            }
+            ++runCount;
+        });
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+
+    worker.Submit([&](wxChartRenderSnapshot &snapshot, const std::atomic<bool> &cancelled) { ++runCount; });
+    unsigned long last = worker.Submit([&](wxChartRenderSnapshot &snapshot, const std::atomic<bool> &cancelled) { ++runCount; });
+    released = true;
+    worker.Wait();
+
+    CHECK(runCount == 2);
+    REQUIRE(worker.GetSnapshot());
+    CHECK(worker.GetSnapshot()->GetGeneration() == last);
+}
+
+TEST_CASE("wxChartPreparationWorker cancels the running job")
+{
+    std::atomic<bool> started(false);
+    std::atomic<bool> sawCancellation(false);
+    std::atomic<int> callbackCount(0);
+    wxChartPreparationWorker worker;
+    worker.SetCallback([&callbackCount]() { ++callbackCount; });
+
+    // The first job runs until it is cancelled by
+    // the submission of the second one
+    unsigned long first = worker.Submit(
+        [&](wxChartRenderSnapshot &snapshot, const std::atomic<bool> &cancelled)
+        {
+            started = true;
+            while (!cancelled)
+            {
+                std::this_thread::yield();
+            }
+            sawCancellation = true;
+            snapshot.AddSeries();
+        });
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+
+    unsigned long second = worker.Submit(
+        [](wxChartRenderSnapshot &snapshot, const std::atomic<bool> &cancelled) {});
+    worker.Wait();
+
+    CHECK(sawCancellation);
+    CHECK(first != second);
+    CHECK(callbackCount == 1);
+    REQUIRE(worker.GetSnapshot());
+    CHECK(worker.GetSnapshot()->GetGeneration() == second);
+    CHECK(worker.GetSnapshot()->GetSeriesCount() == 0);
+}
@@ -23,9 +23,137 @@
 #include <wx/charts/wxcharts.h>
 #include <catch.hpp>
 
+namespace
+{
+    class TestObserver : public wxChartsCategoricalDataObserver
+    {
+    public:
+        TestObserver() : valueChanges(0), categoryAppends(0),
+            datasetAdds(0), datasetRemovals(0), lastIndex(0), lastOldValue(0)
+        {
+        }
+
+        void OnValueChanged(const wxChartsCategoricalData &data,
+            size_t datasetIndex, size_t index, wxDouble oldValue) override
+        {
+            ++valueChanges;
+            lastIndex = index;
+            lastOldValue = oldValue;
+        }
+
+        void OnCategoryAppended(const wxChartsCategoricalData &data) override
+        {
+            ++categoryAppends;
+        }
+
+        void OnDatasetAdded(const wxChartsCategoricalData &data,
+            size_t datasetIndex) override
+        {
+            ++datasetAdds;
+            lastIndex = datasetIndex;
+        }
+
+        void OnDatasetRemoved(const wxChartsCategoricalData &data,
+            size_t datasetIndex) override
+        {
+            ++datasetRemovals;
+            lastIndex = datasetIndex;
+        }
+
+        int valueChanges;
+        int categoryAppends;
+        int datasetAdds;
+        int datasetRemovals;
+        size_t lastIndex;
+        wxDouble lastOldValue;
+    };
+
+    wxChartsDoubleDataset::ptr CreateDataset(const wxVector<wxDouble> &values)
+    {
+        return wxChartsDoubleDataset::ptr(new wxChartsDoubleDataset(*wxRED, *wxRED, values));
+    }
+}
+
 TEST_CASE("wxChartsCategoricalData constructor")
 {
     wxChartsCategoricalData data({});
 
     REQUIRE(data.GetCategories().size() == 0);
 }
+
+TEST_CASE("wxChartsCategoricalData notifies its observers")
+{
+    wxVector<wxString> categories;
+    categories.push_back("a");
+    categories.push_back("b");
+    wxChartsCategoricalData data(categories);
+
+    TestObserver observer;
+    data.AddObserver(&observer);
+
+    wxVector<wxDouble> values;
+    values.push_back(1);
+    values.push_back(2);
+    data.AddDataset(CreateDataset(values));
+    CHECK(observer.datasetAdds == 1);
+    CHECK(observer.lastIndex == 0);
+
+    data.SetValue(0, 1, 5);
+    CHECK(observer.valueChanges == 1);
+    CHECK(observer.lastIndex == 1);
+    CHECK(observer.lastOldValue == 2);
+    CHECK(data.GetDatasets()[0]->GetData()[1] == 5);
+
+    // Setting the same value again isn't a change
+    data.SetValue(0, 1, 5);
+    CHECK(observer.valueChanges == 1);
+
+    wxVector<wxDouble> newValues(1, 3);
+    data.AppendCategory("c", newValues);
+    CHECK(observer.categoryAppends == 1);
+    REQUIRE(data.GetCategories().size() == 3);
+    REQUIRE(data.GetDatasets()[0]->GetData().size() == 3);
+    CHECK(data.GetDatasets()[0]->GetData()[2] == 3);
+
+    data.RemoveDataset(0);
+    CHECK(observer.datasetRemovals == 1);
+    CHECK(data.GetDatasets().empty());
+
+    // Removed observers aren't notified
+    data.RemoveObserver(&observer);
+    data.AddDataset(CreateDataset(values));
+    CHECK(observer.datasetAdds == 1);
+}
+
+TEST_CASE("wxChartsCategoricalData updates the charts")
+{
+    wxVector<wxString> categories;
+    categories.push_back("a");
+    categories.push_back("b");
+    wxChartsCategoricalData::ptr data = wxChartsCategoricalData::make_shared(categories);
+    wxVector<wxDouble> values;
+    values.push_back(1);
+    values.push_back(2);
+    data->AddDataset(CreateDataset(values));
+
+    wxColumnChart columnChart(data, wxSize(400, 300));
+    wxStackedBarChart stackedBarChart(data, wxSize(400, 300));
+    data->AddObserver(&columnChart);
+    data->AddObserver(&stackedBarChart);
+
+    data->SetValue(0, 0, 10);
+    wxVector<wxDouble> newValues(1, 4);
+    data->AppendCategory("c", newValues);
+    data->AddDataset(CreateDataset(wxVector<wxDouble>(3, 2)));
+    data->RemoveDataset(1);
+    data->RemoveDataset(0);
+
+    // The charts can still be drawn without datasets
+    wxImage image;
+    CHECK(columnChart.RenderTo(image, wxSize(400, 300)));
+    CHECK(stackedBarChart.RenderTo(image, wxSize(400, 300)));
+
+    data->RemoveObserver(&columnChart);
+    data->RemoveObserver(&stackedBarChart);
+    CHECK(data->GetDatasets().empty());
+}
@@ -0,0 +1,204 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartscolumnarfile.h>
+#include <catch.hpp>
+#include <algorithm>
+#include <limits>
+#include <stdio.h>
+
+namespace
+{
+    const char* TestFilename = "wxchartscolumnarfiletests.bin";
+
+    void WriteTestFile(size_t count)
+    {
+        wxVector<wxString> names;
+        names.push_back("time");
+        names.push_back("value");
+        wxVector<wxVector<wxDouble> > columns(2);
+        for (size_t i = 0; i < count; ++i)
+        {
+            columns[0].push_back(i);
+            columns[1].push_back((i % 10) == 5 ? 100.0 : static_cast<wxDouble>(i % 7));
+        }
+        REQUIRE(wxChartsColumnarFile::Write(TestFilename, names, columns));
+    }
+}
+
+TEST_CASE("wxChartsColumnarFile Open")
+{
+    WriteTestFile(1000);
+
+    wxChartsColumnarFile file;
+    REQUIRE(file.Open(TestFilename));
+    CHECK(file.IsOpen());
+    CHECK(file.GetRowCount() == 1000);
+    REQUIRE(file.GetColumnCount() == 2);
+    CHECK(file.GetColumnName(1) == "value");
+    CHECK(file.FindColumn("value") == 1);
+    CHECK(file.FindColumn("missing") == wxNOT_FOUND);
+    CHECK((file.GetColumnFlags(0) & wxCHARTSCOLUMN_SORTED) != 0);
+    CHECK((file.GetColumnFlags(1) & wxCHARTSCOLUMN_SORTED) == 0);
+    CHECK(file.GetColumn(0)[999] == 999);
+    CHECK(file.GetColumn(1)[15] == 100);
+
+    file.Close();
+    CHECK(!file.IsOpen());
+    remove(TestFilename);
+}
+
+TEST_CASE("wxChartsColumnarFile rejects invalid files")
+{
+    wxChartsColumnarFile file;
+    CHECK(!file.Open("wxchartscolumnarfiletests_missing.bin"));
+
+    FILE *invalidFile = fopen(TestFilename, "wb");
+    REQUIRE(invalidFile);
+    fputs("not a columnar file, not a columnar file", invalidFile);
+    fclose(invalidFile);
+    CHECK(!file.Open(TestFilename));
+    CHECK(!file.IsOpen());
+    remove(TestFilename);
+}
+
+TEST_CASE("wxChartsColumnarSeries Decimate")
+{
+    WriteTestFile(10000);
+
+    wxChartsColumnarFile::ptr file(new wxChartsColumnarFile());
+    REQUIRE(file->Open(TestFilename));
+    wxChartsColumnarSeries series(file, 0, 1);
+    CHECK(series.IsXSorted());
+
+    wxDouble minX, maxX, minY, maxY;
+    REQUIRE(series.GetExtents(minX, maxX, minY, maxY));
+    CHECK(minX == 0);
+    CHECK(maxX == 9999);
+    CHECK(minY == 0);
+    CHECK(maxY == 100);
+
+    size_t begin, end;
+    series.FindXRange(100.5, 200, begin, end);
+    CHECK(begin == 101);
+    CHECK(end == 201);
+
+    // Each bucket keeps its first, minimum, maximum and
+    // last points
+    wxVector<wxPoint2DDouble> points;
+    series.Decimate(1000, 1999, 50, points);
+    REQUIRE(points.size() <= 200);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        CHECK(points[i].m_x >= 1000);
+        CHECK(points[i].m_x <= 1999);
+        if (i > 0)
+        {
+            CHECK(points[i].m_x > points[i - 1].m_x);
+        }
+    }
+    CHECK(points.front().m_x == 1000);
+    CHECK(points.back().m_x == 1999);
+    REQUIRE(points.size() >= 4);
+    CHECK(points[0].m_y == 6);
+    CHECK(points[1].m_y == 0);
+    CHECK(points[2].m_y == 100);
+
+    // Small ranges are returned as is
+    series.Decimate(10, 19, 50, points);
+    CHECK(points.size() == 10);
+
+    remove(TestFilename);
+}
+
+TEST_CASE("wxChartsColumnarSeries Decimate splits the X range evenly")
+{
+    // The points get sparser as X grows so buckets with the
+    // same number of points would cover very different ranges
+    wxVector<wxString> names;
+    names.push_back("x");
+    names.push_back("y");
+    wxVector<wxVector<wxDouble> > columns(2);
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        columns[0].push_back(static_cast<wxDouble>(i) * i);
+        columns[1].push_back(static_cast<wxDouble>(i % 13));
+    }
+    REQUIRE(wxChartsColumnarFile::Write(TestFilename, names, columns));
+
+    wxChartsColumnarFile::ptr file(new wxChartsColumnarFile());
+    REQUIRE(file->Open(TestFilename));
+    wxChartsColumnarSeries series(file, 0, 1);
+    REQUIRE(series.IsXSorted());
+
+    const wxDouble maxX = 9999.0 * 9999.0;
+    wxVector<wxPoint2DDouble> points;
+    series.Decimate(0, maxX, 10, points);
+    REQUIRE(points.size() <= 40);
+
+    // Every bucket contains points and keeps at most 4 of them
+    wxVector<size_t> bucketCounts(10, 0);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        size_t bucket = std::min(static_cast<size_t>(points[i].m_x / (maxX / 10)), static_cast<size_t>(9));
+        ++bucketCounts[bucket];
+    }
+    for (size_t i = 0; i < bucketCounts.size(); ++i)
+    {
+        CHECK(bucketCounts[i] >= 2);
+        CHECK(bucketCounts[i] <= 4);
+    }
+    CHECK(points.front().m_x == 0);
+    CHECK(points.back().m_x == maxX);
+
+    remove(TestFilename);
+}
+
+
+TEST_CASE("wxChartsColumnarSeries Decimate skips NaN X values")
+{
+    wxVector<wxString> names;
+    names.push_back("x");
+    names.push_back("y");
+    wxVector<wxVector<wxDouble> > columns(2);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        columns[0].push_back(((i % 3) == 1) ? std::numeric_limits<wxDouble>::quiet_NaN() : static_cast<wxDouble>(i));
+        columns[1].push_back(static_cast<wxDouble>(i % 7));
+    }
+    REQUIRE(wxChartsColumnarFile::Write(TestFilename, names, columns));
+
+    wxChartsColumnarFile::ptr file(new wxChartsColumnarFile());
+    REQUIRE(file->Open(TestFilename));
+    wxChartsColumnarSeries series(file, 0, 1);
+    CHECK(!series.IsXSorted());
+
+    wxVector<wxPoint2DDouble> points;
+    series.Decimate(0, 999, 10, points);
+    REQUIRE(!points.empty());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        CHECK(points[i].m_x == points[i].m_x);
+    }
+
+    remove(TestFilename);
+}
@@ -0,0 +1,102 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartsharedpoints.h>
+#include <catch.hpp>
+
+TEST_CASE("wxChartSharedPoints Append")
+{
+    wxChartSharedPoints points;
+    CHECK(points.GetCount() == 0);
+
+    // Appending one value at a time exercises the
+    // merging of the blocks
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        wxVector<wxPoint2DDouble> values;
+        values.push_back(wxPoint2DDouble(i, 2 * i));
+        points.Append(values);
+    }
+
+    REQUIRE(points.GetCount() == 1000);
+    for (size_t i = 0; i < points.GetCount(); ++i)
+    {
+        CHECK(points.GetValue(i).m_x == i);
+        CHECK(points.GetValue(i).m_y == (2 * i));
+    }
+}
+
+TEST_CASE("wxChartSharedPoints RemoveFirst")
+{
+    wxChartSharedPoints points;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        wxVector<wxPoint2DDouble> values;
+        values.push_back(wxPoint2DDouble(i, 0));
+        values.push_back(wxPoint2DDouble(i + 0.5, 0));
+        points.Append(values);
+        points.RemoveFirst(1);
+    }
+
+    REQUIRE(points.GetCount() == 100);
+    CHECK(points.GetValue(0).m_x == 50);
+    CHECK(points.GetValue(99).m_x == 99.5);
+
+    points.Clear();
+    CHECK(points.GetCount() == 0);
+}
+
+TEST_CASE("wxChartSharedPoints copies are not modified")
+{
+    wxChartSharedPoints points;
+    wxVector<wxPoint2DDouble> values;
+    values.push_back(wxPoint2DDouble(1, 10));
+    values.push_back(wxPoint2DDouble(2, 20));
+    points.Append(values);
+
+    wxChartSharedPoints copy = points;
+    points.RemoveFirst(2);
+    points.Append(values);
+    points.Append(values);
+
+    REQUIRE(copy.GetCount() == 2);
+    CHECK(copy.GetValue(0).m_y == 10);
+    CHECK(copy.GetValue(1).m_y == 20);
+    CHECK(points.GetCount() == 4);
+}
+
+TEST_CASE("wxChartSharedPoints FindFirstX")
+{
+    wxChartSharedPoints points;
+    wxVector<wxPoint2DDouble> values;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        values.push_back(wxPoint2DDouble(i * 10, 0));
+    }
+    points.Append(values);
+    points.RemoveFirst(2);
+
+    std::function<wxDouble(wxDouble)> identity = [](wxDouble x) { return x; };
+    CHECK(points.FindFirstX(0, identity) == 0);
+    CHECK(points.FindFirstX(35, identity) == 2);
+    CHECK(points.FindFirstX(1000, identity) == 8);
+}
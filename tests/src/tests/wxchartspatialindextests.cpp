@@ -0,0 +1,161 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartspatialindex.h>
+#include <catch.hpp>
+
+TEST_CASE("wxChartSpatialIndex FindInXRange sorted")
+{
+    wxVector<wxPoint2DDouble> positions;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        positions.push_back(wxPoint2DDouble(i * 10, 5));
+    }
+
+    wxChartSpatialIndex index;
+    index.Build(positions);
+
+    wxVector<size_t> indices;
+    index.FindInXRange(positions, 15, 40, indices);
+
+    REQUIRE(indices.size() == 3);
+    CHECK(indices[0] == 2);
+    CHECK(indices[1] == 3);
+    CHECK(indices[2] == 4);
+
+    indices.clear();
+    index.FindInXRange(positions, 100, 200, indices);
+
+    REQUIRE(indices.size() == 0);
+}
+
+TEST_CASE("wxChartSpatialIndex FindInXRange unsorted")
+{
+    wxVector<wxPoint2DDouble> positions;
+    positions.push_back(wxPoint2DDouble(30, 0));
+    positions.push_back(wxPoint2DDouble(10, 0));
+    positions.push_back(wxPoint2DDouble(20, 0));
+    positions.push_back(wxPoint2DDouble(0, 0));
+
+    wxChartSpatialIndex index;
+    index.Build(positions);
+
+    wxVector<size_t> indices;
+    index.FindInXRange(positions, 10, 20, indices);
+
+    REQUIRE(indices.size() == 2);
+    CHECK(indices[0] == 1);
+    CHECK(indices[1] == 2);
+}
+
+TEST_CASE("wxChartSpatialIndex ignores the points removed since it was built")
+{
+    wxVector<wxPoint2DDouble> positions;
+    positions.push_back(wxPoint2DDouble(30, 30));
+    positions.push_back(wxPoint2DDouble(10, 10));
+    positions.push_back(wxPoint2DDouble(20, 20));
+    positions.push_back(wxPoint2DDouble(0, 0));
+
+    wxChartSpatialIndex index;
+    index.Build(positions);
+    wxChartSpatialIndex withGrid;
+    withGrid.Build(positions, 10);
+
+    positions.pop_back();
+    positions.pop_back();
+
+    wxVector<size_t> indices;
+    index.FindInXRange(positions, 0, 40, indices);
+    REQUIRE(indices.size() == 2);
+    CHECK(indices[0] == 1);
+    CHECK(indices[1] == 0);
+
+    indices.clear();
+    index.FindInRadius(positions, wxPoint2DDouble(0, 0), 100, indices);
+    CHECK(indices.size() == 2);
+
+    indices.clear();
+    withGrid.FindInRadius(positions, wxPoint2DDouble(0, 0), 100, indices);
+    CHECK(indices.size() == 2);
+}
+
+TEST_CASE("wxChartSpatialIndex FindInRadius")
+{
+    wxVector<wxPoint2DDouble> positions;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        for (size_t j = 0; j < 20; ++j)
+        {
+            positions.push_back(wxPoint2DDouble(j * 10, i * 10));
+        }
+    }
+
+    wxChartSpatialIndex withGrid;
+    withGrid.Build(positions, 20);
+    wxChartSpatialIndex withoutGrid;
+    withoutGrid.Build(positions);
+
+    wxPoint2DDouble center(52, 48);
+    wxVector<size_t> expected;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        wxDouble dx = positions[i].m_x - center.m_x;
+        wxDouble dy = positions[i].m_y - center.m_y;
+        if (((dx * dx) + (dy * dy)) <= (15 * 15))
+        {
+            expected.push_back(i);
+        }
+    }
+
+    wxVector<size_t> indices;
+    withGrid.FindInRadius(positions, center, 15, indices);
+
+    REQUIRE(indices.size() == expected.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        CHECK(indices[i] == expected[i]);
+    }
+
+    indices.clear();
+    withoutGrid.FindInRadius(positions, center, 15, indices);
+
+    REQUIRE(indices.size() == expected.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        CHECK(indices[i] == expected[i]);
+    }
+}
+
+TEST_CASE("wxChartSpatialIndex Clear")
+{
+    wxVector<wxPoint2DDouble> positions;
+    positions.push_back(wxPoint2DDouble(1, 1));
+
+    wxChartSpatialIndex index;
+    index.Build(positions, 10);
+    index.Clear();
+
+    wxVector<size_t> indices;
+    index.FindInRadius(positions, wxPoint2DDouble(1, 1), 5, indices);
+
+    REQUIRE(indices.size() == 0);
+}
@@ -0,0 +1,101 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxcharttextsizecache.h>
+#include <catch.hpp>
+
+TEST_CASE("wxChartTextSizeCache Find")
+{
+    wxChartFontOptions font(wxFONTFAMILY_SWISS, 12, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, 0x666666);
+    wxChartTextSizeCache cache;
+
+    wxDouble width = 0;
+    wxDouble height = 0;
+    REQUIRE(!cache.Find(font, "label", 0, 1, width, height));
+
+    cache.Insert(font, "label", 0, 1, 30, 12);
+
+    REQUIRE(cache.GetCount() == 1);
+    REQUIRE(cache.Find(font, "label", 0, 1, width, height));
+    CHECK(width == 30);
+    CHECK(height == 12);
+
+    REQUIRE(!cache.Find(font, "other label", 0, 1, width, height));
+}
+
+TEST_CASE("wxChartTextSizeCache ignores the color")
+{
+    wxChartFontOptions font(wxFONTFAMILY_SWISS, 12, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, 0x666666);
+    wxChartFontOptions otherColor(wxFONTFAMILY_SWISS, 12, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, 0x000000);
+    wxChartFontOptions otherSize(wxFONTFAMILY_SWISS, 14, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, 0x666666);
+    wxChartTextSizeCache cache;
+    cache.Insert(font, "label", 0, 1, 30, 12);
+
+    wxDouble width = 0;
+    wxDouble height = 0;
+    REQUIRE(cache.Find(otherColor, "label", 0, 1, width, height));
+    REQUIRE(!cache.Find(otherSize, "label", 0, 1, width, height));
+}
+
+TEST_CASE("wxChartTextSizeCache depends on the scale factor")
+{
+    wxChartFontOptions font(wxFONTFAMILY_SWISS, 12, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, 0x666666);
+    wxChartTextSizeCache cache;
+    cache.Insert(font, "label", 0, 1, 30, 12);
+    cache.Insert(font, "label", 0, 2, 60, 24);
+
+    REQUIRE(cache.GetCount() == 2);
+
+    wxDouble width = 0;
+    wxDouble height = 0;
+    REQUIRE(cache.Find(font, "label", 0, 2, width, height));
+    CHECK(width == 60);
+    REQUIRE(cache.Find(font, "label", 0, 1, width, height));
+    CHECK(width == 30);
+    REQUIRE(!cache.Find(font, "label", 0, 1.5, width, height));
+}
+
+TEST_CASE("wxChartTextSizeCache SetMaxCount")
+{
+    wxChartFontOptions font(wxFONTFAMILY_SWISS, 12, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL, 0x666666);
+    wxChartTextSizeCache cache(2);
+    cache.Insert(font, "a", 0, 1, 1, 1);
+    cache.Insert(font, "b", 0, 1, 2, 1);
+
+    REQUIRE(cache.GetCount() == 2);
+
+    // The cache is emptied when it is full
+    cache.Insert(font, "c", 0, 1, 3, 1);
+
+    REQUIRE(cache.GetCount() == 1);
+
+    cache.SetMaxCount(0);
+    cache.Insert(font, "d", 0, 1, 4, 1);
+
+    REQUIRE(cache.GetCount() == 0);
+
+    cache.SetMaxCount(10);
+    cache.Insert(font, "e", 0, 1, 5, 1);
+    cache.Clear();
+
+    REQUIRE(cache.GetCount() == 0);
+}
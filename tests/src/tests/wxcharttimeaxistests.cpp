@@ -0,0 +1,111 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxcharttimeaxis.h>
+#include <catch.hpp>
+
+namespace
+{
+    // 2018-01-01 00:00:00 UTC
+    const wxInt64 NewYear2018 = 1514764800000LL;
+    const wxInt64 Hour = 3600000LL;
+    const wxInt64 Day = 24 * Hour;
+}
+
+TEST_CASE("wxChartTimeAxis Floor and Advance follow the calendar")
+{
+    // 2018-02-15 13:45:00 UTC
+    wxInt64 timestamp = NewYear2018 + (45 * Day) + (13 * Hour) + (45 * 60000LL);
+
+    CHECK(wxChartTimeAxis::Floor(timestamp, wxCHARTTIMEUNIT_HOUR, 6) == (NewYear2018 + (45 * Day) + (12 * Hour)));
+    CHECK(wxChartTimeAxis::Floor(timestamp, wxCHARTTIMEUNIT_MONTH, 1) == (NewYear2018 + (31 * Day)));
+    CHECK(wxChartTimeAxis::Floor(timestamp, wxCHARTTIMEUNIT_MONTH, 3) == NewYear2018);
+    CHECK(wxChartTimeAxis::Floor(timestamp, wxCHARTTIMEUNIT_YEAR, 1) == NewYear2018);
+
+    // February 2018 has 28 days
+    wxInt64 february = NewYear2018 + (31 * Day);
+    CHECK(wxChartTimeAxis::Advance(february, wxCHARTTIMEUNIT_MONTH, 1) == (february + (28 * Day)));
+    CHECK(wxChartTimeAxis::Advance(NewYear2018, wxCHARTTIMEUNIT_YEAR, 1) == (NewYear2018 + (365 * Day)));
+
+    // Timestamps before 1970 are rounded down as well
+    CHECK(wxChartTimeAxis::Floor(-1, wxCHARTTIMEUNIT_SECOND, 1) == -1000);
+    CHECK(wxChartTimeAxis::FormatLabel(-1, wxCHARTTIMEUNIT_DAY) == "1969-12-31");
+}
+
+TEST_CASE("wxChartTimeAxis UpdateRange places the tick marks on calendar boundaries")
+{
+    wxChartAxisOptions options(wxCHARTAXISPOSITION_BOTTOM);
+    wxChartTimeAxis axis("x", options);
+
+    // Ten days between 07:30 and 16:00
+    REQUIRE(axis.UpdateRange(NewYear2018 + (7 * Hour) + 1800000, NewYear2018 + (10 * Day) + (16 * Hour), 12));
+    CHECK(axis.GetUnit() == wxCHARTTIMEUNIT_DAY);
+    CHECK(axis.GetStep() == 1);
+    CHECK(axis.GetStart() == NewYear2018);
+    CHECK(axis.GetEnd() == (NewYear2018 + (11 * Day)));
+    CHECK(axis.GetTickMarks().size() == 12);
+    CHECK(axis.GetLabels().size() == 12);
+    CHECK(axis.GetLabels()[0].GetText() == "2018-01-01");
+    CHECK(axis.GetLabels()[11].GetText() == "2018-01-12");
+
+    // A long range switches to months
+    REQUIRE(axis.UpdateRange(NewYear2018, NewYear2018 + (300 * Day), 12));
+    CHECK(axis.GetUnit() == wxCHARTTIMEUNIT_MONTH);
+    CHECK(axis.GetTickMarks().size() <= 12);
+    CHECK(axis.GetLabels()[1].GetText() == "2018-02");
+
+    // And a short one to milliseconds
+    REQUIRE(axis.UpdateRange(NewYear2018 + 3, NewYear2018 + 42, 10));
+    CHECK(axis.GetUnit() == wxCHARTTIMEUNIT_MILLISECOND);
+    CHECK(axis.GetLabels()[0].GetText() == "00:00:00.000");
+}
+
+TEST_CASE("wxChartTimeAxis UpdateRange keeps the tick marks when they don't change")
+{
+    wxChartAxisOptions options(wxCHARTAXISPOSITION_BOTTOM);
+    wxChartTimeAxis axis("x", options);
+
+    REQUIRE(axis.UpdateRange(NewYear2018 + Hour, NewYear2018 + (5 * Hour), 10));
+    const wxChartLabel *firstLabel = &axis.GetLabels()[0];
+
+    // The same range and a range with the same surrounding
+    // tick marks don't rebuild the labels
+    CHECK(!axis.UpdateRange(NewYear2018 + Hour, NewYear2018 + (5 * Hour), 10));
+    CHECK(!axis.UpdateRange(NewYear2018 + Hour + 1000, NewYear2018 + (5 * Hour) - 1000, 10));
+    CHECK(&axis.GetLabels()[0] == firstLabel);
+
+    CHECK(axis.UpdateRange(NewYear2018 + (2 * Hour), NewYear2018 + (6 * Hour), 10));
+}
+
+TEST_CASE("wxChartTimeAxis GetRelativePosition is linear between tick marks")
+{
+    wxChartAxisOptions options(wxCHARTAXISPOSITION_BOTTOM);
+    wxChartTimeAxis axis("x", options);
+
+    REQUIRE(axis.UpdateRange(NewYear2018, NewYear2018 + (4 * Day), 5));
+    REQUIRE(axis.GetTickMarks().size() == 5);
+
+    CHECK(axis.GetRelativePosition(NewYear2018) == Approx(0));
+    CHECK(axis.GetRelativePosition(NewYear2018 + (2 * Day)) == Approx(0.5));
+    CHECK(axis.GetRelativePosition(NewYear2018 + Day + (12 * Hour)) == Approx(0.375));
+    CHECK(axis.GetRelativePosition(NewYear2018 + (4 * Day)) == Approx(1));
+}
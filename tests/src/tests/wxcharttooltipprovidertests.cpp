@@ -0,0 +1,52 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxcharts.h>
+#include <catch.hpp>
+
+TEST_CASE("wxChartTooltipProviderStatic constructor")
+{
+    wxChartTooltipProviderStatic provider("title", "text", *wxRED);
+
+    REQUIRE(provider.GetTooltipTitle() == "title");
+    REQUIRE(provider.GetTooltipText() == "text");
+    REQUIRE(provider.GetAssociatedColor() == *wxRED);
+}
+
+TEST_CASE("wxChartTooltipProviderLazy generates the text once")
+{
+    int count = 0;
+    wxChartTooltipProviderLazy provider(
+        wxChartTooltipProviderLazy::Generator(),
+        [&count]() -> wxString
+        {
+            ++count;
+            return "text";
+        },
+        *wxRED);
+
+    REQUIRE(count == 0);
+    REQUIRE(provider.GetTooltipTitle() == "");
+    REQUIRE(provider.GetTooltipText() == "text");
+    REQUIRE(provider.GetTooltipText() == "text");
+    REQUIRE(count == 1);
+}
@@ -0,0 +1,285 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxchartutilities.h>
+#include <catch.hpp>
+#include <cmath>
+
+TEST_CASE("wxChartUtilities UpdateExtents values")
+{
+    wxVector<wxDouble> values;
+    values.push_back(3);
+    values.push_back(-2);
+    values.push_back(7);
+    values.push_back(1);
+
+    bool found = false;
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    wxChartUtilities::UpdateExtents(values, found, minValue, maxValue);
+
+    CHECK(found);
+    CHECK(minValue == -2);
+    CHECK(maxValue == 7);
+
+    wxVector<wxDouble> moreValues;
+    moreValues.push_back(10);
+    wxChartUtilities::UpdateExtents(moreValues, found, minValue, maxValue);
+
+    CHECK(minValue == -2);
+    CHECK(maxValue == 10);
+
+    wxChartUtilities::UpdateExtents(wxVector<wxDouble>(), found, minValue, maxValue);
+
+    CHECK(minValue == -2);
+    CHECK(maxValue == 10);
+}
+
+TEST_CASE("wxChartUtilities UpdateExtents empty")
+{
+    bool found = false;
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    wxChartUtilities::UpdateExtents(wxVector<wxDouble>(), found, minValue, maxValue);
+
+    CHECK(!found);
+}
+
+TEST_CASE("wxChartUtilities UpdateExtents stride")
+{
+    // Every other value must be ignored
+    const wxDouble values[] = { 50, 1000, 20, -1000, 30 };
+
+    bool found = false;
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    wxChartUtilities::UpdateExtents(values, 3, 2, found, minValue, maxValue);
+
+    CHECK(minValue == 20);
+    CHECK(maxValue == 50);
+}
+
+TEST_CASE("wxChartUtilities UpdateExtents members")
+{
+    wxVector<wxPoint2DDouble> points;
+    points.push_back(wxPoint2DDouble(1, 50));
+    points.push_back(wxPoint2DDouble(-4, 20));
+    points.push_back(wxPoint2DDouble(9, 30));
+
+    bool found = false;
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    wxChartUtilities::UpdateExtents(&points[0], points.size(),
+        &wxPoint2DDouble::m_y, &wxPoint2DDouble::m_y, found, minValue, maxValue);
+
+    CHECK(found);
+    CHECK(minValue == 20);
+    CHECK(maxValue == 50);
+}
+
+namespace
+{
+    class wxChartUtilitiesTestBar
+    {
+    public:
+        wxChartUtilitiesTestBar(wxDouble low, wxDouble high)
+            : m_low(low), m_high(high)
+        {
+        }
+
+        wxDouble GetLow() const { return m_low; }
+        wxDouble GetHigh() const { return m_high; }
+
+    private:
+        wxDouble m_low;
+        wxDouble m_high;
+    };
+
+    struct wxChartUtilitiesTestTriplet
+    {
+        wxDouble m_x;
+        wxDouble m_y;
+        wxDouble m_z;
+    };
+}
+
+TEST_CASE("wxChartUtilities UpdateExtents getters")
+{
+    // The lowest value comes from the low values
+    // and the highest from the high values only
+    wxVector<wxChartUtilitiesTestBar> bars;
+    bars.push_back(wxChartUtilitiesTestBar(10, 40));
+    bars.push_back(wxChartUtilitiesTestBar(-5, 15));
+    bars.push_back(wxChartUtilitiesTestBar(60, 70));
+
+    bool found = false;
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    wxChartUtilities::UpdateExtents(&bars[0], bars.size(),
+        &wxChartUtilitiesTestBar::GetLow, &wxChartUtilitiesTestBar::GetHigh,
+        found, minValue, maxValue);
+
+    CHECK(found);
+    CHECK(minValue == -5);
+    CHECK(maxValue == 70);
+}
+
+TEST_CASE("wxChartUtilities UpdateExtents transform")
+{
+    wxVector<wxDouble> values;
+    values.push_back(1);
+    values.push_back(100);
+    values.push_back(10);
+
+    size_t calls = 0;
+    bool found = false;
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    wxChartUtilities::UpdateExtents(&values[0], values.size(),
+        [&calls](wxDouble value)
+        {
+            ++calls;
+            return -std::log10(value);
+        },
+        found, minValue, maxValue);
+
+    CHECK(calls == 3);
+    CHECK(minValue == -2);
+    CHECK(maxValue == 0);
+}
+
+TEST_CASE("wxChartUtilities UpdateExtents points")
+{
+    wxVector<wxPoint2DDouble> points;
+    points.push_back(wxPoint2DDouble(1, 50));
+    points.push_back(wxPoint2DDouble(-4, 20));
+    points.push_back(wxPoint2DDouble(9, 30));
+
+    bool found = false;
+    wxDouble minX = 0;
+    wxDouble maxX = 0;
+    wxDouble minY = 0;
+    wxDouble maxY = 0;
+    wxChartUtilities::UpdateExtents(points, found, minX, maxX, minY, maxY);
+
+    CHECK(found);
+    CHECK(minX == -4);
+    CHECK(maxX == 9);
+    CHECK(minY == 20);
+    CHECK(maxY == 50);
+}
+
+TEST_CASE("wxChartUtilities UpdateExtents triplets")
+{
+    const wxChartUtilitiesTestTriplet values[] = {
+        { 1, 50, 7 }, { -4, 20, 3 }, { 9, 30, -2 }
+    };
+
+    bool found = true;
+    wxDouble minX = 0;
+    wxDouble maxX = 2;
+    wxDouble minY = 0;
+    wxDouble maxY = 2;
+    wxDouble minZ = 0;
+    wxDouble maxZ = 2;
+    wxChartUtilities::UpdateExtents(values, 3, &wxChartUtilitiesTestTriplet::m_x,
+        &wxChartUtilitiesTestTriplet::m_y, &wxChartUtilitiesTestTriplet::m_z,
+        found, minX, maxX, minY, maxY, minZ, maxZ);
+
+    CHECK(found);
+    CHECK(minX == -4);
+    CHECK(maxX == 9);
+    CHECK(minY == 0);
+    CHECK(maxY == 50);
+    CHECK(minZ == -2);
+    CHECK(maxZ == 7);
+}
+
+TEST_CASE("wxChartUtilities UpdateExtents large array")
+{
+    // Large enough to be split between several threads
+    // on most machines
+    const size_t count = 3000000;
+    wxVector<wxDouble> values(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[i] = (i % 1000);
+    }
+    values[count - 1] = 5000;
+    values[count / 2] = -5000;
+
+    bool found = false;
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    wxChartUtilities::UpdateExtents(values, found, minValue, maxValue);
+
+    CHECK(minValue == -5000);
+    CHECK(maxValue == 5000);
+}
+
+TEST_CASE("wxChartUtilities ParallelFor")
+{
+    const size_t count = 3000000;
+    size_t chunkCount = wxChartUtilities::GetParallelChunkCount(count);
+    REQUIRE(chunkCount >= 1);
+    CHECK(wxChartUtilities::GetParallelChunkCount(10) == 1);
+
+    // Each chunk only writes to its own slot so no
+    // synchronization is needed
+    wxVector<size_t> chunkBegins(chunkCount, count);
+    wxVector<size_t> chunkEnds(chunkCount, 0);
+    wxChartUtilities::ParallelFor(count,
+        [&chunkBegins, &chunkEnds](size_t chunk, size_t begin, size_t end)
+        {
+            chunkBegins[chunk] = begin;
+            chunkEnds[chunk] = end;
+        });
+
+    // The chunks cover the whole range without overlapping
+    CHECK(chunkBegins[0] == 0);
+    for (size_t i = 1; i < chunkCount; ++i)
+    {
+        CHECK(chunkBegins[i] == chunkEnds[i - 1]);
+    }
+    CHECK(chunkEnds[chunkCount - 1] == count);
+}
+
+TEST_CASE("wxChartUtilities ReplaceInExtents")
+{
+    wxDouble minValue = 1;
+    wxDouble maxValue = 5;
+
+    // A value inside the range changes without touching the bounds
+    CHECK(wxChartUtilities::ReplaceInExtents(3, 4, minValue, maxValue));
+    CHECK(minValue == 1);
+    CHECK(maxValue == 5);
+
+    // The range is extended
+    CHECK(wxChartUtilities::ReplaceInExtents(3, 8, minValue, maxValue));
+    CHECK(maxValue == 8);
+    CHECK(wxChartUtilities::ReplaceInExtents(1, -2, minValue, maxValue));
+    CHECK(minValue == -2);
+
+    // The range may shrink
+    CHECK(!wxChartUtilities::ReplaceInExtents(8, 6, minValue, maxValue));
+    CHECK(!wxChartUtilities::ReplaceInExtents(-2, 0, minValue, maxValue));
+}
@@ -0,0 +1,152 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxhistchartsketch.h>
+#include <catch.hpp>
+#include <cmath>
+
+TEST_CASE("wxHistogramChartSketch Add")
+{
+    wxHistogramChartSketch sketch;
+    REQUIRE(sketch.IsEmpty());
+
+    for (size_t i = 1; i <= 1000; ++i)
+    {
+        sketch.Add(i);
+    }
+    sketch.Add(NAN);
+
+    CHECK(sketch.GetCount() == 1000);
+    CHECK(sketch.GetMin() == 1);
+    CHECK(sketch.GetMax() == 1000);
+    CHECK(std::abs(sketch.GetQuantile(0.5) - 500) <= 500 * sketch.GetRelativeAccuracy());
+    CHECK(std::abs(sketch.GetQuantile(0.99) - 990) <= 990 * sketch.GetRelativeAccuracy());
+}
+
+TEST_CASE("wxHistogramChartSketch negative values and zero")
+{
+    wxHistogramChartSketch sketch;
+    sketch.Add(-100);
+    sketch.Add(0);
+    sketch.Add(100);
+
+    CHECK(sketch.GetMin() == -100);
+    CHECK(sketch.GetMax() == 100);
+    CHECK(sketch.GetQuantile(0.5) == 0);
+
+    wxVector<size_t> counts;
+    sketch.Rebin(-100, 100, 4, counts);
+    REQUIRE(counts.size() == 4);
+    CHECK(counts[0] == 1);
+    CHECK(counts[1] == 0);
+    CHECK(counts[2] == 1);
+    CHECK(counts[3] == 1);
+}
+
+TEST_CASE("wxHistogramChartSketch keeps a bounded number of buckets")
+{
+    wxHistogramChartSketch sketch(0.01, 64);
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        sketch.Add(1.0 + i);
+    }
+
+    CHECK(sketch.GetCount() == 100000);
+    // The largest values keep their accuracy
+    CHECK(std::abs(sketch.GetQuantile(0.999) - 99900) <= 99900 * sketch.GetRelativeAccuracy());
+
+    wxVector<size_t> counts;
+    sketch.Rebin(sketch.GetMin(), sketch.GetMax(), 10, counts);
+    size_t total = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        total += counts[i];
+    }
+    CHECK(total == 100000);
+}
+
+TEST_CASE("wxHistogramChartSketch Merge")
+{
+    wxHistogramChartSketch sketch1;
+    wxHistogramChartSketch sketch2;
+    wxHistogramChartSketch all;
+    for (size_t i = 1; i <= 500; ++i)
+    {
+        sketch1.Add(i);
+        all.Add(i);
+    }
+    for (size_t i = 501; i <= 1000; ++i)
+    {
+        sketch2.Add(i);
+        all.Add(i);
+    }
+
+    REQUIRE(sketch1.Merge(sketch2));
+    CHECK(sketch1.GetCount() == 1000);
+    CHECK(sketch1.GetMin() == 1);
+    CHECK(sketch1.GetMax() == 1000);
+    CHECK(sketch1.GetQuantile(0.9) == all.GetQuantile(0.9));
+
+    wxHistogramChartSketch otherAccuracy(0.05);
+    CHECK(!sketch1.Merge(otherAccuracy));
+}
+
+TEST_CASE("wxHistogramChartSketch Rebin")
+{
+    wxHistogramChartSketch sketch;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        sketch.Add(10 + (i % 10));
+    }
+
+    wxVector<size_t> counts;
+    sketch.Rebin(10, 19, 3, counts);
+    REQUIRE(counts.size() == 3);
+    CHECK((counts[0] + counts[1] + counts[2]) == 100);
+
+    sketch.Rebin(10, 19, 1, counts);
+    REQUIRE(counts.size() == 1);
+    CHECK(counts[0] == 100);
+}
+
+TEST_CASE("wxHistogramChartSketch Rebin spreads the buckets")
+{
+    // The buckets of the sketch are much wider than the bins
+    // for the large values, counting each of them in a single
+    // bin would leave some bins empty and others too high
+    wxHistogramChartSketch sketch(0.05);
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        sketch.Add(1000 + (i % 1000));
+    }
+
+    wxVector<size_t> counts;
+    sketch.Rebin(sketch.GetMin(), sketch.GetMax(), 50, counts);
+    REQUIRE(counts.size() == 50);
+    size_t total = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        total += counts[i];
+        CHECK(std::abs(static_cast<double>(counts[i]) - 2000) <= 2000 * 0.1);
+    }
+    CHECK(total == 100000);
+}
@@ -0,0 +1,223 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxhistchart.h>
+#include <wx/charts/wxchartnumericalaxis.h>
+#include <catch.hpp>
+#include <wx/image.h>
+#include <cmath>
+#include <sstream>
+
+class wxHistogramChartTest
+{
+public:
+    typedef wxHistogramChart::Dataset Dataset;
+    typedef wxHistogramChart::Bucket Bucket;
+
+    static const Dataset& GetDataset(const wxHistogramChart &chart)
+    {
+        return *chart.m_dataset;
+    }
+
+    static const wxChartGridMapping& GetMapping(const wxHistogramChart &chart)
+    {
+        return chart.m_grid.GetMapping();
+    }
+
+    static std::size_t GetAxisMaxY(const wxHistogramChart &chart)
+    {
+        return chart.m_axisMaxY;
+    }
+
+    static wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(wxHistogramChart &chart,
+        const wxPoint &point)
+    {
+        return chart.GetActiveElements(point);
+    }
+};
+
+static wxHistogramChartData CreateData(const wxVector<wxDouble> &values, std::size_t nbins)
+{
+    wxHistogramChartDataset::ptr dataset(
+        new wxHistogramChartDataset(*wxBLACK, *wxWHITE, values));
+    return wxHistogramChartData(dataset, nbins);
+}
+
+TEST_CASE("wxHistogramChart Dataset GetBucketIndex")
+{
+    wxHistogramChartTest::Dataset dataset(0, 10, 5, *wxBLACK, *wxWHITE);
+
+    // The minimum and the maximum
+    CHECK(dataset.GetBucketIndex(0) == 0);
+    CHECK(dataset.GetBucketIndex(10) == 4);
+
+    // A value on the limit between two buckets belongs
+    // to the upper one
+    CHECK(dataset.GetBucketIndex(1.999) == 0);
+    CHECK(dataset.GetBucketIndex(2) == 1);
+    CHECK(dataset.GetBucketIndex(4) == 2);
+    CHECK(dataset.GetBucketIndex(8) == 4);
+    CHECK(dataset.GetBucketIndex(7.5) == 3);
+
+    // Values out of range go to the first or the last bucket
+    CHECK(dataset.GetBucketIndex(-1) == 0);
+    CHECK(dataset.GetBucketIndex(11) == 4);
+    CHECK(dataset.GetBucketIndex(NAN) == 4);
+}
+
+TEST_CASE("wxHistogramChart Dataset GetBucketIndex with rounding")
+{
+    // The limits of these buckets can't be represented
+    // exactly so the division alone would put some of
+    // them in the wrong bucket
+    wxHistogramChartTest::Dataset dataset(0.1, 1.3, 12, *wxBLACK, *wxWHITE);
+    const wxVector<wxHistogramChartTest::Bucket> &buckets = dataset.GetBuckets();
+    REQUIRE(buckets.size() == 12);
+
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        CHECK(dataset.GetBucketIndex(buckets[i].m_begin) == i);
+        CHECK(dataset.GetBucketIndex(std::nextafter(buckets[i].m_end, buckets[i].m_begin)) == i);
+    }
+}
+
+TEST_CASE("wxHistogramChart Dataset AppendValues in parallel")
+{
+    // Large enough to be split between several threads
+    // on most machines
+    const std::size_t count = 3000000;
+    wxVector<wxDouble> values(count);
+    unsigned int seed = 12345;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        seed = (seed * 1103515245u) + 12345u;
+        values[i] = ((seed >> 8) % 20001) / 100.0 - 50;
+    }
+
+    wxHistogramChartTest::Dataset parallel(-40, 140, 37, *wxBLACK, *wxWHITE);
+    parallel.AppendValues(&values[0], values.size());
+
+    wxHistogramChartTest::Dataset serial(-40, 140, 37, *wxBLACK, *wxWHITE);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        serial.AppendValue(values[i]);
+    }
+
+    const wxVector<wxHistogramChartTest::Bucket> &parallelBuckets = parallel.GetBuckets();
+    const wxVector<wxHistogramChartTest::Bucket> &serialBuckets = serial.GetBuckets();
+    REQUIRE(parallelBuckets.size() == serialBuckets.size());
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < parallelBuckets.size(); ++i)
+    {
+        CHECK(parallelBuckets[i].m_count == serialBuckets[i].m_count);
+        total += parallelBuckets[i].m_count;
+    }
+    CHECK(total == count);
+    CHECK(parallel.GetMaxCount() == serial.GetMaxCount());
+}
+
+TEST_CASE("wxHistogramChart AddValues")
+{
+    wxVector<wxDouble> values;
+    for (std::size_t i = 0; i <= 10; ++i)
+    {
+        values.push_back(i);
+    }
+    wxHistogramChart chart(CreateData(values, 5), wxSize(400, 300));
+
+    const wxHistogramChartTest::Dataset &dataset = wxHistogramChartTest::GetDataset(chart);
+    const wxVector<wxHistogramChartTest::Bucket> &buckets = dataset.GetBuckets();
+    REQUIRE(buckets.size() == 5);
+    CHECK(buckets[0].m_count == 2);
+    CHECK(buckets[4].m_count == 3);
+    CHECK(wxHistogramChartTest::GetAxisMaxY(chart) == 3);
+
+    // The buckets keep their range, values outside of it
+    // are counted in the first or the last bucket
+    wxVector<wxDouble> newValues;
+    newValues.push_back(1);
+    newValues.push_back(1.5);
+    newValues.push_back(-20);
+    newValues.push_back(5);
+    newValues.push_back(100);
+    chart.AddValues(newValues);
+
+    const wxVector<wxHistogramChartTest::Bucket> &newBuckets =
+        wxHistogramChartTest::GetDataset(chart).GetBuckets();
+    CHECK(newBuckets[0].m_begin == 0);
+    CHECK(newBuckets[4].m_end == 10);
+    CHECK(newBuckets[0].m_count == 5);
+    CHECK(newBuckets[1].m_count == 2);
+    CHECK(newBuckets[2].m_count == 3);
+    CHECK(newBuckets[3].m_count == 2);
+    CHECK(newBuckets[4].m_count == 4);
+
+    // The y-axis follows the highest count
+    CHECK(wxHistogramChartTest::GetDataset(chart).GetMaxCount() == 5);
+    CHECK(wxHistogramChartTest::GetAxisMaxY(chart) == 5);
+    const wxChartNumericalAxis *yAxis = dynamic_cast<const wxChartNumericalAxis*>(
+        &wxHistogramChartTest::GetMapping(chart).GetYAxis());
+    REQUIRE(yAxis);
+    CHECK(yAxis->GetMaxValue() >= 5);
+}
+
+TEST_CASE("wxHistogramChart GetActiveElements")
+{
+    wxVector<wxDouble> values;
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        values.push_back(i % 10);
+    }
+    values.push_back(2);
+    wxHistogramChart chart(CreateData(values, 5), wxSize(400, 300));
+
+    // The grid is only laid out when the chart is drawn
+    wxImage image;
+    REQUIRE(chart.RenderTo(image, wxSize(400, 300)));
+
+    const wxChartGridMapping &mapping = wxHistogramChartTest::GetMapping(chart);
+    const wxVector<wxHistogramChartTest::Bucket> &buckets =
+        wxHistogramChartTest::GetDataset(chart).GetBuckets();
+    REQUIRE(buckets.size() == 5);
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        const wxHistogramChartTest::Bucket &bucket = buckets[i];
+        wxPoint2DDouble center = mapping.GetWindowPosition(
+            (bucket.m_begin + bucket.m_end) / 2, bucket.m_count / 2.0);
+        wxSharedPtr<wxVector<const wxChartElement*> > elements =
+            wxHistogramChartTest::GetActiveElements(chart, wxPoint(center.m_x, center.m_y));
+        REQUIRE(elements->size() == 1);
+
+        std::stringstream count;
+        count << bucket.m_count;
+        CHECK((*elements)[0]->GetTooltipProvider()->GetTooltipText() == count.str());
+        const wxChartRectangle *rectangle = dynamic_cast<const wxChartRectangle*>((*elements)[0]);
+        REQUIRE(rectangle);
+        CHECK(rectangle->GetPosition().m_x == Approx(mapping.GetWindowPosition(bucket.m_begin, 0).m_x));
+    }
+
+    // Above the highest bar and left of the first bucket
+    wxPoint2DDouble above = mapping.GetWindowPosition(1, buckets[1].m_count + 5);
+    CHECK(wxHistogramChartTest::GetActiveElements(chart, wxPoint(above.m_x, above.m_y))->empty());
+    wxPoint2DDouble left = mapping.GetWindowPosition(0, 1);
+    CHECK(wxHistogramChartTest::GetActiveElements(chart, wxPoint(left.m_x - 5, left.m_y))->empty());
+}
@@ -0,0 +1,118 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxcharts.h>
+#include <catch.hpp>
+#include <wx/image.h>
+
+class wxLineChartTest
+{
+public:
+    static const wxChartPointSeries& GetPoints(const wxLineChart &chart, size_t dataset)
+    {
+        return chart.m_datasets[dataset]->GetPoints();
+    }
+};
+
+TEST_CASE("wxLineChart only creates the labels that are displayed")
+{
+    const wxSize size(400, 300);
+    wxVector<wxString> labels;
+    labels.push_back("a");
+    labels.push_back("b");
+    wxVector<wxDouble> values;
+    values.push_back(1);
+    values.push_back(2);
+    wxLineChartData data(labels);
+    data.AddDataset(wxLineChartDataset::ptr(new wxLineChartDataset(
+        "dataset", *wxBLACK, *wxBLACK, *wxWHITE, values)));
+
+    wxLineChartOptions options;
+    options.SetMaxCount(1000);
+    wxLineChart chart(data, options, size);
+    size_t calls = 0;
+    chart.SetLabelGenerator([&calls](size_t index)
+        {
+            ++calls;
+            return wxString("label");
+        });
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        wxVector<wxVector<wxDouble> > batch(1, wxVector<wxDouble>(100, i));
+        REQUIRE(chart.AddData(batch));
+    }
+    CHECK(calls == 0);
+
+    wxImage image;
+    REQUIRE(chart.RenderTo(image, size));
+    CHECK(calls > 0);
+    CHECK(calls < 100);
+
+    // The explicit labels were discarded along with their values
+    // and the labels keep following the values
+    REQUIRE(chart.AddData("c", wxVector<wxDouble>(1, 5)));
+    wxVector<wxVector<wxDouble> > batch(1, wxVector<wxDouble>(1, 5));
+    CHECK(!chart.AddData(wxVector<wxVector<wxDouble> >()));
+    REQUIRE(chart.AddData(batch));
+    REQUIRE(chart.RenderTo(image, size));
+}
+
+TEST_CASE("wxLineChart places the values of shorter datasets at their labels")
+{
+    const wxSize size(400, 300);
+    wxVector<wxString> labels;
+    labels.push_back("a");
+    labels.push_back("b");
+    labels.push_back("c");
+    wxVector<wxDouble> longValues;
+    longValues.push_back(1);
+    longValues.push_back(2);
+    longValues.push_back(3);
+    wxLineChartData data(labels);
+    data.AddDataset(wxLineChartDataset::ptr(new wxLineChartDataset(
+        "long", *wxBLACK, *wxBLACK, *wxWHITE, longValues)));
+    data.AddDataset(wxLineChartDataset::ptr(new wxLineChartDataset(
+        "short", *wxBLACK, *wxBLACK, *wxWHITE, wxVector<wxDouble>(1, 1))));
+
+    wxLineChartOptions options;
+    options.SetMaxCount(3);
+    wxLineChart chart(data, options, size);
+
+    wxVector<wxDouble> values;
+    values.push_back(4);
+    values.push_back(4);
+    REQUIRE(chart.AddData("d", values));
+
+    // The first label was discarded along with the
+    // first value of both datasets
+    const wxChartPointSeries& longPoints = wxLineChartTest::GetPoints(chart, 0);
+    const wxChartPointSeries& shortPoints = wxLineChartTest::GetPoints(chart, 1);
+    REQUIRE(longPoints.GetCount() == 3);
+    REQUIRE(shortPoints.GetCount() == 1);
+    CHECK(longPoints.GetX(2) == shortPoints.GetX(0));
+
+    wxImage image;
+    REQUIRE(chart.RenderTo(image, size));
+    CHECK(shortPoints.GetPosition(0).m_x == longPoints.GetPosition(2).m_x);
+    CHECK(longPoints.GetPosition(0).m_x < longPoints.GetPosition(2).m_x);
+}
@@ -0,0 +1,103 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxcharts.h>
+#include <catch.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("wxMath2DPlot decimates the markers on the background thread")
+{
+    const size_t count = 100000;
+    const wxSize size(400, 300);
+    wxVector<wxPoint2DDouble> points;
+    for (size_t i = 0; i < count; ++i)
+    {
+        points.push_back(wxPoint2DDouble(i, (i * 7) % 13));
+    }
+    wxMath2DPlotData data;
+    data.AddDataset(wxMath2DPlotDataset::ptr(new wxMath2DPlotDataset(
+        *wxBLACK, *wxBLACK, *wxBLACK, points)));
+
+    wxMath2DPlot chart(data, size);
+    std::atomic<bool> published(false);
+    chart.SetBackgroundPreparation(true, [&published]() { published = true; });
+    chart.GetInstrumentation().Enable();
+
+    // The first drawing submits the job, the second one
+    // draws the snapshot it produced
+    wxImage image;
+    chart.RenderTo(image, size);
+    for (size_t i = 0; (i < 1000) && !published; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(published);
+    chart.RenderTo(image, size);
+
+    // At most four markers per pixel column and the line
+    const wxChartStageCounters& counters = chart.GetInstrumentation().GetLastFrame(wxCHARTSTAGE_DATASETS);
+    CHECK(counters.GetPrimitives() > 1);
+    CHECK(counters.GetPrimitives() <= ((4 * size.GetWidth()) + 1));
+}
+
+TEST_CASE("wxMath2DPlot ignores a stale snapshot when hit testing")
+{
+    const size_t count = 100000;
+    const wxSize size(400, 300);
+    wxVector<wxPoint2DDouble> points;
+    for (size_t i = 0; i < count; ++i)
+    {
+        points.push_back(wxPoint2DDouble(i, (i * 7) % 13));
+    }
+    wxVector<wxPoint2DDouble> fewPoints;
+    fewPoints.push_back(wxPoint2DDouble(0, 0));
+    fewPoints.push_back(wxPoint2DDouble(count - 1, 12));
+    wxMath2DPlotData data;
+    data.AddDataset(wxMath2DPlotDataset::ptr(new wxMath2DPlotDataset(
+        *wxBLACK, *wxBLACK, *wxBLACK, points)));
+    data.AddDataset(wxMath2DPlotDataset::ptr(new wxMath2DPlotDataset(
+        *wxBLACK, *wxBLACK, *wxBLACK, fewPoints)));
+
+    wxMath2DPlot chart(data, size);
+    std::atomic<bool> published(false);
+    chart.SetBackgroundPreparation(true, [&published]() { published = true; });
+
+    wxImage image;
+    chart.RenderTo(image, size);
+    for (size_t i = 0; (i < 1000) && !published; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(published);
+    chart.RenderTo(image, size);
+    const wxPoint center(size.GetWidth() / 2, size.GetHeight() / 2);
+    CHECK(chart.ActivateElementsAt(center));
+
+    // The markers of the snapshot refer to the points of the
+    // removed dataset, the chart hasn't been drawn again so
+    // there is no snapshot for the remaining dataset yet
+    REQUIRE(chart.RemoveDataset(0));
+    CHECK(chart.ActivateElementsAt(center));
+    CHECK(!chart.ActivateElementsAt(center));
+}
@@ -0,0 +1,107 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxdoughnutandpiechartbase.h>
+#include <catch.hpp>
+
+namespace
+{
+    class TestObserver : public wxChartValueObserver<std::map<wxString, wxChartSliceData>, wxPieChartDataDelta>
+    {
+    public:
+        TestObserver() : notifications(0), fullUpdate(false) {}
+
+        void OnUpdate(const std::map<wxString, wxChartSliceData> &data) override
+        {
+        }
+
+        void OnDeltaUpdate(const std::map<wxString, wxChartSliceData> &data,
+            const wxPieChartDataDelta &delta) override
+        {
+            ++notifications;
+            fullUpdate = delta.IsFullUpdate();
+            changedSlices = delta.GetChangedSlices();
+        }
+
+        int notifications;
+        bool fullUpdate;
+        std::set<wxString> changedSlices;
+    };
+}
+
+TEST_CASE("wxPieChartData notifies the changed slices")
+{
+    wxPieChartData data;
+    TestObserver observer;
+    data.AddObserver(&observer);
+
+    data.AppendSlice(wxChartSliceData(1, *wxRED, "a"));
+    CHECK(observer.notifications == 1);
+    CHECK(!observer.fullUpdate);
+    CHECK(observer.changedSlices.size() == 1);
+    CHECK(observer.changedSlices.count("a") == 1);
+
+    // The delta is cleared after each notification
+    data.AppendSlice(wxChartSliceData(2, *wxRED, "b"));
+    CHECK(observer.notifications == 2);
+    CHECK(observer.changedSlices.size() == 1);
+    CHECK(observer.changedSlices.count("b") == 1);
+}
+
+TEST_CASE("wxChartUpdateLocker coalesces the notifications")
+{
+    wxPieChartData data;
+    TestObserver observer;
+    data.AddObserver(&observer);
+
+    {
+        wxChartUpdateLocker<wxPieChartData> locker(data);
+        data.AppendSlice(wxChartSliceData(1, *wxRED, "a"));
+        data.AppendSlice(wxChartSliceData(2, wxColor(0, 255, 0), "b"));
+        data.AppendSlice(wxChartSliceData(3, *wxRED, "a"));
+        CHECK(data.IsUpdating());
+        CHECK(observer.notifications == 0);
+    }
+
+    CHECK(!data.IsUpdating());
+    CHECK(observer.notifications == 1);
+    CHECK(observer.changedSlices.size() == 2);
+    CHECK(data.GetSlices().find("a")->second.GetValue() == 4);
+}
+
+TEST_CASE("wxPieChartData UpdateSlices is a full update")
+{
+    wxPieChartData data;
+    TestObserver observer;
+    data.AddObserver(&observer);
+
+    data.BeginUpdate();
+    data.AppendSlice(wxChartSliceData(1, *wxRED, "a"));
+    wxVector<wxChartSliceData> slices;
+    slices.push_back(wxChartSliceData(2, wxColor(0, 255, 0), "b"));
+    data.UpdateSlices(slices);
+    data.EndUpdate();
+
+    CHECK(observer.notifications == 1);
+    CHECK(observer.fullUpdate);
+    CHECK(data.GetSlices().size() == 1);
+}
@@ -0,0 +1,106 @@
+/*
+    Copyright (c) 2018 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include <wx/charts/wxcharts.h>
+#include <catch.hpp>
+#include <wx/image.h>
+
+TEST_CASE("wxTimeSeriesDataset SetMaxCount")
+{
+    wxTimeSeriesDataset dataset("dataset", *wxBLACK);
+    dataset.SetUseMinMaxPyramid(true);
+    dataset.SetMaxCount(100);
+
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        REQUIRE(dataset.Append(i * 1000, static_cast<wxDouble>(i % 17)));
+    }
+
+    REQUIRE(dataset.GetCount() == 100);
+    CHECK(dataset.GetTimestamps()[0] == 9900000);
+    CHECK(dataset.GetValues()[99] == (9999 % 17));
+
+    // The binary search and the pyramid only see the samples
+    // that are kept
+    size_t first;
+    size_t last;
+    dataset.FindRange(0, 9950000, first, last);
+    CHECK(first == 0);
+    CHECK(last == 51);
+
+    bool found = false;
+    wxDouble minValue = 0;
+    wxDouble maxValue = 0;
+    dataset.UpdateExtents(0, 100, found, minValue, maxValue);
+    CHECK(found);
+    CHECK(minValue == 0);
+    CHECK(maxValue == 16);
+
+    wxVector<size_t> boundaries;
+    boundaries.push_back(0);
+    boundaries.push_back(50);
+    boundaries.push_back(100);
+    wxVector<size_t> indices;
+    dataset.Decimate(boundaries, indices);
+    REQUIRE(!indices.empty());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        CHECK(indices[i] < 100);
+    }
+    CHECK(indices.front() == 0);
+    CHECK(indices.back() == 99);
+}
+
+TEST_CASE("wxTimeSeriesDataset SetMaxTimeSpan")
+{
+    wxTimeSeriesDataset dataset("dataset", *wxBLACK);
+    dataset.SetMaxTimeSpan(10000);
+
+    for (size_t i = 0; i <= 100; ++i)
+    {
+        REQUIRE(dataset.Append(i * 1000, static_cast<wxDouble>(i)));
+    }
+
+    REQUIRE(dataset.GetCount() == 11);
+    CHECK(dataset.GetTimestamps()[0] == 90000);
+    CHECK(dataset.GetValues()[10] == 100);
+    CHECK(!dataset.Append(0, 0));
+}
+
+TEST_CASE("wxTimeSeriesChart follows the retention window of its datasets")
+{
+    const wxSize size(400, 300);
+    wxTimeSeriesDataset::ptr dataset(new wxTimeSeriesDataset("dataset", *wxBLACK));
+    dataset->SetMaxCount(10);
+    wxTimeSeriesData data;
+    data.AddDataset(dataset);
+    wxTimeSeriesChart chart(data, size);
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        REQUIRE(chart.Append(0, i * 1000, static_cast<wxDouble>(i)));
+    }
+    CHECK(dataset->GetCount() == 10);
+
+    wxImage image;
+    CHECK(chart.RenderTo(image, size));
+}